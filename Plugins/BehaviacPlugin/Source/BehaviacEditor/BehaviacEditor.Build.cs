@@ -23,6 +23,7 @@ public class BehaviacEditor : ModuleRules
 			"SlateCore",
 			"UnrealEd",
 			"AssetTools",
+			"AssetRegistry",
 			"ContentBrowser",
 			"PropertyEditor",
 			"ToolMenus",
@@ -3,8 +3,9 @@
 
 #include "BehaviacBehaviorTreeFactory.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
 #include "AssetToolsModule.h"
-#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "EditorFramework/AssetImportData.h"
 
 // ===================================================================
@@ -62,9 +63,7 @@ UObject* UBehaviacBehaviorTreeImportFactory::FactoryCreateFile(UClass* InClass,
 
 UObject* UBehaviacBehaviorTreeImportFactory::ImportBehaviorTree(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, FFeedbackContext* Warn)
 {
-	FString FileContent;
-
-	if (!FFileHelper::LoadFileToString(FileContent, *Filename))
+	if (!FPaths::FileExists(Filename))
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Behaviac] ❌ Failed to read import file: %s"), *Filename);
 		return nullptr;
@@ -74,12 +73,16 @@ UObject* UBehaviacBehaviorTreeImportFactory::ImportBehaviorTree(UClass* InClass,
 	NewTree->TreeName = InName.ToString();
 	NewTree->SourceFilePath = Filename;
 
-	if (!NewTree->LoadFromXML(FileContent))
+	// The asset saves the cooked nodes; agents using it never parse the XML
+	if (!NewTree->CookFromFile(Filename))
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Behaviac] ❌ Failed to parse behavior tree from: %s"), *Filename);
 		return nullptr;
 	}
 
+	// Runtime loads of this file pick up the compiled sibling instead of parsing the XML
+	FBehaviacTreeBinary::CompileFile(Filename);
+
 	UE_LOG(LogTemp, Warning, TEXT("[Behaviac] ✅ Successfully imported behavior tree: %s from %s"), *InName.ToString(), *Filename);
 	return NewTree;
 }
@@ -124,19 +127,20 @@ EReimportResult::Type UBehaviacBehaviorTreeImportFactory::Reimport(UObject* Obj)
 
 	UE_LOG(LogTemp, Warning, TEXT("[Behaviac] 🔄 Reimporting behavior tree from: %s"), *Tree->SourceFilePath);
 
-	FString FileContent;
-	if (!FFileHelper::LoadFileToString(FileContent, *Tree->SourceFilePath))
+	if (!FPaths::FileExists(Tree->SourceFilePath))
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Behaviac] ❌ Failed to read source file: %s"), *Tree->SourceFilePath);
 		return EReimportResult::Failed;
 	}
 
-	if (!Tree->LoadFromXML(FileContent))
+	if (!Tree->CookFromFile(Tree->SourceFilePath))
 	{
 		UE_LOG(LogTemp, Error, TEXT("[Behaviac] ❌ Failed to parse behavior tree from: %s"), *Tree->SourceFilePath);
 		return EReimportResult::Failed;
 	}
 
+	FBehaviacTreeBinary::CompileFile(Tree->SourceFilePath);
+
 	Tree->MarkPackageDirty();
 	UE_LOG(LogTemp, Warning, TEXT("[Behaviac] ✅ Successfully reimported behavior tree: %s"), *Tree->TreeName);
 
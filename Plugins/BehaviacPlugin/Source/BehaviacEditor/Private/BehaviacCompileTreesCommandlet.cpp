@@ -0,0 +1,81 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacCompileTreesCommandlet.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviacTypes.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+UBehaviacCompileTreesCommandlet::UBehaviacCompileTreesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBehaviacCompileTreesCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Files;
+
+	FString XmlList;
+	if (FParse::Value(*Params, TEXT("Xml="), XmlList, false))
+	{
+		TArray<FString> Listed;
+		XmlList.ParseIntoArray(Listed, TEXT(","));
+		Files.Append(Listed);
+	}
+
+	if (FParse::Param(*Params, TEXT("All")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByClass(UBehaviacBehaviorTree::StaticClass()->GetClassPathName(), Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			const UBehaviacBehaviorTree* Tree = Cast<UBehaviacBehaviorTree>(Asset.GetAsset());
+			if (Tree && !Tree->SourceFilePath.IsEmpty())
+			{
+				Files.AddUnique(Tree->SourceFilePath);
+			}
+		}
+
+		// Where FBehaviacTreeRegistry looks for referenced trees
+		const FString DataDir = FPaths::ProjectContentDir() / TEXT("BehaviacData");
+		TArray<FString> DataFiles;
+		IFileManager::Get().FindFilesRecursive(DataFiles, *DataDir, TEXT("*.xml"), true, false);
+		for (const FString& File : DataFiles)
+		{
+			Files.AddUnique(File);
+		}
+	}
+
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Nothing to compile; pass -Xml= or -All"));
+		return 1;
+	}
+
+	FString OutputDir;
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+
+	int32 NumFailed = 0;
+	for (const FString& File : Files)
+	{
+		const FString BinaryPath = OutputDir.IsEmpty()
+			? FBehaviacTreeBinary::GetBinaryPath(File)
+			: OutputDir / FPaths::GetBaseFilename(File) + TEXT(".bhvb");
+		if (!FBehaviacTreeBinary::CompileFile(File, BinaryPath))
+		{
+			++NumFailed;
+		}
+	}
+
+	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Compiled %d of %d trees"), Files.Num() - NumFailed, Files.Num());
+	return NumFailed > 0 ? 1 : 0;
+}
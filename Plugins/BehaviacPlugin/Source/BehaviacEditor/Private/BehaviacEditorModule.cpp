@@ -1,6 +1,7 @@
 // BehaviacEditorModule.cpp — toolbar button to open the Behaviac BT web editor.
 
 #include "BehaviacEditorModule.h"
+#include "BehaviacEditorCommands.h"
 #include "BehaviacEditorStyle.h"
 #include "BehaviacEditorToolbarCommands.h"
 #include "ToolMenus.h"
@@ -0,0 +1,123 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacGenerateNativeTreesCommandlet.h"
+#include "BehaviacNativeTreeGenerator.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviacTypes.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+
+UBehaviacGenerateNativeTreesCommandlet::UBehaviacGenerateNativeTreesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBehaviacGenerateNativeTreesCommandlet::Main(const FString& Params)
+{
+	TArray<UBehaviacBehaviorTree*> Trees;
+
+	FString TreeList;
+	if (FParse::Value(*Params, TEXT("Trees="), TreeList, false))
+	{
+		TArray<FString> Paths;
+		TreeList.ParseIntoArray(Paths, TEXT(","));
+		for (const FString& Path : Paths)
+		{
+			if (UBehaviacBehaviorTree* Tree = LoadObject<UBehaviacBehaviorTree>(nullptr, *Path))
+			{
+				Trees.Add(Tree);
+			}
+			else
+			{
+				UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] No behavior tree asset at %s"), *Path);
+			}
+		}
+	}
+
+	FString XmlList;
+	if (FParse::Value(*Params, TEXT("Xml="), XmlList, false))
+	{
+		TArray<FString> Files;
+		XmlList.ParseIntoArray(Files, TEXT(","));
+		for (const FString& File : Files)
+		{
+			if (UBehaviacBehaviorTree* Tree = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, File))
+			{
+				Trees.Add(Tree);
+			}
+			else
+			{
+				UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Could not load behavior tree XML %s"), *File);
+			}
+		}
+	}
+
+	if (FParse::Param(*Params, TEXT("All")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByClass(UBehaviacBehaviorTree::StaticClass()->GetClassPathName(), Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			if (UBehaviacBehaviorTree* Tree = Cast<UBehaviacBehaviorTree>(Asset.GetAsset()))
+			{
+				Trees.AddUnique(Tree);
+			}
+		}
+	}
+
+	if (Trees.Num() == 0)
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Nothing to generate; pass -Trees=, -Xml= or -All"));
+		return 1;
+	}
+
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		OutputDir = FPaths::GameSourceDir() / FApp::GetProjectName() / TEXT("BehaviacGenerated");
+	}
+
+	int32 NumFailed = 0;
+	for (const UBehaviacBehaviorTree* Tree : Trees)
+	{
+		const FString TreeName = FBehaviacNativeTreeRegistry::GetTreeName(Tree);
+
+		FString Code;
+		FString Error;
+		if (!FBehaviacNativeTreeGenerator::Generate(Tree, Code, Error))
+		{
+			UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Tree %s stays interpreted: %s"), *TreeName, *Error);
+			++NumFailed;
+			continue;
+		}
+
+		// Leave unchanged files alone so regenerating does not force a rebuild
+		const FString FilePath = OutputDir / FBehaviacNativeTreeGenerator::GetFileName(TreeName);
+		FString Existing;
+		if (FFileHelper::LoadFileToString(Existing, *FilePath) && Existing == Code)
+		{
+			UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] %s is up to date"), *FilePath);
+			continue;
+		}
+
+		if (!FFileHelper::SaveStringToFile(Code, *FilePath))
+		{
+			UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Could not write %s"), *FilePath);
+			++NumFailed;
+			continue;
+		}
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Generated %s for tree %s"), *FilePath, *TreeName);
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,325 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacNativeTreeGenerator.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviorTree/Composites/BehaviacComposites.h"
+#include "BehaviorTree/Actions/BehaviacActions.h"
+#include "BehaviorTree/Conditions/BehaviacConditions.h"
+#include "BehaviorTree/Decorators/BehaviacDecorators.h"
+#include "BehaviacBlackboard.h"
+
+namespace
+{
+	/** C++ string literal body for Text */
+	FString EscapeLiteral(const FString& Text)
+	{
+		return Text.ReplaceCharWithEscapedChar();
+	}
+
+	/** Round-trippable C++ literal for Value, which must be finite: "inf" and "nan" are not literals */
+	FString FormatDouble(double Value)
+	{
+		check(FMath::IsFinite(Value));
+		FString Text = FString::Printf(TEXT("%.17g"), Value);
+		if (!Text.Contains(TEXT(".")) && !Text.Contains(TEXT("e")))
+		{
+			Text += TEXT(".0");
+		}
+		return Text;
+	}
+
+	FString FormatStatus(EBehaviacStatus Status)
+	{
+		return TEXT("EBehaviacStatus::") + StaticEnum<EBehaviacStatus>()->GetNameStringByValue((int64)Status);
+	}
+
+	/** Numeric comparison of Left against the constant Right, or empty for non-ordering operators */
+	FString FormatNumericComparison(EBehaviacOperatorType Operator, const FString& Left, const FString& Right)
+	{
+		switch (Operator)
+		{
+		case EBehaviacOperatorType::Equal:			return FString::Printf(TEXT("FMath::IsNearlyEqual(%s, %s)"), *Left, *Right);
+		case EBehaviacOperatorType::NotEqual:		return FString::Printf(TEXT("!FMath::IsNearlyEqual(%s, %s)"), *Left, *Right);
+		case EBehaviacOperatorType::Greater:			return FString::Printf(TEXT("%s > %s"), *Left, *Right);
+		case EBehaviacOperatorType::Less:			return FString::Printf(TEXT("%s < %s"), *Left, *Right);
+		case EBehaviacOperatorType::GreaterEqual:	return FString::Printf(TEXT("%s >= %s"), *Left, *Right);
+		case EBehaviacOperatorType::LessEqual:		return FString::Printf(TEXT("%s <= %s"), *Left, *Right);
+		default:									return FString();
+		}
+	}
+
+	/** Writes one node function per node, depth first, and the state they keep */
+	class FTreeWriter
+	{
+	public:
+		TArray<FString> StateMembers;
+		FString Functions;
+		FString Error;
+
+		/** Emit Node and its subtree; returns the node's function index or INDEX_NONE */
+		int32 WriteNode(const UBehaviacBehaviorNode* Node)
+		{
+			if (!Node)
+			{
+				Error = TEXT("null node");
+				return INDEX_NONE;
+			}
+			if (Node->HasAttachments())
+			{
+				Error = FString::Printf(TEXT("%s (id %d) has attachments"), *Node->GetName(), Node->NodeId);
+				return INDEX_NONE;
+			}
+
+			const int32 Index = NumNodes++;
+			TArray<int32> Children;
+			for (int32 ChildIndex = 0; ChildIndex < Node->GetChildCount(); ++ChildIndex)
+			{
+				const int32 Child = WriteNode(Node->GetChild(ChildIndex));
+				if (Child == INDEX_NONE)
+				{
+					return INDEX_NONE;
+				}
+				Children.Add(Child);
+			}
+
+			FString Body;
+			if (!WriteBody(Node, Index, Children, Body))
+			{
+				if (Error.IsEmpty())
+				{
+					Error = FString::Printf(TEXT("%s (id %d) has no generated form"), *Node->GetName(), Node->NodeId);
+				}
+				return INDEX_NONE;
+			}
+
+			Functions += FString::Printf(TEXT("\n\t/** %s (id %d) */\n\tEBehaviacStatus Node%d(UBehaviacAgentComponent* Agent)\n\t{\n%s\t}\n"),
+				*Node->GetClass()->GetName(), Node->NodeId, Index, *Body);
+			return Index;
+		}
+
+	private:
+		int32 NumNodes = 0;
+
+		bool WriteBody(const UBehaviacBehaviorNode* Node, int32 Index, const TArray<int32>& Children, FString& Body)
+		{
+			const UClass* Class = Node->GetClass();
+
+			if (Class == UBehaviacSequence::StaticClass() || Class == UBehaviacSelector::StaticClass())
+			{
+				// Sequence stops at the first failure, Selector at the first success
+				const bool bSequence = Class == UBehaviacSequence::StaticClass();
+				const TCHAR* Stop = bSequence ? TEXT("Failure") : TEXT("Success");
+				const TCHAR* Done = bSequence ? TEXT("Success") : TEXT("Failure");
+
+				StateMembers.Add(FString::Printf(TEXT("int32 Cursor%d = 0;"), Index));
+				Body += TEXT("\t\tfor (;;)\n\t\t{\n\t\t\tEBehaviacStatus Result = EBehaviacStatus::Invalid;\n");
+				Body += FString::Printf(TEXT("\t\t\tswitch (State.Cursor%d)\n\t\t\t{\n"), Index);
+				for (int32 Child = 0; Child < Children.Num(); ++Child)
+				{
+					Body += FString::Printf(TEXT("\t\t\tcase %d: Result = Node%d(Agent); break;\n"), Child, Children[Child]);
+				}
+				Body += FString::Printf(TEXT("\t\t\tdefault: State.Cursor%d = 0; return EBehaviacStatus::%s;\n\t\t\t}\n"), Index, Done);
+				Body += TEXT("\t\t\tif (Result == EBehaviacStatus::Running)\n\t\t\t{\n\t\t\t\treturn Result;\n\t\t\t}\n");
+				Body += FString::Printf(TEXT("\t\t\tif (Result == EBehaviacStatus::%s)\n\t\t\t{\n\t\t\t\tState.Cursor%d = 0;\n\t\t\t\treturn Result;\n\t\t\t}\n"), Stop, Index);
+				Body += FString::Printf(TEXT("\t\t\t++State.Cursor%d;\n\t\t}\n"), Index);
+				return true;
+			}
+
+			if (Class == UBehaviacDecoratorAlwaysSuccess::StaticClass() || Class == UBehaviacDecoratorAlwaysFailure::StaticClass()
+				|| Class == UBehaviacDecoratorNot::StaticClass() || Class == UBehaviacDecoratorLoop::StaticClass())
+			{
+				if (Children.Num() == 0)
+				{
+					Body += TEXT("\t\treturn EBehaviacStatus::Failure;\n");
+					return true;
+				}
+
+				Body += FString::Printf(TEXT("\t\tconst EBehaviacStatus Result = Node%d(Agent);\n"), Children[0]);
+				Body += TEXT("\t\tif (Result == EBehaviacStatus::Running)\n\t\t{\n\t\t\treturn Result;\n\t\t}\n");
+
+				if (Class == UBehaviacDecoratorAlwaysSuccess::StaticClass())
+				{
+					Body += TEXT("\t\treturn EBehaviacStatus::Success;\n");
+				}
+				else if (Class == UBehaviacDecoratorAlwaysFailure::StaticClass())
+				{
+					Body += TEXT("\t\treturn EBehaviacStatus::Failure;\n");
+				}
+				else if (Class == UBehaviacDecoratorNot::StaticClass())
+				{
+					Body += TEXT("\t\tif (Result == EBehaviacStatus::Success)\n\t\t{\n\t\t\treturn EBehaviacStatus::Failure;\n\t\t}\n");
+					Body += TEXT("\t\treturn Result == EBehaviacStatus::Failure ? EBehaviacStatus::Success : Result;\n");
+				}
+				else
+				{
+					// One iteration per tick; the child reset itself when it finished
+					const int32 LoopCount = CastChecked<UBehaviacDecoratorLoop>(Node)->LoopCount;
+					if (LoopCount > 0)
+					{
+						StateMembers.Add(FString::Printf(TEXT("int32 Count%d = 0;"), Index));
+						Body += FString::Printf(TEXT("\t\tif (++State.Count%d >= %d)\n\t\t{\n\t\t\tState.Count%d = 0;\n\t\t\treturn Result;\n\t\t}\n"),
+							Index, LoopCount, Index);
+					}
+					Body += TEXT("\t\treturn EBehaviacStatus::Running;\n");
+				}
+				return true;
+			}
+
+			if (Children.Num() > 0)
+			{
+				return false;
+			}
+
+			if (const UBehaviacGuardedAction* Guarded = ExactCast<UBehaviacGuardedAction>(Node))
+			{
+				// The guard is checked on entry only, like the Sequence(Condition, Action) it came from
+				FString Guard;
+				WriteComparison(Guarded->GuardLeftOperand, Guarded->GuardOperator, Guarded->GuardRightOperand, FString::Printf(TEXT("GuardHints%d"), Index), Guard);
+				Functions += FString::Printf(TEXT("\n\t/** Guard of node %d */\n\tEBehaviacStatus Guard%d(UBehaviacAgentComponent* Agent)\n\t{\n%s\t}\n"),
+					Index, Index, *Guard);
+
+				StateMembers.Add(FString::Printf(TEXT("bool Guarded%d = false;"), Index));
+				Body += FString::Printf(TEXT("\t\tif (!State.Guarded%d)\n\t\t{\n"), Index);
+				Body += FString::Printf(TEXT("\t\t\tif (Guard%d(Agent) == EBehaviacStatus::Failure)\n\t\t\t{\n\t\t\t\treturn EBehaviacStatus::Failure;\n\t\t\t}\n"), Index);
+				Body += FString::Printf(TEXT("\t\t\tState.Guarded%d = true;\n\t\t}\n"), Index);
+				Body += FString::Printf(TEXT("\t\tstatic const int32 MethodId = FBehaviacMethodRegistry::FindOrAdd(TEXT(\"%s\"));\n"), *EscapeLiteral(Guarded->MethodName));
+				Body += FString::Printf(TEXT("\t\tconst EBehaviacStatus Result = CallMethod(Agent, MethodId, %s);\n"), *FormatStatus(Guarded->ResultOption));
+				Body += FString::Printf(TEXT("\t\tif (Result != EBehaviacStatus::Running)\n\t\t{\n\t\t\tState.Guarded%d = false;\n\t\t}\n"), Index);
+				Body += TEXT("\t\treturn Result;\n");
+				return true;
+			}
+
+			if (const UBehaviacAction* Action = ExactCast<UBehaviacAction>(Node))
+			{
+				Body += FString::Printf(TEXT("\t\tstatic const int32 MethodId = FBehaviacMethodRegistry::FindOrAdd(TEXT(\"%s\"));\n"), *EscapeLiteral(Action->MethodName));
+				Body += FString::Printf(TEXT("\t\treturn CallMethod(Agent, MethodId, %s);\n"), *FormatStatus(Action->ResultOption));
+				return true;
+			}
+
+			if (const UBehaviacCondition* Condition = ExactCast<UBehaviacCondition>(Node))
+			{
+				WriteComparison(Condition->LeftOperand, Condition->Operator, Condition->RightOperand, FString::Printf(TEXT("Hints%d"), Index), Body);
+				return true;
+			}
+
+			if (const UBehaviacWait* Wait = ExactCast<UBehaviacWait>(Node))
+			{
+				if (!FMath::IsFinite(Wait->Duration))
+				{
+					Error = FString::Printf(TEXT("%s (id %d) has a non-finite duration"), *Node->GetName(), Node->NodeId);
+					return false;
+				}
+				StateMembers.Add(FString::Printf(TEXT("double EndTime%d = -1.0;"), Index));
+				Body += FString::Printf(TEXT("\t\treturn WaitFor(Agent, %sf, State.EndTime%d);\n"), *FormatDouble(Wait->Duration), Index);
+				return true;
+			}
+
+			if (Class == UBehaviacNoop::StaticClass() || Class == UBehaviacTrue::StaticClass())
+			{
+				Body += TEXT("\t\treturn EBehaviacStatus::Success;\n");
+				return true;
+			}
+
+			if (Class == UBehaviacFalse::StaticClass())
+			{
+				Body += TEXT("\t\treturn EBehaviacStatus::Failure;\n");
+				return true;
+			}
+
+			return false;
+		}
+
+		/** Body returning Success when "Left <Operator> Right" holds; Hints names its slot hints in the state */
+		void WriteComparison(const FString& Left, EBehaviacOperatorType Operator, const FString& Right, const FString& Hints, FString& Body)
+		{
+			StateMembers.Add(FString::Printf(TEXT("int32 %s[2] = { INDEX_NONE, INDEX_NONE };"), *Hints));
+
+			// "Self.X <op> number" reads X as a number directly; anything else, including
+			// numbers too large for a double, takes the interpreter's rules
+			const double Number = Right.IsNumeric() ? FCString::Atod(*Right) : 0.0;
+			const FString Compare = Right.IsNumeric() && FMath::IsFinite(Number)
+				? FormatNumericComparison(Operator, TEXT("Value"), FormatDouble(Number))
+				: FString();
+
+			if (Left.StartsWith(TEXT("Self.")) && !Compare.IsEmpty())
+			{
+				Body += FString::Printf(TEXT("\t\tstatic const FName Key(TEXT(\"%s\"));\n"), *EscapeLiteral(FBehaviacBlackboard::MakeKey(Left).ToString()));
+				Body += FString::Printf(TEXT("\t\tdouble Value;\n\t\tif (ReadNumber(Agent, Key, State.%s[0], Value))\n\t\t{\n"), *Hints);
+				Body += FString::Printf(TEXT("\t\t\treturn %s ? EBehaviacStatus::Success : EBehaviacStatus::Failure;\n\t\t}\n"), *Compare);
+			}
+
+			Body += FString::Printf(TEXT("\t\tstatic const FBehaviacComparison Comparison = MakeComparison(TEXT(\"%s\"), EBehaviacOperatorType::%s, TEXT(\"%s\"));\n"),
+				*EscapeLiteral(Left),
+				*StaticEnum<EBehaviacOperatorType>()->GetNameStringByValue((int64)Operator),
+				*EscapeLiteral(Right));
+			Body += FString::Printf(TEXT("\t\treturn EvaluateCondition(Agent, Comparison, State.%s);\n"), *Hints);
+		}
+	};
+}
+
+bool FBehaviacNativeTreeGenerator::Generate(const UBehaviacBehaviorTree* Tree, FString& OutCode, FString& OutError)
+{
+	OutCode.Reset();
+	OutError.Reset();
+
+	if (!Tree || !Tree->GetRootNode())
+	{
+		OutError = TEXT("tree has no root node");
+		return false;
+	}
+
+	FTreeWriter Writer;
+	const int32 Root = Writer.WriteNode(Tree->GetRootNode());
+	if (Root == INDEX_NONE)
+	{
+		OutError = Writer.Error;
+		return false;
+	}
+
+	const FString TreeName = FBehaviacNativeTreeRegistry::GetTreeName(Tree);
+	const FString ClassName = GetClassName(TreeName);
+	const uint32 TreeHash = FBehaviacNativeTreeRegistry::HashTree(Tree->GetRootNode());
+
+	FString State;
+	for (const FString& Member : Writer.StateMembers)
+	{
+		State += FString::Printf(TEXT("\t\t%s\n"), *Member);
+	}
+
+	OutCode += TEXT("// Behaviac UE5 Plugin\n");
+	OutCode += FString::Printf(TEXT("// Generated from behavior tree %s by the BehaviacGenerateNativeTrees commandlet. Do not edit:\n"), *TreeName);
+	OutCode += TEXT("// once the tree changes, this code no longer matches and the tree is interpreted until regenerated.\n\n");
+	OutCode += TEXT("#include \"BehaviorTree/BehaviacNativeTree.h\"\n#include \"BehaviacAgent.h\"\n\n");
+	OutCode += TEXT("namespace\n{\n");
+	OutCode += FString::Printf(TEXT("class %s final : public FBehaviacNativeTreeTask\n{\n"), *ClassName);
+	OutCode += TEXT("protected:\n");
+	OutCode += TEXT("\tvirtual void ResetState() override { State = FState(); }\n\n");
+	OutCode += FString::Printf(TEXT("\tvirtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override { return Node%d(Agent); }\n\n"), Root);
+	OutCode += TEXT("private:\n");
+	OutCode += FString::Printf(TEXT("\tstruct FState\n\t{\n%s\t};\n\tFState State;\n"), *State);
+	OutCode += Writer.Functions;
+	OutCode += TEXT("};\n}\n\n");
+	OutCode += FString::Printf(TEXT("BEHAVIAC_REGISTER_NATIVE_TREE(%s, \"%s\", 0x%08Xu)\n"), *ClassName, *EscapeLiteral(TreeName), TreeHash);
+	return true;
+}
+
+FString FBehaviacNativeTreeGenerator::GetClassName(const FString& TreeName)
+{
+	FString Identifier = TreeName;
+	for (TCHAR& Char : Identifier)
+	{
+		if (!FChar::IsAlnum(Char))
+		{
+			Char = TEXT('_');
+		}
+	}
+	return TEXT("FBehaviacNativeTree_") + Identifier;
+}
+
+FString FBehaviacNativeTreeGenerator::GetFileName(const FString& TreeName)
+{
+	return GetClassName(TreeName).RightChop(1) + TEXT(".cpp");
+}
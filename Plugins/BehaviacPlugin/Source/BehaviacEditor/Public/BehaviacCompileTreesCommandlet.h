@@ -0,0 +1,31 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BehaviacCompileTreesCommandlet.generated.h"
+
+/**
+ * Compiles behavior tree XML to .bhvb files (see FBehaviacTreeBinary), so
+ * packaged games load trees without parsing XML.
+ *
+ *   UnrealEditor-Cmd <Project> -run=BehaviacCompileTrees
+ *       [-Xml=Content/AI/PenguinWanderTree.xml,...]
+ *       [-All] [-Output=<dir>]
+ *
+ * -All takes the source XML of every behavior tree asset and every XML file
+ * under Content/BehaviacData. Each .bhvb is written next to its XML unless
+ * -Output is given; files are only rewritten when their content changes.
+ */
+UCLASS()
+class BEHAVIACEDITOR_API UBehaviacCompileTreesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBehaviacCompileTreesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
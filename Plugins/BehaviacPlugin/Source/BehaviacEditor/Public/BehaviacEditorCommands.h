@@ -5,6 +5,9 @@
 
 #include "CoreMinimal.h"
 #include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
 
 #if WITH_EDITOR
 
@@ -31,6 +34,10 @@ namespace BehaviacEditorCommands
 			FString AssetPath = FString::Printf(TEXT("/Game/AI/%s"), *AssetName);
 
 			UE_LOG(LogTemp, Warning, TEXT("🔄 Reimporting Behavior Tree: %s"), *AssetName);
+
+			// Trees loaded straight from the XML are parsed again on their next load
+			const int32 Dropped = FBehaviacTreeFileCache::Get().InvalidateByName(AssetName);
+			UE_LOG(LogTemp, Warning, TEXT("✅ Dropped %d cached XML tree(s) named %s"), Dropped, *AssetName);
 			
 			// TODO: Implement actual reimport logic
 			// For now, just log that we need to manually reimport
@@ -51,6 +58,8 @@ namespace BehaviacEditorCommands
 		FConsoleCommandDelegate::CreateLambda([]()
 		{
 			UE_LOG(LogTemp, Warning, TEXT("🔄 Reimporting all Behavior Trees in /Game/AI/"));
+			FBehaviacTreeFileCache::Get().InvalidateAll();
+			UE_LOG(LogTemp, Warning, TEXT("✅ Dropped all cached XML trees"));
 			UE_LOG(LogTemp, Warning, TEXT("⚠️ Manual reimport required - see Behaviac.ReimportBT for details"));
 		})
 	);
@@ -0,0 +1,32 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BehaviacGenerateNativeTreesCommandlet.generated.h"
+
+/**
+ * Writes generated C++ for behavior trees (see FBehaviacNativeTreeGenerator).
+ *
+ *   UnrealEditor-Cmd <Project> -run=BehaviacGenerateNativeTrees
+ *       [-Trees=/Game/AI/PatrolGuard,/Game/AI/PenguinWanderTree]
+ *       [-Xml=Content/AI/PenguinWanderTree.xml]
+ *       [-All] [-Output=<dir>]
+ *
+ * -All takes every behavior tree asset. Output defaults to
+ * Source/<Project>/BehaviacGenerated; files are only rewritten when their
+ * content changes. Trees that cannot be generated are reported and keep
+ * running interpreted.
+ */
+UCLASS()
+class BEHAVIACEDITOR_API UBehaviacGenerateNativeTreesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBehaviacGenerateNativeTreesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,34 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBehaviacBehaviorTree;
+
+/**
+ * Generates the C++ for a behavior tree: one FBehaviacNativeTreeTask subclass
+ * with the tree's control flow written out, registered under the tree's name
+ * and graph hash (see FBehaviacNativeTreeRegistry).
+ *
+ * Covers the nodes the stable, hot trees are made of: Sequence, Selector,
+ * the Loop / AlwaysSuccess / AlwaysFailure / Not decorators, Action,
+ * GuardedAction, Condition, Wait, Noop, True and False, without attachments. Trees using
+ * anything else are left to the interpreter.
+ */
+class BEHAVIACEDITOR_API FBehaviacNativeTreeGenerator
+{
+public:
+	/**
+	 * Generate the source file for Tree. Returns false, with OutError naming
+	 * the node that cannot be generated, when the tree must stay interpreted.
+	 */
+	static bool Generate(const UBehaviacBehaviorTree* Tree, FString& OutCode, FString& OutError);
+
+	/** C++ class generated for the tree registered as TreeName */
+	static FString GetClassName(const FString& TreeName);
+
+	/** Source file name generated for the tree registered as TreeName */
+	static FString GetFileName(const FString& TreeName);
+};
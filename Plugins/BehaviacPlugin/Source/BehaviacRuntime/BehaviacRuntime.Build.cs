@@ -23,7 +23,6 @@ public class BehaviacRuntime : ModuleRules
 			"CoreUObject",
 			"Engine",
 			"GameplayTags",
-			"XmlParser",
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
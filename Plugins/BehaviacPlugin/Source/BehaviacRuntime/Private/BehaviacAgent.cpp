@@ -2,40 +2,185 @@
 // Licensed under the BSD 3-Clause License.
 
 #include "BehaviacAgent.h"
+#include "BehaviacTickManager.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacTaskView.h"
+#include "BehaviorTree/BehaviacTreeAsyncLoader.h"
+#include "BehaviorTree/BehaviacTreeRegistry.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
 
 UBehaviacAgentComponent::UBehaviacAgentComponent()
 	: bAutoTick(true)
-	, CurrentTreeTask(nullptr)
+	, bUseTickManager(false)
+	, ManagedTickGroup(TG_PrePhysics)
+	, bEnableTickLOD(false)
+	, OffscreenTierPenalty(1)
+	, RecentlyRenderedTolerance(0.5f)
+	, ForcedLODTier(-1)
+	, bAllowSleeping(true)
+	, bResumeRunningPath(true)
+	, bTickInParallel(false)
 	, CurrentTreeAsset(nullptr)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
+
+	LODTiers.Add(FBehaviacLODTier(1500.f, 0.f));
+	LODTiers.Add(FBehaviacLODTier(4000.f, 0.25f));
+	LODTiers.Add(FBehaviacLODTier(0.f, 1.f));
 }
 
 void UBehaviacAgentComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (bUseTickManager)
+	{
+		SetUseTickManager(true);
+	}
 }
 
 void UBehaviacAgentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (bAutoTick && CurrentTreeTask)
+	// Managed agents are ticked by UBehaviacTickManager
+	if (!bAutoTick || !TreeInstance.IsValid() || IsTickManaged())
 	{
-		TickBehaviorTree();
+		return;
 	}
+
+	if (bEnableTickLOD)
+	{
+		// Shared with every other agent (and the tick manager) in this world this frame
+		if (!ShouldTickForLOD(GetTimeSeconds(), FBehaviacTickLOD::GetViewerLocations(GetWorld())))
+		{
+			return;
+		}
+	}
+
+	TickBehaviorTree();
 }
 
 void UBehaviacAgentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	LeaveTickManager();
 	StopBehaviorTree();
 	Super::EndPlay(EndPlayReason);
 }
 
+void UBehaviacAgentComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Re-registered during play: rejoin the manager it left in OnUnregister
+	if (bUseTickManager && HasBegunPlay())
+	{
+		SetUseTickManager(true);
+	}
+}
+
+void UBehaviacAgentComponent::OnUnregister()
+{
+	LeaveTickManager();
+	Super::OnUnregister();
+}
+
+void UBehaviacAgentComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	LeaveTickManager();
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+// --- Managed ticking ---
+
+void UBehaviacAgentComponent::SetUseTickManager(bool bInUseTickManager)
+{
+	bUseTickManager = bInUseTickManager;
+
+	if (bUseTickManager && !IsTickManaged())
+	{
+		if (UBehaviacTickManager* Manager = UBehaviacTickManager::Get(this))
+		{
+			Manager->RegisterAgent(this);
+		}
+		else
+		{
+			BEHAVIAC_VLOG(TEXT("[Behaviac] %s: no tick manager for this world, using component tick"), *GetName());
+		}
+	}
+	else if (!bUseTickManager)
+	{
+		LeaveTickManager();
+	}
+}
+
+void UBehaviacAgentComponent::LeaveTickManager()
+{
+	if (UBehaviacTickManager* Manager = TickManager.Get())
+	{
+		Manager->UnregisterAgent(this);
+	}
+}
+
+void UBehaviacAgentComponent::NotifyTickManagerTreeChanged()
+{
+	if (UBehaviacTickManager* Manager = TickManager.Get())
+	{
+		Manager->OnAgentTreeChanged(this);
+	}
+}
+
+// --- Tick LOD ---
+
+double UBehaviacAgentComponent::GetTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : FPlatformTime::Seconds();
+}
+
+void UBehaviacAgentComponent::RequestTickAt(double Time)
+{
+	RequestedTickTime = FMath::Min(RequestedTickTime, Time);
+}
+
+bool UBehaviacAgentComponent::ShouldTickForLOD(double Now, const TArray<FVector>& ViewerLocations)
+{
+	CurrentLODTier = ForcedLODTier >= 0 ? ForcedLODTier : FBehaviacTickLOD::ComputeTier(*this, ViewerLocations);
+	FBehaviacTickLOD::NoteTier(GetWorld(), *this, CurrentLODTier);
+
+	const float Interval = LODTiers.IsValidIndex(CurrentLODTier) ? LODTiers[CurrentLODTier].TickInterval : 0.f;
+	const bool bDue = Interval <= 0.f
+		|| LastLODTickTime < 0.0
+		|| Now - LastLODTickTime >= Interval
+		|| Now >= RequestedTickTime;
+	if (!bDue)
+	{
+		return false;
+	}
+
+	if (LastLODTickTime < 0.0 && Interval > 0.f)
+	{
+		// Spread agents that start together over the interval so they don't all tick on the same frame
+		const double Phase = (GetTypeHash(this) % 1024) / 2048.0;
+		LastLODTickTime = Now - Interval * Phase;
+	}
+	else
+	{
+		LastLODTickTime = Now;
+	}
+
+	// Requests further out stay pending; a stale one only costs a single extra tick
+	if (Now >= RequestedTickTime)
+	{
+		RequestedTickTime = TNumericLimits<double>::Max();
+	}
+	return true;
+}
+
 // --- Behavior Tree Management ---
 
 bool UBehaviacAgentComponent::LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset)
@@ -57,18 +202,19 @@ bool UBehaviacAgentComponent::LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset)
 		return false;
 	}
 
-	// Create the root task (BehaviorTreeTask wrapping the root node)
-	CurrentTreeTask = NewObject<UBehaviacBehaviorTreeTask>(this);
-	
-	BEHAVIAC_VLOG(TEXT("[Behaviac] Creating tasks: RootNode=%d, NodeType=%s, ChildCount=%d"), 
-		RootNode != nullptr, 
-		RootNode ? *RootNode->GetName() : TEXT("NULL"),
-		RootNode ? RootNode->GetChildCount() : -1);
-	
-	CurrentTreeTask->Init(RootNode);
-	
-	BEHAVIAC_VLOG(TEXT("[Behaviac] After Init: CurrentTreeTask->HasChildTask=%d"), 
-		CurrentTreeTask->HasChildTask());
+	// Build the tasks from the compiled tree the asset shares between agents
+	TreeInstance.Create(TreeAsset->GetCompiledTree(), TreeAsset->bInstantiateBranchesLazily);
+	++TaskTreeSerial;
+	NextBranchReclaimTime = 0.0;
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Created tasks: RootNode=%s, ChildCount=%d, StateSize=%u"),
+		*RootNode->GetName(), RootNode->GetChildCount(), TreeInstance.GetStateSize());
+
+	// A new tree gets its first tick without waiting for its LOD interval
+	LastLODTickTime = -1.0;
+	RequestedTickTime = TNumericLimits<double>::Max();
+
+	NotifyTickManagerTreeChanged();
 
 	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Loaded behavior tree: %s"), *TreeAsset->GetName());
 	return true;
@@ -76,141 +222,551 @@ bool UBehaviacAgentComponent::LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset)
 
 bool UBehaviacAgentComponent::LoadBehaviorTreeByPath(const FString& RelativePath)
 {
-	// Try to find the asset
-	FString AssetPath = FString::Printf(TEXT("/Game/BehaviacData/%s"), *RelativePath);
-	UBehaviacBehaviorTree* TreeAsset = LoadObject<UBehaviacBehaviorTree>(nullptr, *AssetPath);
+	// Shared with every other agent and subtree reference naming the same path
+	UBehaviacBehaviorTree* TreeAsset = FBehaviacTreeRegistry::Get().Load(RelativePath);
 
 	if (TreeAsset)
 	{
 		return LoadBehaviorTree(TreeAsset);
 	}
 
-	UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Could not find behavior tree at path: %s"), *AssetPath);
+	UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Could not find behavior tree at path: %s"), *RelativePath);
 	return false;
 }
 
+void UBehaviacAgentComponent::LoadBehaviorTreeByPathAsync(const FString& RelativePath, UBehaviacBehaviorTree* FallbackTree)
+{
+	const uint32 Serial = BeginTreeLoad(FallbackTree);
+	FBehaviacTreeAsyncLoader::Get().LoadPath(RelativePath, FBehaviacTreeLoadedDelegate::CreateWeakLambda(this, [this, Serial](UBehaviacBehaviorTree* Tree)
+	{
+		FinishTreeLoad(Serial, Tree);
+	}));
+}
+
+void UBehaviacAgentComponent::LoadBehaviorTreeFromFileAsync(const FString& FilePath, UBehaviacBehaviorTree* FallbackTree)
+{
+	const uint32 Serial = BeginTreeLoad(FallbackTree);
+	FBehaviacTreeAsyncLoader::Get().LoadFile(FilePath, FBehaviacTreeLoadedDelegate::CreateWeakLambda(this, [this, Serial](UBehaviacBehaviorTree* Tree)
+	{
+		FinishTreeLoad(Serial, Tree);
+	}));
+}
+
+void UBehaviacAgentComponent::LoadBehaviorTreeAssetAsync(TSoftObjectPtr<UBehaviacBehaviorTree> TreeAsset, UBehaviacBehaviorTree* FallbackTree)
+{
+	const uint32 Serial = BeginTreeLoad(FallbackTree);
+	FBehaviacTreeAsyncLoader::Get().LoadAsset(TreeAsset.ToSoftObjectPath(), FBehaviacTreeLoadedDelegate::CreateWeakLambda(this, [this, Serial](UBehaviacBehaviorTree* Tree)
+	{
+		FinishTreeLoad(Serial, Tree);
+	}));
+}
+
+uint32 UBehaviacAgentComponent::BeginTreeLoad(UBehaviacBehaviorTree* FallbackTree)
+{
+	// Loading the fallback bumps the serial too, so take it afterwards
+	if (FallbackTree)
+	{
+		LoadBehaviorTree(FallbackTree);
+	}
+	PendingTreeLoad = ++TreeLoadSerial;
+	return PendingTreeLoad;
+}
+
+void UBehaviacAgentComponent::FinishTreeLoad(uint32 Serial, UBehaviacBehaviorTree* Tree)
+{
+	if (Serial != TreeLoadSerial)
+	{
+		BEHAVIAC_VLOG(TEXT("[Behaviac] %s: dropped a superseded tree load"), *GetName());
+		return;
+	}
+	PendingTreeLoad = 0;
+
+	// A tree that cannot start leaves the fallback running
+	const bool bLoaded = Tree && Tree->GetRootNode() && LoadBehaviorTree(Tree);
+	if (!bLoaded)
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] %s: asynchronous tree load failed"), *GetName());
+	}
+	OnBehaviorTreeLoaded.Broadcast(Tree, bLoaded);
+}
+
 EBehaviacStatus UBehaviacAgentComponent::TickBehaviorTree()
 {
-	if (!CurrentTreeTask)
+	if (!TreeInstance.IsValid())
 	{
-		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] TickBehaviorTree: CurrentTreeTask is NULL!"));
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] TickBehaviorTree: no behavior tree loaded!"));
 		return EBehaviacStatus::Invalid;
 	}
 
-	EBehaviacStatus Result = CurrentTreeTask->Tick(this);
+	{
+		FScopeLock Lock(&PropertyLock);
+		PredicateCache.BeginTick();
+	}
+
+	if (bSleeping)
+	{
+		if (!IsWakeConditionMet())
+		{
+			return EBehaviacStatus::Running;
+		}
+		WakeUp();
+	}
+
+	EBehaviacStatus Result = TreeInstance.GetRoot()->Tick(this, bResumeRunningPath);
+
+	if (TreeInstance.IsLazy())
+	{
+		ReclaimIdleBranches();
+	}
+
+	if (Result == EBehaviacStatus::Running && bAllowSleeping)
+	{
+		if (bInParallelTick)
+		{
+			bPendingSleepCheck = true;
+		}
+		else
+		{
+			TryFallAsleep();
+		}
+	}
 	return Result;
 }
 
+void UBehaviacAgentComponent::ReclaimIdleBranches()
+{
+	const float IdleTime = CurrentTreeAsset ? CurrentTreeAsset->IdleBranchReclaimTime : 0.f;
+	if (IdleTime <= 0.f)
+	{
+		return;
+	}
+
+	const double Now = GetTimeSeconds();
+	if (Now < NextBranchReclaimTime)
+	{
+		return;
+	}
+	NextBranchReclaimTime = Now + IdleTime * 0.25;
+
+	if (TreeInstance.ReclaimIdleBranches(Now, IdleTime) > 0)
+	{
+		// Views of the reclaimed tasks must not reach them
+		++TaskTreeSerial;
+	}
+}
+
+// --- Parallel ticking ---
+
+void UBehaviacAgentComponent::EnqueueGameThreadCommand(TFunction<void()> Command)
+{
+	if (bInParallelTick)
+	{
+		CommandBuffer.AddCommand(MoveTemp(Command));
+	}
+	else if (Command)
+	{
+		Command();
+	}
+}
+
+void UBehaviacAgentComponent::FlushCommandBuffer()
+{
+	check(IsInGameThread() && !bInParallelTick);
+
+	if (CommandBuffer.HasEntries())
+	{
+		TArray<TFunction<void()>> Commands;
+		CommandBuffer.TakeCommands(Commands);
+		for (TFunction<void()>& Command : Commands)
+		{
+			Command();
+		}
+	}
+
+	if (bPendingSleepCheck)
+	{
+		bPendingSleepCheck = false;
+		if (TreeInstance.IsValid() && TreeInstance.GetRoot()->GetTreeStatus() == EBehaviacStatus::Running)
+		{
+			TryFallAsleep();
+		}
+	}
+}
+
+bool UBehaviacAgentComponent::CanTickInParallel()
+{
+	check(IsInGameThread());
+
+	// Every call must answer in the tick that makes it, so every route a method
+	// could take must be a thread-safe handler: TS, the Blueprint delegate and
+	// event, and the other handlers only run on the game thread
+	return bTickInParallel
+		&& !OnMethodNameCalled.IsBound()
+		&& !OnMethodCalled.IsBound()
+		&& !HasBlueprintMethodEvent()
+		&& NumThreadSafeMethodHandlers == NumMethodHandlers;
+}
+
+// --- Sleeping ---
+
+void UBehaviacAgentComponent::TryFallAsleep()
+{
+	FBehaviacWakeCondition Condition;
+	if (!TreeInstance.IsValid() || !TreeInstance.GetRoot()->GetWakeCondition(this, Condition) || !Condition.IsValid())
+	{
+		return;
+	}
+
+	WakeCondition = MoveTemp(Condition);
+
+	// Already satisfied (e.g. the signal arrived after the leaf checked it): stay awake
+	if (IsWakeConditionMet())
+	{
+		WakeCondition = FBehaviacWakeCondition();
+		return;
+	}
+
+	bSleeping = true;
+
+	if (UBehaviacTickManager* Manager = TickManager.Get())
+	{
+		Manager->OnAgentSleep(this);
+	}
+	else if (!WakeCondition.HasWakeTime() && !WakeCondition.HasWakeFrame() && IsComponentTickEnabled())
+	{
+		// Only a signal or event can wake it, so the component tick has nothing to do
+		SetComponentTickEnabled(false);
+		bSleepDisabledComponentTick = true;
+	}
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] %s: sleeping (signal='%s')"), *GetName(), *FBehaviacSignalRegistry::GetName(WakeCondition.SignalId).ToString());
+}
+
+bool UBehaviacAgentComponent::IsWakeConditionMet() const
+{
+	return (WakeCondition.HasSignal() && ActiveSignals.Contains(WakeCondition.SignalId))
+		|| (WakeCondition.HasWakeTime() && GetTimeSeconds() >= WakeCondition.WakeTime)
+		|| (WakeCondition.HasWakeFrame() && GFrameCounter >= WakeCondition.WakeFrame);
+}
+
+void UBehaviacAgentComponent::WakeUp()
+{
+	if (!bSleeping)
+	{
+		return;
+	}
+
+	bSleeping = false;
+	WakeCondition = FBehaviacWakeCondition();
+
+	if (bSleepDisabledComponentTick)
+	{
+		bSleepDisabledComponentTick = false;
+		if (!IsTickManaged())
+		{
+			SetComponentTickEnabled(true);
+		}
+	}
+
+	if (UBehaviacTickManager* Manager = TickManager.Get())
+	{
+		Manager->OnAgentWake(this);
+	}
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] %s: woken"), *GetName());
+}
+
 void UBehaviacAgentComponent::StopBehaviorTree()
 {
-	if (CurrentTreeTask)
+	WakeUp();
+
+	// Loads still in flight no longer apply (LoadBehaviorTree stops first)
+	++TreeLoadSerial;
+
+	if (TreeInstance.IsValid())
 	{
-		CurrentTreeTask->Reset(this);
-		CurrentTreeTask = nullptr;
+		TreeInstance.GetRoot()->Reset(this);
+		TreeInstance.Release();
+		++TaskTreeSerial;
 	}
 
+	// Commands queued by the old tree must not act on the next one
+	CommandBuffer.Reset();
+	bPendingSleepCheck = false;
+
 	CurrentTreeAsset = nullptr;
+	NotifyTickManagerTreeChanged();
 }
 
 void UBehaviacAgentComponent::ResetBehaviorTree()
 {
-	if (CurrentTreeTask)
+	if (FBehaviacBehaviorTreeTask* TreeTask = TreeInstance.GetRoot())
 	{
-		CurrentTreeTask->Reset(this);
+		TreeTask->Reset(this);
 	}
 }
 
 EBehaviacStatus UBehaviacAgentComponent::GetBehaviorTreeStatus() const
 {
-	if (CurrentTreeTask)
+	if (FBehaviacBehaviorTreeTask* TreeTask = TreeInstance.GetRoot())
 	{
-		return CurrentTreeTask->GetTreeStatus();
+		return TreeTask->GetTreeStatus();
 	}
 	return EBehaviacStatus::Invalid;
 }
 
-// --- Property System ---
+UBehaviacTaskView* UBehaviacAgentComponent::InspectBehaviorTree()
+{
+	return TreeInstance.IsValid() ? UBehaviacTaskView::Create(this, TreeInstance.GetRoot()) : nullptr;
+}
 
-void UBehaviacAgentComponent::SetPropertyValue(const FString& PropertyName, const FString& Value)
+FBehaviacPredicateCacheStats UBehaviacAgentComponent::GetPredicateCacheStats() const
 {
 	FScopeLock Lock(&PropertyLock);
+	FBehaviacPredicateCacheStats Stats;
+	Stats.Hits = PredicateCache.GetHits();
+	Stats.Misses = PredicateCache.GetMisses();
+	Stats.Invalidations = PredicateCache.GetInvalidations();
+	const int64 Lookups = Stats.Hits + Stats.Misses + Stats.Invalidations;
+	Stats.HitRate = Lookups > 0 ? (float)((double)Stats.Hits / (double)Lookups) : 0.f;
+	return Stats;
+}
 
-	// Strip "Self." prefix if present
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
-	{
-		CleanName = CleanName.Mid(5);
-	}
+// --- Property System ---
 
-	Properties.Add(CleanName, Value);
+void UBehaviacAgentComponent::SetPropertyValue(const FString& PropertyName, const FString& Value)
+{
+	SetBlackboardValue(FBehaviacBlackboard::MakeKey(PropertyName), FBehaviacValue::MakeString(Value));
 }
 
 FString UBehaviacAgentComponent::GetPropertyValue(const FString& PropertyName) const
 {
 	FScopeLock Lock(&PropertyLock);
 
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
-	{
-		CleanName = CleanName.Mid(5);
-	}
-
-	const FString* Found = Properties.Find(CleanName);
-	return Found ? *Found : FString();
+	// FNAME_Find: looking up an unknown name must not intern it
+	const FBehaviacValue* Found = Blackboard.Find(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
+	return Found ? Found->ToString() : FString();
 }
 
 bool UBehaviacAgentComponent::HasProperty(const FString& PropertyName) const
 {
 	FScopeLock Lock(&PropertyLock);
-
-	FString CleanName = PropertyName;
-	if (CleanName.StartsWith(TEXT("Self.")))
-	{
-		CleanName = CleanName.Mid(5);
-	}
-
-	return Properties.Contains(CleanName);
+	return Blackboard.Contains(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
 }
 
 void UBehaviacAgentComponent::SetIntProperty(const FString& PropertyName, int32 Value)
 {
-	SetPropertyValue(PropertyName, FString::FromInt(Value));
+	SetBlackboardValue(FBehaviacBlackboard::MakeKey(PropertyName), FBehaviacValue::MakeInt(Value));
 }
 
 int32 UBehaviacAgentComponent::GetIntProperty(const FString& PropertyName) const
 {
-	return FCString::Atoi(*GetPropertyValue(PropertyName));
+	return GetIntValue(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
 }
 
 void UBehaviacAgentComponent::SetFloatProperty(const FString& PropertyName, float Value)
 {
-	SetPropertyValue(PropertyName, FString::SanitizeFloat(Value));
+	SetBlackboardValue(FBehaviacBlackboard::MakeKey(PropertyName), FBehaviacValue::MakeFloat(Value));
 }
 
 float UBehaviacAgentComponent::GetFloatProperty(const FString& PropertyName) const
 {
-	return FCString::Atof(*GetPropertyValue(PropertyName));
+	return GetFloatValue(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
 }
 
 void UBehaviacAgentComponent::SetBoolProperty(const FString& PropertyName, bool Value)
 {
-	SetPropertyValue(PropertyName, Value ? TEXT("true") : TEXT("false"));
+	SetBlackboardValue(FBehaviacBlackboard::MakeKey(PropertyName), FBehaviacValue::MakeBool(Value));
 }
 
 bool UBehaviacAgentComponent::GetBoolProperty(const FString& PropertyName) const
 {
-	FString Val = GetPropertyValue(PropertyName);
-	return Val.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Val == TEXT("1");
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
+	if (!Found)
+	{
+		return false;
+	}
+
+	// Same as when properties were strings: true only if the value reads "true"
+	// (any case) or "1". So int 1 is true but 7 is not, and a float (written
+	// "1.0") never is. GetBoolValue is the typed read.
+	switch (Found->GetType())
+	{
+	case EBehaviacValueType::Bool:
+	case EBehaviacValueType::String:
+		return Found->AsBool();
+	case EBehaviacValueType::Int:
+	case EBehaviacValueType::Int64:
+		return Found->AsInt64() == 1;
+	case EBehaviacValueType::Float:
+		return false;
+	default:
+	{
+		const FString Value = Found->ToString();
+		return Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
+	}
+	}
 }
 
 void UBehaviacAgentComponent::SetInt64Property(const FString& PropertyName, int64 Value)
 {
-	SetPropertyValue(PropertyName, FString::Printf(TEXT("%lld"), Value));
+	SetBlackboardValue(FBehaviacBlackboard::MakeKey(PropertyName), FBehaviacValue::MakeInt64(Value));
 }
 
 int64 UBehaviacAgentComponent::GetInt64Property(const FString& PropertyName) const
 {
-	return FCString::Atoi64(*GetPropertyValue(PropertyName));
+	return GetInt64Value(FBehaviacBlackboard::MakeKey(PropertyName, FNAME_Find));
+}
+
+// --- Typed Blackboard ---
+
+void UBehaviacAgentComponent::SetIntValue(FName Key, int32 Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeInt(Value));
+}
+
+int32 UBehaviacAgentComponent::GetIntValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsInt() : 0;
+}
+
+void UBehaviacAgentComponent::SetInt64Value(FName Key, int64 Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeInt64(Value));
+}
+
+int64 UBehaviacAgentComponent::GetInt64Value(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsInt64() : 0;
+}
+
+void UBehaviacAgentComponent::SetFloatValue(FName Key, float Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeFloat(Value));
+}
+
+float UBehaviacAgentComponent::GetFloatValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsFloat() : 0.0f;
+}
+
+void UBehaviacAgentComponent::SetBoolValue(FName Key, bool Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeBool(Value));
+}
+
+bool UBehaviacAgentComponent::GetBoolValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsBool() : false;
+}
+
+void UBehaviacAgentComponent::SetVectorValue(FName Key, FVector Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeVector(Value));
+}
+
+FVector UBehaviacAgentComponent::GetVectorValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsVector() : FVector::ZeroVector;
+}
+
+void UBehaviacAgentComponent::SetNameValue(FName Key, FName Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeName(Value));
+}
+
+FName UBehaviacAgentComponent::GetNameValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsName() : NAME_None;
+}
+
+void UBehaviacAgentComponent::SetObjectValue(FName Key, UObject* Value)
+{
+	SetBlackboardValue(Key, FBehaviacValue::MakeObject(Value));
+}
+
+UObject* UBehaviacAgentComponent::GetObjectValue(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->AsObject() : nullptr;
+}
+
+EBehaviacValueType UBehaviacAgentComponent::GetValueType(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	const FBehaviacValue* Found = Blackboard.Find(Key);
+	return Found ? Found->GetType() : EBehaviacValueType::None;
+}
+
+TArray<FName> UBehaviacAgentComponent::GetBlackboardKeys() const
+{
+	FScopeLock Lock(&PropertyLock);
+	TArray<FName> Keys;
+	Blackboard.GetKeys(Keys);
+	return Keys;
+}
+
+void UBehaviacAgentComponent::SetBlackboardValue(FName Key, const FBehaviacValue& Value)
+{
+	FScopeLock Lock(&PropertyLock);
+	Blackboard.Set(Key, Value);
+}
+
+bool UBehaviacAgentComponent::GetBlackboardValue(FName Key, FBehaviacValue& OutValue) const
+{
+	FScopeLock Lock(&PropertyLock);
+	if (const FBehaviacValue* Found = Blackboard.Find(Key))
+	{
+		OutValue = *Found;
+		return true;
+	}
+	return false;
+}
+
+int32 UBehaviacAgentComponent::FindOrAddBlackboardSlot(FName Key)
+{
+	FScopeLock Lock(&PropertyLock);
+	return Blackboard.FindOrAddSlot(Key);
+}
+
+int32 UBehaviacAgentComponent::FindBlackboardSlot(FName Key) const
+{
+	FScopeLock Lock(&PropertyLock);
+	return Blackboard.FindSlot(Key);
+}
+
+void UBehaviacAgentComponent::SetBlackboardSlotValue(int32 Slot, const FBehaviacValue& Value)
+{
+	FScopeLock Lock(&PropertyLock);
+	if (Blackboard.IsValidSlot(Slot))
+	{
+		Blackboard.SetValue(Slot, Value);
+	}
+}
+
+bool UBehaviacAgentComponent::GetBlackboardSlotValue(int32 Slot, FBehaviacValue& OutValue) const
+{
+	FScopeLock Lock(&PropertyLock);
+	if (Blackboard.IsValidSlot(Slot) && Blackboard.GetValue(Slot).IsSet())
+	{
+		OutValue = Blackboard.GetValue(Slot);
+		return true;
+	}
+	return false;
 }
 
 // --- Method System ---
@@ -218,106 +774,309 @@ int64 UBehaviacAgentComponent::GetInt64Property(const FString& PropertyName) con
 EBehaviacStatus UBehaviacAgentComponent::ExecuteMethod(const FString& MethodName)
 {
 	BEHAVIAC_VLOG(TEXT("[Behaviac] ExecuteMethod called for: '%s'"), *MethodName);
+	return ExecuteMethodById(FBehaviacMethodRegistry::FindOrAdd(MethodName));
+}
+
+EBehaviacStatus UBehaviacAgentComponent::ExecuteMethodById(int32 MethodId)
+{
+	if (MethodId == BEHAVIAC_INVALID_METHOD_ID)
+	{
+		return EBehaviacStatus::Invalid;
+	}
 
-	// Try TypeScript handler: fire OnMethodNameCalled synchronously, then read the result
-	// that TS deposited via SetTSMethodResult() during the broadcast.
-	if (OnMethodNameCalled.IsBound())
+	// Routes were resolved against the delegates' binding state; rebinding invalidates them
+	const bool bScriptBound = OnMethodNameCalled.IsBound();
+	const bool bDelegateBound = OnMethodCalled.IsBound();
+	if (bScriptBound != bRoutesSawScriptBound || bDelegateBound != bRoutesSawDelegateBound)
 	{
-		MethodNameResults.Remove(MethodName);
-		OnMethodNameCalled.Broadcast(MethodName);
-		if (EBehaviacStatus* TSResult = MethodNameResults.Find(MethodName))
+		InvalidateMethodRoutes();
+		bRoutesSawScriptBound = bScriptBound;
+		bRoutesSawDelegateBound = bDelegateBound;
+	}
+
+	if (MethodRoutes.Num() <= MethodId)
+	{
+		MethodRoutes.SetNumZeroed(MethodId + 1);
+	}
+
+	EBehaviacStatus Result = EBehaviacStatus::Invalid;
+	bool bSkipScript = false;
+
+	// TS answers per call and comes first; while it is bound, a cached C++,
+	// Blueprint or negative route must not keep it from being asked
+	const EBehaviacMethodRoute CachedRoute = MethodRoutes[MethodId];
+	if (bScriptBound && CachedRoute != EBehaviacMethodRoute::Script && CachedRoute != EBehaviacMethodRoute::Unresolved)
+	{
+		if (CallScriptMethod(MethodId, Result))
 		{
-			EBehaviacStatus Result = *TSResult;
-			MethodNameResults.Remove(MethodName);
+			if (MethodRoutes.IsValidIndex(MethodId))
+			{
+				MethodRoutes[MethodId] = EBehaviacMethodRoute::Script;
+			}
 			return Result;
 		}
 	}
 
-	// Then check registered C++ handlers
-	if (TFunction<EBehaviacStatus()>* Handler = MethodHandlers.Find(MethodName))
+	switch (CachedRoute)
 	{
-		BEHAVIAC_VLOG(TEXT("[Behaviac] Found C++ handler for '%s', calling it..."), *MethodName);
-		return (*Handler)();
-	}
-	else
-	{
-		BEHAVIAC_VLOG(TEXT("[Behaviac] No C++ handler found for '%s' (have %d handlers registered)"), *MethodName, MethodHandlers.Num());
-		
-		// Debug: List all registered handlers
-		for (const auto& Pair : MethodHandlers)
+	case EBehaviacMethodRoute::Native:
+		return MethodHandlers[MethodId]();
+
+	case EBehaviacMethodRoute::Script:
+		if (CallScriptMethod(MethodId, Result))
 		{
-			BEHAVIAC_VLOG(TEXT("[Behaviac]    - Registered: '%s'"), *Pair.Key);
+			return Result;
 		}
+		// TS did not answer this time; re-resolve without probing it twice
+		bSkipScript = true;
+		break;
+
+	case EBehaviacMethodRoute::Blueprint:
+		CallBlueprintMethod(MethodId, Result);
+		return Result;
+
+	case EBehaviacMethodRoute::None:
+		return EBehaviacStatus::Invalid;
+
+	default:
+		break;
+	}
+
+	// Handlers may re-enter and grow MethodRoutes, so store through the index afterwards
+	const EBehaviacMethodRoute Route = ResolveMethodRoute(MethodId, Result, bSkipScript);
+	if (MethodRoutes.IsValidIndex(MethodId))
+	{
+		MethodRoutes[MethodId] = Route;
+	}
+	return Result;
+}
+
+EBehaviacMethodRoute UBehaviacAgentComponent::ResolveMethodRoute(int32 MethodId, EBehaviacStatus& OutResult, bool bSkipScript)
+{
+	// Same precedence as always: TypeScript, C++ handlers, then Blueprint
+	if (!bSkipScript && CallScriptMethod(MethodId, OutResult))
+	{
+		return EBehaviacMethodRoute::Script;
+	}
+
+	if (MethodHandlers.IsValidIndex(MethodId) && MethodHandlers[MethodId])
+	{
+		BEHAVIAC_VLOG(TEXT("[Behaviac] Found C++ handler for '%s', calling it..."), *FBehaviacMethodRegistry::GetName(MethodId).ToString());
+		OutResult = MethodHandlers[MethodId]();
+		return EBehaviacMethodRoute::Native;
+	}
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] No C++ handler found for '%s' (have %d handlers registered)"),
+		*FBehaviacMethodRegistry::GetName(MethodId).ToString(), NumMethodHandlers);
+
+	if (CallBlueprintMethod(MethodId, OutResult))
+	{
+		return EBehaviacMethodRoute::Blueprint;
+	}
+
+	UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] No handler for method: %s"), *FBehaviacMethodRegistry::GetName(MethodId).ToString());
+	OutResult = EBehaviacStatus::Invalid;
+	return EBehaviacMethodRoute::None;
+}
+
+bool UBehaviacAgentComponent::CallScriptMethod(int32 MethodId, EBehaviacStatus& OutResult)
+{
+	if (!OnMethodNameCalled.IsBound())
+	{
+		return false;
 	}
 
+	// Fire OnMethodNameCalled synchronously, then read the result that TS deposited
+	// via SetTSMethodResult() during the broadcast. A TS handler may itself execute
+	// methods, so the in-flight call is saved and restored around the broadcast.
+	const int32 OuterMethodId = ScriptCallMethodId;
+	const EBehaviacStatus OuterResult = ScriptCallResult;
+	const bool bOuterAnswered = bScriptCallAnswered;
+
+	ScriptCallMethodId = MethodId;
+	ScriptCallResult = EBehaviacStatus::Invalid;
+	bScriptCallAnswered = false;
+
+	OnMethodNameCalled.Broadcast(FBehaviacMethodRegistry::GetName(MethodId).ToString());
+
+	const bool bAnswered = bScriptCallAnswered;
+	OutResult = ScriptCallResult;
+
+	ScriptCallMethodId = OuterMethodId;
+	ScriptCallResult = OuterResult;
+	bScriptCallAnswered = bOuterAnswered;
+	return bAnswered;
+}
+
+bool UBehaviacAgentComponent::CallBlueprintMethod(int32 MethodId, EBehaviacStatus& OutResult)
+{
+	const bool bDelegateBound = OnMethodCalled.IsBound();
+	const bool bHasEvent = HasBlueprintMethodEvent();
+	if (!bDelegateBound && !bHasEvent)
+	{
+		return false;
+	}
+
+	const FString MethodName = FBehaviacMethodRegistry::GetName(MethodId).ToString();
+	OutResult = EBehaviacStatus::Invalid;
+
 	// Try Blueprint delegate
-	if (OnMethodCalled.IsBound())
+	if (bDelegateBound)
 	{
-		EBehaviacStatus Result = EBehaviacStatus::Invalid;
-		OnMethodCalled.Broadcast(MethodName, Result);
-		if (Result != EBehaviacStatus::Invalid)
+		OnMethodCalled.Broadcast(MethodName, OutResult);
+		if (OutResult != EBehaviacStatus::Invalid)
 		{
-			return Result;
+			return true;
 		}
 	}
 
-	// Fall back to Blueprint implementable event
-	EBehaviacStatus BlueprintResult = OnExecuteMethod(MethodName);
-	if (BlueprintResult != EBehaviacStatus::Invalid)
+	// Fall back to Blueprint implementable event (only when a Blueprint implements it)
+	if (bHasEvent)
 	{
-		return BlueprintResult;
+		OutResult = OnExecuteMethod(MethodName);
 	}
+	return true;
+}
 
-	UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] No handler for method: %s"), *MethodName);
-	return EBehaviacStatus::Invalid;
+bool UBehaviacAgentComponent::HasBlueprintMethodEvent()
+{
+	if (BlueprintMethodEventState < 0)
+	{
+		static const FName EventName = GET_FUNCTION_NAME_CHECKED(UBehaviacAgentComponent, OnExecuteMethod);
+		BlueprintMethodEventState = GetClass()->IsFunctionImplementedInScript(EventName) ? 1 : 0;
+	}
+	return BlueprintMethodEventState != 0;
 }
 
-void UBehaviacAgentComponent::RegisterMethodHandler(const FString& MethodName, TFunction<EBehaviacStatus()> Handler)
+void UBehaviacAgentComponent::InvalidateMethodRoutes()
 {
-	MethodHandlers.Add(MethodName, MoveTemp(Handler));
+	MethodRoutes.Reset();
+}
+
+void UBehaviacAgentComponent::RegisterMethodHandler(const FString& MethodName, TFunction<EBehaviacStatus()> Handler, bool bThreadSafe)
+{
+	const int32 MethodId = FBehaviacMethodRegistry::FindOrAdd(MethodName);
+	if (MethodId == BEHAVIAC_INVALID_METHOD_ID)
+	{
+		return;
+	}
+
+	if (MethodHandlers.Num() <= MethodId)
+	{
+		MethodHandlers.SetNum(MethodId + 1);
+	}
+	if (ThreadSafeMethodHandlers.Num() <= MethodId)
+	{
+		ThreadSafeMethodHandlers.Add(false, MethodId + 1 - ThreadSafeMethodHandlers.Num());
+	}
+	if (MethodHandlers[MethodId])
+	{
+		NumThreadSafeMethodHandlers -= ThreadSafeMethodHandlers[MethodId] ? 1 : 0;
+	}
+	else
+	{
+		++NumMethodHandlers;
+	}
+	MethodHandlers[MethodId] = MoveTemp(Handler);
+	ThreadSafeMethodHandlers[MethodId] = bThreadSafe;
+	NumThreadSafeMethodHandlers += bThreadSafe ? 1 : 0;
+
+	// A new handler can change the route of any method, including cached misses
+	InvalidateMethodRoutes();
 }
 
 void UBehaviacAgentComponent::SetTSMethodResult(const FString& MethodName, EBehaviacStatus Result)
 {
-	MethodNameResults.Add(MethodName, Result);
+	if (ScriptCallMethodId != BEHAVIAC_INVALID_METHOD_ID && FBehaviacMethodRegistry::Find(MethodName) == ScriptCallMethodId)
+	{
+		ScriptCallResult = Result;
+		bScriptCallAnswered = true;
+	}
+	else
+	{
+		UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] SetTSMethodResult('%s') outside of its OnMethodNameCalled broadcast, ignored"), *MethodName);
+	}
 }
 
 // --- Signal System ---
 
 void UBehaviacAgentComponent::SendSignal(const FString& SignalName)
 {
-	ActiveSignals.Add(SignalName);
-	OnSignalReceived.Broadcast(SignalName);
+	SendSignalById(FBehaviacSignalRegistry::FindOrAdd(SignalName));
+}
+
+void UBehaviacAgentComponent::SendSignalById(int32 SignalId)
+{
+	if (SignalId == BEHAVIAC_INVALID_SIGNAL_ID)
+	{
+		return;
+	}
+
+	ActiveSignals.Add(SignalId);
+	if (OnSignalReceived.IsBound())
+	{
+		OnSignalReceived.Broadcast(FBehaviacSignalRegistry::GetName(SignalId).ToString());
+	}
+
+	if (bSleeping && WakeCondition.SignalId == SignalId)
+	{
+		WakeUp();
+	}
 }
 
 bool UBehaviacAgentComponent::IsSignalSet(const FString& SignalName) const
 {
-	return ActiveSignals.Contains(SignalName);
+	return IsSignalSetById(FBehaviacSignalRegistry::Find(SignalName));
 }
 
 void UBehaviacAgentComponent::ClearSignal(const FString& SignalName)
 {
-	ActiveSignals.Remove(SignalName);
+	ClearSignalById(FBehaviacSignalRegistry::Find(SignalName));
 }
 
 void UBehaviacAgentComponent::ClearAllSignals()
 {
-	ActiveSignals.Empty();
+	ActiveSignals.Reset();
+}
+
+void UBehaviacAgentComponent::BroadcastSignal(const TArray<UBehaviacAgentComponent*>& Agents, const FString& SignalName)
+{
+	const int32 SignalId = FBehaviacSignalRegistry::FindOrAdd(SignalName);
+	for (UBehaviacAgentComponent* Agent : Agents)
+	{
+		if (Agent)
+		{
+			Agent->SendSignalById(SignalId);
+		}
+	}
 }
 
 // --- Event System ---
 
 void UBehaviacAgentComponent::FireEvent(const FString& EventName)
 {
-	PendingEvents.Add(EventName);
+	FireEventById(FBehaviacSignalRegistry::FindOrAdd(EventName));
+}
+
+void UBehaviacAgentComponent::FireEventById(int32 EventId)
+{
+	if (EventId == BEHAVIAC_INVALID_SIGNAL_ID)
+	{
+		return;
+	}
+
+	PendingEvents.Add(EventId);
+
+	// Events are meant for the running tree; give it a tick to see this one
+	WakeUp();
 }
 
 bool UBehaviacAgentComponent::HasPendingEvent(const FString& EventName) const
 {
-	return PendingEvents.Contains(EventName);
+	return HasPendingEventById(FBehaviacSignalRegistry::Find(EventName));
 }
 
 void UBehaviacAgentComponent::ConsumeEvent(const FString& EventName)
 {
-	PendingEvents.Remove(EventName);
+	ConsumeEventById(FBehaviacSignalRegistry::Find(EventName));
 }
@@ -0,0 +1,281 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacBlackboard.h"
+
+// ===================================================================
+// FBehaviacValue
+// ===================================================================
+
+FBehaviacValue FBehaviacValue::MakeInt(int32 Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Int;
+	V.IntValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeInt64(int64 Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Int64;
+	V.Int64Value = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeFloat(double Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Float;
+	V.FloatValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeBool(bool Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Bool;
+	V.BoolValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeVector(const FVector& Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Vector;
+	V.VectorValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeName(FName Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Name;
+	V.NameValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeObject(UObject* Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::Object;
+	V.ObjectValue = Value;
+	return V;
+}
+
+FBehaviacValue FBehaviacValue::MakeString(const FString& Value)
+{
+	FBehaviacValue V;
+	V.Type = EBehaviacValueType::String;
+	V.StringValue = Value;
+	V.bNumericString = Value.IsNumeric();
+	V.DoubleValue = V.bNumericString ? FCString::Atod(*Value) : 0.0;
+	return V;
+}
+
+double FBehaviacValue::AsDouble() const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Int:    return (double)IntValue;
+	case EBehaviacValueType::Int64:  return (double)Int64Value;
+	case EBehaviacValueType::Float:  return FloatValue;
+	case EBehaviacValueType::Bool:   return BoolValue ? 1.0 : 0.0;
+	case EBehaviacValueType::String: return bNumericString ? DoubleValue : FCString::Atod(*StringValue);
+	default:                         return 0.0;
+	}
+}
+
+int32 FBehaviacValue::AsInt() const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Int:    return IntValue;
+	case EBehaviacValueType::Int64:  return (int32)Int64Value;
+	case EBehaviacValueType::Float:  return (int32)FloatValue;
+	case EBehaviacValueType::Bool:   return BoolValue ? 1 : 0;
+	case EBehaviacValueType::String: return FCString::Atoi(*StringValue);
+	default:                         return 0;
+	}
+}
+
+int64 FBehaviacValue::AsInt64() const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Int:    return (int64)IntValue;
+	case EBehaviacValueType::Int64:  return Int64Value;
+	case EBehaviacValueType::Float:  return (int64)FloatValue;
+	case EBehaviacValueType::Bool:   return BoolValue ? 1 : 0;
+	case EBehaviacValueType::String: return FCString::Atoi64(*StringValue);
+	default:                         return 0;
+	}
+}
+
+bool FBehaviacValue::AsBool() const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Bool:   return BoolValue;
+	case EBehaviacValueType::Int:    return IntValue != 0;
+	case EBehaviacValueType::Int64:  return Int64Value != 0;
+	case EBehaviacValueType::Float:  return FloatValue != 0.0;
+	case EBehaviacValueType::Object: return ObjectValue.IsValid();
+	// Legacy string semantics: "true" (any case) or "1"
+	case EBehaviacValueType::String: return StringValue.Equals(TEXT("true"), ESearchCase::IgnoreCase) || StringValue == TEXT("1");
+	default:                         return false;
+	}
+}
+
+FVector FBehaviacValue::AsVector() const
+{
+	if (Type == EBehaviacValueType::Vector)
+	{
+		return VectorValue;
+	}
+	if (Type == EBehaviacValueType::String)
+	{
+		FVector Parsed = FVector::ZeroVector;
+		Parsed.InitFromString(StringValue);
+		return Parsed;
+	}
+	return FVector::ZeroVector;
+}
+
+FName FBehaviacValue::AsName() const
+{
+	if (Type == EBehaviacValueType::Name)
+	{
+		return NameValue;
+	}
+	if (Type == EBehaviacValueType::String)
+	{
+		return FName(*StringValue);
+	}
+	return NAME_None;
+}
+
+UObject* FBehaviacValue::AsObject() const
+{
+	return Type == EBehaviacValueType::Object ? ObjectValue.Get() : nullptr;
+}
+
+FString FBehaviacValue::ToString() const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Int:    return FString::FromInt(IntValue);
+	case EBehaviacValueType::Int64:  return FString::Printf(TEXT("%lld"), Int64Value);
+	case EBehaviacValueType::Float:  return FString::SanitizeFloat(FloatValue);
+	case EBehaviacValueType::Bool:   return BoolValue ? TEXT("true") : TEXT("false");
+	case EBehaviacValueType::Vector: return VectorValue.ToString();
+	case EBehaviacValueType::Name:   return NameValue.ToString();
+	case EBehaviacValueType::Object: return ObjectValue.IsValid() ? ObjectValue->GetPathName() : FString();
+	case EBehaviacValueType::String: return StringValue;
+	default:                         return FString();
+	}
+}
+
+void FBehaviacValue::AppendString(FStringBuilderBase& Out) const
+{
+	switch (Type)
+	{
+	case EBehaviacValueType::Int:    Out.Appendf(TEXT("%d"), IntValue); break;
+	case EBehaviacValueType::Int64:  Out.Appendf(TEXT("%lld"), Int64Value); break;
+	case EBehaviacValueType::Bool:   Out << (BoolValue ? TEXT("true") : TEXT("false")); break;
+	case EBehaviacValueType::Name:   NameValue.AppendString(Out); break;
+	case EBehaviacValueType::String: Out << StringValue; break;
+	case EBehaviacValueType::None:   break;
+	default:                         Out << ToString(); break;
+	}
+}
+
+bool FBehaviacValue::Identical(const FBehaviacValue& Other) const
+{
+	if (Type != Other.Type)
+	{
+		return false;
+	}
+
+	switch (Type)
+	{
+	case EBehaviacValueType::None:   return true;
+	case EBehaviacValueType::Int:    return IntValue == Other.IntValue;
+	case EBehaviacValueType::Int64:  return Int64Value == Other.Int64Value;
+	case EBehaviacValueType::Float:  return FloatValue == Other.FloatValue;
+	case EBehaviacValueType::Bool:   return BoolValue == Other.BoolValue;
+	case EBehaviacValueType::Vector: return VectorValue == Other.VectorValue;
+	case EBehaviacValueType::Name:   return NameValue == Other.NameValue;
+	case EBehaviacValueType::Object: return ObjectValue == Other.ObjectValue;
+	case EBehaviacValueType::String: return StringValue.Equals(Other.StringValue, ESearchCase::CaseSensitive);
+	default:                         return false;
+	}
+}
+
+// ===================================================================
+// FBehaviacBlackboard
+// ===================================================================
+
+FName FBehaviacBlackboard::MakeKey(const FString& PropertyName, EFindName FindType)
+{
+	const TCHAR* Chars = *PropertyName;
+	int32 Len = PropertyName.Len();
+
+	// Strip "Self." prefix without copying the string
+	if (PropertyName.StartsWith(TEXT("Self.")))
+	{
+		Chars += 5;
+		Len -= 5;
+	}
+
+	return Len > 0 ? FName(Len, Chars, FindType) : FName();
+}
+
+int32 FBehaviacBlackboard::FindOrAddSlot(FName Key)
+{
+	// Empty names and unknown lookups both map to NAME_None; it must not become a key they all share
+	if (Key.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* Existing = SlotIndex.Find(Key))
+	{
+		return *Existing;
+	}
+
+	const int32 Slot = Values.AddDefaulted();
+	SlotSerials.Add(EmptySerial);
+	SlotKeys.Add(Key);
+	SlotIndex.Add(Key, Slot);
+	return Slot;
+}
+
+void FBehaviacBlackboard::ClearValues()
+{
+	for (int32 Slot = 0; Slot < Values.Num(); ++Slot)
+	{
+		SetValue(Slot, FBehaviacValue());
+	}
+}
+
+void FBehaviacBlackboard::Empty()
+{
+	SlotIndex.Empty();
+	SlotKeys.Empty();
+	Values.Empty();
+	SlotSerials.Empty();
+	EmptySerial = ++WriteSerial;
+}
+
+void FBehaviacBlackboard::GetKeys(TArray<FName>& OutKeys) const
+{
+	OutKeys.Reset(Values.Num());
+	for (int32 Slot = 0; Slot < Values.Num(); ++Slot)
+	{
+		if (Values[Slot].IsSet())
+		{
+			OutKeys.Add(SlotKeys[Slot]);
+		}
+	}
+}
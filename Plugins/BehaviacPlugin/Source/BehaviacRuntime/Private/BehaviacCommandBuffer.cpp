@@ -0,0 +1,23 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacCommandBuffer.h"
+
+void FBehaviacCommandBuffer::AddCommand(TFunction<void()> Command)
+{
+	if (Command)
+	{
+		Commands.Add(MoveTemp(Command));
+	}
+}
+
+void FBehaviacCommandBuffer::TakeCommands(TArray<TFunction<void()>>& OutCommands)
+{
+	OutCommands = MoveTemp(Commands);
+	Commands.Reset();
+}
+
+void FBehaviacCommandBuffer::Reset()
+{
+	Commands.Reset();
+}
@@ -0,0 +1,64 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacMethods.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace BehaviacMethodRegistry
+{
+	static FRWLock Lock;
+	static TMap<FName, int32> Ids;
+	static TArray<FName> Names;
+}
+
+int32 FBehaviacMethodRegistry::FindOrAdd(const FString& MethodName)
+{
+	if (MethodName.IsEmpty())
+	{
+		return BEHAVIAC_INVALID_METHOD_ID;
+	}
+
+	const FName Name(*MethodName);
+	{
+		FReadScopeLock ReadLock(BehaviacMethodRegistry::Lock);
+		if (const int32* Existing = BehaviacMethodRegistry::Ids.Find(Name))
+		{
+			return *Existing;
+		}
+	}
+
+	FWriteScopeLock WriteLock(BehaviacMethodRegistry::Lock);
+	if (const int32* Existing = BehaviacMethodRegistry::Ids.Find(Name))
+	{
+		return *Existing;
+	}
+	const int32 Id = BehaviacMethodRegistry::Names.Add(Name);
+	BehaviacMethodRegistry::Ids.Add(Name, Id);
+	return Id;
+}
+
+int32 FBehaviacMethodRegistry::Find(const FString& MethodName)
+{
+	// FNAME_Find: looking up an unknown method must not grow the name table
+	const FName Name(*MethodName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return BEHAVIAC_INVALID_METHOD_ID;
+	}
+
+	FReadScopeLock ReadLock(BehaviacMethodRegistry::Lock);
+	const int32* Existing = BehaviacMethodRegistry::Ids.Find(Name);
+	return Existing ? *Existing : BEHAVIAC_INVALID_METHOD_ID;
+}
+
+FName FBehaviacMethodRegistry::GetName(int32 MethodId)
+{
+	FReadScopeLock ReadLock(BehaviacMethodRegistry::Lock);
+	return BehaviacMethodRegistry::Names.IsValidIndex(MethodId) ? BehaviacMethodRegistry::Names[MethodId] : NAME_None;
+}
+
+int32 FBehaviacMethodRegistry::Num()
+{
+	FReadScopeLock ReadLock(BehaviacMethodRegistry::Lock);
+	return BehaviacMethodRegistry::Names.Num();
+}
@@ -3,16 +3,28 @@
 
 #include "BehaviacRuntimeModule.h"
 #include "BehaviacTypes.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
 
 #define LOCTEXT_NAMESPACE "FBehaviacRuntimeModule"
 
 void FBehaviacRuntimeModule::StartupModule()
 {
 	UE_LOG(LogBehaviac, Log, TEXT("BehaviacRuntime module started. Version 1.0.0 (ported from behaviac 3.6.39)"));
+
+	// Built-in nodes, then those of every module loaded after this one
+	FBehaviacNodeRegistry::Get().RegisterPending();
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([](FName, EModuleChangeReason Reason)
+	{
+		if (Reason == EModuleChangeReason::ModuleLoaded)
+		{
+			FBehaviacNodeRegistry::Get().RegisterPending();
+		}
+	});
 }
 
 void FBehaviacRuntimeModule::ShutdownModule()
 {
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
 	UE_LOG(LogBehaviac, Log, TEXT("BehaviacRuntime module shut down."));
 }
 
@@ -0,0 +1,64 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacSignals.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace BehaviacSignalRegistry
+{
+	static FRWLock Lock;
+	static TMap<FName, int32> Ids;
+	static TArray<FName> Names;
+}
+
+int32 FBehaviacSignalRegistry::FindOrAdd(const FString& SignalName)
+{
+	if (SignalName.IsEmpty())
+	{
+		return BEHAVIAC_INVALID_SIGNAL_ID;
+	}
+
+	const FName Name(*SignalName);
+	{
+		FReadScopeLock ReadLock(BehaviacSignalRegistry::Lock);
+		if (const int32* Existing = BehaviacSignalRegistry::Ids.Find(Name))
+		{
+			return *Existing;
+		}
+	}
+
+	FWriteScopeLock WriteLock(BehaviacSignalRegistry::Lock);
+	if (const int32* Existing = BehaviacSignalRegistry::Ids.Find(Name))
+	{
+		return *Existing;
+	}
+	const int32 Id = BehaviacSignalRegistry::Names.Add(Name);
+	BehaviacSignalRegistry::Ids.Add(Name, Id);
+	return Id;
+}
+
+int32 FBehaviacSignalRegistry::Find(const FString& SignalName)
+{
+	// FNAME_Find: looking up an unknown signal must not grow the name table
+	const FName Name(*SignalName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return BEHAVIAC_INVALID_SIGNAL_ID;
+	}
+
+	FReadScopeLock ReadLock(BehaviacSignalRegistry::Lock);
+	const int32* Existing = BehaviacSignalRegistry::Ids.Find(Name);
+	return Existing ? *Existing : BEHAVIAC_INVALID_SIGNAL_ID;
+}
+
+FName FBehaviacSignalRegistry::GetName(int32 SignalId)
+{
+	FReadScopeLock ReadLock(BehaviacSignalRegistry::Lock);
+	return BehaviacSignalRegistry::Names.IsValidIndex(SignalId) ? BehaviacSignalRegistry::Names[SignalId] : NAME_None;
+}
+
+int32 FBehaviacSignalRegistry::Num()
+{
+	FReadScopeLock ReadLock(BehaviacSignalRegistry::Lock);
+	return BehaviacSignalRegistry::Names.Num();
+}
@@ -0,0 +1,159 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacTickLOD.h"
+#include "BehaviacAgent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/ObjectKey.h"
+
+void FBehaviacTickLOD::GatherViewerLocations(const UWorld* World, TArray<FVector>& OutLocations)
+{
+	OutLocations.Reset();
+	if (!World)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC)
+		{
+			continue;
+		}
+
+		FVector Location;
+		FRotator Rotation;
+		PC->GetPlayerViewPoint(Location, Rotation);
+		OutLocations.Add(Location);
+	}
+}
+
+namespace
+{
+	/** Per-world LOD state shared by every agent of the world */
+	struct FWorldLOD
+	{
+		TArray<FVector> Locations;
+		uint64 ViewerFrame = MAX_uint64;
+
+		/** Tier of each agent checked during TierFrame */
+		TMap<TObjectKey<UBehaviacAgentComponent>, int32> AgentTiers;
+		uint64 TierFrame = MAX_uint64;
+
+		/** Frame anything was last asked of this world */
+		uint64 UsedFrame = 0;
+	};
+
+	FWorldLOD* FindWorldLOD(const UWorld* World, bool bCreate)
+	{
+		check(IsInGameThread());
+
+		// Boxed so an entry stays put while other worlds are added
+		static TMap<TObjectKey<UWorld>, TUniquePtr<FWorldLOD>> LODByWorld;
+		static uint64 PrunedFrame = MAX_uint64;
+
+		if (PrunedFrame != GFrameCounter)
+		{
+			// Forget worlds nobody asked about last frame (torn down, or no LOD agents left)
+			for (auto It = LODByWorld.CreateIterator(); It; ++It)
+			{
+				if (It->Value->UsedFrame + 1 < GFrameCounter)
+				{
+					It.RemoveCurrent();
+				}
+			}
+			PrunedFrame = GFrameCounter;
+		}
+
+		TUniquePtr<FWorldLOD>* Found = LODByWorld.Find(TObjectKey<UWorld>(World));
+		if (!Found)
+		{
+			if (!bCreate)
+			{
+				return nullptr;
+			}
+			Found = &LODByWorld.Add(TObjectKey<UWorld>(World), MakeUnique<FWorldLOD>());
+		}
+		(*Found)->UsedFrame = GFrameCounter;
+		return Found->Get();
+	}
+}
+
+const TArray<FVector>& FBehaviacTickLOD::GetViewerLocations(const UWorld* World)
+{
+	FWorldLOD& LOD = *FindWorldLOD(World, true);
+	if (LOD.ViewerFrame != GFrameCounter)
+	{
+		GatherViewerLocations(World, LOD.Locations);
+		LOD.ViewerFrame = GFrameCounter;
+	}
+	return LOD.Locations;
+}
+
+void FBehaviacTickLOD::NoteTier(const UWorld* World, const UBehaviacAgentComponent& Agent, int32 Tier)
+{
+	FWorldLOD& LOD = *FindWorldLOD(World, true);
+	if (LOD.TierFrame != GFrameCounter)
+	{
+		LOD.AgentTiers.Reset();
+		LOD.TierFrame = GFrameCounter;
+	}
+	// Keyed by agent so a second check in the same frame replaces the first
+	LOD.AgentTiers.Add(TObjectKey<UBehaviacAgentComponent>(&Agent), Tier);
+}
+
+void FBehaviacTickLOD::GetAgentsPerTier(const UWorld* World, TArray<int32>& OutCounts)
+{
+	OutCounts.Reset();
+	const FWorldLOD* LOD = FindWorldLOD(World, false);
+	if (!LOD || LOD->TierFrame == MAX_uint64 || LOD->TierFrame + 1 < GFrameCounter)
+	{
+		return;
+	}
+
+	for (const TPair<TObjectKey<UBehaviacAgentComponent>, int32>& Pair : LOD->AgentTiers)
+	{
+		const int32 Tier = FMath::Max(Pair.Value, 0);
+		if (Tier >= OutCounts.Num())
+		{
+			OutCounts.SetNumZeroed(Tier + 1);
+		}
+		++OutCounts[Tier];
+	}
+}
+
+int32 FBehaviacTickLOD::ComputeTier(const UBehaviacAgentComponent& Agent, const TArray<FVector>& ViewerLocations)
+{
+	const TArray<FBehaviacLODTier>& Tiers = Agent.LODTiers;
+	const AActor* Owner = Agent.GetOwner();
+	if (Tiers.Num() == 0 || !Owner || ViewerLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVector Location = Owner->GetActorLocation();
+	double NearestDistSq = TNumericLimits<double>::Max();
+	for (const FVector& Viewer : ViewerLocations)
+	{
+		NearestDistSq = FMath::Min(NearestDistSq, FVector::DistSquared(Location, Viewer));
+	}
+
+	int32 Tier = Tiers.Num() - 1;
+	for (int32 Index = 0; Index < Tiers.Num(); ++Index)
+	{
+		const float MaxDistance = Tiers[Index].MaxDistance;
+		if (MaxDistance <= 0.f || NearestDistSq <= FMath::Square((double)MaxDistance))
+		{
+			Tier = Index;
+			break;
+		}
+	}
+
+	if (Agent.OffscreenTierPenalty > 0 && !Owner->WasRecentlyRendered(Agent.RecentlyRenderedTolerance))
+	{
+		Tier = FMath::Min(Tier + Agent.OffscreenTierPenalty, Tiers.Num() - 1);
+	}
+	return Tier;
+}
@@ -0,0 +1,596 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacTickManager.h"
+#include "BehaviacAgent.h"
+#include "BehaviacTickLOD.h"
+#include "BehaviacTimerManager.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+
+TAutoConsoleVariable<float> CVarBehaviacTickBudgetMs(
+	TEXT("Behaviac.TickManager.FrameBudgetMs"),
+	0.f,
+	TEXT("Per-frame budget for agents ticked by the Behaviac tick manager, in milliseconds.\n")
+	TEXT("  0 = unlimited (default)\n")
+	TEXT("  >0 = stop when spent; the remaining agents go first next frame"),
+	ECVF_Default
+);
+
+TAutoConsoleVariable<int32> CVarBehaviacParallelTick(
+	TEXT("Behaviac.TickManager.Parallel"),
+	0,
+	TEXT("Tick agents that opted in with bTickInParallel on worker threads.\n")
+	TEXT("  0 = off, every agent ticks on the game thread (default)\n")
+	TEXT("  1 = on"),
+	ECVF_Default
+);
+
+// ===================================================================
+// Tick function
+// ===================================================================
+
+void FBehaviacManagerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Manager && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Manager->TickManagedGroup((ETickingGroup)TickGroup.GetValue(), DeltaTime);
+	}
+}
+
+FString FBehaviacManagerTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("BehaviacTickManager[%d]"), (int32)TickGroup.GetValue());
+}
+
+FName FBehaviacManagerTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("BehaviacTickManager"));
+}
+
+// ===================================================================
+// UBehaviacTickManager
+// ===================================================================
+
+UBehaviacTickManager* UBehaviacTickManager::Get(const UObject* WorldContext)
+{
+	UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UBehaviacTickManager>() : nullptr;
+}
+
+bool UBehaviacTickManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBehaviacTickManager::Deinitialize()
+{
+	TArray<TObjectKey<UBehaviacAgentComponent>> Registered;
+	AgentEntries.GetKeys(Registered);
+	for (const TObjectKey<UBehaviacAgentComponent>& Key : Registered)
+	{
+		UnregisterAgent(Key.ResolveObjectPtr());
+	}
+	AgentEntries.Reset();
+	NumSleeping = 0;
+
+	for (TUniquePtr<FGroup>& Group : Groups)
+	{
+		if (Group->TickFunction.IsTickFunctionRegistered())
+		{
+			Group->TickFunction.UnRegisterTickFunction();
+		}
+	}
+	Groups.Empty();
+
+	Super::Deinitialize();
+}
+
+UBehaviacTickManager::FGroup* UBehaviacTickManager::FindGroup(ETickingGroup InTickGroup)
+{
+	for (TUniquePtr<FGroup>& Group : Groups)
+	{
+		if (Group->TickGroup == InTickGroup)
+		{
+			return Group.Get();
+		}
+	}
+	return nullptr;
+}
+
+UBehaviacTickManager::FGroup& UBehaviacTickManager::FindOrAddGroup(ETickingGroup InTickGroup)
+{
+	if (FGroup* Existing = FindGroup(InTickGroup))
+	{
+		return *Existing;
+	}
+
+	FGroup& Group = *Groups.Add_GetRef(MakeUnique<FGroup>());
+	Group.TickGroup = InTickGroup;
+	Group.TickFunction.Manager = this;
+	Group.TickFunction.TickGroup = InTickGroup;
+	Group.TickFunction.bCanEverTick = true;
+	Group.TickFunction.bStartWithTickEnabled = true;
+
+	// Without a level (e.g. a manager created outside a world) the group is ticked by hand
+	UWorld* World = Cast<UWorld>(GetOuter());
+	if (World && World->PersistentLevel)
+	{
+		Group.TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+	return Group;
+}
+
+void UBehaviacTickManager::AddToBucket(UBehaviacAgentComponent* Agent, FAgentEntry& Entry)
+{
+	FGroup& Group = FindOrAddGroup(Entry.TickGroup);
+
+	FBucket* Bucket = Group.Buckets.FindByPredicate([&Entry](const FBucket& Candidate)
+	{
+		return Candidate.Tree == Entry.Tree;
+	});
+	if (!Bucket)
+	{
+		Bucket = &Group.Buckets.AddDefaulted_GetRef();
+		Bucket->Tree = Entry.Tree;
+	}
+
+	Entry.Slot = Bucket->Agents.Add(Agent);
+	++Group.NumAgents;
+}
+
+void UBehaviacTickManager::RemoveFromBucket(UBehaviacAgentComponent* Agent, FAgentEntry& Entry)
+{
+	FGroup* Group = FindGroup(Entry.TickGroup);
+	if (!Group)
+	{
+		return;
+	}
+
+	FBucket* Bucket = Group->Buckets.FindByPredicate([&Entry](const FBucket& Candidate)
+	{
+		return Candidate.Tree == Entry.Tree;
+	});
+	if (!Bucket)
+	{
+		return;
+	}
+
+	int32 Index = Entry.Slot;
+	if (!Bucket->Agents.IsValidIndex(Index) || Bucket->Agents[Index] != Agent)
+	{
+		Index = Bucket->Agents.IndexOfByKey(Agent);
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+	}
+	Entry.Slot = INDEX_NONE;
+
+	if (TickingGroup == Group)
+	{
+		// Mid-walk: keep indices stable and compact once the walk is over
+		Bucket->Agents[Index].Reset();
+		Group->bNeedsCompaction = true;
+	}
+	else
+	{
+		Bucket->Agents.RemoveAtSwap(Index);
+		if (Bucket->Agents.IsValidIndex(Index))
+		{
+			if (FAgentEntry* Moved = AgentEntries.Find(Bucket->Agents[Index].Get()))
+			{
+				Moved->Slot = Index;
+			}
+		}
+	}
+	--Group->NumAgents;
+}
+
+void UBehaviacTickManager::CompactGroup(FGroup& Group)
+{
+	// A budgeted walk resumes at the same agent: the slots and buckets before it
+	// that go away move the resume position back by as many
+	int32 ResumeBucket = 0;
+	int32 ResumeIndex = 0;
+	for (int32 BucketIndex = 0; BucketIndex < Group.Buckets.Num(); ++BucketIndex)
+	{
+		const TArray<TWeakObjectPtr<UBehaviacAgentComponent>>& Agents = Group.Buckets[BucketIndex].Agents;
+		if (BucketIndex == Group.ResumeBucket)
+		{
+			for (int32 Index = 0; Index < FMath::Min(Group.ResumeIndex, Agents.Num()); ++Index)
+			{
+				ResumeIndex += !Agents[Index].IsExplicitlyNull();
+			}
+			break;
+		}
+		ResumeBucket += Agents.ContainsByPredicate([](const TWeakObjectPtr<UBehaviacAgentComponent>& Agent) { return !Agent.IsExplicitlyNull(); });
+	}
+
+	for (int32 BucketIndex = Group.Buckets.Num() - 1; BucketIndex >= 0; --BucketIndex)
+	{
+		FBucket& Bucket = Group.Buckets[BucketIndex];
+		Bucket.Agents.RemoveAll([](const TWeakObjectPtr<UBehaviacAgentComponent>& Agent) { return Agent.IsExplicitlyNull(); });
+		if (Bucket.Agents.Num() == 0)
+		{
+			Group.Buckets.RemoveAt(BucketIndex);
+			continue;
+		}
+
+		for (int32 Index = 0; Index < Bucket.Agents.Num(); ++Index)
+		{
+			if (FAgentEntry* Entry = AgentEntries.Find(Bucket.Agents[Index].Get()))
+			{
+				Entry->Slot = Index;
+			}
+		}
+	}
+	// A resume bucket that emptied hands over to the start of the next one
+	Group.ResumeBucket = ResumeBucket;
+	Group.ResumeIndex = ResumeIndex;
+	Group.bNeedsCompaction = false;
+}
+
+void UBehaviacTickManager::RegisterAgent(UBehaviacAgentComponent* Agent)
+{
+	if (!Agent || AgentEntries.Contains(Agent))
+	{
+		return;
+	}
+
+	FAgentEntry& Entry = AgentEntries.Add(Agent);
+	Entry.TickGroup = Agent->ManagedTickGroup;
+	Entry.Tree = Agent->GetBehaviorTreeAsset();
+	if (Agent->IsSleeping())
+	{
+		Entry.bSleeping = true;
+		++NumSleeping;
+		ScheduleWake(Agent, Entry);
+	}
+	else
+	{
+		AddToBucket(Agent, Entry);
+	}
+
+	Agent->TickManager = this;
+	Agent->SetComponentTickEnabled(false);
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] TickManager: registered %s (%d agents)"), *Agent->GetName(), AgentEntries.Num());
+}
+
+void UBehaviacTickManager::UnregisterAgent(UBehaviacAgentComponent* Agent)
+{
+	FAgentEntry Entry;
+	if (!Agent || !AgentEntries.RemoveAndCopyValue(Agent, Entry))
+	{
+		return;
+	}
+
+	if (Entry.bSleeping)
+	{
+		CancelWake(Entry);
+		--NumSleeping;
+	}
+	else
+	{
+		RemoveFromBucket(Agent, Entry);
+	}
+
+	Agent->TickManager = nullptr;
+	Agent->SetComponentTickEnabled(Agent->PrimaryComponentTick.bStartWithTickEnabled);
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] TickManager: unregistered %s (%d agents)"), *Agent->GetName(), AgentEntries.Num());
+}
+
+void UBehaviacTickManager::OnAgentTreeChanged(UBehaviacAgentComponent* Agent)
+{
+	FAgentEntry* Entry = AgentEntries.Find(Agent);
+	if (!Entry)
+	{
+		return;
+	}
+
+	FAgentEntry NewEntry;
+	NewEntry.TickGroup = Agent->ManagedTickGroup;
+	NewEntry.Tree = Agent->GetBehaviorTreeAsset();
+	if (NewEntry.TickGroup == Entry->TickGroup && NewEntry.Tree == Entry->Tree)
+	{
+		return;
+	}
+
+	if (Entry->bSleeping)
+	{
+		// Re-bucketed when it wakes
+		Entry->TickGroup = NewEntry.TickGroup;
+		Entry->Tree = NewEntry.Tree;
+		return;
+	}
+
+	RemoveFromBucket(Agent, *Entry);
+	Entry->TickGroup = NewEntry.TickGroup;
+	Entry->Tree = NewEntry.Tree;
+	AddToBucket(Agent, *Entry);
+}
+
+// --- Sleeping ---
+
+void UBehaviacTickManager::OnAgentSleep(UBehaviacAgentComponent* Agent)
+{
+	FAgentEntry* Entry = AgentEntries.Find(Agent);
+	if (!Entry || Entry->bSleeping)
+	{
+		return;
+	}
+
+	RemoveFromBucket(Agent, *Entry);
+	Entry->bSleeping = true;
+	++NumSleeping;
+	ScheduleWake(Agent, *Entry);
+}
+
+void UBehaviacTickManager::OnAgentWake(UBehaviacAgentComponent* Agent)
+{
+	FAgentEntry* Entry = AgentEntries.Find(Agent);
+	if (!Entry || !Entry->bSleeping)
+	{
+		return;
+	}
+
+	CancelWake(*Entry);
+	Entry->bSleeping = false;
+	--NumSleeping;
+	AddToBucket(Agent, *Entry);
+}
+
+void UBehaviacTickManager::ScheduleWake(UBehaviacAgentComponent* Agent, FAgentEntry& Entry)
+{
+	const FBehaviacWakeCondition& Condition = Agent->GetWakeCondition();
+	if (!Condition.HasWakeTime() && !Condition.HasWakeFrame())
+	{
+		return;
+	}
+
+	// Whichever deadline comes first wakes the agent, which cancels the other
+	TWeakObjectPtr<UBehaviacAgentComponent> WeakAgent(Agent);
+	auto Wake = [WeakAgent]()
+	{
+		if (UBehaviacAgentComponent* SleepingAgent = WeakAgent.Get())
+		{
+			SleepingAgent->WakeUp();
+		}
+	};
+
+	FBehaviacTimers& Timers = UBehaviacTimerManager::Get(this);
+	if (Condition.HasWakeTime())
+	{
+		Entry.WakeTimeTimer = Timers.SetTimerAt(Condition.WakeTime, Wake);
+	}
+	if (Condition.HasWakeFrame())
+	{
+		Entry.WakeFrameTimer = Timers.SetFrameTimerAt(Condition.WakeFrame, Wake);
+	}
+}
+
+void UBehaviacTickManager::CancelWake(FAgentEntry& Entry)
+{
+	if (!Entry.WakeTimeTimer.IsValid() && !Entry.WakeFrameTimer.IsValid())
+	{
+		return;
+	}
+
+	FBehaviacTimers& Timers = UBehaviacTimerManager::Get(this);
+	Timers.ClearTimer(Entry.WakeTimeTimer);
+	Timers.ClearTimer(Entry.WakeFrameTimer);
+}
+
+int32 UBehaviacTickManager::BroadcastSignal(const FString& SignalName, const UBehaviacBehaviorTree* Tree)
+{
+	const int32 SignalId = FBehaviacSignalRegistry::FindOrAdd(SignalName);
+	if (SignalId == BEHAVIAC_INVALID_SIGNAL_ID)
+	{
+		return 0;
+	}
+
+	// Waking or signal handlers may unregister agents; do not iterate the map itself
+	TArray<TWeakObjectPtr<UBehaviacAgentComponent>, TInlineAllocator<64>> Targets;
+	for (const TPair<TObjectKey<UBehaviacAgentComponent>, FAgentEntry>& Pair : AgentEntries)
+	{
+		if (!Tree || Pair.Value.Tree == Tree)
+		{
+			if (UBehaviacAgentComponent* Agent = Pair.Key.ResolveObjectPtr())
+			{
+				Targets.Add(Agent);
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : Targets)
+	{
+		if (Agent.IsValid())
+		{
+			Agent->SendSignalById(SignalId);
+		}
+	}
+	return Targets.Num();
+}
+
+float UBehaviacTickManager::GetFrameBudgetMs() const
+{
+	return FrameBudgetMs >= 0.f ? FrameBudgetMs : CVarBehaviacTickBudgetMs.GetValueOnGameThread();
+}
+
+bool UBehaviacTickManager::IsParallelTickingEnabled() const
+{
+	return ParallelOverride >= 0 ? ParallelOverride != 0 : CVarBehaviacParallelTick.GetValueOnGameThread() != 0;
+}
+
+void UBehaviacTickManager::TickManagedGroup(ETickingGroup InTickGroup, float DeltaTime)
+{
+	// Agents whose wake deadline passed rejoin their bucket and are ticked in this walk
+	UBehaviacTimerManager::Get(this).AdvanceTimers();
+
+	FGroup* Group = FindGroup(InTickGroup);
+	if (!Group)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const float BudgetMs = GetFrameBudgetMs();
+	const double BudgetSeconds = BudgetMs > 0.f ? BudgetMs / 1000.0 : 0.0;
+
+	// Unlimited walks always start at the front; budgeted walks resume where they stopped
+	int32 BucketIndex = BudgetSeconds > 0.0 ? Group->ResumeBucket : 0;
+	int32 AgentIndex = BudgetSeconds > 0.0 ? Group->ResumeIndex : 0;
+
+	// Walk each slot present at the start once; agents registered by a tick this
+	// frame are appended and wait for the next frame, removed ones are null
+	int32 NumSlots = 0;
+	for (const FBucket& Bucket : Group->Buckets)
+	{
+		NumSlots += Bucket.Agents.Num();
+	}
+
+	// Viewers are shared by every tick group and component-ticked agent this frame
+	const TArray<FVector>& ViewerLocations = FBehaviacTickLOD::GetViewerLocations(Cast<UWorld>(GetOuter()));
+	double Now = -1.0;
+
+	const bool bParallel = IsParallelTickingEnabled();
+	ParallelAgents.Reset();
+
+	int32 Ticked = 0;
+	int32 SkippedByLOD = 0;
+	int32 Steps = 0;
+
+	TickingGroup = Group;
+	while (Steps < NumSlots)
+	{
+		if (!Group->Buckets.IsValidIndex(BucketIndex))
+		{
+			BucketIndex = 0;
+			AgentIndex = 0;
+		}
+		TArray<TWeakObjectPtr<UBehaviacAgentComponent>>& Agents = Group->Buckets[BucketIndex].Agents;
+		if (AgentIndex >= Agents.Num())
+		{
+			++BucketIndex;
+			AgentIndex = 0;
+			continue;
+		}
+
+		UBehaviacAgentComponent* Agent = Agents[AgentIndex++].Get();
+		++Steps;
+		if (!Agent || !Agent->HasBehaviorTree())
+		{
+			continue;
+		}
+
+		if (Agent->bEnableTickLOD)
+		{
+			if (Now < 0.0)
+			{
+				Now = Agent->GetTimeSeconds();
+			}
+
+			if (!Agent->ShouldTickForLOD(Now, ViewerLocations))
+			{
+				++SkippedByLOD;
+				continue;
+			}
+		}
+
+		if (bParallel && Agent->CanTickInParallel())
+		{
+			ParallelAgents.Add(Agent);
+		}
+		else
+		{
+			Agent->TickBehaviorTree();
+		}
+		++Ticked;
+
+		if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (ParallelAgents.Num() > 0)
+	{
+		// Workers cannot advance the wheels; catch them up here, so deadlines
+		// due by now (including ones set during the walk) read as fired
+		UBehaviacTimerManager::Get(this).AdvanceTimers();
+
+		// Collected agents are all live (no GC or unregistering since the walk), so
+		// resolve them once for the workers
+		TArray<UBehaviacAgentComponent*, TInlineAllocator<64>> Parallel;
+		for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : ParallelAgents)
+		{
+			Parallel.Add(Agent.Get());
+			Parallel.Last()->BeginParallelTick();
+		}
+		ParallelFor(TEXT("Behaviac.TickAgents"), Parallel.Num(), 16, [&Parallel](int32 Index)
+		{
+			Parallel[Index]->TickBehaviorTree();
+		});
+
+		// Commands may sleep or unregister agents, which the walk already tolerates
+		for (UBehaviacAgentComponent* Agent : Parallel)
+		{
+			Agent->EndParallelTick();
+		}
+		for (const TWeakObjectPtr<UBehaviacAgentComponent>& Agent : ParallelAgents)
+		{
+			if (Agent.IsValid())
+			{
+				Agent->FlushCommandBuffer();
+			}
+		}
+	}
+	TickingGroup = nullptr;
+
+	Group->ResumeBucket = BucketIndex;
+	Group->ResumeIndex = AgentIndex;
+	Group->LastTicked = Ticked;
+	Group->LastTickedInParallel = ParallelAgents.Num();
+	Group->LastDeferred = NumSlots - Steps;
+	Group->LastSkippedByLOD = SkippedByLOD;
+	Group->LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (Group->bNeedsCompaction)
+	{
+		CompactGroup(*Group);
+	}
+}
+
+FBehaviacTickManagerStats UBehaviacTickManager::GetStats() const
+{
+	FBehaviacTickManagerStats Stats;
+	Stats.NumAgents = AgentEntries.Num();
+	Stats.NumSleeping = NumSleeping;
+	for (const TUniquePtr<FGroup>& Group : Groups)
+	{
+		Stats.NumBuckets += Group->Buckets.Num();
+		Stats.NumTicked += Group->LastTicked;
+		Stats.NumTickedInParallel += Group->LastTickedInParallel;
+		Stats.NumDeferred += Group->LastDeferred;
+		Stats.NumSkippedByLOD += Group->LastSkippedByLOD;
+		Stats.TickTimeMs += (float)(Group->LastTickSeconds * 1000.0);
+	}
+	FBehaviacTickLOD::GetAgentsPerTier(Cast<UWorld>(GetOuter()), Stats.AgentsPerLODTier);
+
+	int64 PredicateLookups = 0;
+	for (const TPair<TObjectKey<UBehaviacAgentComponent>, FAgentEntry>& Pair : AgentEntries)
+	{
+		if (const UBehaviacAgentComponent* Agent = Pair.Key.ResolveObjectPtr())
+		{
+			const FBehaviacPredicateCacheStats CacheStats = Agent->GetPredicateCacheStats();
+			Stats.PredicateCacheHits += CacheStats.Hits;
+			PredicateLookups += CacheStats.Hits + CacheStats.Misses + CacheStats.Invalidations;
+		}
+	}
+	Stats.PredicateCacheHitRate = PredicateLookups > 0 ? (float)((double)Stats.PredicateCacheHits / (double)PredicateLookups) : 0.f;
+	return Stats;
+}
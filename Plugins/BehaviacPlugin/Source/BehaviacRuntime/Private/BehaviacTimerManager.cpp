@@ -0,0 +1,219 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacTimerManager.h"
+#include "BehaviacAgent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+// ===================================================================
+// UBehaviacTimerManager
+// ===================================================================
+
+UBehaviacTimerManager* UBehaviacTimerManager::Find(const UObject* WorldContext)
+{
+	const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UBehaviacTimerManager>() : nullptr;
+}
+
+FBehaviacTimers& UBehaviacTimerManager::Get(const UObject* WorldContext)
+{
+	UBehaviacTimerManager* Manager = Find(WorldContext);
+	return Manager ? Manager->Timers : FBehaviacTimers::GetNoWorld();
+}
+
+bool UBehaviacTimerManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBehaviacTimerManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Timers.SetWorld(GetWorld());
+}
+
+void UBehaviacTimerManager::Tick(float DeltaTime)
+{
+	Timers.AdvanceTimers();
+}
+
+TStatId UBehaviacTimerManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBehaviacTimerManager, STATGROUP_Tickables);
+}
+
+// ===================================================================
+// FBehaviacTimers
+// ===================================================================
+
+FBehaviacTimers& FBehaviacTimers::GetNoWorld()
+{
+	static FBehaviacTimers NoWorld;
+	return NoWorld;
+}
+
+double FBehaviacTimers::GetTimeSeconds() const
+{
+	return World ? World->GetTimeSeconds() : FPlatformTime::Seconds();
+}
+
+uint64 FBehaviacTimers::ToWheelTick(double Time)
+{
+	return (uint64)FMath::FloorToDouble(FMath::Max(0.0, Time) * TimeTicksPerSecond);
+}
+
+void FBehaviacTimers::AdvanceTimers()
+{
+	check(IsInGameThread());
+
+	TArray<TFunction<void()>> Callbacks;
+	{
+		FScopeLock Lock(&TimerLock);
+		const double Now = GetTimeSeconds();
+		TimeWheel.Advance(ToWheelTick(Now), Now, Callbacks);
+		FrameWheel.Advance(GFrameCounter, (double)GFrameCounter, Callbacks);
+	}
+
+	// Outside the lock: callbacks wake agents and set timers, and workers must not wait on them
+	for (TFunction<void()>& Callback : Callbacks)
+	{
+		Callback();
+	}
+}
+
+void FBehaviacTimers::StartWheels()
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+
+	bool bStarted;
+	{
+		FScopeLock Lock(&TimerLock);
+		bStarted = TimeWheel.HasStarted() && FrameWheel.HasStarted();
+	}
+	if (!bStarted)
+	{
+		AdvanceTimers();
+	}
+}
+
+FBehaviacTimerHandle FBehaviacTimers::SetTimerAt(double Time, TFunction<void()> OnFired)
+{
+	StartWheels();
+
+	FScopeLock Lock(&TimerLock);
+	FBehaviacTimerHandle Handle = TimeWheel.Add(ToWheelTick(Time), Time, MoveTemp(OnFired));
+	Handle.Wheel = Wheel_Time;
+	return Handle;
+}
+
+FBehaviacTimerHandle FBehaviacTimers::SetFrameTimerAt(uint64 Frame, TFunction<void()> OnFired)
+{
+	StartWheels();
+
+	FScopeLock Lock(&TimerLock);
+	FBehaviacTimerHandle Handle = FrameWheel.Add(Frame, (double)Frame, MoveTemp(OnFired));
+	Handle.Wheel = Wheel_Frame;
+	return Handle;
+}
+
+void FBehaviacTimers::ClearTimer(FBehaviacTimerHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		FScopeLock Lock(&TimerLock);
+		GetWheel(Handle).Remove(Handle);
+	}
+}
+
+bool FBehaviacTimers::HasFired(const FBehaviacTimerHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	// Only the game thread advances the wheels, so the timer cannot fire between the check and the advance
+	if (IsInGameThread() && IsTimerPending(Handle))
+	{
+		AdvanceTimers();
+	}
+
+	FScopeLock Lock(&TimerLock);
+	return GetWheel(Handle).HasFired(Handle);
+}
+
+bool FBehaviacTimers::IsTimerPending(const FBehaviacTimerHandle& Handle) const
+{
+	FScopeLock Lock(&TimerLock);
+	return Handle.IsValid() && GetWheel(Handle).IsPending(Handle);
+}
+
+int32 FBehaviacTimers::GetNumPendingTimers() const
+{
+	FScopeLock Lock(&TimerLock);
+	return TimeWheel.NumPending() + FrameWheel.NumPending();
+}
+
+// ===================================================================
+// FBehaviacTaskTimer
+// ===================================================================
+
+FBehaviacTimers* FBehaviacTaskTimer::GetTimers() const
+{
+	if (bNoWorld)
+	{
+		return &FBehaviacTimers::GetNoWorld();
+	}
+	UBehaviacTimerManager* TimerManager = Manager.Get();
+	return TimerManager ? &TimerManager->GetTimers() : nullptr;
+}
+
+void FBehaviacTaskTimer::SetAt(const UBehaviacAgentComponent* Agent, double Time)
+{
+	Clear();
+	UBehaviacTimerManager* TimerManager = UBehaviacTimerManager::Find(Agent);
+	FBehaviacTimers& Timers = TimerManager ? TimerManager->GetTimers() : FBehaviacTimers::GetNoWorld();
+
+	// Time is on the agent's clock; the world-less timers may run on another
+	const double Delay = Agent ? Time - Agent->GetTimeSeconds() : Time - Timers.GetTimeSeconds();
+	Handle = Timers.SetTimerAt(Timers.GetTimeSeconds() + Delay);
+	Manager = TimerManager;
+	bNoWorld = !TimerManager;
+}
+
+void FBehaviacTaskTimer::SetAtFrame(const UBehaviacAgentComponent* Agent, uint64 Frame)
+{
+	Clear();
+	UBehaviacTimerManager* TimerManager = UBehaviacTimerManager::Find(Agent);
+	FBehaviacTimers& Timers = TimerManager ? TimerManager->GetTimers() : FBehaviacTimers::GetNoWorld();
+	Handle = Timers.SetFrameTimerAt(Frame);
+	Manager = TimerManager;
+	bNoWorld = !TimerManager;
+}
+
+bool FBehaviacTaskTimer::HasFired() const
+{
+	FBehaviacTimers* Timers = GetTimers();
+	return Timers && Timers->HasFired(Handle);
+}
+
+void FBehaviacTaskTimer::Clear()
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	if (FBehaviacTimers* Timers = GetTimers())
+	{
+		Timers->ClearTimer(Handle);
+	}
+	Handle.Invalidate();
+	Manager = nullptr;
+	bNoWorld = false;
+}
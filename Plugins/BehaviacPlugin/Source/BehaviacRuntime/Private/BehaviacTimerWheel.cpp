@@ -0,0 +1,310 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviacTimerWheel.h"
+
+FBehaviacTimerWheel::FBehaviacTimerWheel()
+{
+	for (int32& Head : ListHeads)
+	{
+		Head = INDEX_NONE;
+	}
+	for (uint64& Occupied : OccupiedSlots)
+	{
+		Occupied = 0;
+	}
+}
+
+// ===================================================================
+// Timers
+// ===================================================================
+
+FBehaviacTimerHandle FBehaviacTimerWheel::Add(uint64 DeadlineTick, double Deadline, TFunction<void()> OnFired)
+{
+	if (!bStarted)
+	{
+		// Not advanced yet: park the timer in the due list, where its deadline is checked directly
+		bStarted = true;
+		CurrentTick = DeadlineTick;
+	}
+
+	const int32 Index = FreeIndices.Num() > 0 ? FreeIndices.Pop(EAllowShrinking::No) : Timers.AddDefaulted();
+
+	FTimer& Timer = Timers[Index];
+	Timer.Tick = DeadlineTick;
+	Timer.Deadline = Deadline;
+	Timer.OnFired = MoveTemp(OnFired);
+	Timer.State = EState::Pending;
+	if (++NextSerial == 0)
+	{
+		++NextSerial;
+	}
+	Timer.Serial = NextSerial;
+
+	++NumPendingTimers;
+	Place(Index);
+
+	FBehaviacTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Timer.Serial;
+	return Handle;
+}
+
+void FBehaviacTimerWheel::Remove(FBehaviacTimerHandle& Handle)
+{
+	if (IsCurrent(Handle))
+	{
+		if (Timers[Handle.Index].State == EState::Pending)
+		{
+			Unlink(Handle.Index);
+			--NumPendingTimers;
+		}
+		Release(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+
+bool FBehaviacTimerWheel::HasFired(const FBehaviacTimerHandle& Handle) const
+{
+	return IsCurrent(Handle) && Timers[Handle.Index].State == EState::Fired;
+}
+
+bool FBehaviacTimerWheel::IsPending(const FBehaviacTimerHandle& Handle) const
+{
+	return IsCurrent(Handle) && Timers[Handle.Index].State == EState::Pending;
+}
+
+bool FBehaviacTimerWheel::IsCurrent(const FBehaviacTimerHandle& Handle) const
+{
+	return Timers.IsValidIndex(Handle.Index)
+		&& Timers[Handle.Index].Serial == Handle.Serial
+		&& Timers[Handle.Index].State != EState::Free;
+}
+
+// ===================================================================
+// Advancing
+// ===================================================================
+
+void FBehaviacTimerWheel::Advance(uint64 NowTick, double Now)
+{
+	TArray<TFunction<void()>> Callbacks;
+	Advance(NowTick, Now, Callbacks);
+
+	// Run callbacks last: they may add or remove timers
+	for (TFunction<void()>& Callback : Callbacks)
+	{
+		Callback();
+	}
+}
+
+void FBehaviacTimerWheel::Advance(uint64 NowTick, double Now, TArray<TFunction<void()>>& OutCallbacks)
+{
+	if (!bStarted)
+	{
+		bStarted = true;
+		CurrentTick = NowTick;
+	}
+
+	if (NumPendingTimers == 0)
+	{
+		CurrentTick = FMath::Max(CurrentTick, NowTick);
+		return;
+	}
+
+	static constexpr uint64 SlotMask = NumSlots - 1;
+	static constexpr uint64 WheelMask = (uint64(1) << (SlotBits * NumLevels)) - 1;
+
+	while (CurrentTick < NowTick)
+	{
+		// Ticks before the next busy one would only visit empty lists
+		const uint64 BusyTick = FindNextBusyTick();
+		if (BusyTick > NowTick)
+		{
+			CurrentTick = NowTick;
+			break;
+		}
+		CurrentTick = BusyTick;
+		const uint64 Tick = CurrentTick;
+
+		if ((Tick & WheelMask) == 0)
+		{
+			Replace(OverflowList);
+		}
+
+		// Cascade from the highest level that wrapped, so its timers can drop through several levels
+		for (int32 Level = NumLevels - 1; Level >= 1; --Level)
+		{
+			const uint64 LevelMask = (uint64(1) << (SlotBits * Level)) - 1;
+			if ((Tick & LevelMask) == 0)
+			{
+				Replace(Level * NumSlots + (int32)((Tick >> (SlotBits * Level)) & SlotMask));
+			}
+		}
+
+		// Timers of this tick join the due list
+		Replace((int32)(Tick & SlotMask));
+	}
+
+	ProcessList(DueList, NowTick, Now, OutCallbacks);
+}
+
+uint64 FBehaviacTimerWheel::FindNextBusyTick() const
+{
+	uint64 BusyTick = MAX_uint64;
+
+	// Level L replaces slot (K & SlotMask) at tick K << (SlotBits * L), for every K past the current one
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		const uint64 Occupied = OccupiedSlots[Level];
+		if (Occupied == 0)
+		{
+			continue;
+		}
+
+		const int32 Shift = SlotBits * Level;
+		const uint64 FirstK = (CurrentTick >> Shift) + 1;
+		const int32 Start = (int32)(FirstK & (NumSlots - 1));
+		const uint64 Rotated = Start == 0 ? Occupied : (Occupied >> Start) | (Occupied << (NumSlots - Start));
+		const uint64 Tick = (FirstK + FMath::CountTrailingZeros64(Rotated)) << Shift;
+		BusyTick = FMath::Min(BusyTick, Tick);
+	}
+
+	if (ListHeads[OverflowList] != INDEX_NONE)
+	{
+		// Re-sorted each time the top level wraps
+		const int32 WheelBits = SlotBits * NumLevels;
+		BusyTick = FMath::Min(BusyTick, ((CurrentTick >> WheelBits) + 1) << WheelBits);
+	}
+	return BusyTick;
+}
+
+void FBehaviacTimerWheel::ProcessList(int32 List, uint64 NowTick, double Now, TArray<TFunction<void()>>& OutCallbacks)
+{
+	int32 Index = ListHeads[List];
+	while (Index != INDEX_NONE)
+	{
+		const int32 Next = Timers[Index].Next;
+
+		// Past ticks are due whatever the rounding; the current tick compares exact deadlines
+		if (Timers[Index].Tick < NowTick || Timers[Index].Deadline <= Now)
+		{
+			Fire(Index, OutCallbacks);
+		}
+		Index = Next;
+	}
+}
+
+void FBehaviacTimerWheel::Fire(int32 Index, TArray<TFunction<void()>>& OutCallbacks)
+{
+	Unlink(Index);
+	--NumPendingTimers;
+
+	FTimer& Timer = Timers[Index];
+	Timer.State = EState::Fired;
+	if (Timer.OnFired)
+	{
+		OutCallbacks.Add(MoveTemp(Timer.OnFired));
+		Release(Index);
+	}
+}
+
+void FBehaviacTimerWheel::Release(int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.State = EState::Free;
+	Timer.OnFired = nullptr;
+	FreeIndices.Add(Index);
+}
+
+// ===================================================================
+// Lists
+// ===================================================================
+
+void FBehaviacTimerWheel::Place(int32 Index)
+{
+	const uint64 Tick = Timers[Index].Tick;
+	if (Tick <= CurrentTick)
+	{
+		Link(Index, DueList);
+		return;
+	}
+
+	const uint64 Delta = Tick - CurrentTick;
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		if (Delta < (uint64(1) << (SlotBits * (Level + 1))))
+		{
+			Link(Index, Level * NumSlots + (int32)((Tick >> (SlotBits * Level)) & (NumSlots - 1)));
+			return;
+		}
+	}
+	Link(Index, OverflowList);
+}
+
+void FBehaviacTimerWheel::Replace(int32 List)
+{
+	int32 Index = ListHeads[List];
+	ListHeads[List] = INDEX_NONE;
+	if (List < DueList)
+	{
+		OccupiedSlots[List / NumSlots] &= ~(uint64(1) << (List % NumSlots));
+	}
+
+	while (Index != INDEX_NONE)
+	{
+		FTimer& Timer = Timers[Index];
+		const int32 Next = Timer.Next;
+		Timer.Prev = INDEX_NONE;
+		Timer.Next = INDEX_NONE;
+		Timer.List = INDEX_NONE;
+		Place(Index);
+		Index = Next;
+	}
+}
+
+void FBehaviacTimerWheel::Link(int32 Index, int32 List)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.List = List;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = ListHeads[List];
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Index;
+	}
+	ListHeads[List] = Index;
+	if (List < DueList)
+	{
+		OccupiedSlots[List / NumSlots] |= uint64(1) << (List % NumSlots);
+	}
+}
+
+void FBehaviacTimerWheel::Unlink(int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	if (Timer.List == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		ListHeads[Timer.List] = Timer.Next;
+		if (Timer.Next == INDEX_NONE && Timer.List < DueList)
+		{
+			OccupiedSlots[Timer.List / NumSlots] &= ~(uint64(1) << (Timer.List % NumSlots));
+		}
+	}
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+	Timer.List = INDEX_NONE;
+}
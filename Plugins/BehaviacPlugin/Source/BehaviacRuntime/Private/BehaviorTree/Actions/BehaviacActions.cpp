@@ -3,14 +3,24 @@
 
 #include "BehaviorTree/Actions/BehaviacActions.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+BEHAVIAC_REGISTER_NODE(Action, UBehaviacAction);
+BEHAVIAC_REGISTER_NODE(Assignment, UBehaviacAssignment);
+BEHAVIAC_REGISTER_NODE(Compute, UBehaviacCompute);
+BEHAVIAC_REGISTER_NODE(Noop, UBehaviacNoop);
+BEHAVIAC_REGISTER_NODE(End, UBehaviacEnd);
+BEHAVIAC_REGISTER_NODE(Wait, UBehaviacWait);
+BEHAVIAC_REGISTER_NODE(WaitFrames, UBehaviacWaitFrames);
+BEHAVIAC_REGISTER_NODE(WaitforSignal, UBehaviacWaitForSignal);
 
 // ===================================================================
 // ACTION
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacAction::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacAction::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacActionTask>(Outer);
+	return Allocator.New<FBehaviacActionTask>();
 }
 
 void UBehaviacAction::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -40,7 +50,13 @@ void UBehaviacAction::LoadFromProperties(int32 Version, const FString& InAgentTy
 	BEHAVIAC_VLOG(TEXT("[Behaviac] After parsing: MethodName='%s'"), *MethodName);
 }
 
-EBehaviacStatus UBehaviacActionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void UBehaviacAction::ResolveOperands()
+{
+	Super::ResolveOperands();
+	MethodId = FBehaviacMethodRegistry::FindOrAdd(MethodName);
+}
+
+EBehaviacStatus FBehaviacActionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacAction* ActionNode = Cast<UBehaviacAction>(Node);
 	if (!ActionNode || !Agent)
@@ -52,8 +68,8 @@ EBehaviacStatus UBehaviacActionTask::OnUpdate(UBehaviacAgentComponent* Agent, EB
 
 	BEHAVIAC_VLOG(TEXT("[Behaviac] ActionTask::OnUpdate: Calling method '%s'"), *ActionNode->MethodName);
 
-	// Call the method on the agent
-	EBehaviacStatus Result = Agent->ExecuteMethod(ActionNode->MethodName);
+	// Call the method on the agent (route cached per agent after the first call)
+	EBehaviacStatus Result = Agent->ExecuteMethodById(ActionNode->MethodId);
 
 	BEHAVIAC_VLOG(TEXT("[Behaviac] ActionTask::OnUpdate: Method '%s' returned %d (Invalid=0, Success=1, Failure=2, Running=3)"), 
 		*ActionNode->MethodName, (int32)Result);
@@ -75,13 +91,67 @@ EBehaviacStatus UBehaviacActionTask::OnUpdate(UBehaviacAgentComponent* Agent, EB
 	return ActionNode->ResultOption;
 }
 
+// ===================================================================
+// GUARDED ACTION
+// ===================================================================
+
+FBehaviacBehaviorTask* UBehaviacGuardedAction::CreateTask(FBehaviacTaskAllocator& Allocator) const
+{
+	return Allocator.New<FBehaviacGuardedActionTask>();
+}
+
+void UBehaviacGuardedAction::ResolveOperands()
+{
+	Super::ResolveOperands();
+
+	// Same operand rules as UBehaviacCondition
+	Guard.Resolve(
+		GuardLeftOperand, EBehaviacOperandMode::PropertyOrMethod,
+		GuardRightOperand, EBehaviacOperandMode::PropertyOrMethod,
+		GuardOperator);
+}
+
+void UBehaviacGuardedAction::GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates)
+{
+	Super::GatherPredicates(OutPredicates);
+	OutPredicates.Add(&Guard);
+}
+
+FBehaviacGuardedActionTask::FBehaviacGuardedActionTask()
+	: bGuardPassed(false)
+{
+	SlotHints[0] = INDEX_NONE;
+	SlotHints[1] = INDEX_NONE;
+}
+
+bool FBehaviacGuardedActionTask::OnEnter(UBehaviacAgentComponent* Agent)
+{
+	bGuardPassed = false;
+	return Super::OnEnter(Agent);
+}
+
+EBehaviacStatus FBehaviacGuardedActionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+{
+	if (!bGuardPassed)
+	{
+		const UBehaviacGuardedAction* GuardedNode = Cast<UBehaviacGuardedAction>(Node);
+		if (!GuardedNode || !Agent || !GuardedNode->GetGuard().Evaluate(Agent, SlotHints))
+		{
+			return EBehaviacStatus::Failure;
+		}
+		bGuardPassed = true;
+	}
+
+	return Super::OnUpdate(Agent, ChildStatus);
+}
+
 // ===================================================================
 // ASSIGNMENT
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacAssignment::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacAssignment::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacAssignmentTask>(Outer);
+	return Allocator.New<FBehaviacAssignmentTask>();
 }
 
 void UBehaviacAssignment::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -106,7 +176,20 @@ void UBehaviacAssignment::LoadFromProperties(int32 Version, const FString& InAge
 	}
 }
 
-EBehaviacStatus UBehaviacAssignmentTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void UBehaviacAssignment::ResolveOperands()
+{
+	Super::ResolveOperands();
+	TargetKey = FBehaviacBlackboard::MakeKey(PropertyName);
+	Source = FBehaviacOperand::Resolve(PropertyValue, EBehaviacOperandMode::PropertyOrConstant);
+}
+
+FBehaviacAssignmentTask::FBehaviacAssignmentTask()
+{
+	SlotHints[0] = INDEX_NONE;
+	SlotHints[1] = INDEX_NONE;
+}
+
+EBehaviacStatus FBehaviacAssignmentTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacAssignment* AssignNode = Cast<UBehaviacAssignment>(Node);
 	if (!AssignNode || !Agent)
@@ -114,15 +197,26 @@ EBehaviacStatus UBehaviacAssignmentTask::OnUpdate(UBehaviacAgentComponent* Agent
 		return EBehaviacStatus::Failure;
 	}
 
-	FString Value = AssignNode->PropertyValue;
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	FBehaviacBlackboard& Blackboard = Agent->GetBlackboard();
 
-	// Resolve if it references another property
-	if (Value.StartsWith(TEXT("Self.")))
+	// Claim the target slot first: adding it may grow the value array
+	const int32 TargetSlot = Blackboard.FindOrAddSlotWithHint(AssignNode->TargetKey, SlotHints[0]);
+	if (TargetSlot == INDEX_NONE)
 	{
-		Value = Agent->GetPropertyValue(Value);
+		return EBehaviacStatus::Failure;
 	}
+	const FBehaviacValue* Value = AssignNode->Source.Find(Blackboard, SlotHints[1]);
 
-	Agent->SetPropertyValue(AssignNode->PropertyName, Value);
+	if (!Value)
+	{
+		// An unset source property assigns an empty value, as before
+		Blackboard.SetValue(TargetSlot, FBehaviacValue::MakeString(FString()));
+	}
+	else if (Value != &Blackboard.GetValue(TargetSlot))
+	{
+		Blackboard.SetValue(TargetSlot, *Value);
+	}
 	return EBehaviacStatus::Success;
 }
 
@@ -130,9 +224,9 @@ EBehaviacStatus UBehaviacAssignmentTask::OnUpdate(UBehaviacAgentComponent* Agent
 // COMPUTE
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacCompute::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacCompute::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacComputeTask>(Outer);
+	return Allocator.New<FBehaviacComputeTask>();
 }
 
 void UBehaviacCompute::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -164,40 +258,45 @@ void UBehaviacCompute::LoadFromProperties(int32 Version, const FString& InAgentT
 	}
 }
 
-EBehaviacStatus UBehaviacComputeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void UBehaviacCompute::ResolveOperands()
+{
+	Super::ResolveOperands();
+	ResultKey = FBehaviacBlackboard::MakeKey(ResultProperty);
+	Left = FBehaviacOperand::Resolve(LeftOperand, EBehaviacOperandMode::PropertyOrConstant);
+	Right = FBehaviacOperand::Resolve(RightOperand, EBehaviacOperandMode::PropertyOrConstant);
+	Kernel = BehaviacSelectArithmeticKernel(Operator);
+}
+
+FBehaviacComputeTask::FBehaviacComputeTask()
+{
+	SlotHints[0] = INDEX_NONE;
+	SlotHints[1] = INDEX_NONE;
+	SlotHints[2] = INDEX_NONE;
+}
+
+EBehaviacStatus FBehaviacComputeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacCompute* ComputeNode = Cast<UBehaviacCompute>(Node);
-	if (!ComputeNode || !Agent)
+	if (!ComputeNode || !Agent || !ComputeNode->Kernel)
 	{
 		return EBehaviacStatus::Failure;
 	}
 
-	FString LeftStr = ComputeNode->LeftOperand;
-	FString RightStr = ComputeNode->RightOperand;
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	FBehaviacBlackboard& Blackboard = Agent->GetBlackboard();
 
-	if (LeftStr.StartsWith(TEXT("Self.")))
-	{
-		LeftStr = Agent->GetPropertyValue(LeftStr);
-	}
-	if (RightStr.StartsWith(TEXT("Self.")))
-	{
-		RightStr = Agent->GetPropertyValue(RightStr);
-	}
+	const FBehaviacValue* LeftValue = ComputeNode->Left.Find(Blackboard, SlotHints[1]);
+	const FBehaviacValue* RightValue = ComputeNode->Right.Find(Blackboard, SlotHints[2]);
+	const double Result = ComputeNode->Kernel(
+		LeftValue ? LeftValue->AsDouble() : 0.0,
+		RightValue ? RightValue->AsDouble() : 0.0);
 
-	double Left = FCString::Atod(*LeftStr);
-	double Right = FCString::Atod(*RightStr);
-	double Result = 0.0;
-
-	switch (ComputeNode->Operator)
+	const int32 ResultSlot = Blackboard.FindOrAddSlotWithHint(ComputeNode->ResultKey, SlotHints[0]);
+	if (ResultSlot == INDEX_NONE)
 	{
-	case EBehaviacOperatorType::Add:		Result = Left + Right; break;
-	case EBehaviacOperatorType::Subtract:	Result = Left - Right; break;
-	case EBehaviacOperatorType::Multiply:	Result = Left * Right; break;
-	case EBehaviacOperatorType::Divide:		Result = (Right != 0.0) ? Left / Right : 0.0; break;
-	default: break;
+		return EBehaviacStatus::Failure;
 	}
-
-	Agent->SetPropertyValue(ComputeNode->ResultProperty, FString::SanitizeFloat(Result));
+	Blackboard.SetValue(ResultSlot, FBehaviacValue::MakeFloat(Result));
 	return EBehaviacStatus::Success;
 }
 
@@ -205,12 +304,12 @@ EBehaviacStatus UBehaviacComputeTask::OnUpdate(UBehaviacAgentComponent* Agent, E
 // NOOP
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacNoop::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacNoop::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacNoopTask>(Outer);
+	return Allocator.New<FBehaviacNoopTask>();
 }
 
-EBehaviacStatus UBehaviacNoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacNoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return EBehaviacStatus::Success;
 }
@@ -219,9 +318,9 @@ EBehaviacStatus UBehaviacNoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBeh
 // END
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacEnd::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacEnd::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacEndTask>(Outer);
+	return Allocator.New<FBehaviacEndTask>();
 }
 
 void UBehaviacEnd::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -244,7 +343,7 @@ void UBehaviacEnd::LoadFromProperties(int32 Version, const FString& InAgentType,
 	}
 }
 
-EBehaviacStatus UBehaviacEndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacEndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacEnd* EndNode = Cast<UBehaviacEnd>(Node);
 	return EndNode ? EndNode->EndStatus : EBehaviacStatus::Success;
@@ -254,9 +353,9 @@ EBehaviacStatus UBehaviacEndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBeha
 // WAIT
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacWait::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWait::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWaitTask>(Outer);
+	return Allocator.New<FBehaviacWaitTask>();
 }
 
 void UBehaviacWait::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -273,61 +372,70 @@ void UBehaviacWait::LoadFromProperties(int32 Version, const FString& InAgentType
 	}
 }
 
-UBehaviacWaitTask::UBehaviacWaitTask()
+FBehaviacWaitTask::FBehaviacWaitTask()
 	: StartTime(0.0)
 	, WaitDuration(0.0f)
 {
 }
 
-bool UBehaviacWaitTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacWaitTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacWait* WaitNode = Cast<UBehaviacWait>(Node);
 	WaitDuration = WaitNode ? WaitNode->Duration : 1.0f;
 
-	if (UWorld* World = Agent ? Agent->GetWorld() : nullptr)
-	{
-		StartTime = World->GetTimeSeconds();
-	}
-	else
+	StartTime = Agent ? Agent->GetTimeSeconds() : FPlatformTime::Seconds();
+	Timer.SetAt(Agent, StartTime + WaitDuration);
+
+	// Tick LOD may skip frames; make sure the tree is ticked when the wait is over
+	if (Agent)
 	{
-		StartTime = FPlatformTime::Seconds();
+		Agent->RequestTickAt(StartTime + WaitDuration);
 	}
 
 	UE_LOG(LogBehaviac, Log, TEXT("[Wait] ENTER — duration=%.2fs, startTime=%.3f"), WaitDuration, StartTime);
 	return true;
 }
 
-EBehaviacStatus UBehaviacWaitTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacWaitTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	double CurrentTime = 0.0;
-
-	if (UWorld* World = Agent ? Agent->GetWorld() : nullptr)
-	{
-		CurrentTime = World->GetTimeSeconds();
-	}
-	else
+	if (Timer.HasFired())
 	{
-		CurrentTime = FPlatformTime::Seconds();
-	}
-
-	const double Elapsed = CurrentTime - StartTime;
-	if (Elapsed >= WaitDuration)
-	{
-		UE_LOG(LogBehaviac, Log, TEXT("[Wait] COMPLETE — elapsed=%.3fs / %.2fs"), Elapsed, WaitDuration);
+		UE_LOG(LogBehaviac, Log, TEXT("[Wait] COMPLETE — %.2fs"), WaitDuration);
 		return EBehaviacStatus::Success;
 	}
 
-	BEHAVIAC_VLOG(TEXT("[Wait] running — elapsed=%.3fs / %.2fs"), Elapsed, WaitDuration);
+	BEHAVIAC_VLOG(TEXT("[Wait] running — %.2fs"), WaitDuration);
 	return EBehaviacStatus::Running;
 }
 
+void FBehaviacWaitTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Timer.Clear();
+}
+
+void FBehaviacWaitTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
+}
+
+bool FBehaviacWaitTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	if (!CanSleep())
+	{
+		return false;
+	}
+	OutCondition.AddDeadline(StartTime + WaitDuration);
+	return true;
+}
+
 // ===================================================================
 // WAIT FRAMES
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacWaitFrames::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWaitFrames::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWaitFramesTask>(Outer);
+	return Allocator.New<FBehaviacWaitFramesTask>();
 }
 
 void UBehaviacWaitFrames::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -344,38 +452,54 @@ void UBehaviacWaitFrames::LoadFromProperties(int32 Version, const FString& InAge
 	}
 }
 
-UBehaviacWaitFramesTask::UBehaviacWaitFramesTask()
+FBehaviacWaitFramesTask::FBehaviacWaitFramesTask()
 	: StartFrame(0)
 	, TargetFrames(0)
 {
 }
 
-bool UBehaviacWaitFramesTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacWaitFramesTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacWaitFrames* WFNode = Cast<UBehaviacWaitFrames>(Node);
 	TargetFrames = WFNode ? WFNode->FrameCount : 1;
 	StartFrame = GFrameCounter;
+	Timer.SetAtFrame(Agent, StartFrame + FMath::Max(0, TargetFrames));
 	return true;
 }
 
-EBehaviacStatus UBehaviacWaitFramesTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacWaitFramesTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+{
+	return Timer.HasFired() ? EBehaviacStatus::Success : EBehaviacStatus::Running;
+}
+
+void FBehaviacWaitFramesTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Timer.Clear();
+}
+
+void FBehaviacWaitFramesTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
+}
+
+bool FBehaviacWaitFramesTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
 {
-	int32 Elapsed = static_cast<int32>(GFrameCounter - StartFrame);
-	if (Elapsed >= TargetFrames)
+	if (!CanSleep())
 	{
-		return EBehaviacStatus::Success;
+		return false;
 	}
-
-	return EBehaviacStatus::Running;
+	OutCondition.AddFrameDeadline(StartFrame + FMath::Max(0, TargetFrames));
+	return true;
 }
 
 // ===================================================================
 // WAIT FOR SIGNAL
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacWaitForSignal::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWaitForSignal::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWaitForSignalTask>(Outer);
+	return Allocator.New<FBehaviacWaitForSignalTask>();
 }
 
 void UBehaviacWaitForSignal::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -391,7 +515,13 @@ void UBehaviacWaitForSignal::LoadFromProperties(int32 Version, const FString& In
 	}
 }
 
-EBehaviacStatus UBehaviacWaitForSignalTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void UBehaviacWaitForSignal::ResolveOperands()
+{
+	Super::ResolveOperands();
+	SignalId = FBehaviacSignalRegistry::FindOrAdd(SignalName);
+}
+
+EBehaviacStatus FBehaviacWaitForSignalTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacWaitForSignal* WFSNode = Cast<UBehaviacWaitForSignal>(Node);
 	if (!WFSNode || !Agent)
@@ -399,10 +529,21 @@ EBehaviacStatus UBehaviacWaitForSignalTask::OnUpdate(UBehaviacAgentComponent* Ag
 		return EBehaviacStatus::Failure;
 	}
 
-	if (Agent->IsSignalSet(WFSNode->SignalName))
+	if (Agent->IsSignalSetById(WFSNode->SignalId))
 	{
 		return EBehaviacStatus::Success;
 	}
 
 	return EBehaviacStatus::Running;
 }
+
+bool FBehaviacWaitForSignalTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	const UBehaviacWaitForSignal* WFSNode = Cast<UBehaviacWaitForSignal>(Node);
+	if (!WFSNode || WFSNode->SignalId == BEHAVIAC_INVALID_SIGNAL_ID || !CanSleep())
+	{
+		return false;
+	}
+	OutCondition.SignalId = WFSNode->SignalId;
+	return true;
+}
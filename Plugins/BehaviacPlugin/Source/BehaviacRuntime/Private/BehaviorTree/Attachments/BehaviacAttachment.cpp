@@ -3,6 +3,12 @@
 
 #include "BehaviorTree/Attachments/BehaviacAttachment.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+// In the order the loose name match tries them
+BEHAVIAC_REGISTER_ATTACHMENT(Precondition, UBehaviacPrecondition, Precondition);
+BEHAVIAC_REGISTER_ATTACHMENT(Effector, UBehaviacEffector, Effector);
+BEHAVIAC_REGISTER_ATTACHMENT(Event, UBehaviacEventAttachment, Event);
 
 // ===================================================================
 // UBehaviacAttachment
@@ -13,6 +19,7 @@ UBehaviacAttachment::UBehaviacAttachment()
 	, EffectorPhase(EBehaviacEffectorPhase::Both)
 	, ActionResult(EBehaviacActionResult::All)
 	, bNegate(false)
+	, bOperandsResolved(false)
 {
 }
 
@@ -50,6 +57,19 @@ bool UBehaviacAttachment::AppliesToPhase(EBehaviacPreconditionPhase Phase) const
 	return PreconditionPhase == EBehaviacPreconditionPhase::Both || PreconditionPhase == Phase;
 }
 
+void UBehaviacAttachment::ResolveOperands()
+{
+	bOperandsResolved = true;
+}
+
+#if WITH_EDITOR
+void UBehaviacAttachment::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	bOperandsResolved = false;
+}
+#endif
+
 // ===================================================================
 // UBehaviacPrecondition
 // ===================================================================
@@ -93,6 +113,21 @@ bool UBehaviacPrecondition::AppliesToPhase(EBehaviacPreconditionPhase Phase) con
 	return PreconditionPhase == EBehaviacPreconditionPhase::Both || PreconditionPhase == Phase;
 }
 
+void UBehaviacPrecondition::ResolveOperands()
+{
+	Super::ResolveOperands();
+	Comparison.Resolve(
+		LeftOperand, EBehaviacOperandMode::Property,
+		RightOperand, EBehaviacOperandMode::PropertyOrConstant,
+		Operator);
+}
+
+void UBehaviacPrecondition::GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates)
+{
+	EnsureOperandsResolved();
+	OutPredicates.Add(&Comparison);
+}
+
 bool UBehaviacPrecondition::Evaluate(UBehaviacAgentComponent* Agent) const
 {
 	if (!Agent)
@@ -100,53 +135,9 @@ bool UBehaviacPrecondition::Evaluate(UBehaviacAgentComponent* Agent) const
 		return false;
 	}
 
-	// Get left and right values from agent properties
-	FString LeftValue = Agent->GetPropertyValue(LeftOperand);
-	FString RightValue = RightOperand;
-
-	// If right operand references a property, resolve it
-	if (RightOperand.StartsWith(TEXT("Self.")))
-	{
-		RightValue = Agent->GetPropertyValue(RightOperand);
-	}
-
-	bool bResult = false;
-
-	// Try numeric comparison first
-	bool bIsNumeric = LeftValue.IsNumeric() && RightValue.IsNumeric();
-
-	if (bIsNumeric)
-	{
-		double Left = FCString::Atod(*LeftValue);
-		double Right = FCString::Atod(*RightValue);
-
-		switch (Operator)
-		{
-		case EBehaviacOperatorType::Equal:			bResult = FMath::IsNearlyEqual(Left, Right); break;
-		case EBehaviacOperatorType::NotEqual:		bResult = !FMath::IsNearlyEqual(Left, Right); break;
-		case EBehaviacOperatorType::Greater:			bResult = Left > Right; break;
-		case EBehaviacOperatorType::Less:			bResult = Left < Right; break;
-		case EBehaviacOperatorType::GreaterEqual:	bResult = Left >= Right; break;
-		case EBehaviacOperatorType::LessEqual:		bResult = Left <= Right; break;
-		default: break;
-		}
-	}
-	else
-	{
-		// String comparison
-		int32 Cmp = LeftValue.Compare(RightValue);
-		switch (Operator)
-		{
-		case EBehaviacOperatorType::Equal:			bResult = (Cmp == 0); break;
-		case EBehaviacOperatorType::NotEqual:		bResult = (Cmp != 0); break;
-		case EBehaviacOperatorType::Greater:			bResult = (Cmp > 0); break;
-		case EBehaviacOperatorType::Less:			bResult = (Cmp < 0); break;
-		case EBehaviacOperatorType::GreaterEqual:	bResult = (Cmp >= 0); break;
-		case EBehaviacOperatorType::LessEqual:		bResult = (Cmp <= 0); break;
-		default: break;
-		}
-	}
+	EnsureOperandsResolved();
 
+	const bool bResult = Comparison.Evaluate(Agent);
 	return bNegate ? !bResult : bResult;
 }
 
@@ -176,10 +167,18 @@ void UBehaviacEffector::Apply(UBehaviacAgentComponent* Agent, bool bSuccess) con
 
 	if (bShouldApply && !PropertyName.IsEmpty())
 	{
-		Agent->SetPropertyValue(PropertyName, PropertyValue);
+		EnsureOperandsResolved();
+		Agent->SetBlackboardValue(TargetKey, ResolvedValue);
 	}
 }
 
+void UBehaviacEffector::ResolveOperands()
+{
+	Super::ResolveOperands();
+	TargetKey = FBehaviacBlackboard::MakeKey(PropertyName);
+	ResolvedValue = FBehaviacValue::MakeString(PropertyValue);
+}
+
 // ===================================================================
 // UBehaviacEventAttachment
 // ===================================================================
@@ -188,3 +187,9 @@ UBehaviacEventAttachment::UBehaviacEventAttachment()
 	: bTriggeredOnce(true)
 {
 }
+
+void UBehaviacEventAttachment::ResolveOperands()
+{
+	Super::ResolveOperands();
+	EventId = FBehaviacSignalRegistry::FindOrAdd(EventName);
+}
@@ -3,11 +3,13 @@
 
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/Attachments/BehaviacAttachment.h"
 
 UBehaviacBehaviorNode::UBehaviacBehaviorNode()
 	: NodeId(BEHAVIAC_INVALID_NODE_ID)
 	, bHasEvents(false)
 	, ParentNode(nullptr)
+	, bOperandsResolved(false)
 {
 }
 
@@ -33,13 +35,13 @@ void UBehaviacBehaviorNode::AddChild(UBehaviacBehaviorNode* Child)
 	}
 }
 
-UBehaviacBehaviorTask* UBehaviacBehaviorNode::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacBehaviorNode::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
 	// Base class returns nullptr; subclasses override to create their specific task type
 	return nullptr;
 }
 
-bool UBehaviacBehaviorNode::IsValid(UBehaviacAgentComponent* Agent, UBehaviacBehaviorTask* Task) const
+bool UBehaviacBehaviorNode::IsValid(UBehaviacAgentComponent* Agent, FBehaviacBehaviorTask* Task) const
 {
 	return Agent != nullptr;
 }
@@ -52,3 +54,95 @@ UBehaviacBehaviorNode* UBehaviacBehaviorNode::GetChild(int32 Index) const
 	}
 	return nullptr;
 }
+
+void UBehaviacBehaviorNode::EnsureOperandsResolved()
+{
+	if (!bOperandsResolved)
+	{
+		check(IsInGameThread());
+		bOperandsResolved = true;
+		ResolveOperands();
+	}
+}
+
+void UBehaviacBehaviorNode::EnsureSubtreeOperandsResolved()
+{
+	EnsureOperandsResolved();
+
+	// Attachments edited since the node resolved are stale on their own
+	const TArray<UBehaviacAttachment*>* AttachmentLists[] = { &Preconditions, &Effectors, &Events };
+	for (const TArray<UBehaviacAttachment*>* Attachments : AttachmentLists)
+	{
+		for (UBehaviacAttachment* Attachment : *Attachments)
+		{
+			if (Attachment)
+			{
+				Attachment->EnsureOperandsResolved();
+			}
+		}
+	}
+
+	for (UBehaviacBehaviorNode* Child : Children)
+	{
+		if (Child)
+		{
+			Child->EnsureSubtreeOperandsResolved();
+		}
+	}
+}
+
+bool UBehaviacBehaviorNode::GatherChildrenObservedKeys(FBehaviacObservedKeys& OutKeys) const
+{
+	for (const UBehaviacBehaviorNode* Child : Children)
+	{
+		if (Child && !Child->GatherObservedKeys(OutKeys))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UBehaviacBehaviorNode::GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates)
+{
+	for (UBehaviacAttachment* Precondition : Preconditions)
+	{
+		if (Precondition)
+		{
+			Precondition->GatherPredicates(OutPredicates);
+		}
+	}
+}
+
+void UBehaviacBehaviorNode::ResolveOperands()
+{
+	for (UBehaviacAttachment* Precondition : Preconditions)
+	{
+		if (Precondition)
+		{
+			Precondition->ResolveOperands();
+		}
+	}
+	for (UBehaviacAttachment* Effector : Effectors)
+	{
+		if (Effector)
+		{
+			Effector->ResolveOperands();
+		}
+	}
+	for (UBehaviacAttachment* Event : Events)
+	{
+		if (Event)
+		{
+			Event->ResolveOperands();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UBehaviacBehaviorNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateResolvedOperands();
+}
+#endif
@@ -3,14 +3,77 @@
 
 #include "BehaviorTree/BehaviacBehaviorTask.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
 #include "BehaviorTree/Attachments/BehaviacAttachment.h"
 #include "BehaviacAgent.h"
 
 // ===================================================================
-// UBehaviacBehaviorTask
+// FBehaviacTaskAllocator
 // ===================================================================
 
-UBehaviacBehaviorTask::UBehaviacBehaviorTask()
+FBehaviacTaskAllocator::FBehaviacTaskAllocator(uint8* InState, TArrayView<const FSlot> InLayout, FBehaviacTreeInstance* InDeferTo)
+	: State(InState)
+	, Layout(InLayout)
+	, DeferTo(InDeferTo)
+{
+}
+
+FBehaviacTaskAllocator FBehaviacTaskAllocator::MakeMeasuring()
+{
+	FBehaviacTaskAllocator Allocator;
+	Allocator.bMeasuring = true;
+	return Allocator;
+}
+
+void FBehaviacTaskAllocator::Destroy(FBehaviacBehaviorTask* Task)
+{
+	if (!Task)
+	{
+		return;
+	}
+
+	if (Task->bInStateBlock)
+	{
+		Task->~FBehaviacBehaviorTask();
+	}
+	else
+	{
+		delete Task;
+	}
+}
+
+void* FBehaviacTaskAllocator::AllocateSlot(SIZE_T Size, SIZE_T Alignment)
+{
+	if (bMeasuring)
+	{
+		FSlot& Slot = MeasuredLayout.AddDefaulted_GetRef();
+		Slot.Offset = Align(MeasuredSize, (uint32)Alignment);
+		Slot.Size = (uint32)Size;
+		Slot.Alignment = (uint32)Alignment;
+		MeasuredSize = Slot.Offset + Slot.Size;
+		MeasuredAlignment = FMath::Max(MeasuredAlignment, (uint32)Alignment);
+		return nullptr;
+	}
+
+	if (!State || bMismatch)
+	{
+		return nullptr;
+	}
+
+	if (!Layout.IsValidIndex(NextSlot) || Layout[NextSlot].Size != Size || Layout[NextSlot].Alignment != Alignment)
+	{
+		bMismatch = true;
+		return nullptr;
+	}
+
+	return State + Layout[NextSlot++].Offset;
+}
+
+// ===================================================================
+// FBehaviacBehaviorTask
+// ===================================================================
+
+FBehaviacBehaviorTask::FBehaviacBehaviorTask()
 	: Node(nullptr)
 	, Status(EBehaviacStatus::Invalid)
 	, ParentTask(nullptr)
@@ -18,14 +81,25 @@ UBehaviacBehaviorTask::UBehaviacBehaviorTask()
 {
 }
 
-void UBehaviacBehaviorTask::Init(UBehaviacBehaviorNode* InNode)
+void FBehaviacBehaviorTask::Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator)
 {
 	Node = InNode;
 	Status = EBehaviacStatus::Invalid;
+
+	if (Node)
+	{
+		Node->EnsureOperandsResolved();
+	}
 }
 
-EBehaviacStatus UBehaviacBehaviorTask::Execute(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacBehaviorTask::Execute(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
+	if (bResultPending)
+	{
+		bResultPending = false;
+		return Status;
+	}
+
 	if (!Node || !Node->IsValid(Agent, this))
 	{
 		return EBehaviacStatus::Failure;
@@ -44,6 +118,11 @@ EBehaviacStatus UBehaviacBehaviorTask::Execute(UBehaviacAgentComponent* Agent, E
 
 		bHasEntered = true;
 
+		if (DeferredOwner)
+		{
+			DeferredOwner->BuildChildTasks(this, Agent ? Agent->GetTimeSeconds() : FPlatformTime::Seconds());
+		}
+
 		if (!OnEnter(Agent))
 		{
 			bHasEntered = false;
@@ -77,37 +156,74 @@ EBehaviacStatus UBehaviacBehaviorTask::Execute(UBehaviacAgentComponent* Agent, E
 	return Result;
 }
 
-void UBehaviacBehaviorTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacBehaviorTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Status = EBehaviacStatus::Invalid;
 	bHasEntered = false;
+	bResultPending = false;
 }
 
-void UBehaviacBehaviorTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler)
+void FBehaviacBehaviorTask::Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler)
 {
 	Handler(this);
 }
 
-bool UBehaviacBehaviorTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacBehaviorTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	return false;
+}
+
+bool FBehaviacBehaviorTask::CanSleep() const
+{
+	if (Status != EBehaviacStatus::Running || !bHasEntered)
+	{
+		return false;
+	}
+
+	// Update preconditions are re-evaluated every tick
+	if (Node)
+	{
+		for (const UBehaviacAttachment* Precondition : Node->Preconditions)
+		{
+			if (Precondition && Precondition->AppliesToPhase(EBehaviacPreconditionPhase::Update))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+FBehaviacBehaviorTask* FBehaviacBehaviorTask::ForwardedIfRunning(FBehaviacBehaviorTask* Child) const
+{
+	return CanSleep() && Child && Child->GetStatus() == EBehaviacStatus::Running ? Child : nullptr;
+}
+
+bool FBehaviacBehaviorTask::GetChildWakeCondition(const FBehaviacBehaviorTask* Child, UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	return CanSleep() && Child && Child->GetWakeCondition(Agent, OutCondition);
+}
+
+bool FBehaviacBehaviorTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	return true;
 }
 
-void UBehaviacBehaviorTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacBehaviorTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 }
 
-EBehaviacStatus UBehaviacBehaviorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacBehaviorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return EBehaviacStatus::Success;
 }
 
-EBehaviacStatus UBehaviacBehaviorTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacBehaviorTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return OnUpdate(Agent, ChildStatus);
 }
 
-bool UBehaviacBehaviorTask::CheckPreconditions(UBehaviacAgentComponent* Agent, bool bIsUpdate) const
+bool FBehaviacBehaviorTask::CheckPreconditions(UBehaviacAgentComponent* Agent, bool bIsUpdate) const
 {
 	if (!Node)
 	{
@@ -136,7 +252,7 @@ bool UBehaviacBehaviorTask::CheckPreconditions(UBehaviacAgentComponent* Agent, b
 	return true;
 }
 
-void UBehaviacBehaviorTask::ApplyEffectors(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) const
+void FBehaviacBehaviorTask::ApplyEffectors(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) const
 {
 	if (!Node)
 	{
@@ -156,47 +272,77 @@ void UBehaviacBehaviorTask::ApplyEffectors(UBehaviacAgentComponent* Agent, EBeha
 }
 
 // ===================================================================
-// UBehaviacCompositeTask
+// FBehaviacCompositeTask
 // ===================================================================
 
-UBehaviacCompositeTask::UBehaviacCompositeTask()
+FBehaviacCompositeTask::FBehaviacCompositeTask()
 	: ActiveChildIndex(0)
 {
 }
 
-void UBehaviacCompositeTask::Init(UBehaviacBehaviorNode* InNode)
+FBehaviacCompositeTask::~FBehaviacCompositeTask()
 {
-	Super::Init(InNode);
+	for (FBehaviacBehaviorTask* ChildTask : ChildTasks)
+	{
+		FBehaviacTaskAllocator::Destroy(ChildTask);
+	}
+}
+
+void FBehaviacCompositeTask::Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator)
+{
+	Super::Init(InNode, Allocator);
 	ActiveChildIndex = 0;
+	DestroyChildTasks();
 
-	if (InNode)
+	if (InNode && InNode->GetChildCount() > 0)
 	{
-		ChildTasks.Empty();
-		ChildTasks.Reserve(InNode->GetChildCount());
+		if (FBehaviacTreeInstance* DeferTo = Allocator.GetDeferringInstance())
+		{
+			DeferredOwner = DeferTo;
+		}
+		else
+		{
+			CreateChildTasks(Allocator);
+		}
+	}
+}
+
+void FBehaviacCompositeTask::CreateChildTasks(FBehaviacTaskAllocator& Allocator)
+{
+	ChildTasks.Reset(Node ? Node->GetChildCount() : 0);
 
-		for (int32 i = 0; i < InNode->GetChildCount(); i++)
+	for (int32 i = 0; Node && i < Node->GetChildCount(); i++)
+	{
+		UBehaviacBehaviorNode* ChildNode = Node->GetChild(i);
+		if (ChildNode)
 		{
-			UBehaviacBehaviorNode* ChildNode = InNode->GetChild(i);
-			if (ChildNode)
+			FBehaviacBehaviorTask* ChildTask = ChildNode->CreateTask(Allocator);
+			if (ChildTask)
 			{
-				UBehaviacBehaviorTask* ChildTask = ChildNode->CreateTask(this);
-				if (ChildTask)
-				{
-					ChildTask->Init(ChildNode);
-					ChildTask->SetParentTask(this);
-					ChildTasks.Add(ChildTask);
-				}
+				ChildTask->Init(ChildNode, Allocator);
+				ChildTask->SetParentTask(this);
+				ChildTasks.Add(ChildTask);
 			}
 		}
 	}
 }
 
-void UBehaviacCompositeTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacCompositeTask::DestroyChildTasks()
+{
+	for (FBehaviacBehaviorTask* ChildTask : ChildTasks)
+	{
+		FBehaviacTaskAllocator::Destroy(ChildTask);
+	}
+	ChildTasks.Reset();
+	ActiveChildIndex = 0;
+}
+
+void FBehaviacCompositeTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Super::Reset(Agent);
 	ActiveChildIndex = 0;
 
-	for (UBehaviacBehaviorTask* ChildTask : ChildTasks)
+	for (FBehaviacBehaviorTask* ChildTask : ChildTasks)
 	{
 		if (ChildTask)
 		{
@@ -205,7 +351,7 @@ void UBehaviacCompositeTask::Reset(UBehaviacAgentComponent* Agent)
 	}
 }
 
-void UBehaviacCompositeTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler)
+void FBehaviacCompositeTask::Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler)
 {
 	if (!bChildFirst)
 	{
@@ -215,7 +361,7 @@ void UBehaviacCompositeTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviac
 		}
 	}
 
-	for (UBehaviacBehaviorTask* ChildTask : ChildTasks)
+	for (FBehaviacBehaviorTask* ChildTask : ChildTasks)
 	{
 		if (ChildTask)
 		{
@@ -230,34 +376,58 @@ void UBehaviacCompositeTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviac
 }
 
 // ===================================================================
-// UBehaviacSingleChildTask
+// FBehaviacSingleChildTask
 // ===================================================================
 
-UBehaviacSingleChildTask::UBehaviacSingleChildTask()
+FBehaviacSingleChildTask::FBehaviacSingleChildTask()
 	: ChildTask(nullptr)
 {
 }
 
-void UBehaviacSingleChildTask::Init(UBehaviacBehaviorNode* InNode)
+FBehaviacSingleChildTask::~FBehaviacSingleChildTask()
+{
+	FBehaviacTaskAllocator::Destroy(ChildTask);
+}
+
+void FBehaviacSingleChildTask::Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator)
 {
-	Super::Init(InNode);
+	Super::Init(InNode, Allocator);
+	DestroyChildTasks();
 
 	if (InNode && InNode->GetChildCount() > 0)
 	{
-		UBehaviacBehaviorNode* ChildNode = InNode->GetChild(0);
-		if (ChildNode)
+		if (FBehaviacTreeInstance* DeferTo = Allocator.GetDeferringInstance())
 		{
-			ChildTask = ChildNode->CreateTask(this);
-			if (ChildTask)
-			{
-				ChildTask->Init(ChildNode);
-				ChildTask->SetParentTask(this);
-			}
+			DeferredOwner = DeferTo;
+		}
+		else
+		{
+			CreateChildTasks(Allocator);
 		}
 	}
 }
 
-void UBehaviacSingleChildTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacSingleChildTask::CreateChildTasks(FBehaviacTaskAllocator& Allocator)
+{
+	UBehaviacBehaviorNode* ChildNode = Node ? Node->GetChild(0) : nullptr;
+	if (ChildNode)
+	{
+		ChildTask = ChildNode->CreateTask(Allocator);
+		if (ChildTask)
+		{
+			ChildTask->Init(ChildNode, Allocator);
+			ChildTask->SetParentTask(this);
+		}
+	}
+}
+
+void FBehaviacSingleChildTask::DestroyChildTasks()
+{
+	FBehaviacTaskAllocator::Destroy(ChildTask);
+	ChildTask = nullptr;
+}
+
+void FBehaviacSingleChildTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Super::Reset(Agent);
 	if (ChildTask)
@@ -266,7 +436,7 @@ void UBehaviacSingleChildTask::Reset(UBehaviacAgentComponent* Agent)
 	}
 }
 
-void UBehaviacSingleChildTask::Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler)
+void FBehaviacSingleChildTask::Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler)
 {
 	if (!bChildFirst)
 	{
@@ -287,7 +457,7 @@ void UBehaviacSingleChildTask::Traverse(bool bChildFirst, TFunction<bool(UBehavi
 	}
 }
 
-EBehaviacStatus UBehaviacSingleChildTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacSingleChildTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTask)
 	{
@@ -299,24 +469,33 @@ EBehaviacStatus UBehaviacSingleChildTask::UpdateCurrent(UBehaviacAgentComponent*
 }
 
 // ===================================================================
-// UBehaviacBehaviorTreeTask
+// FBehaviacBehaviorTreeTask
 // ===================================================================
 
-void UBehaviacBehaviorTreeTask::Init(UBehaviacBehaviorNode* InNode)
+void FBehaviacBehaviorTreeTask::Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator)
+{
+	Init(InNode, Allocator, nullptr);
+}
+
+void FBehaviacBehaviorTreeTask::Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator, FBehaviacNativeTreeFactory NativeFactory)
 {
 	// Don't call Super::Init() because SingleChildTask expects InNode to HAVE children
 	// Instead, create a task directly FROM the root node
 	
 	Node = InNode;  // Set our node reference
 	Status = EBehaviacStatus::Invalid;
+	ResumeTask = nullptr;
+	FBehaviacTaskAllocator::Destroy(ChildTask);
+	ChildTask = nullptr;
 	
 	if (InNode)
 	{
-		// Create task from the root node itself (not from its child!)
-		ChildTask = InNode->CreateTask(this);
+		// Create task from the root node itself (not from its child!), or the
+		// generated tree that runs in its place
+		ChildTask = NativeFactory ? NativeFactory(Allocator) : InNode->CreateTask(Allocator);
 		if (ChildTask)
 		{
-			ChildTask->Init(InNode);
+			ChildTask->Init(InNode, Allocator);
 			ChildTask->SetParentTask(this);
 			
 			BEHAVIAC_VLOG(TEXT("[Behaviac] BehaviorTreeTask created ChildTask from node '%s'"), 
@@ -330,22 +509,60 @@ void UBehaviacBehaviorTreeTask::Init(UBehaviacBehaviorNode* InNode)
 	}
 }
 
-EBehaviacStatus UBehaviacBehaviorTreeTask::Tick(UBehaviacAgentComponent* Agent)
+EBehaviacStatus FBehaviacBehaviorTreeTask::Tick(UBehaviacAgentComponent* Agent, bool bResume)
+{
+	FBehaviacBehaviorTask* Task = bResume && ResumeTask ? ResumeTask : this;
+	EBehaviacStatus Result = Task->Execute(Agent, EBehaviacStatus::Invalid);
+
+	// The ancestors skipped this tick only forward to their running child, so
+	// nothing above needs ticking until it finishes; then each parent in turn
+	// gets the result through its usual update and decides what runs next.
+	while (Result != EBehaviacStatus::Running && Task != this && Task->GetParentTask())
+	{
+		FBehaviacBehaviorTask* Finished = Task;
+		Finished->bResultPending = true;
+		Task = Finished->GetParentTask();
+		Result = Task->Execute(Agent, EBehaviacStatus::Invalid);
+		Finished->bResultPending = false;
+	}
+
+	// A task still running below the tree task means the whole chain above it is running
+	ResumeTask = bResume && Result == EBehaviacStatus::Running ? FindResumeTask(Task) : nullptr;
+	return Result;
+}
+
+void FBehaviacBehaviorTreeTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	ResumeTask = nullptr;
+}
+
+FBehaviacBehaviorTask* FBehaviacBehaviorTreeTask::FindResumeTask(FBehaviacBehaviorTask* From)
+{
+	FBehaviacBehaviorTask* Task = From;
+	while (FBehaviacBehaviorTask* Child = Task->GetForwardedChild())
+	{
+		Task = Child;
+	}
+	return Task;
+}
+
+bool FBehaviacBehaviorTreeTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
 {
-	return Execute(Agent, EBehaviacStatus::Invalid);
+	return GetChildWakeCondition(ChildTask, Agent, OutCondition);
 }
 
-bool UBehaviacBehaviorTreeTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacBehaviorTreeTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	return true;
 }
 
-void UBehaviacBehaviorTreeTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacBehaviorTreeTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 	Super::OnExit(Agent, InStatus);
 }
 
-EBehaviacStatus UBehaviacBehaviorTreeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacBehaviorTreeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTask)
 	{
@@ -3,262 +3,311 @@
 
 #include "BehaviorTree/BehaviacBehaviorTree.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
-#include "BehaviorTree/Composites/BehaviacComposites.h"
-#include "BehaviorTree/Actions/BehaviacActions.h"
-#include "BehaviorTree/Conditions/BehaviacConditions.h"
-#include "BehaviorTree/Decorators/BehaviacDecorators.h"
-#include "BehaviorTree/Attachments/BehaviacAttachment.h"
-#include "FSM/BehaviacFSM.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+#include "BehaviorTree/BehaviacTreeAsyncLoader.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+#include "BehaviorTree/BehaviacTreeOptimizer.h"
+#include "BehaviorTree/BehaviacXmlReader.h"
+#include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
-#include "XmlFile.h"
 
 UBehaviacBehaviorTree::UBehaviacBehaviorTree()
 	: RootNode(nullptr)
 	, Version(0)
+	, bInstantiateBranchesLazily(false)
+	, IdleBranchReclaimTime(0.f)
+	, bUseNativeTree(true)
+	, bRunFlatProgram(false)
+	, bOptimizeOnLoad(true)
 {
 }
 
-// Forward declaration for recursive parsing
-static UBehaviacBehaviorNode* ParseNodeFromXML(const FXmlNode* XmlNode, UObject* Outer);
-
-/** Map a class name to a node UClass */
-static UBehaviacBehaviorNode* CreateNodeByClassName(const FString& ClassName, UObject* Outer)
-{
-	// Composites
-	if (ClassName == TEXT("Selector"))			return NewObject<UBehaviacSelector>(Outer);
-	if (ClassName == TEXT("Sequence"))			return NewObject<UBehaviacSequence>(Outer);
-	if (ClassName == TEXT("Parallel"))			return NewObject<UBehaviacParallel>(Outer);
-	if (ClassName == TEXT("IfElse"))				return NewObject<UBehaviacIfElse>(Outer);
-	if (ClassName == TEXT("SelectorLoop"))		return NewObject<UBehaviacSelectorLoop>(Outer);
-	if (ClassName == TEXT("SelectorProbability")) return NewObject<UBehaviacSelectorProbability>(Outer);
-	if (ClassName == TEXT("SelectorStochastic"))	return NewObject<UBehaviacSelectorStochastic>(Outer);
-	if (ClassName == TEXT("SequenceStochastic"))	return NewObject<UBehaviacSequenceStochastic>(Outer);
-	if (ClassName == TEXT("ReferencedBehavior"))	return NewObject<UBehaviacReferenceBehavior>(Outer);
-	if (ClassName == TEXT("WithPrecondition"))	return NewObject<UBehaviacWithPrecondition>(Outer);
-
-	// Actions
-	if (ClassName == TEXT("Action"))				return NewObject<UBehaviacAction>(Outer);
-	if (ClassName == TEXT("Assignment"))			return NewObject<UBehaviacAssignment>(Outer);
-	if (ClassName == TEXT("Compute"))			return NewObject<UBehaviacCompute>(Outer);
-	if (ClassName == TEXT("Noop"))				return NewObject<UBehaviacNoop>(Outer);
-	if (ClassName == TEXT("End"))				return NewObject<UBehaviacEnd>(Outer);
-	if (ClassName == TEXT("Wait"))				return NewObject<UBehaviacWait>(Outer);
-	if (ClassName == TEXT("WaitFrames"))			return NewObject<UBehaviacWaitFrames>(Outer);
-	if (ClassName == TEXT("WaitforSignal"))		return NewObject<UBehaviacWaitForSignal>(Outer);
-
-	// Conditions
-	if (ClassName == TEXT("Condition"))			return NewObject<UBehaviacCondition>(Outer);
-	if (ClassName == TEXT("And"))				return NewObject<UBehaviacAnd>(Outer);
-	if (ClassName == TEXT("Or"))					return NewObject<UBehaviacOr>(Outer);
-	if (ClassName == TEXT("True"))				return NewObject<UBehaviacTrue>(Outer);
-	if (ClassName == TEXT("False"))				return NewObject<UBehaviacFalse>(Outer);
-
-	// Decorators
-	if (ClassName == TEXT("DecoratorAlwaysFailure"))		return NewObject<UBehaviacDecoratorAlwaysFailure>(Outer);
-	if (ClassName == TEXT("DecoratorAlwaysRunning"))		return NewObject<UBehaviacDecoratorAlwaysRunning>(Outer);
-	if (ClassName == TEXT("DecoratorAlwaysSuccess"))		return NewObject<UBehaviacDecoratorAlwaysSuccess>(Outer);
-	if (ClassName == TEXT("DecoratorNot"))				return NewObject<UBehaviacDecoratorNot>(Outer);
-	if (ClassName == TEXT("DecoratorLoop"))				return NewObject<UBehaviacDecoratorLoop>(Outer);
-	if (ClassName == TEXT("DecoratorLoopUntil"))			return NewObject<UBehaviacDecoratorLoopUntil>(Outer);
-	if (ClassName == TEXT("DecoratorRepeat"))			return NewObject<UBehaviacDecoratorRepeat>(Outer);
-	if (ClassName == TEXT("DecoratorCount"))				return NewObject<UBehaviacDecoratorCount>(Outer);
-	if (ClassName == TEXT("DecoratorCountLimit"))		return NewObject<UBehaviacDecoratorCountLimit>(Outer);
-	if (ClassName == TEXT("DecoratorTime"))				return NewObject<UBehaviacDecoratorTime>(Outer);
-	if (ClassName == TEXT("DecoratorFrames"))			return NewObject<UBehaviacDecoratorFrames>(Outer);
-	if (ClassName == TEXT("DecoratorFailureUntil"))		return NewObject<UBehaviacDecoratorFailureUntil>(Outer);
-	if (ClassName == TEXT("DecoratorSuccessUntil"))		return NewObject<UBehaviacDecoratorSuccessUntil>(Outer);
-	if (ClassName == TEXT("DecoratorIterator"))			return NewObject<UBehaviacDecoratorIterator>(Outer);
-	if (ClassName == TEXT("DecoratorLog"))				return NewObject<UBehaviacDecoratorLog>(Outer);
-	if (ClassName == TEXT("DecoratorWeight"))			return NewObject<UBehaviacDecoratorWeight>(Outer);
-
-	// FSM
-	if (ClassName == TEXT("FSM"))				return NewObject<UBehaviacFSMNode>(Outer);
-
-	UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Unknown node class: %s"), *ClassName);
-	return nullptr;
-}
-
-static UBehaviacBehaviorNode* ParseNodeFromXML(const FXmlNode* XmlNode, UObject* Outer)
+namespace
 {
-	if (!XmlNode)
+	/**
+	 * Builds nodes straight from an FBehaviacXmlReader. Property arrays are
+	 * kept per depth and reused from node to node.
+	 */
+	class FBehaviacXmlTreeBuilder
 	{
-		return nullptr;
-	}
+	public:
+		FBehaviacXmlTreeBuilder(FBehaviacXmlReader& InReader, UObject* InOuter)
+			: Reader(InReader)
+			, Outer(InOuter)
+		{
+		}
 
-	FString ClassName = XmlNode->GetAttribute(TEXT("class"));
-	if (ClassName.IsEmpty())
-	{
-		ClassName = XmlNode->GetTag();
-	}
+		/**
+		 * Build the node the reader just started (a <node> or <custom>), through
+		 * its end tag. OutNode is nullptr for an unknown class, whose element is
+		 * skipped. Returns false on a syntax error.
+		 */
+		bool ReadNode(int32 Depth, UBehaviacBehaviorNode*& OutNode)
+		{
+			OutNode = nullptr;
 
-	// Strip namespace prefix (e.g., "behaviac::Selector" -> "Selector")
-	int32 LastColonIdx;
-	if (ClassName.FindLastChar(TEXT(':'), LastColonIdx))
-	{
-		ClassName = ClassName.Mid(LastColonIdx + 1);
-	}
+			FStringView ClassView;
+			if (!Reader.FindAttribute(TEXT("class"), ClassView))
+			{
+				ClassView = Reader.GetName();
+			}
 
-	UBehaviacBehaviorNode* BehaviorNode = CreateNodeByClassName(ClassName, Outer);
-	if (!BehaviorNode)
-	{
-		return nullptr;
-	}
+			// Strip namespace prefix (e.g., "behaviac::Selector" -> "Selector")
+			int32 LastColonIdx;
+			if (ClassView.FindLastChar(TEXT(':'), LastColonIdx))
+			{
+				ClassView.RightChopInline(LastColonIdx + 1);
+			}
 
-	BehaviorNode->NodeClassName = ClassName;
+			UBehaviacBehaviorNode* BehaviorNode = FBehaviacNodeRegistry::Get().CreateNode(ClassView, Outer);
+			if (!BehaviorNode)
+			{
+				return Reader.SkipElement();
+			}
+			BehaviorNode->NodeClassName = FString(ClassView);
 
-	// Parse properties
-	TArray<FBehaviacProperty> Properties;
-	for (const FXmlNode* PropNode : XmlNode->GetChildrenNodes())
-	{
-		if (PropNode->GetTag() == TEXT("property"))
-		{
-			Properties.Add(FBehaviacProperty(
-				PropNode->GetAttribute(TEXT("name")),
-				PropNode->GetAttribute(TEXT("value"))
-			));
-		}
-	}
+			const FString IdAttr = Reader.GetAttribute(TEXT("id"));
+			GetProperties(Depth).Reset();
 
-	// Also parse inline attributes as properties
-	FString IdAttr = XmlNode->GetAttribute(TEXT("id"));
-	if (!IdAttr.IsEmpty())
-	{
-		Properties.Add(FBehaviacProperty(TEXT("Id"), IdAttr));
-	}
+			for (;;)
+			{
+				const EBehaviacXmlToken Token = Reader.Next();
+				if (Token == EBehaviacXmlToken::EndElement)
+				{
+					break;
+				}
+				if (Token != EBehaviacXmlToken::StartElement)
+				{
+					return false;
+				}
 
-	BehaviorNode->LoadFromProperties(0, TEXT(""), Properties);
+				const FStringView Tag = Reader.GetName();
+				bool bOk = true;
+				if (Tag == TEXT("property"))
+				{
+					bOk = ReadProperty(GetProperties(Depth));
+				}
+				else if (Tag == TEXT("node") || Tag == TEXT("custom"))
+				{
+					UBehaviacBehaviorNode* ChildNode = nullptr;
+					bOk = ReadNode(Depth + 1, ChildNode);
+					if (ChildNode)
+					{
+						BehaviorNode->AddChild(ChildNode);
+					}
+				}
+				else if (Tag == TEXT("attachment"))
+				{
+					bOk = ReadAttachment(Depth + 1, BehaviorNode);
+				}
+				else
+				{
+					bOk = Reader.SkipElement();
+				}
 
-	// Parse child nodes
-	for (const FXmlNode* ChildXml : XmlNode->GetChildrenNodes())
-	{
-		if (ChildXml->GetTag() == TEXT("node") || ChildXml->GetTag() == TEXT("custom"))
-		{
-			UBehaviacBehaviorNode* ChildNode = ParseNodeFromXML(ChildXml, Outer);
-			if (ChildNode)
+				if (!bOk)
+				{
+					return false;
+				}
+			}
+
+			// Also parse inline attributes as properties
+			TArray<FBehaviacProperty>& Properties = GetProperties(Depth);
+			if (!IdAttr.IsEmpty())
 			{
-				BehaviorNode->AddChild(ChildNode);
+				Properties.Emplace(TEXT("Id"), IdAttr);
 			}
+
+			BehaviorNode->LoadFromProperties(0, TEXT(""), Properties);
+
+			// Resolve operands once here so the first tick does no string work
+			BehaviorNode->EnsureOperandsResolved();
+
+			OutNode = BehaviorNode;
+			return true;
 		}
-		else if (ChildXml->GetTag() == TEXT("attachment"))
+
+	private:
+		/** Add the <property> the reader just started to Properties */
+		bool ReadProperty(TArray<FBehaviacProperty>& Properties)
 		{
-			FString AttachClass = ChildXml->GetAttribute(TEXT("class"));
+			Properties.Emplace(Reader.GetAttribute(TEXT("name")), Reader.GetAttribute(TEXT("value")));
+			return Reader.SkipElement();
+		}
+
+		/** Build the <attachment> the reader just started onto BehaviorNode */
+		bool ReadAttachment(int32 Depth, UBehaviacBehaviorNode* BehaviorNode)
+		{
+			const FString AttachClass = Reader.GetAttribute(TEXT("class"));
 
 			// Parse attachment properties
-			TArray<FBehaviacProperty> AttachProps;
-			for (const FXmlNode* AttachPropNode : ChildXml->GetChildrenNodes())
+			GetProperties(Depth).Reset();
+			for (;;)
 			{
-				if (AttachPropNode->GetTag() == TEXT("property"))
+				const EBehaviacXmlToken Token = Reader.Next();
+				if (Token == EBehaviacXmlToken::EndElement)
+				{
+					break;
+				}
+				if (Token != EBehaviacXmlToken::StartElement)
 				{
-					AttachProps.Add(FBehaviacProperty(
-						AttachPropNode->GetAttribute(TEXT("name")),
-						AttachPropNode->GetAttribute(TEXT("value"))
-					));
+					return false;
+				}
+				const bool bOk = Reader.GetName() == TEXT("property")
+					? ReadProperty(GetProperties(Depth))
+					: Reader.SkipElement();
+				if (!bOk)
+				{
+					return false;
 				}
 			}
+			FBehaviacNodeRegistry::Get().AddAttachment(BehaviorNode, AttachClass, GetProperties(Depth));
+			return true;
+		}
 
-			// Create appropriate attachment
-			UBehaviacAttachment* Attachment = nullptr;
-
-			if (AttachClass.Contains(TEXT("Precondition")))
-			{
-				UBehaviacPrecondition* Precond = NewObject<UBehaviacPrecondition>(BehaviorNode);
-				Precond->LoadFromProperties(0, TEXT(""), AttachProps);
-				BehaviorNode->Preconditions.Add(Precond);
-			}
-			else if (AttachClass.Contains(TEXT("Effector")))
-			{
-				UBehaviacEffector* Eff = NewObject<UBehaviacEffector>(BehaviorNode);
-				Eff->LoadFromProperties(0, TEXT(""), AttachProps);
-				BehaviorNode->Effectors.Add(Eff);
-			}
-			else if (AttachClass.Contains(TEXT("Event")))
+		/** Property array for a node at Depth. Only valid until a deeper one is asked for. */
+		TArray<FBehaviacProperty>& GetProperties(int32 Depth)
+		{
+			while (ScratchProperties.Num() <= Depth)
 			{
-				UBehaviacEventAttachment* Evt = NewObject<UBehaviacEventAttachment>(BehaviorNode);
-				Evt->LoadFromProperties(0, TEXT(""), AttachProps);
-				BehaviorNode->Events.Add(Evt);
+				ScratchProperties.AddDefaulted();
 			}
+			return ScratchProperties[Depth];
 		}
-	}
 
-	return BehaviorNode;
-}
+		FBehaviacXmlReader& Reader;
+		UObject* Outer;
+		TArray<TArray<FBehaviacProperty>> ScratchProperties;
+	};
 
-bool UBehaviacBehaviorTree::LoadFromXML(const FString& XMLContent)
-{
-	// FXmlFile's ConstructFromBuffer splits on newlines before stripping <?xml?>.
-	// If the entire XML is on one line, the prolog removal blanks the whole string.
-	// Fix: strip the XML declaration ourselves and add a newline after every '>'.
-	FString Sanitized = XMLContent;
-	// Remove the <?xml ... ?> prolog (handles both single-line and multi-line)
+	/**
+	 * Build the compiled node at Index and its subtree. Returns nullptr for an
+	 * unknown class, whose subtree is skipped as LoadFromXML skips its element.
+	 */
+	UBehaviacBehaviorNode* BuildCompiledNode(const FBehaviacTreeBinaryView& View, int32 Index, UObject* Outer, TArray<FBehaviacProperty>& Scratch)
 	{
-		int32 PrologStart = Sanitized.Find(TEXT("<?xml"), ESearchCase::IgnoreCase);
-		if (PrologStart != INDEX_NONE)
+		const FBehaviacTreeBinary::FNodeRecord& Record = View.GetNodes()[Index];
+		const FString ClassName = View.GetString(Record.ClassName);
+		UBehaviacBehaviorNode* BehaviorNode = FBehaviacNodeRegistry::Get().CreateNode(ClassName, Outer);
+		if (!BehaviorNode)
 		{
-			int32 PrologEnd = Sanitized.Find(TEXT("?>"), ESearchCase::CaseSensitive, ESearchDir::FromStart, PrologStart);
-			if (PrologEnd != INDEX_NONE)
+			return nullptr;
+		}
+		BehaviorNode->NodeClassName = ClassName;
+
+		// Children are the consecutive subtrees after this node
+		for (int32 Child = Index + 1; Child < Index + Record.SubtreeSize; Child += View.GetNodes()[Child].SubtreeSize)
+		{
+			if (UBehaviacBehaviorNode* ChildNode = BuildCompiledNode(View, Child, Outer, Scratch))
 			{
-				Sanitized.RemoveAt(PrologStart, (PrologEnd + 2) - PrologStart);
+				BehaviorNode->AddChild(ChildNode);
 			}
 		}
-	}
-	// Ensure each tag ends with a newline so FXmlFile can parse line-by-line
-	Sanitized = Sanitized.Replace(TEXT(">"), TEXT(">\n"));
 
-	FXmlFile XmlFile(Sanitized, EConstructMethod::ConstructFromBuffer);
+		for (const FBehaviacTreeBinary::FAttachmentRecord& Attachment : View.GetAttachments().Slice(Record.FirstAttachment, Record.NumAttachments))
+		{
+			Scratch.Reset();
+			View.GetProperties(Attachment.FirstProperty, Attachment.NumProperties, Scratch);
+			FBehaviacNodeRegistry::Get().AddAttachment(BehaviorNode, View.GetString(Attachment.ClassName), Scratch);
+		}
 
-	if (!XmlFile.IsValid())
-	{
-		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content"));
-		return false;
+		Scratch.Reset();
+		View.GetProperties(Record.FirstProperty, Record.NumProperties, Scratch);
+		BehaviorNode->LoadFromProperties(0, TEXT(""), Scratch);
+		BehaviorNode->EnsureOperandsResolved();
+		return BehaviorNode;
 	}
+}
 
-	const FXmlNode* Root = XmlFile.GetRootNode();
-	if (!Root)
+bool UBehaviacBehaviorTree::LoadFromXML(FStringView XMLContent)
+{
+	FBehaviacXmlReader Reader(XMLContent);
+
+	// The root element (<behavior>) carries the version and agent type
+	if (Reader.Next() != EBehaviacXmlToken::StartElement)
 	{
-		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] XML has no root node"));
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content, %s"), *Reader.GetErrorMessage());
 		return false;
 	}
 
 	// Parse version
-	FString VersionStr = Root->GetAttribute(TEXT("version"));
-	if (!VersionStr.IsEmpty())
+	FStringView VersionStr;
+	if (Reader.FindAttribute(TEXT("version"), VersionStr) && !VersionStr.IsEmpty())
 	{
-		Version = FCString::Atoi(*VersionStr);
+		Version = FCString::Atoi(*FString(VersionStr));
 	}
 
 	// Parse agent type
-	AgentType = Root->GetAttribute(TEXT("agenttype"));
+	AgentType = Reader.GetAttribute(TEXT("agenttype"));
+
+	InvalidateCompiledTree();
 
-	// Find the first node element
-	const FXmlNode* FirstNode = Root->FindChildNode(TEXT("node"));
-	if (!FirstNode)
+	// The first child that is a <node> (or names a class) is the root node; the rest is skipped
+	FBehaviacXmlTreeBuilder Builder(Reader, this);
+	bool bFoundNode = false;
+	for (;;)
 	{
-		// Try direct children
-		for (const FXmlNode* Child : Root->GetChildrenNodes())
+		const EBehaviacXmlToken Token = Reader.Next();
+		if (Token == EBehaviacXmlToken::EndElement)
 		{
-			if (Child->GetAttribute(TEXT("class")).Len() > 0)
+			break;
+		}
+		if (Token != EBehaviacXmlToken::StartElement)
+		{
+			UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content, %s"), *Reader.GetErrorMessage());
+			return false;
+		}
+
+		FStringView ClassAttr;
+		const bool bIsNode = Reader.GetName() == TEXT("node")
+			|| (Reader.FindAttribute(TEXT("class"), ClassAttr) && !ClassAttr.IsEmpty());
+		if (bFoundNode || !bIsNode)
+		{
+			if (!Reader.SkipElement())
 			{
-				FirstNode = Child;
-				break;
+				UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content, %s"), *Reader.GetErrorMessage());
+				return false;
 			}
+			continue;
 		}
-	}
 
-	if (FirstNode)
-	{
-		RootNode = ParseNodeFromXML(FirstNode, this);
-		
+		bFoundNode = true;
+		UBehaviacBehaviorNode* ParsedRoot = nullptr;
+		if (!Builder.ReadNode(1, ParsedRoot))
+		{
+			UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content, %s"), *Reader.GetErrorMessage());
+			return false;
+		}
+		RootNode = ParsedRoot;
+
 		if (RootNode)
 		{
 			BEHAVIAC_VLOG(TEXT("[Behaviac] XML parsed! RootNode=%s, ChildCount=%d"), 
 				*RootNode->GetName(), RootNode->GetChildCount());
+
+			if (bOptimizeOnLoad && CVarBehaviacOptimizeTrees.GetValueOnAnyThread() != 0)
+			{
+				Optimize();
+			}
 		}
 		else
 		{
-			UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] ParseNodeFromXML returned NULL!"));
+			UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Root node of the XML could not be created!"));
 		}
 	}
-	else
+
+	// Only comments and the like may follow the root element
+	if (Reader.Next() != EBehaviacXmlToken::EndOfDocument)
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to parse XML content, %s"), *Reader.GetErrorMessage());
+		RootNode = nullptr;
+		return false;
+	}
+
+	if (!bFoundNode)
 	{
 		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] No <node> element found in XML!"));
 	}
@@ -266,29 +315,235 @@ bool UBehaviacBehaviorTree::LoadFromXML(const FString& XMLContent)
 	return RootNode != nullptr;
 }
 
+bool UBehaviacBehaviorTree::LoadFromBinary(TConstArrayView<uint8> Data)
+{
+	FBehaviacTreeBinaryView View;
+	FString Error;
+	if (!View.Initialize(Data, Error))
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Failed to load compiled tree, %s"), *Error);
+		return false;
+	}
+
+	Version = View.GetHeader().TreeVersion;
+	AgentType = View.GetString(View.GetHeader().AgentType);
+	InvalidateCompiledTree();
+
+	TArray<FBehaviacProperty> Scratch;
+	RootNode = BuildCompiledNode(View, 0, this, Scratch);
+	if (!RootNode)
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Root node of the compiled tree could not be created!"));
+		return false;
+	}
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Compiled tree loaded! RootNode=%s, ChildCount=%d"),
+		*RootNode->GetName(), RootNode->GetChildCount());
+
+	if (bOptimizeOnLoad && CVarBehaviacOptimizeTrees.GetValueOnAnyThread() != 0)
+	{
+		Optimize();
+	}
+	return true;
+}
+
+bool UBehaviacBehaviorTree::CookFromFile(const FString& FilePath)
+{
+	FString FileContent;
+	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *FilePath);
+		return false;
+	}
+
+	// Parse, resolve operands and optimize
+	if (!LoadFromXML(FileContent))
+	{
+		return false;
+	}
+
+	// Lay out the tasks, so a tree the compiler cannot run fails the import rather than the first spawn
+	const TSharedPtr<const FBehaviacCompiledTree> Program = GetCompiledTree();
+	if (!Program.IsValid())
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Tree from %s could not be compiled"), *FilePath);
+		return false;
+	}
+
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*FilePath);
+	SourceFilePath = FilePath;
+	CookInfo.PipelineVersion = CookPipelineVersion;
+	CookInfo.SourceHash = FCrc::StrCrc32(*FileContent);
+	CookInfo.SourceTimeStamp = Stat.ModificationTime;
+	CookInfo.SourceFileSize = Stat.FileSize;
+	CheckedSourceFileSize = -1;
+	CookInfo.NumNodes = Program->GetNodes().Num() - 1;
+	CookInfo.StateSize = (int32)Program->GetStateSize();
+	CookInfo.NumSharedPredicates = Program->GetNumSharedPredicates();
+
+	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Cooked tree %s: %d nodes, %d bytes of state per agent, %d shared conditions"),
+		*(TreeName.IsEmpty() ? GetName() : TreeName), CookInfo.NumNodes, CookInfo.StateSize, CookInfo.NumSharedPredicates);
+	return true;
+}
+
+bool UBehaviacBehaviorTree::IsCookedFromCurrentSource() const
+{
+#if UE_BUILD_SHIPPING
+	// Source XML is not packaged and cannot be parsed; the saved nodes, cooked or
+	// imported before cooking existed, are all there is
+	return RootNode != nullptr;
+#else
+	if (CookInfo.PipelineVersion != CookPipelineVersion || !RootNode)
+	{
+		return false;
+	}
+	if (SourceFilePath.IsEmpty())
+	{
+		return true;
+	}
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*SourceFilePath);
+	if (!Stat.bIsValid || (Stat.ModificationTime == CookInfo.SourceTimeStamp && Stat.FileSize == CookInfo.SourceFileSize))
+	{
+		return true;
+	}
+
+	// Touched but not edited still matches; read the file once per stamp, not on every spawn
+	if (Stat.ModificationTime != CheckedSourceTimeStamp || Stat.FileSize != CheckedSourceFileSize)
+	{
+		FString FileContent;
+		bCheckedSourceMatches = FFileHelper::LoadFileToString(FileContent, *SourceFilePath) && FCrc::StrCrc32(*FileContent) == CookInfo.SourceHash;
+		CheckedSourceTimeStamp = Stat.ModificationTime;
+		CheckedSourceFileSize = Stat.FileSize;
+	}
+	return bCheckedSourceMatches;
+#endif
+}
+
+FBehaviacTreeOptimizerStats UBehaviacBehaviorTree::Optimize()
+{
+	OptimizerStats = FBehaviacTreeOptimizerStats();
+	if (RootNode)
+	{
+		RootNode = FBehaviacTreeOptimizer::Optimize(RootNode, this, OptimizerStats);
+		InvalidateCompiledTree();
+
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Optimized tree %s: %d -> %d nodes (%d folded, %d pruned, %d collapsed, %d fused)"),
+			*(TreeName.IsEmpty() ? GetName() : TreeName), OptimizerStats.NodesBefore, OptimizerStats.NodesAfter,
+			OptimizerStats.ConstantsFolded, OptimizerStats.NodesPruned, OptimizerStats.NodesCollapsed, OptimizerStats.NodesFused);
+	}
+	return OptimizerStats;
+}
+
+TSharedPtr<const FBehaviacCompiledTree> UBehaviacBehaviorTree::GetCompiledTree()
+{
+	if (!CompiledTree.IsValid() || CompiledTree->GetRootNode() != RootNode)
+	{
+		// Resolve everything up front, so running the program (in parallel too) only reads the nodes
+		check(IsInGameThread());
+		if (RootNode)
+		{
+			RootNode->EnsureSubtreeOperandsResolved();
+		}
+		CompiledTree = FBehaviacCompiledTree::Compile(RootNode, FBehaviacNativeTreeRegistry::FindFor(this), bRunFlatProgram);
+	}
+	return CompiledTree;
+}
+
+void UBehaviacBehaviorTree::ReserveAgentStates(int32 NumAgents)
+{
+	if (TSharedPtr<const FBehaviacCompiledTree> Program = GetCompiledTree())
+	{
+		Program->GetTaskPool().Reserve(Program->GetSlabSize(bInstantiateBranchesLazily), NumAgents);
+	}
+}
+
+void UBehaviacBehaviorTree::TrimStatePool()
+{
+	if (CompiledTree.IsValid())
+	{
+		CompiledTree->GetTaskPool().Trim();
+	}
+}
+
+FBehaviacTreePoolStats UBehaviacBehaviorTree::GetStatePoolStats()
+{
+	FBehaviacTreePoolStats Stats;
+	if (TSharedPtr<const FBehaviacCompiledTree> Program = GetCompiledTree())
+	{
+		const uint32 SlabSize = Program->GetSlabSize(bInstantiateBranchesLazily);
+		const FBehaviacTaskPool::FStats Slabs = Program->GetTaskPool().GetStats(SlabSize);
+		const FBehaviacTaskPool::FStats All = Program->GetTaskPool().GetStats();
+		Stats.SlabSize = (int32)SlabSize;
+		Stats.SlabsInUse = Slabs.NumInUse;
+		Stats.SlabsFree = Slabs.NumPooled;
+		Stats.SlabsHighWater = Slabs.HighWater;
+		Stats.BytesInUse = (int32)All.BytesInUse;
+		Stats.BytesPooled = (int32)All.BytesPooled;
+		Stats.HighWaterBytes = (int32)All.HighWaterBytes;
+	}
+	return Stats;
+}
+
+#if WITH_EDITOR
+void UBehaviacBehaviorTree::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateCompiledTree();
+}
+#endif
+
 // ===================================================================
 // Blueprint Function Library
 // ===================================================================
 
 UBehaviacBehaviorTree* UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(UObject* WorldContext, const FString& FilePath)
 {
+	// A compiled sibling, when up to date, skips the XML entirely
+	const FString File = FBehaviacTreeBinary::ChooseFile(FilePath);
+
+	if (CVarBehaviacTreeFileCache.GetValueOnAnyThread() != 0 && IsInGameThread())
+	{
+		return FBehaviacTreeFileCache::Get().Load(File);
+	}
+
+	if (FBehaviacTreeBinary::GetFileFormat(File) == EBehaviacFileFormat::BSON)
+	{
+		return FBehaviacTreeBinary::LoadFile(File);
+	}
+
 	FString FileContent;
 
-	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	if (!FFileHelper::LoadFileToString(FileContent, *File))
 	{
-		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *FilePath);
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *File);
 		return nullptr;
 	}
 
-	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
-	Tree->SourceFilePath = FilePath;
-	Tree->TreeName = FPaths::GetBaseFilename(FilePath);
+	return FBehaviacTreeFileCache::Parse(File, FileContent);
+}
 
-	if (Tree->LoadFromXML(FileContent))
+void UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFileAsync(const FString& FilePath, FBehaviacOnTreeLoaded OnLoaded)
+{
+	FBehaviacTreeAsyncLoader::Get().LoadFile(FilePath, FBehaviacTreeLoadedDelegate::CreateLambda([OnLoaded](UBehaviacBehaviorTree* Tree)
 	{
-		return Tree;
-	}
+		OnLoaded.ExecuteIfBound(Tree);
+	}));
+}
+
+void UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeAssetAsync(TSoftObjectPtr<UBehaviacBehaviorTree> TreeAsset, FBehaviacOnTreeLoaded OnLoaded)
+{
+	FBehaviacTreeAsyncLoader::Get().LoadAsset(TreeAsset.ToSoftObjectPath(), FBehaviacTreeLoadedDelegate::CreateLambda([OnLoaded](UBehaviacBehaviorTree* Tree)
+	{
+		OnLoaded.ExecuteIfBound(Tree);
+	}));
+}
+
+FBehaviacTreeFileCacheStats UBehaviacBehaviorTreeLibrary::GetTreeFileCacheStats()
+{
+	return FBehaviacTreeFileCache::Get().GetStats();
+}
 
-	UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to parse behavior tree from file: %s"), *FilePath);
-	return nullptr;
+void UBehaviacBehaviorTreeLibrary::FlushTreeFileCache()
+{
+	FBehaviacTreeFileCache::Get().InvalidateAll();
 }
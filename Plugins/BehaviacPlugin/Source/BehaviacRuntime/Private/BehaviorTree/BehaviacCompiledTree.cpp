@@ -0,0 +1,713 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacCompiledTree.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacOperand.h"
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviorTree/Composites/BehaviacComposites.h"
+#include "BehaviorTree/Actions/BehaviacActions.h"
+#include "BehaviorTree/Conditions/BehaviacConditions.h"
+#include "BehaviorTree/Decorators/BehaviacDecorators.h"
+#include "BehaviacTypes.h"
+
+namespace
+{
+	/** Flat op of Node, by exact class; None for nodes with attachments or no flat form */
+	EBehaviacFlatOp GetFlatOp(const UBehaviacBehaviorNode* Node)
+	{
+		if (!Node || Node->HasAttachments())
+		{
+			return EBehaviacFlatOp::None;
+		}
+
+		const UClass* Class = Node->GetClass();
+		if (Class == UBehaviacSequence::StaticClass())				return EBehaviacFlatOp::Sequence;
+		if (Class == UBehaviacSelector::StaticClass())				return EBehaviacFlatOp::Selector;
+		if (Class == UBehaviacDecoratorAlwaysSuccess::StaticClass())	return EBehaviacFlatOp::AlwaysSuccess;
+		if (Class == UBehaviacDecoratorAlwaysFailure::StaticClass())	return EBehaviacFlatOp::AlwaysFailure;
+		if (Class == UBehaviacDecoratorNot::StaticClass())			return EBehaviacFlatOp::Not;
+		if (Class == UBehaviacDecoratorLoop::StaticClass())			return EBehaviacFlatOp::Loop;
+		if (Class == UBehaviacAction::StaticClass())				return EBehaviacFlatOp::Action;
+		if (Class == UBehaviacGuardedAction::StaticClass())			return EBehaviacFlatOp::GuardedAction;
+		if (Class == UBehaviacCondition::StaticClass())				return EBehaviacFlatOp::Condition;
+		if (Class == UBehaviacWait::StaticClass())					return EBehaviacFlatOp::Wait;
+		if (Class == UBehaviacNoop::StaticClass() || Class == UBehaviacTrue::StaticClass())	return EBehaviacFlatOp::Succeed;
+		if (Class == UBehaviacFalse::StaticClass())					return EBehaviacFlatOp::Fail;
+		return EBehaviacFlatOp::None;
+	}
+
+	/**
+	 * Runs a flat program: stands in for the root node's task and walks the
+	 * entries below it with a switch on their op, keeping each entry's state in
+	 * the agent's state block. Nodes behave as in generated trees.
+	 */
+	class FBehaviacFlatTreeTask final : public FBehaviacNativeTreeTask
+	{
+	public:
+		static FBehaviacBehaviorTask* Make(FBehaviacTaskAllocator& Allocator)
+		{
+			return Allocator.New<FBehaviacFlatTreeTask>();
+		}
+
+		/** Run InProgram with the entry states at InStates, one per entry */
+		void Bind(const FBehaviacCompiledTree& InProgram, FBehaviacFlatNodeState* InStates)
+		{
+			Program = &InProgram;
+			States = InStates;
+			for (int32 Index = 0; Index < Program->GetNodes().Num(); ++Index)
+			{
+				new (&States[Index]) FBehaviacFlatNodeState();
+			}
+		}
+
+		virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override
+		{
+			if (!Program || !CanSleep())
+			{
+				return false;
+			}
+
+			// Follow the running path down to the leaf keeping it running
+			const TArray<FBehaviacCompiledNode>& Nodes = Program->GetNodes();
+			for (int32 Index = 1; Nodes.IsValidIndex(Index);)
+			{
+				const FBehaviacCompiledNode& Entry = Nodes[Index];
+				switch (Entry.Op)
+				{
+				case EBehaviacFlatOp::Sequence:
+				case EBehaviacFlatOp::Selector:
+					if (States[Index].Counter <= Index)
+					{
+						return false;
+					}
+					Index = States[Index].Counter;
+					break;
+
+				case EBehaviacFlatOp::AlwaysSuccess:
+				case EBehaviacFlatOp::AlwaysFailure:
+				case EBehaviacFlatOp::Not:
+					if (Entry.NumChildren == 0)
+					{
+						return false;
+					}
+					++Index;
+					break;
+
+				case EBehaviacFlatOp::Wait:
+					if (States[Index].EndTime < 0.0)
+					{
+						return false;
+					}
+					OutCondition.AddDeadline(States[Index].EndTime);
+					return true;
+
+				default:
+					// A Loop keeps going when its child finishes; actions may finish any tick
+					return false;
+				}
+			}
+			return false;
+		}
+
+	protected:
+		virtual void ResetState() override
+		{
+			for (int32 Index = 0; Program && Index < Program->GetNodes().Num(); ++Index)
+			{
+				States[Index] = FBehaviacFlatNodeState();
+			}
+		}
+
+		virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override
+		{
+			return Program ? Run(Agent, 1) : EBehaviacStatus::Failure;
+		}
+
+	private:
+		EBehaviacStatus Run(UBehaviacAgentComponent* Agent, int32 Index)
+		{
+			const TArray<FBehaviacCompiledNode>& Nodes = Program->GetNodes();
+			const FBehaviacCompiledNode& Entry = Nodes[Index];
+			FBehaviacFlatNodeState& State = States[Index];
+
+			switch (Entry.Op)
+			{
+			case EBehaviacFlatOp::Sequence:
+			case EBehaviacFlatOp::Selector:
+			{
+				// Sequence stops at the first failure, Selector at the first success
+				const bool bSequence = Entry.Op == EBehaviacFlatOp::Sequence;
+				const EBehaviacStatus Stop = bSequence ? EBehaviacStatus::Failure : EBehaviacStatus::Success;
+				for (int32 Child = State.Counter > Index ? State.Counter : Index + 1; Child < Entry.SubtreeEnd; Child = Nodes[Child].SubtreeEnd)
+				{
+					const EBehaviacStatus Result = Run(Agent, Child);
+					if (Result == EBehaviacStatus::Running)
+					{
+						State.Counter = Child;
+						return Result;
+					}
+					if (Result == Stop)
+					{
+						State.Counter = 0;
+						return Result;
+					}
+				}
+				State.Counter = 0;
+				return bSequence ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+			}
+
+			case EBehaviacFlatOp::AlwaysSuccess:
+			case EBehaviacFlatOp::AlwaysFailure:
+			case EBehaviacFlatOp::Not:
+			case EBehaviacFlatOp::Loop:
+			{
+				if (Entry.NumChildren == 0)
+				{
+					return EBehaviacStatus::Failure;
+				}
+
+				const EBehaviacStatus Result = Run(Agent, Index + 1);
+				if (Result == EBehaviacStatus::Running)
+				{
+					return Result;
+				}
+				if (Entry.Op == EBehaviacFlatOp::AlwaysSuccess)
+				{
+					return EBehaviacStatus::Success;
+				}
+				if (Entry.Op == EBehaviacFlatOp::AlwaysFailure)
+				{
+					return EBehaviacStatus::Failure;
+				}
+				if (Entry.Op == EBehaviacFlatOp::Not)
+				{
+					if (Result == EBehaviacStatus::Success)
+					{
+						return EBehaviacStatus::Failure;
+					}
+					return Result == EBehaviacStatus::Failure ? EBehaviacStatus::Success : Result;
+				}
+
+				// One iteration per tick; the child reset itself when it finished
+				const int32 LoopCount = CastChecked<UBehaviacDecoratorLoop>(Entry.Node)->LoopCount;
+				if (LoopCount > 0 && ++State.Counter >= LoopCount)
+				{
+					State.Counter = 0;
+					return Result;
+				}
+				return EBehaviacStatus::Running;
+			}
+
+			case EBehaviacFlatOp::Action:
+			{
+				const UBehaviacAction* Action = CastChecked<UBehaviacAction>(Entry.Node);
+				return CallMethod(Agent, Action->MethodId, Action->ResultOption);
+			}
+
+			case EBehaviacFlatOp::GuardedAction:
+			{
+				// The guard is checked on entry only
+				const UBehaviacGuardedAction* Guarded = CastChecked<UBehaviacGuardedAction>(Entry.Node);
+				if (State.Counter == 0)
+				{
+					if (EvaluateCondition(Agent, Guarded->GetGuard(), State.SlotHints) == EBehaviacStatus::Failure)
+					{
+						return EBehaviacStatus::Failure;
+					}
+					State.Counter = 1;
+				}
+				const EBehaviacStatus Result = CallMethod(Agent, Guarded->MethodId, Guarded->ResultOption);
+				if (Result != EBehaviacStatus::Running)
+				{
+					State.Counter = 0;
+				}
+				return Result;
+			}
+
+			case EBehaviacFlatOp::Condition:
+				return EvaluateCondition(Agent, CastChecked<UBehaviacCondition>(Entry.Node)->GetComparison(), State.SlotHints);
+
+			case EBehaviacFlatOp::Wait:
+				return WaitFor(Agent, CastChecked<UBehaviacWait>(Entry.Node)->Duration, State.EndTime);
+
+			case EBehaviacFlatOp::Succeed:
+				return EBehaviacStatus::Success;
+
+			default:
+				return EBehaviacStatus::Failure;
+			}
+		}
+
+		const FBehaviacCompiledTree* Program = nullptr;
+		FBehaviacFlatNodeState* States = nullptr;
+	};
+
+	/** Append Task and its subtree to Nodes in depth-first order */
+	void FlattenTask(const FBehaviacBehaviorTask* Task, int32 Parent, int32 Depth, TArray<FBehaviacCompiledNode>& Nodes)
+	{
+		const int32 Index = Nodes.AddDefaulted();
+		{
+			FBehaviacCompiledNode& Entry = Nodes[Index];
+			Entry.Node = Task->GetNode();
+			Entry.Kind = Entry.Node ? Entry.Node->GetClass() : nullptr;
+			Entry.Parent = Parent;
+			Entry.Depth = Depth;
+		}
+
+		int32 NumChildren = 0;
+		for (int32 ChildIndex = 0; ChildIndex < Task->GetNumChildTasks(); ++ChildIndex)
+		{
+			if (const FBehaviacBehaviorTask* Child = Task->GetChildTask(ChildIndex))
+			{
+				FlattenTask(Child, Index, Depth + 1, Nodes);
+				++NumChildren;
+			}
+		}
+
+		Nodes[Index].NumChildren = NumChildren;
+		Nodes[Index].SubtreeEnd = Nodes.Num();
+	}
+
+	/**
+	 * Memoize the comparisons whose predicate occurs more than once among the
+	 * entries, so an agent evaluates each of them once per tick. Returns how
+	 * many distinct predicates are shared.
+	 */
+	int32 MarkSharedPredicates(const TArray<FBehaviacCompiledNode>& Nodes)
+	{
+		// Entry 0 is the tree task, which runs the root node of entry 1
+		TArray<FBehaviacComparison*> Predicates;
+		for (int32 Index = 1; Index < Nodes.Num(); ++Index)
+		{
+			if (Nodes[Index].Node)
+			{
+				Nodes[Index].Node->GatherPredicates(Predicates);
+			}
+		}
+
+		TMap<int32, int32> Uses;
+		for (const FBehaviacComparison* Predicate : Predicates)
+		{
+			if (Predicate->IsResolved() && Predicate->PredicateId != INDEX_NONE)
+			{
+				++Uses.FindOrAdd(Predicate->PredicateId);
+			}
+		}
+
+		int32 NumShared = 0;
+		for (const TPair<int32, int32>& Pair : Uses)
+		{
+			NumShared += Pair.Value > 1 ? 1 : 0;
+		}
+		for (FBehaviacComparison* Predicate : Predicates)
+		{
+			const int32* Count = Uses.Find(Predicate->PredicateId);
+			Predicate->SetMemoized(Count && *Count > 1);
+		}
+		return NumShared;
+	}
+}
+
+// ===================================================================
+// FBehaviacTaskPool
+// ===================================================================
+
+FBehaviacTaskPool::~FBehaviacTaskPool()
+{
+	Trim();
+}
+
+uint8* FBehaviacTaskPool::Allocate(uint32 Size)
+{
+	FScopeLock ScopeLock(&Lock);
+	FSizeClass& SizeClass = SizeClasses.FindOrAdd(Size);
+	SizeClass.HighWater = FMath::Max(SizeClass.HighWater, ++SizeClass.NumInUse);
+	HighWater = FMath::Max(HighWater, ++NumInUse);
+	BytesInUse += Size;
+	HighWaterBytes = FMath::Max(HighWaterBytes, BytesInUse);
+
+	if (SizeClass.Free.Num() > 0)
+	{
+		BytesPooled -= Size;
+		return SizeClass.Free.Pop(EAllowShrinking::No);
+	}
+	return (uint8*)FMemory::Malloc(Size, Alignment);
+}
+
+void FBehaviacTaskPool::Free(uint8* Block, uint32 Size)
+{
+	if (!Block)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FSizeClass& SizeClass = SizeClasses.FindOrAdd(Size);
+	--SizeClass.NumInUse;
+	--NumInUse;
+	BytesInUse -= Size;
+	BytesPooled += Size;
+	SizeClass.Free.Add(Block);
+}
+
+void FBehaviacTaskPool::Reserve(uint32 Size, int32 Count)
+{
+	if (Size == 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FSizeClass& SizeClass = SizeClasses.FindOrAdd(Size);
+	const int32 NumToAdd = Count - SizeClass.NumInUse - SizeClass.Free.Num();
+	if (NumToAdd > 0)
+	{
+		SizeClass.Free.Reserve(SizeClass.Free.Num() + NumToAdd);
+		for (int32 Index = 0; Index < NumToAdd; ++Index)
+		{
+			SizeClass.Free.Add((uint8*)FMemory::Malloc(Size, Alignment));
+		}
+		BytesPooled += Size * NumToAdd;
+	}
+}
+
+void FBehaviacTaskPool::Trim()
+{
+	FScopeLock ScopeLock(&Lock);
+	for (TPair<uint32, FSizeClass>& Pair : SizeClasses)
+	{
+		for (uint8* Block : Pair.Value.Free)
+		{
+			FMemory::Free(Block);
+		}
+		Pair.Value.Free.Empty();
+	}
+	BytesPooled = 0;
+}
+
+uint32 FBehaviacTaskPool::GetBytesInUse() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return BytesInUse;
+}
+
+uint32 FBehaviacTaskPool::GetBytesPooled() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return BytesPooled;
+}
+
+FBehaviacTaskPool::FStats FBehaviacTaskPool::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	FStats Stats;
+	Stats.NumInUse = NumInUse;
+	Stats.HighWater = HighWater;
+	Stats.BytesInUse = BytesInUse;
+	Stats.BytesPooled = BytesPooled;
+	Stats.HighWaterBytes = HighWaterBytes;
+	for (const TPair<uint32, FSizeClass>& Pair : SizeClasses)
+	{
+		Stats.NumPooled += Pair.Value.Free.Num();
+	}
+	return Stats;
+}
+
+FBehaviacTaskPool::FStats FBehaviacTaskPool::GetStats(uint32 Size) const
+{
+	FScopeLock ScopeLock(&Lock);
+	FStats Stats;
+	if (const FSizeClass* SizeClass = SizeClasses.Find(Size))
+	{
+		Stats.NumInUse = SizeClass->NumInUse;
+		Stats.NumPooled = SizeClass->Free.Num();
+		Stats.HighWater = SizeClass->HighWater;
+		Stats.BytesInUse = Size * SizeClass->NumInUse;
+		Stats.BytesPooled = Size * SizeClass->Free.Num();
+		Stats.HighWaterBytes = Size * SizeClass->HighWater;
+	}
+	return Stats;
+}
+
+// ===================================================================
+// FBehaviacCompiledTree
+// ===================================================================
+
+TSharedPtr<const FBehaviacCompiledTree> FBehaviacCompiledTree::Compile(UBehaviacBehaviorNode* RootNode, FBehaviacNativeTreeFactory NativeFactory, bool bFlat)
+{
+	if (!RootNode)
+	{
+		return nullptr;
+	}
+
+	// Build the tree once on the heap, recording where each task would go.
+	// This also resolves every node's operands, so agents never do.
+	FBehaviacTaskAllocator Measuring = FBehaviacTaskAllocator::MakeMeasuring();
+	FBehaviacBehaviorTreeTask* Root = Measuring.New<FBehaviacBehaviorTreeTask>();
+	Root->Init(RootNode, Measuring, NativeFactory);
+
+	TSharedPtr<FBehaviacCompiledTree> Program = MakeShared<FBehaviacCompiledTree>();
+	Program->RootNode = RootNode;
+	Program->NativeFactory = NativeFactory;
+	Program->Layout = Measuring.GetMeasuredLayout();
+	Program->StateSize = Measuring.GetMeasuredSize();
+	Program->StateAlignment = Measuring.GetMeasuredAlignment();
+
+	FlattenTask(Root, INDEX_NONE, 0, Program->Nodes);
+	FBehaviacTaskAllocator::Destroy(Root);
+
+	Program->NumSharedPredicates = MarkSharedPredicates(Program->Nodes);
+
+	// Flat only if every node below the tree task has a flat op
+	Program->bFlat = bFlat && !NativeFactory && Program->Nodes.Num() > 1;
+	for (int32 Index = 0; Index < Program->Nodes.Num(); ++Index)
+	{
+		FBehaviacCompiledNode& Entry = Program->Nodes[Index];
+		Entry.Op = Index == 0 ? EBehaviacFlatOp::Tree : GetFlatOp(Entry.Node);
+		Program->bFlat &= Entry.Op != EBehaviacFlatOp::None;
+	}
+
+	if (Program->bFlat)
+	{
+		// The block holds the tree task, the flat task and then one state per entry
+		FBehaviacTaskAllocator FlatMeasuring = FBehaviacTaskAllocator::MakeMeasuring();
+		FBehaviacBehaviorTreeTask* FlatRoot = FlatMeasuring.New<FBehaviacBehaviorTreeTask>();
+		FlatRoot->Init(RootNode, FlatMeasuring, &FBehaviacFlatTreeTask::Make);
+		FBehaviacTaskAllocator::Destroy(FlatRoot);
+
+		Program->Layout = FlatMeasuring.GetMeasuredLayout();
+		Program->FlatStateOffset = Align(FlatMeasuring.GetMeasuredSize(), alignof(FBehaviacFlatNodeState));
+		Program->StateSize = Program->FlatStateOffset + (uint32)(Program->Nodes.Num() * sizeof(FBehaviacFlatNodeState));
+		Program->StateAlignment = FMath::Max<uint32>(FlatMeasuring.GetMeasuredAlignment(), alignof(FBehaviacFlatNodeState));
+		Program->Nodes[0].State = Program->Layout[0];
+		Program->Nodes[1].State = Program->Layout[1];
+	}
+	// Tasks are created parent first, children in order, so entries and slots line up
+	else if (Program->Nodes.Num() == Program->Layout.Num())
+	{
+		for (int32 Index = 0; Index < Program->Nodes.Num(); ++Index)
+		{
+			Program->Nodes[Index].State = Program->Layout[Index];
+		}
+	}
+	else
+	{
+		UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] Compiled tree %s has %d entries but %d task slots"),
+			*RootNode->GetName(), Program->Nodes.Num(), Program->Layout.Num());
+	}
+
+	// Branch blocks: each entry's direct children, packed in order
+	for (int32 Index = 0; Index < Program->Nodes.Num(); ++Index)
+	{
+		FBehaviacCompiledNode& Entry = Program->Nodes[Index];
+		Entry.FirstChildSlot = Program->ChildSlots.Num();
+
+		uint32 BlockSize = 0;
+		for (int32 Child = Index + 1; Child < Entry.SubtreeEnd; Child = Program->Nodes[Child].SubtreeEnd)
+		{
+			const FBehaviacTaskAllocator::FSlot& ChildState = Program->Nodes[Child].State;
+			FBehaviacTaskAllocator::FSlot& Slot = Program->ChildSlots.AddDefaulted_GetRef();
+			Slot.Offset = Align(BlockSize, FMath::Max(ChildState.Alignment, 1u));
+			Slot.Size = ChildState.Size;
+			Slot.Alignment = ChildState.Alignment;
+			BlockSize = Slot.Offset + Slot.Size;
+		}
+		Entry.ChildBlockSize = BlockSize;
+
+		Program->NodeIndices.Add(Entry.Node, Index);
+	}
+
+	// The tree task shares the root node with entry 1; look the node up as entry 1
+	if (Program->Nodes.Num() > 1)
+	{
+		Program->NodeIndices.Add(RootNode, 1);
+	}
+
+	Program->RootStateSize = Program->Layout.Num() >= 2 && !Program->bFlat ? Program->Layout[1].Offset + Program->Layout[1].Size : Program->StateSize;
+	Program->TaskPool = MakeUnique<FBehaviacTaskPool>(Program->StateAlignment);
+	return Program;
+}
+
+TArrayView<const FBehaviacTaskAllocator::FSlot> FBehaviacCompiledTree::GetChildLayout(int32 Index) const
+{
+	if (!Nodes.IsValidIndex(Index))
+	{
+		return TArrayView<const FBehaviacTaskAllocator::FSlot>();
+	}
+	return MakeArrayView(ChildSlots).Slice(Nodes[Index].FirstChildSlot, Nodes[Index].NumChildren);
+}
+
+int32 FBehaviacCompiledTree::FindNode(const UBehaviacBehaviorNode* Node) const
+{
+	const int32* Index = NodeIndices.Find(Node);
+	return Index ? *Index : INDEX_NONE;
+}
+
+// ===================================================================
+// FBehaviacTreeInstance
+// ===================================================================
+
+bool FBehaviacTreeInstance::Create(const TSharedPtr<const FBehaviacCompiledTree>& InProgram, bool bInLazy)
+{
+	Release();
+
+	if (!InProgram.IsValid())
+	{
+		return false;
+	}
+
+	Program = InProgram;
+	bLazy = bInLazy;
+	StateSize = Program->GetSlabSize(bLazy);
+	if (StateSize > 0)
+	{
+		State = Program->GetTaskPool().Allocate(StateSize);
+	}
+
+	FBehaviacTaskAllocator Allocator(State, bLazy ? Program->GetRootLayout() : MakeArrayView(Program->GetLayout()), bLazy ? this : nullptr);
+	Root = Allocator.New<FBehaviacBehaviorTreeTask>();
+	if (Program->IsFlat())
+	{
+		Root->Init(Program->GetRootNode(), Allocator, &FBehaviacFlatTreeTask::Make);
+		static_cast<FBehaviacFlatTreeTask*>(Root->GetChildTask(0))->Bind(*Program,
+			reinterpret_cast<FBehaviacFlatNodeState*>(State + Program->GetFlatStateOffset()));
+	}
+	else
+	{
+		Root->Init(Program->GetRootNode(), Allocator, Program->GetNativeFactory());
+	}
+
+	if (!Allocator.MatchedLayout())
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Tree %s changed since it was compiled; some tasks were allocated separately"),
+			*GetNameSafe(Program->GetRootNode()));
+		return false;
+	}
+	return true;
+}
+
+void FBehaviacTreeInstance::Release()
+{
+	FBehaviacTaskAllocator::Destroy(Root);
+	Root = nullptr;
+
+	for (TPair<FBehaviacBehaviorTask*, FBranch>& Pair : Branches)
+	{
+		Program->GetTaskPool().Free(Pair.Value.Block, Pair.Value.Size);
+	}
+	Branches.Reset();
+
+	if (State)
+	{
+		Program->GetTaskPool().Free(State, StateSize);
+		State = nullptr;
+	}
+	StateSize = 0;
+	bLazy = false;
+	Program.Reset();
+}
+
+bool FBehaviacTreeInstance::OwnsStateOf(const FBehaviacBehaviorTask* Task) const
+{
+	const uint8* Address = reinterpret_cast<const uint8*>(Task);
+	return State && Address >= State && Address < State + StateSize;
+}
+
+void FBehaviacTreeInstance::BuildChildTasks(FBehaviacBehaviorTask* Task, double Now)
+{
+	Task->DeferredOwner = nullptr;
+
+	const int32 Index = Program.IsValid() ? Program->FindNode(Task->GetNode()) : INDEX_NONE;
+	if (Index == INDEX_NONE)
+	{
+		// Not part of the compiled tree (edited since): build on the heap, still deferring below
+		FBehaviacTaskAllocator Heap(nullptr, TArrayView<const FBehaviacTaskAllocator::FSlot>(), this);
+		Task->CreateChildTasks(Heap);
+		return;
+	}
+
+	FBranch Branch;
+	Branch.Size = Program->GetNodes()[Index].ChildBlockSize;
+	Branch.Block = Branch.Size > 0 ? Program->GetTaskPool().Allocate(Branch.Size) : nullptr;
+	Branch.LastActive = Now;
+
+	FBehaviacTaskAllocator Allocator(Branch.Block, Program->GetChildLayout(Index), this);
+	Task->CreateChildTasks(Allocator);
+
+	if (Branch.Block)
+	{
+		Branches.Add(Task, Branch);
+	}
+	if (!Allocator.MatchedLayout())
+	{
+		UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] Branch %s changed since it was compiled; some tasks were allocated separately"),
+			*GetNameSafe(Task->GetNode()));
+	}
+}
+
+int32 FBehaviacTreeInstance::ReclaimIdleBranches(double Now, double IdleSeconds)
+{
+	TArray<FBehaviacBehaviorTask*> Idle;
+	for (TPair<FBehaviacBehaviorTask*, FBranch>& Pair : Branches)
+	{
+		// The tree task and the root node's task live in the state block and stay built
+		if (Pair.Key == Root || Pair.Key->GetParentTask() == Root)
+		{
+			continue;
+		}
+
+		if (Pair.Key->bHasEntered)
+		{
+			Pair.Value.LastActive = Now;
+		}
+		else if (Now - Pair.Value.LastActive >= IdleSeconds)
+		{
+			Idle.Add(Pair.Key);
+		}
+	}
+
+	int32 NumReclaimed = 0;
+	for (FBehaviacBehaviorTask* Task : Idle)
+	{
+		// Branches below an idle one went with it
+		if (Branches.Contains(Task))
+		{
+			ReclaimBranch(Task);
+			++NumReclaimed;
+		}
+	}
+	return NumReclaimed;
+}
+
+void FBehaviacTreeInstance::ReclaimBranch(FBehaviacBehaviorTask* Task)
+{
+	TArray<FBranch> Blocks;
+	Task->Traverse(false, [this, &Blocks](FBehaviacBehaviorTask* Below)
+	{
+		FBranch Branch;
+		if (Branches.RemoveAndCopyValue(Below, Branch))
+		{
+			Blocks.Add(Branch);
+		}
+		return true;
+	});
+
+	Task->DestroyChildTasks();
+	Task->DeferredOwner = this;
+
+	for (const FBranch& Branch : Blocks)
+	{
+		Program->GetTaskPool().Free(Branch.Block, Branch.Size);
+	}
+}
+
+uint32 FBehaviacTreeInstance::GetBranchBytes() const
+{
+	uint32 Bytes = 0;
+	for (const TPair<FBehaviacBehaviorTask*, FBranch>& Pair : Branches)
+	{
+		Bytes += Pair.Value.Size;
+	}
+	return Bytes;
+}
@@ -0,0 +1,250 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/Attachments/BehaviacAttachment.h"
+#include "BehaviacAgent.h"
+#include "UObject/UnrealType.h"
+#include "Misc/ScopeLock.h"
+
+TAutoConsoleVariable<int32> CVarBehaviacNativeTrees(
+	TEXT("Behaviac.NativeTrees"),
+	1,
+	TEXT("Run behavior trees through their generated C++ when it matches the tree.\n")
+	TEXT("  0 = always interpret\n")
+	TEXT("  1 = use generated code (default)"),
+	ECVF_Default
+);
+
+namespace
+{
+	struct FNativeTreeEntry
+	{
+		uint32 TreeHash = 0;
+		FBehaviacNativeTreeFactory Factory = nullptr;
+	};
+
+	FCriticalSection& GetNativeTreeLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	/** Keyed case-insensitively, like asset names */
+	TMap<FString, FNativeTreeEntry>& GetNativeTrees()
+	{
+		static TMap<FString, FNativeTreeEntry> Trees;
+		return Trees;
+	}
+
+	/** Append Object's class and edited property values; object references are hashed by the caller */
+	void AppendObjectText(const UObject* Object, FString& Out)
+	{
+		const UClass* Class = Object->GetClass();
+		Out += Class->GetName();
+		Out += TEXT('{');
+
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_Transient))
+			{
+				continue;
+			}
+
+			const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+			if (Property->IsA<FObjectPropertyBase>() || (ArrayProperty && ArrayProperty->Inner->IsA<FObjectPropertyBase>()))
+			{
+				continue;
+			}
+
+			for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+			{
+				Out += Property->GetName();
+				Out += TEXT('=');
+				Property->ExportText_InContainer(Index, Out, Object, Object, nullptr, PPF_None);
+				Out += TEXT(';');
+			}
+		}
+	}
+
+	void AppendNodeText(const UBehaviacBehaviorNode* Node, FString& Out)
+	{
+		if (!Node)
+		{
+			Out += TEXT("null;");
+			return;
+		}
+
+		AppendObjectText(Node, Out);
+
+		const TArray<UBehaviacAttachment*>* AttachmentLists[] = { &Node->Preconditions, &Node->Effectors, &Node->Events };
+		for (const TArray<UBehaviacAttachment*>* Attachments : AttachmentLists)
+		{
+			Out += TEXT('[');
+			for (const UBehaviacAttachment* Attachment : *Attachments)
+			{
+				if (Attachment)
+				{
+					AppendObjectText(Attachment, Out);
+					Out += TEXT('}');
+				}
+			}
+			Out += TEXT(']');
+		}
+
+		Out += TEXT('(');
+		for (int32 Index = 0; Index < Node->GetChildCount(); ++Index)
+		{
+			AppendNodeText(Node->GetChild(Index), Out);
+		}
+		Out += TEXT(")}");
+	}
+}
+
+// ===================================================================
+// FBehaviacNativeTreeRegistry
+// ===================================================================
+
+void FBehaviacNativeTreeRegistry::Register(const FString& TreeName, uint32 TreeHash, FBehaviacNativeTreeFactory Factory)
+{
+	FScopeLock Lock(&GetNativeTreeLock());
+	FNativeTreeEntry& Entry = GetNativeTrees().FindOrAdd(TreeName);
+	Entry.TreeHash = TreeHash;
+	Entry.Factory = Factory;
+}
+
+void FBehaviacNativeTreeRegistry::Unregister(const FString& TreeName)
+{
+	FScopeLock Lock(&GetNativeTreeLock());
+	GetNativeTrees().Remove(TreeName);
+}
+
+FBehaviacNativeTreeFactory FBehaviacNativeTreeRegistry::Find(const FString& TreeName, uint32 TreeHash)
+{
+	FScopeLock Lock(&GetNativeTreeLock());
+	const FNativeTreeEntry* Entry = GetNativeTrees().Find(TreeName);
+	return (Entry && Entry->TreeHash == TreeHash) ? Entry->Factory : nullptr;
+}
+
+bool FBehaviacNativeTreeRegistry::Contains(const FString& TreeName)
+{
+	FScopeLock Lock(&GetNativeTreeLock());
+	return GetNativeTrees().Contains(TreeName);
+}
+
+FBehaviacNativeTreeFactory FBehaviacNativeTreeRegistry::FindFor(const UBehaviacBehaviorTree* Tree)
+{
+	if (!Tree || !Tree->bUseNativeTree || !Tree->RootNode || CVarBehaviacNativeTrees.GetValueOnAnyThread() == 0)
+	{
+		return nullptr;
+	}
+
+	const FString TreeName = GetTreeName(Tree);
+	if (!Contains(TreeName))
+	{
+		return nullptr;
+	}
+
+	FBehaviacNativeTreeFactory Factory = Find(TreeName, HashTree(Tree->RootNode));
+	if (!Factory)
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Generated code for tree %s is out of date; interpreting it. Regenerate with -run=BehaviacGenerateNativeTrees."),
+			*TreeName);
+	}
+	return Factory;
+}
+
+FString FBehaviacNativeTreeRegistry::GetTreeName(const UBehaviacBehaviorTree* Tree)
+{
+	if (!Tree)
+	{
+		return FString();
+	}
+	return Tree->TreeName.IsEmpty() ? Tree->GetName() : Tree->TreeName;
+}
+
+uint32 FBehaviacNativeTreeRegistry::HashTree(const UBehaviacBehaviorNode* RootNode)
+{
+	FString Text;
+	AppendNodeText(RootNode, Text);
+	return FCrc::StrCrc32(*Text);
+}
+
+// ===================================================================
+// FBehaviacNativeTreeTask
+// ===================================================================
+
+void FBehaviacNativeTreeTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	ResetState();
+}
+
+bool FBehaviacNativeTreeTask::OnEnter(UBehaviacAgentComponent* Agent)
+{
+	ResetState();
+	return true;
+}
+
+EBehaviacStatus FBehaviacNativeTreeTask::CallMethod(UBehaviacAgentComponent* Agent, int32 MethodId, EBehaviacStatus ResultOption)
+{
+	const EBehaviacStatus Result = Agent->ExecuteMethodById(MethodId);
+	if (Result == EBehaviacStatus::Running)
+	{
+		return EBehaviacStatus::Running;
+	}
+	if (ResultOption == EBehaviacStatus::Running)
+	{
+		return (Result != EBehaviacStatus::Invalid) ? Result : EBehaviacStatus::Success;
+	}
+	return ResultOption;
+}
+
+bool FBehaviacNativeTreeTask::ReadNumber(UBehaviacAgentComponent* Agent, FName Key, int32& SlotHint, double& OutValue)
+{
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	const FBehaviacValue* Value = Agent->GetBlackboard().FindWithHint(Key, SlotHint);
+	if (Value && Value->IsNumeric())
+	{
+		OutValue = Value->AsDouble();
+		return true;
+	}
+	return false;
+}
+
+EBehaviacStatus FBehaviacNativeTreeTask::EvaluateCondition(UBehaviacAgentComponent* Agent, const FBehaviacComparison& Comparison, int32* SlotHints)
+{
+	return Comparison.Evaluate(Agent, SlotHints) ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+}
+
+FBehaviacComparison FBehaviacNativeTreeTask::MakeComparison(const TCHAR* Left, EBehaviacOperatorType Operator, const TCHAR* Right)
+{
+	FBehaviacComparison Comparison;
+	Comparison.Resolve(
+		Left, EBehaviacOperandMode::PropertyOrMethod,
+		Right, EBehaviacOperandMode::PropertyOrMethod,
+		Operator);
+	return Comparison;
+}
+
+EBehaviacStatus FBehaviacNativeTreeTask::WaitFor(UBehaviacAgentComponent* Agent, double Duration, double& InOutEndTime)
+{
+	const double Now = Agent->GetTimeSeconds();
+	if (InOutEndTime < 0.0)
+	{
+		InOutEndTime = Now + Duration;
+
+		// Tick LOD may skip frames; make sure the tree is ticked when the wait is over
+		Agent->RequestTickAt(InOutEndTime);
+	}
+
+	if (Now >= InOutEndTime)
+	{
+		InOutEndTime = -1.0;
+		return EBehaviacStatus::Success;
+	}
+	return EBehaviacStatus::Running;
+}
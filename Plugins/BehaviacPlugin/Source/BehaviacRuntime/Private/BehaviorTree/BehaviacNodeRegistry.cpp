@@ -0,0 +1,215 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/Attachments/BehaviacAttachment.h"
+#include "Misc/ScopeRWLock.h"
+#include "String/Find.h"
+
+namespace BehaviacNodeRegistry
+{
+	/** Registrars constructed since the last RegisterPending, newest first */
+	static FBehaviacNodeRegistrar*& GetPendingHead()
+	{
+		static FBehaviacNodeRegistrar* Head = nullptr;
+		return Head;
+	}
+
+	/** Name for a lookup; FNAME_Find so unknown class names do not grow the name table */
+	static FName FindName(FStringView ClassName)
+	{
+		const FStringView ShortName = FBehaviacNodeRegistry::GetShortName(ClassName);
+		return FName(ShortName.Len(), ShortName.GetData(), FNAME_Find);
+	}
+}
+
+FBehaviacNodeRegistrar::FBehaviacNodeRegistrar(const TCHAR* InClassName, UClass* (*InGetClass)())
+	: ClassName(InClassName)
+	, GetClass(InGetClass)
+{
+	FBehaviacNodeRegistrar*& Head = BehaviacNodeRegistry::GetPendingHead();
+	Next = Head;
+	Head = this;
+}
+
+FBehaviacNodeRegistrar::FBehaviacNodeRegistrar(const TCHAR* InClassName, UClass* (*InGetClass)(), EBehaviacAttachmentKind InKind)
+	: FBehaviacNodeRegistrar(InClassName, InGetClass)
+{
+	Kind = InKind;
+	bAttachment = true;
+}
+
+FBehaviacNodeRegistry& FBehaviacNodeRegistry::Get()
+{
+	static FBehaviacNodeRegistry Registry;
+	return Registry;
+}
+
+void FBehaviacNodeRegistry::RegisterNode(FName ClassName, TSubclassOf<UBehaviacBehaviorNode> NodeClass)
+{
+	if (ClassName.IsNone() || !NodeClass || NodeClass->HasAnyClassFlags(CLASS_Abstract))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Cannot register node class %s as %s"), *GetNameSafe(NodeClass), *ClassName.ToString());
+		return;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	TObjectPtr<UClass>& Registered = Nodes.FindOrAdd(ClassName);
+	if (Registered && Registered != NodeClass)
+	{
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Node class %s now creates %s instead of %s"),
+			*ClassName.ToString(), *NodeClass->GetName(), *Registered->GetName());
+	}
+	Registered = NodeClass.Get();
+}
+
+void FBehaviacNodeRegistry::RegisterAttachment(FName ClassName, TSubclassOf<UBehaviacAttachment> AttachmentClass, EBehaviacAttachmentKind Kind)
+{
+	if (ClassName.IsNone() || !AttachmentClass || AttachmentClass->HasAnyClassFlags(CLASS_Abstract))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Cannot register attachment class %s as %s"), *GetNameSafe(AttachmentClass), *ClassName.ToString());
+		return;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	FAttachmentEntry& Entry = Attachments.FindOrAdd(ClassName);
+	if (Entry.Class && Entry.Class != AttachmentClass)
+	{
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Attachment class %s now creates %s instead of %s"),
+			*ClassName.ToString(), *AttachmentClass->GetName(), *Entry.Class->GetName());
+	}
+	Entry.Class = AttachmentClass.Get();
+	Entry.Kind = Kind;
+}
+
+void FBehaviacNodeRegistry::Unregister(FName ClassName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Nodes.Remove(ClassName);
+	Attachments.Remove(ClassName);
+}
+
+UClass* FBehaviacNodeRegistry::FindNodeClass(FStringView ClassName) const
+{
+	const FName Name = BehaviacNodeRegistry::FindName(ClassName);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+
+	FReadScopeLock ReadLock(Lock);
+	const TObjectPtr<UClass>* Registered = Nodes.Find(Name);
+	return Registered ? Registered->Get() : nullptr;
+}
+
+UBehaviacBehaviorNode* FBehaviacNodeRegistry::CreateNode(FStringView ClassName, UObject* Outer) const
+{
+	UClass* NodeClass = FindNodeClass(ClassName);
+	if (!NodeClass)
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Unknown node class: %s"), *FString(ClassName));
+		return nullptr;
+	}
+	return NewObject<UBehaviacBehaviorNode>(Outer, NodeClass);
+}
+
+bool FBehaviacNodeRegistry::AddAttachment(UBehaviacBehaviorNode* Node, FStringView ClassName, const TArray<FBehaviacProperty>& Properties) const
+{
+	FAttachmentEntry Entry;
+	{
+		const FName Name = BehaviacNodeRegistry::FindName(ClassName);
+		FReadScopeLock ReadLock(Lock);
+		if (const FAttachmentEntry* Registered = Attachments.Find(Name))
+		{
+			Entry = *Registered;
+		}
+		else
+		{
+			// Exports name attachments loosely ("PreconditionAttachment" and the
+			// like); the first registered name the class contains wins
+			for (const TPair<FName, FAttachmentEntry>& Pair : Attachments)
+			{
+				if (UE::String::FindFirst(ClassName, Pair.Key.ToString(), ESearchCase::IgnoreCase) != INDEX_NONE)
+				{
+					Entry = Pair.Value;
+					break;
+				}
+			}
+		}
+	}
+
+	if (!Entry.Class)
+	{
+		BEHAVIAC_VLOG(TEXT("[Behaviac] Skipped unknown attachment class: %s"), *FString(ClassName));
+		return false;
+	}
+
+	UBehaviacAttachment* Attachment = NewObject<UBehaviacAttachment>(Node, Entry.Class);
+	Attachment->LoadFromProperties(0, TEXT(""), Properties);
+	switch (Entry.Kind)
+	{
+	case EBehaviacAttachmentKind::Precondition:	Node->Preconditions.Add(Attachment); break;
+	case EBehaviacAttachmentKind::Effector:		Node->Effectors.Add(Attachment); break;
+	case EBehaviacAttachmentKind::Event:		Node->Events.Add(Attachment); break;
+	}
+	return true;
+}
+
+void FBehaviacNodeRegistry::RegisterPending()
+{
+	check(IsInGameThread());
+
+	// Oldest first, so a file's registrations apply in the order they are written
+	TArray<FBehaviacNodeRegistrar*, TInlineAllocator<64>> Pending;
+	FBehaviacNodeRegistrar*& Head = BehaviacNodeRegistry::GetPendingHead();
+	for (FBehaviacNodeRegistrar* Registrar = Head; Registrar; Registrar = Registrar->Next)
+	{
+		Pending.Add(Registrar);
+	}
+	Head = nullptr;
+
+	for (int32 Index = Pending.Num() - 1; Index >= 0; --Index)
+	{
+		const FBehaviacNodeRegistrar& Registrar = *Pending[Index];
+		if (Registrar.bAttachment)
+		{
+			RegisterAttachment(FName(Registrar.ClassName), Registrar.GetClass(), Registrar.Kind);
+		}
+		else
+		{
+			RegisterNode(FName(Registrar.ClassName), Registrar.GetClass());
+		}
+	}
+
+	if (Pending.Num() > 0)
+	{
+		BEHAVIAC_VLOG(TEXT("[Behaviac] Registered %d node and attachment classes"), Pending.Num());
+	}
+}
+
+FStringView FBehaviacNodeRegistry::GetShortName(FStringView ClassName)
+{
+	// "behaviac::Selector" -> "Selector", "PluginBehaviac.Events.Precondition" -> "Precondition"
+	for (int32 Index = ClassName.Len() - 1; Index >= 0; --Index)
+	{
+		if (ClassName[Index] == TEXT(':') || ClassName[Index] == TEXT('.'))
+		{
+			return ClassName.RightChop(Index + 1);
+		}
+	}
+	return ClassName;
+}
+
+void FBehaviacNodeRegistry::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FWriteScopeLock WriteLock(Lock);
+	for (TPair<FName, TObjectPtr<UClass>>& Pair : Nodes)
+	{
+		Collector.AddReferencedObject(Pair.Value);
+	}
+	for (TPair<FName, FAttachmentEntry>& Pair : Attachments)
+	{
+		Collector.AddReferencedObject(Pair.Value.Class);
+	}
+}
@@ -0,0 +1,428 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacOperand.h"
+#include "BehaviacAgent.h"
+#include "Misc/ScopeRWLock.h"
+
+TAutoConsoleVariable<int32> CVarBehaviacPredicateCache(
+	TEXT("Behaviac.PredicateCache"),
+	1,
+	TEXT("Share the results of conditions that occur more than once in a tree within an agent's tick.\n")
+	TEXT("  0 = evaluate every occurrence\n")
+	TEXT("  1 = memoize until a key the condition reads is written (default)"),
+	ECVF_Default);
+
+// ===================================================================
+// FBehaviacOperand
+// ===================================================================
+
+FBehaviacOperand FBehaviacOperand::Resolve(const FString& Text, EBehaviacOperandMode Mode)
+{
+	FBehaviacOperand Operand;
+
+	const bool bSelfReference = Text.StartsWith(TEXT("Self."));
+	if (bSelfReference || Mode == EBehaviacOperandMode::Property)
+	{
+		Operand.Key = FBehaviacBlackboard::MakeKey(Text);
+		if (bSelfReference && Mode == EBehaviacOperandMode::PropertyOrMethod)
+		{
+			Operand.Kind = EKind::PropertyOrMethod;
+			Operand.MethodId = FBehaviacMethodRegistry::FindOrAdd(Text.Mid(5));
+		}
+		else
+		{
+			Operand.Kind = EKind::Property;
+		}
+		return Operand;
+	}
+
+	Operand.Kind = EKind::Constant;
+	if (Text == TEXT("true"))
+	{
+		Operand.Constant = FBehaviacValue::MakeBool(true);
+	}
+	else if (Text == TEXT("false"))
+	{
+		Operand.Constant = FBehaviacValue::MakeBool(false);
+	}
+	else
+	{
+		// Keep the literal text (so assignments read back verbatim); the numeric
+		// interpretation is cached by MakeString.
+		Operand.Constant = FBehaviacValue::MakeString(Text);
+	}
+	return Operand;
+}
+
+FBehaviacValue FBehaviacOperand::CallFallbackMethod(UBehaviacAgentComponent* Agent) const
+{
+	const EBehaviacStatus MethodResult = Agent->ExecuteMethodById(MethodId);
+	UE_LOG(LogBehaviac, Verbose, TEXT("[Behaviac] Operand '%s' unset, called method: %d"), *Key.ToString(), (int32)MethodResult);
+	return FBehaviacValue::MakeBool(MethodResult == EBehaviacStatus::Success);
+}
+
+void FBehaviacOperand::GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const
+{
+	if (Kind == EKind::Constant)
+	{
+		return;
+	}
+
+	OutKeys.Keys.AddUnique(Key);
+	if (Kind == EKind::PropertyOrMethod)
+	{
+		OutKeys.MethodFallbackKeys.AddUnique(Key);
+	}
+}
+
+// ===================================================================
+// FBehaviacObservedKeys
+// ===================================================================
+
+bool FBehaviacObservedKeys::HaveChangedSince(const FBehaviacBlackboard& Blackboard, uint64 Serial) const
+{
+	// A fallback method can return anything; only its property is observable
+	for (const FName& Key : MethodFallbackKeys)
+	{
+		const FBehaviacValue* Value = Blackboard.Find(Key);
+		if (!Value || (Value->GetType() == EBehaviacValueType::String && Value->GetString().IsEmpty()))
+		{
+			return true;
+		}
+	}
+
+	if (Blackboard.GetWriteSerial() == Serial)
+	{
+		return false;
+	}
+
+	for (const FName& Key : Keys)
+	{
+		if (Blackboard.GetKeySerial(Key) > Serial)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// ===================================================================
+// Kernels
+// ===================================================================
+
+template<EBehaviacOperatorType Op>
+static bool BehaviacApplyOrdering(int32 Cmp)
+{
+	switch (Op)
+	{
+	case EBehaviacOperatorType::Equal:			return Cmp == 0;
+	case EBehaviacOperatorType::NotEqual:		return Cmp != 0;
+	case EBehaviacOperatorType::Greater:			return Cmp > 0;
+	case EBehaviacOperatorType::Less:			return Cmp < 0;
+	case EBehaviacOperatorType::GreaterEqual:	return Cmp >= 0;
+	case EBehaviacOperatorType::LessEqual:		return Cmp <= 0;
+	default: return false;
+	}
+}
+
+template<EBehaviacOperatorType Op>
+static bool BehaviacCompareNumbers(double Left, double Right)
+{
+	switch (Op)
+	{
+	case EBehaviacOperatorType::Equal:			return FMath::IsNearlyEqual(Left, Right);
+	case EBehaviacOperatorType::NotEqual:		return !FMath::IsNearlyEqual(Left, Right);
+	case EBehaviacOperatorType::Greater:			return Left > Right;
+	case EBehaviacOperatorType::Less:			return Left < Right;
+	case EBehaviacOperatorType::GreaterEqual:	return Left >= Right;
+	case EBehaviacOperatorType::LessEqual:		return Left <= Right;
+	default: return false;
+	}
+}
+
+/** Comparison of the string forms, without heap allocation for common types. */
+template<ESearchCase::Type StringCase>
+static int32 BehaviacCompareStrings(const FBehaviacValue& Left, const FBehaviacValue& Right)
+{
+	if (Left.GetType() == EBehaviacValueType::String && Right.GetType() == EBehaviacValueType::String)
+	{
+		return Left.GetString().Compare(Right.GetString(), StringCase);
+	}
+
+	TStringBuilder<128> LeftStr;
+	TStringBuilder<128> RightStr;
+	Left.AppendString(LeftStr);
+	Right.AppendString(RightStr);
+	return StringCase == ESearchCase::CaseSensitive
+		? FCString::Strcmp(LeftStr.ToString(), RightStr.ToString())
+		: FCString::Stricmp(LeftStr.ToString(), RightStr.ToString());
+}
+
+template<EBehaviacOperatorType Op, ESearchCase::Type StringCase = ESearchCase::CaseSensitive>
+static bool BehaviacCompareKernel(const FBehaviacValue& Left, const FBehaviacValue& Right)
+{
+	if (Left.IsNumeric() && Right.IsNumeric())
+	{
+		return BehaviacCompareNumbers<Op>(Left.AsDouble(), Right.AsDouble());
+	}
+	return BehaviacApplyOrdering<Op>(BehaviacCompareStrings<StringCase>(Left, Right));
+}
+
+static bool BehaviacCompareNever(const FBehaviacValue& Left, const FBehaviacValue& Right)
+{
+	return false;
+}
+
+FBehaviacCompareKernel FBehaviacComparison::SelectKernel(EBehaviacOperatorType Operator, ESearchCase::Type StringCase)
+{
+	if (StringCase == ESearchCase::IgnoreCase)
+	{
+		switch (Operator)
+		{
+		case EBehaviacOperatorType::Equal:			return &BehaviacCompareKernel<EBehaviacOperatorType::Equal, ESearchCase::IgnoreCase>;
+		case EBehaviacOperatorType::NotEqual:		return &BehaviacCompareKernel<EBehaviacOperatorType::NotEqual, ESearchCase::IgnoreCase>;
+		case EBehaviacOperatorType::Greater:			return &BehaviacCompareKernel<EBehaviacOperatorType::Greater, ESearchCase::IgnoreCase>;
+		case EBehaviacOperatorType::Less:			return &BehaviacCompareKernel<EBehaviacOperatorType::Less, ESearchCase::IgnoreCase>;
+		case EBehaviacOperatorType::GreaterEqual:	return &BehaviacCompareKernel<EBehaviacOperatorType::GreaterEqual, ESearchCase::IgnoreCase>;
+		case EBehaviacOperatorType::LessEqual:		return &BehaviacCompareKernel<EBehaviacOperatorType::LessEqual, ESearchCase::IgnoreCase>;
+		default:									return &BehaviacCompareNever;
+		}
+	}
+
+	switch (Operator)
+	{
+	case EBehaviacOperatorType::Equal:			return &BehaviacCompareKernel<EBehaviacOperatorType::Equal>;
+	case EBehaviacOperatorType::NotEqual:		return &BehaviacCompareKernel<EBehaviacOperatorType::NotEqual>;
+	case EBehaviacOperatorType::Greater:			return &BehaviacCompareKernel<EBehaviacOperatorType::Greater>;
+	case EBehaviacOperatorType::Less:			return &BehaviacCompareKernel<EBehaviacOperatorType::Less>;
+	case EBehaviacOperatorType::GreaterEqual:	return &BehaviacCompareKernel<EBehaviacOperatorType::GreaterEqual>;
+	case EBehaviacOperatorType::LessEqual:		return &BehaviacCompareKernel<EBehaviacOperatorType::LessEqual>;
+	default:									return &BehaviacCompareNever;
+	}
+}
+
+static double BehaviacAdd(double Left, double Right)		{ return Left + Right; }
+static double BehaviacSubtract(double Left, double Right)	{ return Left - Right; }
+static double BehaviacMultiply(double Left, double Right)	{ return Left * Right; }
+static double BehaviacDivide(double Left, double Right)		{ return (Right != 0.0) ? Left / Right : 0.0; }
+static double BehaviacArithmeticZero(double Left, double Right) { return 0.0; }
+
+FBehaviacArithmeticKernel BehaviacSelectArithmeticKernel(EBehaviacOperatorType Operator)
+{
+	switch (Operator)
+	{
+	case EBehaviacOperatorType::Add:		return &BehaviacAdd;
+	case EBehaviacOperatorType::Subtract:	return &BehaviacSubtract;
+	case EBehaviacOperatorType::Multiply:	return &BehaviacMultiply;
+	case EBehaviacOperatorType::Divide:		return &BehaviacDivide;
+	default:								return &BehaviacArithmeticZero;
+	}
+}
+
+// ===================================================================
+// FBehaviacComparison
+// ===================================================================
+
+void FBehaviacComparison::Resolve(const FString& LeftText, EBehaviacOperandMode LeftMode,
+	const FString& RightText, EBehaviacOperandMode RightMode,
+	EBehaviacOperatorType InOperator, ESearchCase::Type InStringCase)
+{
+	Left = FBehaviacOperand::Resolve(LeftText, LeftMode);
+	Right = FBehaviacOperand::Resolve(RightText, RightMode);
+	Operator = InOperator;
+	StringCase = InStringCase;
+	Kernel = SelectKernel(InOperator, InStringCase);
+	PredicateId = FBehaviacPredicateRegistry::FindOrAdd(*this);
+	SetMemoized(false);
+}
+
+void FBehaviacComparison::SetMemoized(bool bInMemoize)
+{
+	bMemoize = bInMemoize && PredicateId != INDEX_NONE;
+	MemoKeys = FBehaviacObservedKeys();
+	if (bMemoize)
+	{
+		Left.GatherObservedKeys(MemoKeys);
+		Right.GatherObservedKeys(MemoKeys);
+	}
+}
+
+/** True when a PropertyOrMethod operand has no usable property value and must call its method. */
+static bool BehaviacNeedsFallback(UBehaviacAgentComponent* Agent, const FBehaviacOperand& Operand, int32& SlotHint)
+{
+	if (Operand.Kind != FBehaviacOperand::EKind::PropertyOrMethod)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	const FBehaviacValue* Value = Operand.Find(Agent->GetBlackboard(), SlotHint);
+	// An empty string counts as unset, as it did for the string-based evaluator
+	return !Value || (Value->GetType() == EBehaviacValueType::String && Value->GetString().IsEmpty());
+}
+
+bool FBehaviacComparison::Evaluate(UBehaviacAgentComponent* Agent, int32* SlotHints) const
+{
+	if (!Agent || !Kernel)
+	{
+		return false;
+	}
+
+	int32 LocalHints[2] = { INDEX_NONE, INDEX_NONE };
+	int32* Hints = SlotHints ? SlotHints : LocalHints;
+
+	// Shared predicates reuse this tick's result while the keys they read are unchanged
+	FBehaviacPredicateCache* Cache = nullptr;
+	if (bMemoize && CVarBehaviacPredicateCache.GetValueOnAnyThread() != 0)
+	{
+		Cache = &Agent->GetPredicateCache();
+
+		FScopeLock Lock(&Agent->GetBlackboardLock());
+		bool bCached = false;
+		if (Cache->Find(PredicateId, MemoKeys, Agent->GetBlackboard(), bCached))
+		{
+			return bCached;
+		}
+	}
+
+	// Fallback methods run outside the lock; handlers are free to write properties.
+	FBehaviacValue LeftCalled;
+	FBehaviacValue RightCalled;
+	const bool bLeftCalled = BehaviacNeedsFallback(Agent, Left, Hints[0]);
+	if (bLeftCalled)
+	{
+		LeftCalled = Left.CallFallbackMethod(Agent);
+	}
+	const bool bRightCalled = BehaviacNeedsFallback(Agent, Right, Hints[1]);
+	if (bRightCalled)
+	{
+		RightCalled = Right.CallFallbackMethod(Agent);
+	}
+
+	static const FBehaviacValue Unset;
+
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	const FBehaviacBlackboard& Blackboard = Agent->GetBlackboard();
+	const FBehaviacValue* LeftValue = bLeftCalled ? &LeftCalled : Left.Find(Blackboard, Hints[0]);
+	const FBehaviacValue* RightValue = bRightCalled ? &RightCalled : Right.Find(Blackboard, Hints[1]);
+
+	const bool bResult = Kernel(LeftValue ? *LeftValue : Unset, RightValue ? *RightValue : Unset);
+	if (Cache && !bLeftCalled && !bRightCalled)
+	{
+		Cache->Store(PredicateId, Blackboard.GetWriteSerial(), bResult);
+	}
+	return bResult;
+}
+
+// ===================================================================
+// FBehaviacPredicateRegistry
+// ===================================================================
+
+namespace BehaviacPredicateRegistry
+{
+	/** Texts compare case-sensitively, as constants do */
+	struct FKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	static FRWLock Lock;
+	static TMap<FString, int32, FDefaultSetAllocator, FKeyFuncs> Ids;
+
+	/** Canonical text of an operand; length-prefixed so constants cannot run into each other */
+	static void AppendOperand(FString& Out, const FBehaviacOperand& Operand)
+	{
+		switch (Operand.Kind)
+		{
+		case FBehaviacOperand::EKind::Constant:
+		{
+			TStringBuilder<128> Text;
+			Operand.Constant.AppendString(Text);
+			Out += FString::Printf(TEXT("C%d:%d:%s"), (int32)Operand.Constant.GetType(), Text.Len(), Text.ToString());
+			break;
+		}
+		case FBehaviacOperand::EKind::Property:
+			Out += TEXT("P:") + Operand.Key.ToString().ToLower();
+			break;
+		case FBehaviacOperand::EKind::PropertyOrMethod:
+			Out += FString::Printf(TEXT("M%d:%s"), Operand.MethodId, *Operand.Key.ToString().ToLower());
+			break;
+		}
+	}
+}
+
+int32 FBehaviacPredicateRegistry::FindOrAdd(const FBehaviacComparison& Comparison)
+{
+	FString Text = FString::Printf(TEXT("%d%s|"), (int32)Comparison.Operator,
+		Comparison.StringCase == ESearchCase::IgnoreCase ? TEXT("i") : TEXT(""));
+	BehaviacPredicateRegistry::AppendOperand(Text, Comparison.Left);
+	Text += TEXT("|");
+	BehaviacPredicateRegistry::AppendOperand(Text, Comparison.Right);
+
+	{
+		FReadScopeLock ReadLock(BehaviacPredicateRegistry::Lock);
+		if (const int32* Existing = BehaviacPredicateRegistry::Ids.Find(Text))
+		{
+			return *Existing;
+		}
+	}
+
+	FWriteScopeLock WriteLock(BehaviacPredicateRegistry::Lock);
+	if (const int32* Existing = BehaviacPredicateRegistry::Ids.Find(Text))
+	{
+		return *Existing;
+	}
+	const int32 Id = BehaviacPredicateRegistry::Ids.Num();
+	BehaviacPredicateRegistry::Ids.Add(MoveTemp(Text), Id);
+	return Id;
+}
+
+int32 FBehaviacPredicateRegistry::Num()
+{
+	FReadScopeLock ReadLock(BehaviacPredicateRegistry::Lock);
+	return BehaviacPredicateRegistry::Ids.Num();
+}
+
+// ===================================================================
+// FBehaviacPredicateCache
+// ===================================================================
+
+bool FBehaviacPredicateCache::Find(int32 Id, const FBehaviacObservedKeys& Keys, const FBehaviacBlackboard& Blackboard, bool& bOutResult)
+{
+	if (!Entries.IsValidIndex(Id) || Entries[Id].Epoch != Epoch)
+	{
+		++Misses;
+		return false;
+	}
+
+	const FEntry& Entry = Entries[Id];
+	if (Keys.HaveChangedSince(Blackboard, Entry.Serial))
+	{
+		++Invalidations;
+		return false;
+	}
+
+	++Hits;
+	bOutResult = Entry.bResult;
+	return true;
+}
+
+void FBehaviacPredicateCache::Store(int32 Id, uint64 Serial, bool bResult)
+{
+	if (Id < 0)
+	{
+		return;
+	}
+	if (Id >= Entries.Num())
+	{
+		Entries.SetNum(Id + 1);
+	}
+
+	FEntry& Entry = Entries[Id];
+	Entry.Epoch = Epoch;
+	Entry.Serial = Serial;
+	Entry.bResult = bResult;
+}
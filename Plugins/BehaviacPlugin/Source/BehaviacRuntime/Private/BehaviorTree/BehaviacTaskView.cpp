@@ -0,0 +1,56 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTaskView.h"
+#include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviacAgent.h"
+
+UBehaviacTaskView* UBehaviacTaskView::Create(UBehaviacAgentComponent* Agent, const FBehaviacBehaviorTask* Task)
+{
+	if (!Agent || !Task)
+	{
+		return nullptr;
+	}
+
+	UBehaviacTaskView* View = NewObject<UBehaviacTaskView>(Agent);
+	View->Agent = Agent;
+	View->Task = Task;
+	View->TreeSerial = Agent->GetTaskTreeSerial();
+	return View;
+}
+
+const FBehaviacBehaviorTask* UBehaviacTaskView::GetTask() const
+{
+	const UBehaviacAgentComponent* Owner = Agent.Get();
+	return Owner && Owner->GetTaskTreeSerial() == TreeSerial ? Task : nullptr;
+}
+
+EBehaviacStatus UBehaviacTaskView::GetStatus() const
+{
+	const FBehaviacBehaviorTask* Viewed = GetTask();
+	return Viewed ? Viewed->GetStatus() : EBehaviacStatus::Invalid;
+}
+
+UBehaviacBehaviorNode* UBehaviacTaskView::GetNode() const
+{
+	const FBehaviacBehaviorTask* Viewed = GetTask();
+	return Viewed ? Viewed->GetNode() : nullptr;
+}
+
+TArray<UBehaviacTaskView*> UBehaviacTaskView::GetChildren() const
+{
+	TArray<UBehaviacTaskView*> Children;
+	if (const FBehaviacBehaviorTask* Viewed = GetTask())
+	{
+		UBehaviacAgentComponent* Owner = Agent.Get();
+		Children.Reserve(Viewed->GetNumChildTasks());
+		for (int32 Index = 0; Index < Viewed->GetNumChildTasks(); ++Index)
+		{
+			if (UBehaviacTaskView* Child = Create(Owner, Viewed->GetChildTask(Index)))
+			{
+				Children.Add(Child);
+			}
+		}
+	}
+	return Children;
+}
@@ -0,0 +1,220 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTreeAsyncLoader.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+#include "BehaviorTree/BehaviacTreeRegistry.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	/** What the worker read for one tree file */
+	struct FTreeFileData
+	{
+		FString File;
+		FFileStatData Stat;
+		uint32 ContentHash = 0;
+		TArray<uint8> Compiled;
+		FString Error;
+	};
+
+	/** Read File and compile it if it is XML. Any thread. */
+	void ReadTreeFile(FTreeFileData& Out)
+	{
+		Out.Stat = IFileManager::Get().GetStatData(*Out.File);
+		if (FBehaviacTreeBinary::GetFileFormat(Out.File) == EBehaviacFileFormat::BSON)
+		{
+			if (!Out.Stat.bIsValid || !FFileHelper::LoadFileToArray(Out.Compiled, *Out.File, FILEREAD_Silent))
+			{
+				Out.Error = TEXT("could not read the file");
+				return;
+			}
+			Out.ContentHash = FBehaviacTreeBinary::GetChecksum(Out.Compiled);
+			return;
+		}
+
+		FString Content;
+		if (!Out.Stat.bIsValid || !FFileHelper::LoadFileToString(Content, *Out.File))
+		{
+			Out.Error = TEXT("could not read the file");
+			return;
+		}
+		Out.ContentHash = FCrc::StrCrc32(*Content);
+		FBehaviacTreeBinary::CompileXML(Content, Out.Compiled, Out.Error);
+	}
+}
+
+FBehaviacTreeAsyncLoader& FBehaviacTreeAsyncLoader::Get()
+{
+	static FBehaviacTreeAsyncLoader Loader;
+	return Loader;
+}
+
+void FBehaviacTreeAsyncLoader::LoadFile(const FString& FilePath, FBehaviacTreeLoadedDelegate OnLoaded)
+{
+	check(IsInGameThread());
+
+	const bool bUseCache = CVarBehaviacTreeFileCache.GetValueOnGameThread() != 0;
+	const FString Key = FBehaviacTreeFileCache::NormalizePath(FilePath);
+	if (bUseCache)
+	{
+		if (UBehaviacBehaviorTree* Cached = FBehaviacTreeFileCache::Get().Find(FBehaviacTreeBinary::ChooseFile(Key)))
+		{
+			OnLoaded.ExecuteIfBound(Cached);
+			return;
+		}
+	}
+
+	const FString RequestKey = TEXT("file:") + Key;
+	if (!Enqueue(RequestKey, MoveTemp(OnLoaded)))
+	{
+		return;
+	}
+
+	UE::Tasks::Launch(TEXT("Behaviac.LoadTreeFile"), [this, Key, RequestKey, bUseCache]()
+	{
+		TSharedRef<FTreeFileData> Data = MakeShared<FTreeFileData>();
+		Data->File = FBehaviacTreeBinary::ChooseFile(Key);
+		ReadTreeFile(*Data);
+
+		AsyncTask(ENamedThreads::GameThread, [this, Data, RequestKey, bUseCache]()
+		{
+			if (!Data->Error.IsEmpty())
+			{
+				UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to load behavior tree from file: %s, %s"), *Data->File, *Data->Error);
+				Complete(RequestKey, nullptr);
+				return;
+			}
+
+			// A synchronous load may have cached the file meanwhile
+			FBehaviacTreeFileCache& Cache = FBehaviacTreeFileCache::Get();
+			UBehaviacBehaviorTree* Tree = bUseCache ? Cache.Find(Data->File) : nullptr;
+			if (!Tree)
+			{
+				Tree = FBehaviacTreeBinary::LoadTree(Data->File, Data->Compiled);
+				if (Tree && bUseCache)
+				{
+					Cache.Add(Data->File, Tree, Data->Stat, Data->ContentHash);
+				}
+			}
+			Complete(RequestKey, Tree);
+		});
+	});
+}
+
+void FBehaviacTreeAsyncLoader::LoadAsset(const FSoftObjectPath& AssetPath, FBehaviacTreeLoadedDelegate OnLoaded)
+{
+	check(IsInGameThread());
+
+	if (UBehaviacBehaviorTree* Loaded = Cast<UBehaviacBehaviorTree>(AssetPath.ResolveObject()))
+	{
+		OnLoaded.ExecuteIfBound(Loaded);
+		return;
+	}
+
+	const FString RequestKey = TEXT("asset:") + AssetPath.ToString();
+	if (!Enqueue(RequestKey, MoveTemp(OnLoaded)))
+	{
+		return;
+	}
+
+	Streamable.RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateLambda([this, AssetPath, RequestKey]()
+	{
+		UBehaviacBehaviorTree* Tree = Cast<UBehaviacBehaviorTree>(AssetPath.ResolveObject());
+		if (!Tree)
+		{
+			UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] No behavior tree asset at %s"), *AssetPath.ToString());
+		}
+		Complete(RequestKey, Tree);
+	}));
+}
+
+void FBehaviacTreeAsyncLoader::LoadPath(const FString& Path, FBehaviacTreeLoadedDelegate OnLoaded)
+{
+	check(IsInGameThread());
+
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+	const FString Key = FBehaviacTreeRegistry::NormalizePath(Path);
+	if (Key.IsEmpty())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+	if (UBehaviacBehaviorTree* Existing = Registry.Find(Key))
+	{
+		OnLoaded.ExecuteIfBound(Existing);
+		return;
+	}
+
+	const FString RequestKey = TEXT("path:") + Key;
+	if (!Enqueue(RequestKey, MoveTemp(OnLoaded)))
+	{
+		return;
+	}
+
+	// Registered under the path once it arrives, like a synchronous registry load
+	auto OnArrived = [this, Key, RequestKey, Path](const FString& LoadedFile)
+	{
+		return FBehaviacTreeLoadedDelegate::CreateLambda([this, Key, RequestKey, Path, LoadedFile](UBehaviacBehaviorTree* Tree)
+		{
+			if (Tree)
+			{
+				FBehaviacTreeRegistry::Get().Register(Key, Tree, LoadedFile);
+			}
+			else
+			{
+				UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Could not find behavior tree for path: %s"), *Path);
+			}
+			Complete(RequestKey, Tree);
+		});
+	};
+
+	// Asset first, then the XML or compiled file
+	const FString AssetPath = FBehaviacTreeRegistry::GetAssetPath(Key);
+	if (!AssetPath.IsEmpty() && FPackageName::DoesPackageExist(FPackageName::ObjectPathToPackageName(AssetPath)))
+	{
+		LoadAsset(FSoftObjectPath(AssetPath), OnArrived(FString()));
+		return;
+	}
+
+	const FString FilePath = FBehaviacTreeRegistry::GetFilePath(Key);
+	if (FPaths::FileExists(FilePath) || FPaths::FileExists(FBehaviacTreeBinary::GetBinaryPath(FilePath)))
+	{
+		LoadFile(FilePath, OnArrived(FilePath));
+		return;
+	}
+	OnArrived(FString()).Execute(nullptr);
+}
+
+bool FBehaviacTreeAsyncLoader::Enqueue(const FString& Key, FBehaviacTreeLoadedDelegate&& OnLoaded)
+{
+	if (TArray<FBehaviacTreeLoadedDelegate>* Waiting = Pending.Find(Key))
+	{
+		Waiting->Add(MoveTemp(OnLoaded));
+		return false;
+	}
+	Pending.Add(Key).Add(MoveTemp(OnLoaded));
+	return true;
+}
+
+void FBehaviacTreeAsyncLoader::Complete(const FString& Key, UBehaviacBehaviorTree* Tree)
+{
+	TArray<FBehaviacTreeLoadedDelegate> Waiting;
+	if (!Pending.RemoveAndCopyValue(Key, Waiting))
+	{
+		return;
+	}
+
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Async load %s done, %d request(s)"), *Key, Waiting.Num());
+	for (FBehaviacTreeLoadedDelegate& OnLoaded : Waiting)
+	{
+		OnLoaded.ExecuteIfBound(Tree);
+	}
+}
@@ -0,0 +1,601 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacXmlReader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+TAutoConsoleVariable<int32> CVarBehaviacPreferBinaryTrees(
+	TEXT("Behaviac.PreferBinaryTrees"),
+	1,
+	TEXT("Load a tree file's compiled .bhvb sibling instead of its XML when the .bhvb is at least as new.\n")
+	TEXT("  0 = always parse the XML (ignored in shipping builds, which never parse XML)\n")
+	TEXT("  1 = prefer the compiled file (default)"),
+	ECVF_Default
+);
+
+namespace
+{
+	using FHeader = FBehaviacTreeBinary::FHeader;
+	using FStringRecord = FBehaviacTreeBinary::FStringRecord;
+	using FNodeRecord = FBehaviacTreeBinary::FNodeRecord;
+	using FAttachmentRecord = FBehaviacTreeBinary::FAttachmentRecord;
+	using FPropertyRecord = FBehaviacTreeBinary::FPropertyRecord;
+
+	/** Elements of the compiled node a reader is inside: filled as it goes, flushed at its end tag */
+	struct FPendingNode
+	{
+		int32 Record = INDEX_NONE;
+		TArray<FPropertyRecord> Properties;
+		TArray<FAttachmentRecord> Attachments;
+		TArray<FPropertyRecord> AttachmentProperties;
+	};
+
+	/**
+	 * Walks tree XML with FBehaviacXmlReader, following the same element rules
+	 * as UBehaviacBehaviorTree::LoadFromXML, and lays out the tables.
+	 */
+	class FBehaviacTreeCompiler
+	{
+	public:
+		explicit FBehaviacTreeCompiler(FBehaviacXmlReader& InReader)
+			: Reader(InReader)
+		{
+		}
+
+		bool Compile(FString& OutError)
+		{
+			if (Reader.Next() != EBehaviacXmlToken::StartElement)
+			{
+				OutError = Reader.GetErrorMessage();
+				return false;
+			}
+
+			FStringView VersionStr;
+			if (Reader.FindAttribute(TEXT("version"), VersionStr) && !VersionStr.IsEmpty())
+			{
+				TreeVersion = FCString::Atoi(*FString(VersionStr));
+			}
+			AgentType = Intern(Reader.GetAttribute(TEXT("agenttype")));
+
+			bool bFoundNode = false;
+			for (;;)
+			{
+				const EBehaviacXmlToken Token = Reader.Next();
+				if (Token == EBehaviacXmlToken::EndElement)
+				{
+					break;
+				}
+
+				FStringView ClassAttr;
+				const bool bIsNode = Token == EBehaviacXmlToken::StartElement
+					&& (Reader.GetName() == TEXT("node") || (Reader.FindAttribute(TEXT("class"), ClassAttr) && !ClassAttr.IsEmpty()));
+				const bool bOk = Token == EBehaviacXmlToken::StartElement
+					&& (bIsNode && !bFoundNode ? ReadNode(0) : Reader.SkipElement());
+				if (!bOk)
+				{
+					OutError = Reader.GetErrorMessage();
+					return false;
+				}
+				bFoundNode |= bIsNode;
+			}
+
+			if (Reader.Next() != EBehaviacXmlToken::EndOfDocument)
+			{
+				OutError = Reader.GetErrorMessage();
+				return false;
+			}
+
+			if (!bFoundNode)
+			{
+				OutError = TEXT("no <node> element");
+				return false;
+			}
+			return true;
+		}
+
+		void Write(TArray<uint8>& OutData) const
+		{
+			TArray<FStringRecord> StringRecords;
+			TArray<uint8> StringBytes;
+			StringRecords.Reserve(Strings.Num());
+			for (const FString& String : Strings)
+			{
+				const FTCHARToUTF8 Utf8(*String, String.Len());
+				StringRecords.Add({ (uint32)StringBytes.Num(), (uint32)Utf8.Length() });
+				StringBytes.Append((const uint8*)Utf8.Get(), Utf8.Length());
+			}
+			StringBytes.AddZeroed(Align(StringBytes.Num(), 4) - StringBytes.Num());
+
+			FHeader Header;
+			FMemory::Memzero(Header);
+			Header.Magic = FBehaviacTreeBinary::Magic;
+			Header.FormatVersion = FBehaviacTreeBinary::FormatVersion;
+			Header.HeaderSize = sizeof(FHeader);
+			Header.TreeVersion = TreeVersion;
+			Header.AgentType = AgentType;
+			Header.NumStrings = StringRecords.Num();
+			Header.NumNodes = Nodes.Num();
+			Header.NumAttachments = Attachments.Num();
+			Header.NumProperties = Properties.Num();
+			Header.NumStringBytes = StringBytes.Num();
+
+			OutData.Reset();
+			Append(OutData, &Header, 1);
+			Append(OutData, StringRecords.GetData(), StringRecords.Num());
+			Append(OutData, Nodes.GetData(), Nodes.Num());
+			Append(OutData, Attachments.GetData(), Attachments.Num());
+			Append(OutData, Properties.GetData(), Properties.Num());
+			OutData.Append(StringBytes);
+
+			FHeader* Written = (FHeader*)OutData.GetData();
+			Written->PayloadSize = OutData.Num() - sizeof(FHeader);
+			Written->Checksum = FCrc::MemCrc32(OutData.GetData() + sizeof(FHeader), Written->PayloadSize);
+		}
+
+	private:
+		template <typename T>
+		static void Append(TArray<uint8>& OutData, const T* Records, int32 Num)
+		{
+			static_assert(sizeof(T) % 4 == 0, "Records keep every section 4-byte aligned");
+			OutData.Append((const uint8*)Records, Num * sizeof(T));
+		}
+
+		int32 Intern(const FString& String)
+		{
+			if (const int32* Existing = StringIndex.Find(String))
+			{
+				return *Existing;
+			}
+			const int32 Index = Strings.Add(String);
+			StringIndex.Add(String, Index);
+			return Index;
+		}
+
+		FPendingNode& GetPending(int32 Depth)
+		{
+			while (Pending.Num() <= Depth)
+			{
+				Pending.AddDefaulted();
+			}
+			return Pending[Depth];
+		}
+
+		/** Compile the <node> or <custom> the reader just started, through its end tag */
+		bool ReadNode(int32 Depth)
+		{
+			FStringView ClassView;
+			if (!Reader.FindAttribute(TEXT("class"), ClassView))
+			{
+				ClassView = Reader.GetName();
+			}
+			int32 LastColonIdx;
+			if (ClassView.FindLastChar(TEXT(':'), LastColonIdx))
+			{
+				ClassView.RightChopInline(LastColonIdx + 1);
+			}
+
+			FPendingNode& Node = GetPending(Depth);
+			Node.Record = Nodes.AddZeroed();
+			Node.Properties.Reset();
+			Node.Attachments.Reset();
+			Node.AttachmentProperties.Reset();
+			Nodes[Node.Record].ClassName = Intern(FString(ClassView));
+			const FString IdAttr = Reader.GetAttribute(TEXT("id"));
+
+			for (;;)
+			{
+				const EBehaviacXmlToken Token = Reader.Next();
+				if (Token == EBehaviacXmlToken::EndElement)
+				{
+					break;
+				}
+				if (Token != EBehaviacXmlToken::StartElement)
+				{
+					return false;
+				}
+
+				const FStringView Tag = Reader.GetName();
+				bool bOk = true;
+				if (Tag == TEXT("property"))
+				{
+					bOk = ReadProperty(GetPending(Depth).Properties);
+				}
+				else if (Tag == TEXT("node") || Tag == TEXT("custom"))
+				{
+					bOk = ReadNode(Depth + 1);
+				}
+				else if (Tag == TEXT("attachment"))
+				{
+					bOk = ReadAttachment(GetPending(Depth));
+				}
+				else
+				{
+					bOk = Reader.SkipElement();
+				}
+
+				if (!bOk)
+				{
+					return false;
+				}
+			}
+
+			// Deeper nodes may have grown Pending; look this one up again
+			FPendingNode& Done = GetPending(Depth);
+			if (!IdAttr.IsEmpty())
+			{
+				Done.Properties.Add({ Intern(TEXT("Id")), Intern(IdAttr) });
+			}
+
+			FNodeRecord& Record = Nodes[Done.Record];
+			Record.SubtreeSize = Nodes.Num() - Done.Record;
+			Record.FirstAttachment = Attachments.Num();
+			Record.NumAttachments = Done.Attachments.Num();
+			for (FAttachmentRecord Attachment : Done.Attachments)
+			{
+				Attachment.FirstProperty += Properties.Num();
+				Attachments.Add(Attachment);
+			}
+			Properties.Append(Done.AttachmentProperties);
+			Record.FirstProperty = Properties.Num();
+			Record.NumProperties = Done.Properties.Num();
+			Properties.Append(Done.Properties);
+			return true;
+		}
+
+		bool ReadProperty(TArray<FPropertyRecord>& OutProperties)
+		{
+			OutProperties.Add({ Intern(Reader.GetAttribute(TEXT("name"))), Intern(Reader.GetAttribute(TEXT("value"))) });
+			return Reader.SkipElement();
+		}
+
+		/** Compile the <attachment> the reader just started onto Node; its properties are placed when Node ends */
+		bool ReadAttachment(FPendingNode& Node)
+		{
+			FAttachmentRecord& Attachment = Node.Attachments.AddZeroed_GetRef();
+			Attachment.ClassName = Intern(Reader.GetAttribute(TEXT("class")));
+			Attachment.FirstProperty = Node.AttachmentProperties.Num();
+
+			for (;;)
+			{
+				const EBehaviacXmlToken Token = Reader.Next();
+				if (Token == EBehaviacXmlToken::EndElement)
+				{
+					break;
+				}
+				if (Token != EBehaviacXmlToken::StartElement)
+				{
+					return false;
+				}
+				const bool bOk = Reader.GetName() == TEXT("property")
+					? ReadProperty(Node.AttachmentProperties)
+					: Reader.SkipElement();
+				if (!bOk)
+				{
+					return false;
+				}
+			}
+			Attachment.NumProperties = Node.AttachmentProperties.Num() - Attachment.FirstProperty;
+			return true;
+		}
+
+		FBehaviacXmlReader& Reader;
+		int32 TreeVersion = 0;
+		int32 AgentType = INDEX_NONE;
+
+		TArray<FString> Strings;
+		TMap<FString, int32> StringIndex;
+		TArray<FNodeRecord> Nodes;
+		TArray<FAttachmentRecord> Attachments;
+		TArray<FPropertyRecord> Properties;
+		TArray<FPendingNode> Pending;
+	};
+
+	bool IsRange(int32 First, int32 Num, int32 Count)
+	{
+		return First >= 0 && Num >= 0 && (int64)First + Num <= Count;
+	}
+}
+
+// ===================================================================
+// FBehaviacTreeBinary
+// ===================================================================
+
+bool FBehaviacTreeBinary::CompileXML(FStringView XMLContent, TArray<uint8>& OutData, FString& OutError)
+{
+	FBehaviacXmlReader Reader(XMLContent);
+	FBehaviacTreeCompiler Compiler(Reader);
+	if (!Compiler.Compile(OutError))
+	{
+		return false;
+	}
+	Compiler.Write(OutData);
+	return true;
+}
+
+bool FBehaviacTreeBinary::CompileFile(const FString& XmlPath, const FString& BinaryPath)
+{
+	const FString OutPath = BinaryPath.IsEmpty() ? GetBinaryPath(XmlPath) : BinaryPath;
+
+	FString XMLContent;
+	if (!FFileHelper::LoadFileToString(XMLContent, *XmlPath))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *XmlPath);
+		return false;
+	}
+
+	TArray<uint8> Data;
+	FString Error;
+	if (!CompileXML(XMLContent, Data, Error))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to compile %s, %s"), *XmlPath, *Error);
+		return false;
+	}
+
+	// Leave identical output alone, but keep it newer than the XML so it is still preferred
+	TArray<uint8> Existing;
+	if (FFileHelper::LoadFileToArray(Existing, *OutPath, FILEREAD_Silent) && Existing == Data)
+	{
+		if (IFileManager::Get().GetTimeStamp(*OutPath) < IFileManager::Get().GetTimeStamp(*XmlPath))
+		{
+			IFileManager::Get().SetTimeStamp(*OutPath, FDateTime::UtcNow());
+		}
+		BEHAVIAC_VLOG(TEXT("[Behaviac] %s is up to date"), *OutPath);
+		return true;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Data, *OutPath))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Could not write %s"), *OutPath);
+		return false;
+	}
+	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Compiled %s to %s (%d bytes)"), *XmlPath, *OutPath, Data.Num());
+	return true;
+}
+
+FString FBehaviacTreeBinary::GetBinaryPath(const FString& XmlPath)
+{
+	return FPaths::ChangeExtension(XmlPath, TEXT("bhvb"));
+}
+
+EBehaviacFileFormat FBehaviacTreeBinary::GetFileFormat(const FString& FilePath)
+{
+	return FPaths::GetExtension(FilePath).Equals(TEXT("bhvb"), ESearchCase::IgnoreCase)
+		? EBehaviacFileFormat::BSON
+		: EBehaviacFileFormat::XML;
+}
+
+FString FBehaviacTreeBinary::ChooseFile(const FString& FilePath)
+{
+	if (GetFileFormat(FilePath) == EBehaviacFileFormat::BSON)
+	{
+		return FilePath;
+	}
+
+#if UE_BUILD_SHIPPING
+	return GetBinaryPath(FilePath);
+#else
+	if (CVarBehaviacPreferBinaryTrees.GetValueOnAnyThread() == 0)
+	{
+		return FilePath;
+	}
+
+	const FString BinaryPath = GetBinaryPath(FilePath);
+	const FFileStatData Binary = IFileManager::Get().GetStatData(*BinaryPath);
+	if (!Binary.bIsValid)
+	{
+		return FilePath;
+	}
+	const FFileStatData Xml = IFileManager::Get().GetStatData(*FilePath);
+	return !Xml.bIsValid || Binary.ModificationTime >= Xml.ModificationTime ? BinaryPath : FilePath;
+#endif
+}
+
+uint32 FBehaviacTreeBinary::GetChecksum(TConstArrayView<uint8> Data)
+{
+	return Data.Num() >= (int32)sizeof(FHeader) ? ((const FHeader*)Data.GetData())->Checksum : 0;
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeBinary::LoadTree(const FString& FilePath, TConstArrayView<uint8> Data)
+{
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->SourceFilePath = FilePath;
+	Tree->TreeName = FPaths::GetBaseFilename(FilePath);
+
+	if (Tree->LoadFromBinary(Data))
+	{
+		return Tree;
+	}
+
+	UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to load compiled behavior tree from file: %s"), *FilePath);
+	return nullptr;
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeBinary::LoadFile(const FString& FilePath)
+{
+	FBehaviacMappedTreeFile File;
+	if (!File.Open(FilePath))
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *FilePath);
+		return nullptr;
+	}
+	return LoadTree(FilePath, File.GetData());
+}
+
+// ===================================================================
+// FBehaviacTreeBinaryView
+// ===================================================================
+
+bool FBehaviacTreeBinaryView::Initialize(TConstArrayView<uint8> Data, FString& OutError)
+{
+	Header = nullptr;
+
+	if (Data.Num() < (int32)sizeof(FHeader))
+	{
+		OutError = TEXT("file is too short for a header");
+		return false;
+	}
+	if (!IsAligned(Data.GetData(), 4))
+	{
+		OutError = TEXT("data is not 4-byte aligned");
+		return false;
+	}
+
+	const FHeader* InHeader = (const FHeader*)Data.GetData();
+	if (InHeader->Magic != FBehaviacTreeBinary::Magic)
+	{
+		OutError = TEXT("not a compiled behavior tree");
+		return false;
+	}
+	if (InHeader->FormatVersion != FBehaviacTreeBinary::FormatVersion || InHeader->HeaderSize != sizeof(FHeader))
+	{
+		OutError = FString::Printf(TEXT("format version %d, expected %d; compile the tree again"),
+			InHeader->FormatVersion, FBehaviacTreeBinary::FormatVersion);
+		return false;
+	}
+	if ((int64)InHeader->PayloadSize != Data.Num() - (int64)sizeof(FHeader))
+	{
+		OutError = FString::Printf(TEXT("payload is %lld bytes, header says %u"), Data.Num() - (int64)sizeof(FHeader), InHeader->PayloadSize);
+		return false;
+	}
+	if (FCrc::MemCrc32(Data.GetData() + sizeof(FHeader), InHeader->PayloadSize) != InHeader->Checksum)
+	{
+		OutError = TEXT("checksum mismatch, the file is corrupt");
+		return false;
+	}
+
+	// Sections
+	if (InHeader->NumStrings < 0 || InHeader->NumNodes < 1 || InHeader->NumAttachments < 0 || InHeader->NumProperties < 0)
+	{
+		OutError = TEXT("bad table sizes");
+		return false;
+	}
+	const int64 Expected = (int64)sizeof(FBehaviacTreeBinary::FStringRecord) * InHeader->NumStrings
+		+ (int64)sizeof(FNodeRecord) * InHeader->NumNodes
+		+ (int64)sizeof(FAttachmentRecord) * InHeader->NumAttachments
+		+ (int64)sizeof(FPropertyRecord) * InHeader->NumProperties
+		+ InHeader->NumStringBytes;
+	if (Expected != InHeader->PayloadSize)
+	{
+		OutError = TEXT("tables do not fill the payload");
+		return false;
+	}
+
+	const uint8* Cursor = Data.GetData() + sizeof(FHeader);
+	Strings = MakeArrayView((const FBehaviacTreeBinary::FStringRecord*)Cursor, InHeader->NumStrings);
+	Cursor += Strings.NumBytes();
+	Nodes = MakeArrayView((const FNodeRecord*)Cursor, InHeader->NumNodes);
+	Cursor += Nodes.NumBytes();
+	Attachments = MakeArrayView((const FAttachmentRecord*)Cursor, InHeader->NumAttachments);
+	Cursor += Attachments.NumBytes();
+	Properties = MakeArrayView((const FPropertyRecord*)Cursor, InHeader->NumProperties);
+	Cursor += Properties.NumBytes();
+	StringBytes = Cursor;
+	Header = InHeader;
+
+	// Every index, once, so building the tree needs no checks
+	bool bValid = IsString(Header->AgentType, true);
+	for (const FBehaviacTreeBinary::FStringRecord& String : Strings)
+	{
+		bValid &= (uint64)String.Offset + String.Length <= Header->NumStringBytes;
+	}
+	for (const FPropertyRecord& Property : Properties)
+	{
+		bValid &= IsString(Property.Name, false) && IsString(Property.Value, false);
+	}
+	for (const FAttachmentRecord& Attachment : Attachments)
+	{
+		bValid &= IsString(Attachment.ClassName, false) && IsRange(Attachment.FirstProperty, Attachment.NumProperties, Properties.Num());
+	}
+
+	// Subtrees must nest: each one ends within its parent's
+	TArray<int32, TInlineAllocator<32>> OpenEnds;
+	bValid &= Nodes[0].SubtreeSize == Nodes.Num();
+	for (int32 i = 0; i < Nodes.Num() && bValid; i++)
+	{
+		const FNodeRecord& Node = Nodes[i];
+		bValid &= IsString(Node.ClassName, false)
+			&& Node.SubtreeSize >= 1
+			&& IsRange(i, Node.SubtreeSize, Nodes.Num())
+			&& IsRange(Node.FirstProperty, Node.NumProperties, Properties.Num())
+			&& IsRange(Node.FirstAttachment, Node.NumAttachments, Attachments.Num());
+
+		while (OpenEnds.Num() > 0 && OpenEnds.Last() <= i)
+		{
+			OpenEnds.Pop(EAllowShrinking::No);
+		}
+		bValid &= OpenEnds.Num() == 0 || i + Node.SubtreeSize <= OpenEnds.Last();
+		OpenEnds.Add(i + Node.SubtreeSize);
+	}
+
+	if (!bValid)
+	{
+		Header = nullptr;
+		OutError = TEXT("index out of range");
+		return false;
+	}
+	return true;
+}
+
+FString FBehaviacTreeBinaryView::GetString(int32 Index) const
+{
+	if (Index == INDEX_NONE)
+	{
+		return FString();
+	}
+	const FBehaviacTreeBinary::FStringRecord& String = Strings[Index];
+	const FUTF8ToTCHAR Converted((const ANSICHAR*)StringBytes + String.Offset, String.Length);
+	return FString(FStringView(Converted.Get(), Converted.Length()));
+}
+
+void FBehaviacTreeBinaryView::GetProperties(int32 First, int32 Num, TArray<FBehaviacProperty>& OutProperties) const
+{
+	OutProperties.Reserve(OutProperties.Num() + Num);
+	for (const FPropertyRecord& Property : Properties.Slice(First, Num))
+	{
+		OutProperties.Emplace(GetString(Property.Name), GetString(Property.Value));
+	}
+}
+
+bool FBehaviacTreeBinaryView::IsString(int32 Index, bool bAllowNone) const
+{
+	return (bAllowNone && Index == INDEX_NONE) || (Index >= 0 && Index < Strings.Num());
+}
+
+// ===================================================================
+// FBehaviacMappedTreeFile
+// ===================================================================
+
+bool FBehaviacMappedTreeFile::Open(const FString& FilePath)
+{
+	Region.Reset();
+	Handle.Reset();
+	Buffer.Reset();
+
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (Handle.IsValid() && Handle->GetFileSize() > 0)
+	{
+		Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+		if (Region.IsValid())
+		{
+			return true;
+		}
+	}
+
+	// No mapping on this platform (or for this file): read it instead
+	Handle.Reset();
+	return FFileHelper::LoadFileToArray(Buffer, *FilePath, FILEREAD_Silent) && Buffer.Num() > 0;
+}
+
+TConstArrayView<uint8> FBehaviacMappedTreeFile::GetData() const
+{
+	if (Region.IsValid())
+	{
+		return MakeArrayView(Region->GetMappedPtr(), (int32)Region->GetMappedSize());
+	}
+	return Buffer;
+}
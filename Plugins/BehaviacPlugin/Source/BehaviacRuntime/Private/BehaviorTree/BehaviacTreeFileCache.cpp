@@ -0,0 +1,195 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectHash.h"
+
+TAutoConsoleVariable<int32> CVarBehaviacTreeFileCache(
+	TEXT("Behaviac.TreeFileCache"),
+	1,
+	TEXT("Share the tree parsed from an XML file between every load of that file while it is unchanged.\n")
+	TEXT("  0 = parse the file on every load\n")
+	TEXT("  1 = parse once per file version (default)"),
+	ECVF_Default
+);
+
+FBehaviacTreeFileCache& FBehaviacTreeFileCache::Get()
+{
+	static FBehaviacTreeFileCache Cache;
+	return Cache;
+}
+
+FString FBehaviacTreeFileCache::NormalizePath(const FString& FilePath)
+{
+	FString Normalized = FPaths::ConvertRelativePathToFull(FilePath);
+	FPaths::NormalizeFilename(Normalized);
+	return Normalized;
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeFileCache::Load(const FString& FilePath)
+{
+	check(IsInGameThread());
+
+	const FString Key = NormalizePath(FilePath);
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*Key);
+
+	FEntry* Entry = Entries.Find(Key);
+	if (Entry && Stat.bIsValid && Entry->TimeStamp == Stat.ModificationTime && Entry->FileSize == Stat.FileSize)
+	{
+		++Hits;
+		return Entry->Tree;
+	}
+
+	// Compiled files are mapped and carry their own checksum; XML is read and hashed
+	const bool bCompiled = FBehaviacTreeBinary::GetFileFormat(Key) == EBehaviacFileFormat::BSON;
+	FBehaviacMappedTreeFile MappedFile;
+	FString FileContent;
+	const bool bRead = Stat.bIsValid
+		&& (bCompiled ? MappedFile.Open(Key) : FFileHelper::LoadFileToString(FileContent, *Key));
+	if (!bRead)
+	{
+		UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to read file: %s"), *FilePath);
+		return nullptr;
+	}
+
+	// Touched but not edited: the cached tree still matches
+	const uint32 ContentHash = bCompiled
+		? FBehaviacTreeBinary::GetChecksum(MappedFile.GetData())
+		: FCrc::StrCrc32(*FileContent);
+	if (Entry && Entry->ContentHash == ContentHash)
+	{
+		Entry->TimeStamp = Stat.ModificationTime;
+		Entry->FileSize = Stat.FileSize;
+		++Hits;
+		return Entry->Tree;
+	}
+
+	UBehaviacBehaviorTree* Tree = bCompiled
+		? FBehaviacTreeBinary::LoadTree(FilePath, MappedFile.GetData())
+		: Parse(FilePath, FileContent);
+	if (!Tree)
+	{
+		// A broken edit keeps the entry stale, so the next load tries the file again
+		return nullptr;
+	}
+
+	Add(FilePath, Tree, Stat, ContentHash);
+	return Tree;
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeFileCache::Find(const FString& FilePath) const
+{
+	check(IsInGameThread());
+
+	const FString Key = NormalizePath(FilePath);
+	const FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*Key);
+	return Stat.bIsValid && Entry->TimeStamp == Stat.ModificationTime && Entry->FileSize == Stat.FileSize
+		? Entry->Tree.Get()
+		: nullptr;
+}
+
+void FBehaviacTreeFileCache::Add(const FString& FilePath, UBehaviacBehaviorTree* Tree, const FFileStatData& Stat, uint32 ContentHash)
+{
+	check(IsInGameThread());
+
+	const FString Key = NormalizePath(FilePath);
+	FEntry* Entry = Entries.Find(Key);
+	if (Entry)
+	{
+		++Reloads;
+		UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] %s changed on disk, parsed again"), *Key);
+	}
+	else
+	{
+		++Misses;
+		Entry = &Entries.Add(Key);
+	}
+
+	Entry->Tree = Tree;
+	Entry->TimeStamp = Stat.ModificationTime;
+	Entry->FileSize = Stat.FileSize;
+	Entry->ContentHash = ContentHash;
+	Entry->Bytes = MeasureTree(Tree);
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Cached tree from %s (%lld bytes)"), *Key, Entry->Bytes);
+}
+
+bool FBehaviacTreeFileCache::Invalidate(const FString& FilePath)
+{
+	return Entries.Remove(NormalizePath(FilePath)) > 0;
+}
+
+int32 FBehaviacTreeFileCache::InvalidateByName(const FString& BaseName)
+{
+	int32 NumRemoved = 0;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (FPaths::GetBaseFilename(It.Key()).Equals(BaseName, ESearchCase::IgnoreCase))
+		{
+			It.RemoveCurrent();
+			++NumRemoved;
+		}
+	}
+	return NumRemoved;
+}
+
+void FBehaviacTreeFileCache::InvalidateAll()
+{
+	Entries.Empty();
+}
+
+FBehaviacTreeFileCacheStats FBehaviacTreeFileCache::GetStats() const
+{
+	FBehaviacTreeFileCacheStats Stats;
+	Stats.NumTrees = Entries.Num();
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Reloads = Reloads;
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		Stats.Bytes += Pair.Value.Bytes;
+	}
+	return Stats;
+}
+
+void FBehaviacTreeFileCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FString, FEntry>& Pair : Entries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Tree);
+	}
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeFileCache::Parse(const FString& FilePath, const FString& Content)
+{
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->SourceFilePath = FilePath;
+	Tree->TreeName = FPaths::GetBaseFilename(FilePath);
+
+	if (Tree->LoadFromXML(Content))
+	{
+		return Tree;
+	}
+
+	UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] Failed to parse behavior tree from file: %s"), *FilePath);
+	return nullptr;
+}
+
+int64 FBehaviacTreeFileCache::MeasureTree(const UBehaviacBehaviorTree* Tree)
+{
+	int64 Bytes = Tree->GetClass()->GetStructureSize();
+	ForEachObjectWithOuter(Tree, [&Bytes](UObject* Object)
+	{
+		Bytes += Object->GetClass()->GetStructureSize();
+	}, true);
+	return Bytes;
+}
@@ -0,0 +1,366 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTreeOptimizer.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/Composites/BehaviacComposites.h"
+#include "BehaviorTree/Actions/BehaviacActions.h"
+#include "BehaviorTree/Conditions/BehaviacConditions.h"
+#include "BehaviorTree/Decorators/BehaviacDecorators.h"
+
+TAutoConsoleVariable<int32> CVarBehaviacOptimizeTrees(
+	TEXT("Behaviac.OptimizeTrees"),
+	1,
+	TEXT("Optimize behavior trees after loading them from XML.\n")
+	TEXT("  0 = keep trees exactly as authored\n")
+	TEXT("  1 = fold constants, prune dead branches, collapse and fuse nodes (default)"),
+	ECVF_Default);
+
+namespace
+{
+	/** Node class, for the rewrites that must not apply to subclasses */
+	template <typename T>
+	bool IsExactly(const UBehaviacBehaviorNode* Node)
+	{
+		return Node && Node->GetClass() == T::StaticClass();
+	}
+
+	/** Status a True, False or Noop leaf always returns, or Invalid for any other node */
+	EBehaviacStatus GetConstantStatus(const UBehaviacBehaviorNode* Node)
+	{
+		if (!Node || Node->HasAttachments() || Node->GetChildCount() > 0)
+		{
+			return EBehaviacStatus::Invalid;
+		}
+		if (IsExactly<UBehaviacTrue>(Node) || IsExactly<UBehaviacNoop>(Node))
+		{
+			return EBehaviacStatus::Success;
+		}
+		if (IsExactly<UBehaviacFalse>(Node))
+		{
+			return EBehaviacStatus::Failure;
+		}
+		return EBehaviacStatus::Invalid;
+	}
+
+	class FOptimizer
+	{
+	public:
+		FOptimizer(UObject* InOuter, FBehaviacTreeOptimizerStats& InStats)
+			: Outer(InOuter)
+			, Stats(InStats)
+		{
+		}
+
+		/** Optimize Node's subtree, children first; returns the node that takes its place */
+		UBehaviacBehaviorNode* Visit(UBehaviacBehaviorNode* Node)
+		{
+			for (int32 Index = 0; Index < Node->Children.Num(); ++Index)
+			{
+				if (Node->Children[Index])
+				{
+					Node->Children[Index] = Visit(Node->Children[Index]);
+					Node->Children[Index]->SetParent(Node);
+				}
+			}
+
+			if (Node->HasAttachments())
+			{
+				return Node;
+			}
+
+			if (IsExactly<UBehaviacCondition>(Node))
+			{
+				return FoldCondition(CastChecked<UBehaviacCondition>(Node));
+			}
+			if (IsExactly<UBehaviacSequence>(Node) || IsExactly<UBehaviacSelector>(Node))
+			{
+				return OptimizeComposite(Node);
+			}
+			if (IsExactly<UBehaviacIfElse>(Node))
+			{
+				return OptimizeIfElse(Node);
+			}
+			if (IsExactly<UBehaviacDecoratorAlwaysSuccess>(Node) || IsExactly<UBehaviacDecoratorAlwaysFailure>(Node)
+				|| IsExactly<UBehaviacDecoratorNot>(Node) || IsExactly<UBehaviacDecoratorLoop>(Node))
+			{
+				return OptimizeDecorator(Node);
+			}
+			return Node;
+		}
+
+	private:
+		UObject* Outer;
+		FBehaviacTreeOptimizerStats& Stats;
+
+		/** Record Removed, and whatever was merged into it, as merged into Survivor */
+		static void Absorb(UBehaviacBehaviorNode* Survivor, const UBehaviacBehaviorNode* Removed)
+		{
+			Survivor->MergedNodeIds.Add(Removed->NodeId);
+			Survivor->MergedNodeIds.Append(Removed->MergedNodeIds);
+		}
+
+		/** Absorb Removed and its whole subtree; returns the number of nodes removed */
+		static int32 AbsorbSubtree(UBehaviacBehaviorNode* Survivor, const UBehaviacBehaviorNode* Removed)
+		{
+			if (!Removed)
+			{
+				return 0;
+			}
+			Absorb(Survivor, Removed);
+			int32 Count = 1;
+			for (const UBehaviacBehaviorNode* Child : Removed->Children)
+			{
+				Count += AbsorbSubtree(Survivor, Child);
+			}
+			return Count;
+		}
+
+		/** True or False leaf standing in for Replaced and its subtree */
+		UBehaviacBehaviorNode* MakeConstant(bool bSuccess, UBehaviacBehaviorNode* Replaced)
+		{
+			UBehaviacBehaviorNode* Constant = bSuccess
+				? static_cast<UBehaviacBehaviorNode*>(NewObject<UBehaviacTrue>(Outer))
+				: static_cast<UBehaviacBehaviorNode*>(NewObject<UBehaviacFalse>(Outer));
+			Constant->NodeId = Replaced->NodeId;
+			Constant->NodeClassName = bSuccess ? TEXT("True") : TEXT("False");
+			Constant->AgentType = Replaced->AgentType;
+			Constant->MergedNodeIds = Replaced->MergedNodeIds;
+			for (const UBehaviacBehaviorNode* Child : Replaced->Children)
+			{
+				AbsorbSubtree(Constant, Child);
+			}
+			Constant->EnsureOperandsResolved();
+			++Stats.ConstantsFolded;
+			return Constant;
+		}
+
+		/** Replace Node by its only child */
+		UBehaviacBehaviorNode* Collapse(UBehaviacBehaviorNode* Node, UBehaviacBehaviorNode* Child)
+		{
+			Absorb(Child, Node);
+			++Stats.NodesCollapsed;
+			return Child;
+		}
+
+		UBehaviacBehaviorNode* FoldCondition(UBehaviacCondition* Condition)
+		{
+			Condition->EnsureOperandsResolved();
+			const FBehaviacComparison& Comparison = Condition->GetComparison();
+			if (!Comparison.IsResolved() || !Comparison.Left.IsConstant() || !Comparison.Right.IsConstant())
+			{
+				return Condition;
+			}
+			return MakeConstant(Comparison.Kernel(Comparison.Left.Constant, Comparison.Right.Constant), Condition);
+		}
+
+		UBehaviacBehaviorNode* OptimizeDecorator(UBehaviacBehaviorNode* Node)
+		{
+			if (Node->GetChildCount() != 1 || !Node->Children[0])
+			{
+				return Node;
+			}
+			UBehaviacBehaviorNode* Child = Node->Children[0];
+
+			if (IsExactly<UBehaviacDecoratorLoop>(Node))
+			{
+				// One iteration returns the child's own result
+				return CastChecked<UBehaviacDecoratorLoop>(Node)->LoopCount == 1 ? Collapse(Node, Child) : Node;
+			}
+
+			const bool bNot = IsExactly<UBehaviacDecoratorNot>(Node);
+			const bool bForceSuccess = IsExactly<UBehaviacDecoratorAlwaysSuccess>(Node);
+
+			const EBehaviacStatus Constant = GetConstantStatus(Child);
+			if (Constant != EBehaviacStatus::Invalid)
+			{
+				return MakeConstant(bNot ? Constant == EBehaviacStatus::Failure : bForceSuccess, Node);
+			}
+
+			if (bNot || Child->HasAttachments())
+			{
+				return Node;
+			}
+
+			// The outer override wins over whatever the inner decorator made of the result
+			if ((IsExactly<UBehaviacDecoratorAlwaysSuccess>(Child) || IsExactly<UBehaviacDecoratorAlwaysFailure>(Child)
+				|| IsExactly<UBehaviacDecoratorNot>(Child)) && Child->GetChildCount() == 1 && Child->Children[0])
+			{
+				Absorb(Node, Child);
+				Node->Children[0] = Child->Children[0];
+				Node->Children[0]->SetParent(Node);
+				++Stats.NodesCollapsed;
+				return OptimizeDecorator(Node);
+			}
+
+			// An Action's ResultOption already overrides its terminal result
+			if (IsExactly<UBehaviacAction>(Child))
+			{
+				CastChecked<UBehaviacAction>(Child)->ResultOption = bForceSuccess ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+				Absorb(Child, Node);
+				++Stats.NodesFused;
+				return Child;
+			}
+			return Node;
+		}
+
+		UBehaviacBehaviorNode* OptimizeComposite(UBehaviacBehaviorNode* Node)
+		{
+			const bool bSequence = IsExactly<UBehaviacSequence>(Node);
+
+			// A child that returns Continue moves on to the next one; Stop ends the composite
+			const EBehaviacStatus Continue = bSequence ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+
+			TArray<UBehaviacBehaviorNode*> Kept;
+			for (int32 Index = 0; Index < Node->Children.Num(); ++Index)
+			{
+				UBehaviacBehaviorNode* Child = Node->Children[Index];
+				if (!Child)
+				{
+					continue;
+				}
+
+				// Sequence(A, Sequence(B, C)) is Sequence(A, B, C)
+				if (Child->GetClass() == Node->GetClass() && !Child->HasAttachments())
+				{
+					Absorb(Node, Child);
+					++Stats.NodesCollapsed;
+					Node->Children.Insert(Child->Children, Index + 1);
+					continue;
+				}
+
+				const EBehaviacStatus Constant = GetConstantStatus(Child);
+				if (Constant == Continue)
+				{
+					Stats.NodesPruned += AbsorbSubtree(Node, Child);
+					continue;
+				}
+
+				Kept.Add(Child);
+				if (Constant != EBehaviacStatus::Invalid)
+				{
+					// Nothing after a constant Stop can run
+					for (int32 Dead = Index + 1; Dead < Node->Children.Num(); ++Dead)
+					{
+						Stats.NodesPruned += AbsorbSubtree(Node, Node->Children[Dead]);
+					}
+					break;
+				}
+			}
+
+			if (bSequence)
+			{
+				FuseGuardedActions(Kept);
+			}
+
+			Node->Children = MoveTemp(Kept);
+			for (UBehaviacBehaviorNode* Child : Node->Children)
+			{
+				Child->SetParent(Node);
+			}
+
+			if (Node->Children.Num() == 0)
+			{
+				// Every child was skipped over: an empty Sequence succeeds, an empty Selector fails
+				return MakeConstant(bSequence, Node);
+			}
+			if (Node->Children.Num() == 1)
+			{
+				return Collapse(Node, Node->Children[0]);
+			}
+			return Node;
+		}
+
+		/** Replace each Condition directly followed by an Action with one GuardedAction */
+		void FuseGuardedActions(TArray<UBehaviacBehaviorNode*>& Children)
+		{
+			for (int32 Index = 0; Index + 1 < Children.Num(); ++Index)
+			{
+				UBehaviacBehaviorNode* Guard = Children[Index];
+				UBehaviacBehaviorNode* Act = Children[Index + 1];
+				if (!IsExactly<UBehaviacCondition>(Guard) || !IsExactly<UBehaviacAction>(Act) || Guard->HasAttachments() || Act->HasAttachments())
+				{
+					continue;
+				}
+
+				const UBehaviacCondition* Condition = CastChecked<UBehaviacCondition>(Guard);
+				const UBehaviacAction* Action = CastChecked<UBehaviacAction>(Act);
+
+				UBehaviacGuardedAction* Fused = NewObject<UBehaviacGuardedAction>(Outer);
+				Fused->NodeId = Action->NodeId;
+				Fused->NodeClassName = TEXT("GuardedAction");
+				Fused->AgentType = Action->AgentType;
+				Fused->MergedNodeIds = Action->MergedNodeIds;
+				Absorb(Fused, Condition);
+				Fused->MethodName = Action->MethodName;
+				Fused->ResultOption = Action->ResultOption;
+				Fused->GuardLeftOperand = Condition->LeftOperand;
+				Fused->GuardRightOperand = Condition->RightOperand;
+				Fused->GuardOperator = Condition->Operator;
+				Fused->EnsureOperandsResolved();
+
+				Children[Index] = Fused;
+				Children.RemoveAt(Index + 1);
+				++Stats.NodesFused;
+			}
+		}
+
+		UBehaviacBehaviorNode* OptimizeIfElse(UBehaviacBehaviorNode* Node)
+		{
+			const EBehaviacStatus Constant = Node->GetChildCount() >= 2 ? GetConstantStatus(Node->Children[0]) : EBehaviacStatus::Invalid;
+			if (Constant == EBehaviacStatus::Invalid)
+			{
+				return Node;
+			}
+
+			// The branch the constant condition always picks; the other one is dead
+			const int32 Taken = Constant == EBehaviacStatus::Success ? 1 : 2;
+			UBehaviacBehaviorNode* Branch = Node->Children.IsValidIndex(Taken) ? Node->Children[Taken] : nullptr;
+			if (!Branch)
+			{
+				// No else branch: the IfElse fails
+				return MakeConstant(false, Node);
+			}
+
+			for (int32 Index = 0; Index < Node->Children.Num(); ++Index)
+			{
+				if (Index != Taken)
+				{
+					Stats.NodesPruned += AbsorbSubtree(Branch, Node->Children[Index]);
+				}
+			}
+			return Collapse(Node, Branch);
+		}
+	};
+}
+
+UBehaviacBehaviorNode* FBehaviacTreeOptimizer::Optimize(UBehaviacBehaviorNode* Root, UObject* Outer, FBehaviacTreeOptimizerStats& OutStats)
+{
+	OutStats = FBehaviacTreeOptimizerStats();
+	if (!Root)
+	{
+		return nullptr;
+	}
+
+	OutStats.NodesBefore = CountNodes(Root);
+	FOptimizer Optimizer(Outer, OutStats);
+	UBehaviacBehaviorNode* NewRoot = Optimizer.Visit(Root);
+	NewRoot->SetParent(nullptr);
+	OutStats.NodesAfter = CountNodes(NewRoot);
+	return NewRoot;
+}
+
+int32 FBehaviacTreeOptimizer::CountNodes(const UBehaviacBehaviorNode* Root)
+{
+	if (!Root)
+	{
+		return 0;
+	}
+
+	int32 Count = 1;
+	for (const UBehaviacBehaviorNode* Child : Root->Children)
+	{
+		Count += CountNodes(Child);
+	}
+	return Count;
+}
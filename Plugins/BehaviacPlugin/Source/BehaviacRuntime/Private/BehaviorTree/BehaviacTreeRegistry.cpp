@@ -0,0 +1,402 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacTreeRegistry.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+#include "BehaviorTree/BehaviacBehaviorNode.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+#include "BehaviacAgent.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+// ===================================================================
+// FBehaviacTreeRegistry
+// ===================================================================
+
+FBehaviacTreeRegistry& FBehaviacTreeRegistry::Get()
+{
+	static FBehaviacTreeRegistry Registry;
+	return Registry;
+}
+
+FString FBehaviacTreeRegistry::NormalizePath(const FString& Path)
+{
+	FString Normalized = Path.TrimStartAndEnd().Replace(TEXT("\\"), TEXT("/"));
+	if (Normalized.EndsWith(TEXT(".xml"), ESearchCase::IgnoreCase))
+	{
+		Normalized.LeftChopInline(4, EAllowShrinking::No);
+	}
+	else if (Normalized.EndsWith(TEXT(".bhvb"), ESearchCase::IgnoreCase))
+	{
+		Normalized.LeftChopInline(5, EAllowShrinking::No);
+	}
+	if (!FPaths::IsRelative(Normalized))
+	{
+		// Absolute file paths stay as they are, minus the extension
+		return Normalized;
+	}
+	while (Normalized.StartsWith(TEXT("/")))
+	{
+		Normalized.RightChopInline(1, EAllowShrinking::No);
+	}
+	return Normalized;
+}
+
+FString FBehaviacTreeRegistry::GetAssetPath(const FString& Key)
+{
+	if (!FPaths::IsRelative(Key))
+	{
+		return FString();
+	}
+	return FString::Printf(TEXT("/Game/BehaviacData/%s.%s"), *Key, *FPaths::GetBaseFilename(Key));
+}
+
+FString FBehaviacTreeRegistry::GetFilePath(const FString& Key)
+{
+	return FPaths::IsRelative(Key)
+		? FPaths::ProjectContentDir() / TEXT("BehaviacData") / Key + TEXT(".xml")
+		: Key + TEXT(".xml");
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeRegistry::Load(const FString& Path)
+{
+	const FString Key = NormalizePath(Path);
+	if (Key.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	if (UBehaviacBehaviorTree* Existing = Find(Key))
+	{
+		return Existing;
+	}
+
+	check(IsInGameThread());
+
+	// Assets and files are read without the lock, which parallel agents take to follow their links
+	UBehaviacBehaviorTree* Tree = nullptr;
+	FString LoadedFile;
+	const FString AssetPath = GetAssetPath(Key);
+	if (!AssetPath.IsEmpty())
+	{
+		Tree = LoadObject<UBehaviacBehaviorTree>(nullptr, *AssetPath, nullptr, LOAD_Quiet | LOAD_NoWarn);
+	}
+	if (!Tree)
+	{
+		const FString FilePath = GetFilePath(Key);
+		if (FPaths::FileExists(FilePath) || FPaths::FileExists(FBehaviacTreeBinary::GetBinaryPath(FilePath)))
+		{
+			Tree = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, FilePath);
+			LoadedFile = FilePath;
+		}
+	}
+
+	if (!Tree)
+	{
+		UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Could not find behavior tree for path: %s"), *Path);
+		return nullptr;
+	}
+
+	Register(Key, Tree, LoadedFile);
+	UE_LOG(LogBehaviac, Log, TEXT("[Behaviac] Registered behavior tree %s as %s"), *Tree->GetName(), *Key);
+	return Tree;
+}
+
+UBehaviacBehaviorTree* FBehaviacTreeRegistry::Find(const FString& Path) const
+{
+	const FString Key = NormalizePath(Path);
+	UBehaviacBehaviorTree* Tree = nullptr;
+	FString FilePath;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const FEntry* Entry = Trees.Find(Key);
+		if (!Entry)
+		{
+			return nullptr;
+		}
+		Tree = Entry->Tree;
+		FilePath = Entry->FilePath;
+	}
+
+	// A tree parsed from a file is current while the file cache still holds it for the unchanged file
+	if (!FilePath.IsEmpty() && IsInGameThread() && CVarBehaviacTreeFileCache.GetValueOnGameThread() != 0
+		&& FBehaviacTreeFileCache::Get().Find(FBehaviacTreeBinary::ChooseFile(FilePath)) != Tree)
+	{
+		BEHAVIAC_VLOG(TEXT("[Behaviac] %s changed since %s was loaded from it"), *FilePath, *Key);
+		return nullptr;
+	}
+	return Tree;
+}
+
+void FBehaviacTreeRegistry::Register(const FString& Path, UBehaviacBehaviorTree* Tree, const FString& FilePath)
+{
+	const FString Key = NormalizePath(Path);
+	if (Key.IsEmpty() || !Tree)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FEntry& Entry = Trees.FindOrAdd(Key);
+	Entry.Tree = Tree;
+	Entry.FilePath = FilePath;
+	++Generation;
+}
+
+void FBehaviacTreeRegistry::Unregister(const FString& Path)
+{
+	const FString Key = NormalizePath(Path);
+
+	FScopeLock ScopeLock(&Lock);
+	FEntry Entry;
+	if (!Trees.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+	++Generation;
+
+	// Links of other trees to this one are made anew on their next resolve
+	if (Entry.Tree && !Contains(Entry.Tree))
+	{
+		Links.Remove(Entry.Tree.Get());
+		for (auto It = Links.CreateIterator(); It; ++It)
+		{
+			if (It.Value() == Entry.Tree.Get())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+bool FBehaviacTreeRegistry::Contains(const UBehaviacBehaviorTree* Tree) const
+{
+	FScopeLock ScopeLock(&Lock);
+	for (const TPair<FString, FEntry>& Pair : Trees)
+	{
+		if (Pair.Value.Tree == Tree)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+uint32 FBehaviacTreeRegistry::GetGeneration() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Generation;
+}
+
+bool FBehaviacTreeRegistry::AddLink(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To)
+{
+	if (!From || !To)
+	{
+		return true;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (From == To || IsLinkedLocked(To, From))
+	{
+		return false;
+	}
+	Links.AddUnique(From, To);
+	return true;
+}
+
+bool FBehaviacTreeRegistry::IsLinked(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return IsLinkedLocked(From, To);
+}
+
+bool FBehaviacTreeRegistry::IsLinkedLocked(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To) const
+{
+	TArray<const UBehaviacBehaviorTree*, TInlineAllocator<16>> Pending;
+	TSet<const UBehaviacBehaviorTree*> Visited;
+	Pending.Add(From);
+	while (Pending.Num() > 0)
+	{
+		const UBehaviacBehaviorTree* Tree = Pending.Pop(EAllowShrinking::No);
+		for (auto It = Links.CreateConstKeyIterator(Tree); It; ++It)
+		{
+			if (It.Value() == To)
+			{
+				return true;
+			}
+			if (!Visited.Contains(It.Value()))
+			{
+				Visited.Add(It.Value());
+				Pending.Add(It.Value());
+			}
+		}
+	}
+	return false;
+}
+
+int32 FBehaviacTreeRegistry::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Trees.Num();
+}
+
+void FBehaviacTreeRegistry::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FScopeLock ScopeLock(&Lock);
+	for (TPair<FString, FEntry>& Pair : Trees)
+	{
+		Collector.AddReferencedObject(Pair.Value.Tree);
+	}
+}
+
+// ===================================================================
+// FBehaviacSubtreeLink
+// ===================================================================
+
+TSharedPtr<const FBehaviacCompiledTree> FBehaviacSubtreeLink::Resolve(const UBehaviacBehaviorNode* Owner, const FString& Path, bool& bOutPending)
+{
+	bOutPending = false;
+
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+	{
+		FScopeLock ScopeLock(&Registry.GetLock());
+
+		// The registry changed since: a failed path may resolve now, and a linked tree may be gone
+		if (State != EState::Unlinked && Generation != Registry.GetGeneration())
+		{
+			if (State == EState::Failed || !Registry.Contains(Tree.Get()))
+			{
+				ResetLocked();
+			}
+			else
+			{
+				Generation = Registry.GetGeneration();
+			}
+		}
+
+		if (State == EState::Linked)
+		{
+			return Program;
+		}
+		if (State == EState::Failed)
+		{
+			return nullptr;
+		}
+		if (!IsInGameThread())
+		{
+			bOutPending = true;
+			return nullptr;
+		}
+	}
+
+	// Loaded and compiled without the lock; only the game thread gets here, so no other link is made meanwhile
+	TSharedPtr<const FBehaviacCompiledTree> TargetProgram;
+	UBehaviacBehaviorTree* Target = Registry.Load(Path);
+	if (Target)
+	{
+		// Trees built in code have no owning asset; only links between trees can close a cycle
+		const UBehaviacBehaviorTree* OwnerTree = Owner ? Owner->GetTypedOuter<UBehaviacBehaviorTree>() : nullptr;
+		if (!Registry.AddLink(OwnerTree, Target))
+		{
+			UE_LOG(LogBehaviac, Error, TEXT("[Behaviac] %s in %s references %s, which already runs it; not linked"),
+				*Owner->GetName(), *OwnerTree->GetName(), *Target->GetName());
+		}
+		else
+		{
+			TargetProgram = Target->GetCompiledTree();
+			if (!TargetProgram.IsValid())
+			{
+				UE_LOG(LogBehaviac, Warning, TEXT("[Behaviac] Referenced tree %s has nothing to run"), *Target->GetName());
+			}
+		}
+	}
+
+	FScopeLock ScopeLock(&Registry.GetLock());
+	Generation = Registry.GetGeneration();
+	if (!TargetProgram.IsValid())
+	{
+		State = EState::Failed;
+		return nullptr;
+	}
+
+	Tree = Target;
+	Program = TargetProgram;
+	bLazy = Target->bInstantiateBranchesLazily;
+	State = EState::Linked;
+	BEHAVIAC_VLOG(TEXT("[Behaviac] Linked %s to subtree %s (%d entries)"), *Owner->GetName(), *Target->GetName(), Program->GetNodes().Num());
+	return Program;
+}
+
+void FBehaviacSubtreeLink::Reset()
+{
+	FScopeLock ScopeLock(&FBehaviacTreeRegistry::Get().GetLock());
+	ResetLocked();
+}
+
+void FBehaviacSubtreeLink::ResetLocked()
+{
+	State = EState::Unlinked;
+	Tree.Reset();
+	Program.Reset();
+	bLazy = false;
+}
+
+UBehaviacBehaviorTree* FBehaviacSubtreeLink::GetTree() const
+{
+	FScopeLock ScopeLock(&FBehaviacTreeRegistry::Get().GetLock());
+	return Tree.Get();
+}
+
+bool FBehaviacSubtreeLink::IsLazy() const
+{
+	FScopeLock ScopeLock(&FBehaviacTreeRegistry::Get().GetLock());
+	return bLazy;
+}
+
+// ===================================================================
+// Subtree tasks
+// ===================================================================
+
+EBehaviacStatus BehaviacTickSubtree(UBehaviacAgentComponent* Agent, const UBehaviacBehaviorNode* Owner,
+	FBehaviacSubtreeLink& Link, const FString& Path, FBehaviacTreeInstance& Instance)
+{
+	if (!Agent)
+	{
+		return EBehaviacStatus::Failure;
+	}
+
+	if (!Instance.IsValid())
+	{
+		bool bPending = false;
+		TSharedPtr<const FBehaviacCompiledTree> Program = Link.Resolve(Owner, Path, bPending);
+		if (bPending)
+		{
+			TWeakObjectPtr<const UBehaviacBehaviorNode> WeakOwner(Owner);
+			FBehaviacSubtreeLink* LinkPtr = &Link;
+			Agent->EnqueueGameThreadCommand([WeakOwner, LinkPtr, Path]()
+			{
+				// The link lives in the node; a node that is gone took it along
+				if (const UBehaviacBehaviorNode* LiveOwner = WeakOwner.Get())
+				{
+					bool bStillPending = false;
+					LinkPtr->Resolve(LiveOwner, Path, bStillPending);
+				}
+			});
+			return EBehaviacStatus::Running;
+		}
+		if (!Program.IsValid())
+		{
+			return EBehaviacStatus::Failure;
+		}
+
+		// Only the agent's state is new; the program is the referenced tree's own
+		Instance.Create(Program, Link.IsLazy());
+		if (!Instance.IsValid())
+		{
+			return EBehaviacStatus::Failure;
+		}
+	}
+
+	return Instance.GetRoot()->Tick(Agent, Agent->bResumeRunningPath);
+}
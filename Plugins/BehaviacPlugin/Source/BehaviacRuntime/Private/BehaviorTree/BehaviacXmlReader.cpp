@@ -0,0 +1,428 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#include "BehaviorTree/BehaviacXmlReader.h"
+
+namespace
+{
+	bool IsXmlSpace(TCHAR C)
+	{
+		return C == TEXT(' ') || C == TEXT('\t') || C == TEXT('\n') || C == TEXT('\r');
+	}
+
+	bool IsNameChar(TCHAR C)
+	{
+		return !IsXmlSpace(C) && C != TEXT('/') && C != TEXT('>') && C != TEXT('<')
+			&& C != TEXT('=') && C != TEXT('"') && C != TEXT('\'');
+	}
+
+	/** Code point of a character reference between '&' and ';' ("#65", "#x41"); false unless every digit is valid */
+	bool ParseCharRef(FStringView Entity, uint32& OutCode)
+	{
+		if (Entity.Len() < 2 || Entity[0] != TEXT('#'))
+		{
+			return false;
+		}
+		const bool bHex = Entity[1] == TEXT('x') || Entity[1] == TEXT('X');
+		const FStringView Digits = Entity.RightChop(bHex ? 2 : 1);
+		if (Digits.IsEmpty() || Digits.Len() > 8)
+		{
+			return false;
+		}
+
+		uint32 Code = 0;
+		for (const TCHAR C : Digits)
+		{
+			uint32 Digit = 0;
+			if (C >= TEXT('0') && C <= TEXT('9'))				Digit = C - TEXT('0');
+			else if (bHex && C >= TEXT('a') && C <= TEXT('f'))	Digit = C - TEXT('a') + 10;
+			else if (bHex && C >= TEXT('A') && C <= TEXT('F'))	Digit = C - TEXT('A') + 10;
+			else return false;
+			Code = Code * (bHex ? 16 : 10) + Digit;
+		}
+
+		// Unicode scalar values only: no NUL, no lone surrogates
+		if (Code == 0 || Code > 0x10FFFF || (Code >= 0xD800 && Code <= 0xDFFF))
+		{
+			return false;
+		}
+		OutCode = Code;
+		return true;
+	}
+
+	/** The first character reference in Value that ParseCharRef rejects, if any */
+	bool FindMalformedCharRef(FStringView Value, FStringView& OutEntity)
+	{
+		for (int32 i = 0; i < Value.Len(); i++)
+		{
+			int32 Semi = INDEX_NONE;
+			if (Value[i] != TEXT('&') || i + 1 >= Value.Len() || Value[i + 1] != TEXT('#') || !Value.RightChop(i).FindChar(TEXT(';'), Semi))
+			{
+				continue;
+			}
+			const FStringView Entity = Value.Mid(i + 1, Semi - 1);
+			uint32 Code = 0;
+			if (!ParseCharRef(Entity, Code))
+			{
+				OutEntity = Entity;
+				return true;
+			}
+			i += Semi;
+		}
+		return false;
+	}
+}
+
+FBehaviacXmlReader::FBehaviacXmlReader(FStringView InText)
+	: Text(InText)
+{
+	// A byte order mark that survived decoding is not part of the document
+	if (Text.Len() > 0 && Text[0] == TEXT('\xFEFF'))
+	{
+		Pos = 1;
+	}
+}
+
+EBehaviacXmlToken FBehaviacXmlReader::Next()
+{
+	if (HasError())
+	{
+		return EBehaviacXmlToken::Error;
+	}
+
+	if (bPendingEnd)
+	{
+		bPendingEnd = false;
+		Attributes.Reset();
+		return EBehaviacXmlToken::EndElement;
+	}
+
+	Attributes.Reset();
+
+	for (;;)
+	{
+		// Text between tags is not part of the behaviac dialect
+		while (Pos < Text.Len() && Text[Pos] != TEXT('<'))
+		{
+			++Pos;
+		}
+		if (Pos >= Text.Len())
+		{
+			if (Open.Num() > 0)
+			{
+				return Fail(*FString::Printf(TEXT("end of document inside <%s>"), *FString(Open.Last())), Text.Len());
+			}
+			if (!bSeenRoot)
+			{
+				return Fail(TEXT("no root element"), Text.Len());
+			}
+			return EBehaviacXmlToken::EndOfDocument;
+		}
+
+		TagStart = Pos;
+		const FStringView Rest = Text.RightChop(Pos);
+		if (Rest.StartsWith(TEXT("<!--")))
+		{
+			if (!SkipPast(TEXT("-->")))
+			{
+				return Fail(TEXT("unterminated comment"), TagStart);
+			}
+		}
+		else if (Rest.StartsWith(TEXT("<![CDATA[")))
+		{
+			if (!SkipPast(TEXT("]]>")))
+			{
+				return Fail(TEXT("unterminated CDATA section"), TagStart);
+			}
+		}
+		else if (Rest.StartsWith(TEXT("<?")))
+		{
+			if (!SkipPast(TEXT("?>")))
+			{
+				return Fail(TEXT("unterminated processing instruction"), TagStart);
+			}
+		}
+		else if (Rest.StartsWith(TEXT("<!")))
+		{
+			if (!SkipPast(TEXT(">")))
+			{
+				return Fail(TEXT("unterminated declaration"), TagStart);
+			}
+		}
+		else if (Rest.StartsWith(TEXT("</")))
+		{
+			return ReadEndTag();
+		}
+		else
+		{
+			return ReadStartTag();
+		}
+	}
+}
+
+bool FBehaviacXmlReader::SkipElement()
+{
+	int32 Level = 1;
+	while (Level > 0)
+	{
+		switch (Next())
+		{
+		case EBehaviacXmlToken::StartElement:
+			++Level;
+			break;
+		case EBehaviacXmlToken::EndElement:
+			--Level;
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FBehaviacXmlReader::FindAttribute(FStringView AttributeName, FStringView& OutValue) const
+{
+	for (const TPair<FStringView, FStringView>& Attribute : Attributes)
+	{
+		if (Attribute.Key.Equals(AttributeName, ESearchCase::CaseSensitive))
+		{
+			OutValue = Attribute.Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+FString FBehaviacXmlReader::GetAttribute(FStringView AttributeName) const
+{
+	FStringView Value;
+	return FindAttribute(AttributeName, Value) ? DecodeText(Value) : FString();
+}
+
+FString FBehaviacXmlReader::GetErrorMessage() const
+{
+	if (!HasError())
+	{
+		return FString();
+	}
+	int32 Line = 0;
+	int32 Column = 0;
+	GetLocation(Line, Column);
+	return FString::Printf(TEXT("line %d, column %d: %s"), Line, Column, *Error);
+}
+
+void FBehaviacXmlReader::GetLocation(int32& OutLine, int32& OutColumn) const
+{
+	// Counted on demand: only errors and diagnostics pay for it
+	const int32 At = FMath::Min(HasError() ? ErrorPos : TagStart, Text.Len());
+	OutLine = 1;
+	int32 LineStart = 0;
+	for (int32 i = 0; i < At; i++)
+	{
+		if (Text[i] == TEXT('\n'))
+		{
+			++OutLine;
+			LineStart = i + 1;
+		}
+	}
+	OutColumn = At - LineStart + 1;
+}
+
+FString FBehaviacXmlReader::DecodeText(FStringView Raw)
+{
+	int32 Amp = INDEX_NONE;
+	if (!Raw.FindChar(TEXT('&'), Amp))
+	{
+		return FString(Raw);
+	}
+
+	FString Decoded;
+	Decoded.Reserve(Raw.Len());
+	Decoded.Append(Raw.GetData(), Amp);
+	for (int32 i = Amp; i < Raw.Len(); i++)
+	{
+		const TCHAR C = Raw[i];
+		int32 Semi = INDEX_NONE;
+		if (C != TEXT('&') || !Raw.RightChop(i).FindChar(TEXT(';'), Semi))
+		{
+			Decoded.AppendChar(C);
+			continue;
+		}
+
+		const FStringView Entity = Raw.Mid(i + 1, Semi - 1);
+		uint32 Code = 0;
+		if (ParseCharRef(Entity, Code))
+		{
+			if (Code > 0xFFFF && sizeof(TCHAR) == 2)
+			{
+				Code -= 0x10000;
+				Decoded.AppendChar((TCHAR)(0xD800 + (Code >> 10)));
+				Decoded.AppendChar((TCHAR)(0xDC00 + (Code & 0x3FF)));
+			}
+			else
+			{
+				Decoded.AppendChar((TCHAR)Code);
+			}
+			i += Semi;
+			continue;
+		}
+
+		TCHAR Replacement = 0;
+		if (Entity.Equals(TEXT("lt"), ESearchCase::CaseSensitive))			Replacement = TEXT('<');
+		else if (Entity.Equals(TEXT("gt"), ESearchCase::CaseSensitive))		Replacement = TEXT('>');
+		else if (Entity.Equals(TEXT("amp"), ESearchCase::CaseSensitive))		Replacement = TEXT('&');
+		else if (Entity.Equals(TEXT("quot"), ESearchCase::CaseSensitive))	Replacement = TEXT('"');
+		else if (Entity.Equals(TEXT("apos"), ESearchCase::CaseSensitive))	Replacement = TEXT('\'');
+
+		if (Replacement)
+		{
+			Decoded.AppendChar(Replacement);
+			i += Semi;
+		}
+		else
+		{
+			// Not an entity we know: keep it as written
+			Decoded.AppendChar(C);
+		}
+	}
+	return Decoded;
+}
+
+EBehaviacXmlToken FBehaviacXmlReader::Fail(const TCHAR* Message, int32 At)
+{
+	Error = Message;
+	ErrorPos = At;
+	return EBehaviacXmlToken::Error;
+}
+
+void FBehaviacXmlReader::SkipWhitespace()
+{
+	while (Pos < Text.Len() && IsXmlSpace(Text[Pos]))
+	{
+		++Pos;
+	}
+}
+
+bool FBehaviacXmlReader::SkipPast(FStringView Terminator)
+{
+	const int32 Found = Text.RightChop(Pos).Find(Terminator);
+	if (Found == INDEX_NONE)
+	{
+		return false;
+	}
+	Pos += Found + Terminator.Len();
+	return true;
+}
+
+FStringView FBehaviacXmlReader::ReadName()
+{
+	const int32 Start = Pos;
+	while (Pos < Text.Len() && IsNameChar(Text[Pos]))
+	{
+		++Pos;
+	}
+	return Text.Mid(Start, Pos - Start);
+}
+
+EBehaviacXmlToken FBehaviacXmlReader::ReadStartTag()
+{
+	++Pos;
+	Name = ReadName();
+	if (Name.IsEmpty())
+	{
+		return Fail(TEXT("expected an element name after '<'"), Pos);
+	}
+	if (bSeenRoot && Open.Num() == 0)
+	{
+		return Fail(*FString::Printf(TEXT("<%s> after the root element"), *FString(Name)), TagStart);
+	}
+
+	for (;;)
+	{
+		SkipWhitespace();
+		if (Pos >= Text.Len())
+		{
+			return Fail(*FString::Printf(TEXT("unterminated tag <%s>"), *FString(Name)), TagStart);
+		}
+
+		const TCHAR C = Text[Pos];
+		if (C == TEXT('>'))
+		{
+			++Pos;
+			Open.Add(Name);
+			bSeenRoot = true;
+			return EBehaviacXmlToken::StartElement;
+		}
+		if (C == TEXT('/'))
+		{
+			if (Pos + 1 >= Text.Len() || Text[Pos + 1] != TEXT('>'))
+			{
+				return Fail(TEXT("expected '>' after '/'"), Pos + 1);
+			}
+			Pos += 2;
+			bPendingEnd = true;
+			bSeenRoot = true;
+			return EBehaviacXmlToken::StartElement;
+		}
+
+		const int32 AttributeStart = Pos;
+		const FStringView AttributeName = ReadName();
+		if (AttributeName.IsEmpty())
+		{
+			return Fail(*FString::Printf(TEXT("unexpected '%c' in <%s>"), C, *FString(Name)), Pos);
+		}
+		SkipWhitespace();
+		if (Pos >= Text.Len() || Text[Pos] != TEXT('='))
+		{
+			return Fail(*FString::Printf(TEXT("expected '=' after attribute %s"), *FString(AttributeName)), Pos);
+		}
+		++Pos;
+		SkipWhitespace();
+		if (Pos >= Text.Len() || (Text[Pos] != TEXT('"') && Text[Pos] != TEXT('\'')))
+		{
+			return Fail(*FString::Printf(TEXT("expected a quoted value for attribute %s"), *FString(AttributeName)), Pos);
+		}
+
+		const TCHAR Quote = Text[Pos++];
+		const int32 ValueStart = Pos;
+		while (Pos < Text.Len() && Text[Pos] != Quote)
+		{
+			++Pos;
+		}
+		if (Pos >= Text.Len())
+		{
+			return Fail(*FString::Printf(TEXT("unterminated value for attribute %s"), *FString(AttributeName)), AttributeStart);
+		}
+		const FStringView Value = Text.Mid(ValueStart, Pos - ValueStart);
+		FStringView Malformed;
+		if (FindMalformedCharRef(Value, Malformed))
+		{
+			return Fail(*FString::Printf(TEXT("malformed character reference &%s; in attribute %s"), *FString(Malformed), *FString(AttributeName)), ValueStart);
+		}
+		Attributes.Emplace(AttributeName, Value);
+		++Pos;
+	}
+}
+
+EBehaviacXmlToken FBehaviacXmlReader::ReadEndTag()
+{
+	Pos += 2;
+	Name = ReadName();
+	SkipWhitespace();
+	if (Pos >= Text.Len() || Text[Pos] != TEXT('>'))
+	{
+		return Fail(*FString::Printf(TEXT("expected '>' to close </%s>"), *FString(Name)), Pos);
+	}
+	++Pos;
+
+	if (Open.Num() == 0)
+	{
+		return Fail(*FString::Printf(TEXT("</%s> closes nothing"), *FString(Name)), TagStart);
+	}
+	if (!Open.Last().Equals(Name, ESearchCase::CaseSensitive))
+	{
+		return Fail(*FString::Printf(TEXT("</%s> closes <%s>"), *FString(Name), *FString(Open.Last())), TagStart);
+	}
+	Open.Pop(EAllowShrinking::No);
+	return EBehaviacXmlToken::EndElement;
+}
@@ -4,14 +4,26 @@
 #include "BehaviorTree/Composites/BehaviacComposites.h"
 #include "BehaviorTree/Decorators/BehaviacDecorators.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+BEHAVIAC_REGISTER_NODE(Selector, UBehaviacSelector);
+BEHAVIAC_REGISTER_NODE(Sequence, UBehaviacSequence);
+BEHAVIAC_REGISTER_NODE(Parallel, UBehaviacParallel);
+BEHAVIAC_REGISTER_NODE(IfElse, UBehaviacIfElse);
+BEHAVIAC_REGISTER_NODE(SelectorLoop, UBehaviacSelectorLoop);
+BEHAVIAC_REGISTER_NODE(SelectorProbability, UBehaviacSelectorProbability);
+BEHAVIAC_REGISTER_NODE(SelectorStochastic, UBehaviacSelectorStochastic);
+BEHAVIAC_REGISTER_NODE(SequenceStochastic, UBehaviacSequenceStochastic);
+BEHAVIAC_REGISTER_NODE(ReferencedBehavior, UBehaviacReferenceBehavior);
+BEHAVIAC_REGISTER_NODE(WithPrecondition, UBehaviacWithPrecondition);
 
 // ===================================================================
 // SELECTOR
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSelector::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacSelector::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacSelectorTask>(Outer);
+	return Allocator.New<FBehaviacSelectorTask>();
 }
 
 void UBehaviacSelector::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -37,17 +49,23 @@ bool UBehaviacSelector::CheckIfInterrupted(UBehaviacAgentComponent* Agent) const
 	return false;
 }
 
-bool UBehaviacSelectorTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSelectorTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	ActiveChildIndex = 0;
 	return true;
 }
 
-void UBehaviacSelectorTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacSelectorTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 }
 
-EBehaviacStatus UBehaviacSelectorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+bool FBehaviacSelectorTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	// Only the active child is ticked while it runs
+	return ChildTasks.IsValidIndex(ActiveChildIndex) && GetChildWakeCondition(ChildTasks[ActiveChildIndex], Agent, OutCondition);
+}
+
+EBehaviacStatus FBehaviacSelectorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// If the current child returned success or is still running, propagate that
 	if (ChildStatus == EBehaviacStatus::Success)
@@ -88,9 +106,9 @@ EBehaviacStatus UBehaviacSelectorTask::OnUpdate(UBehaviacAgentComponent* Agent,
 // SEQUENCE
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSequence::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacSequence::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacSequenceTask>(Outer);
+	return Allocator.New<FBehaviacSequenceTask>();
 }
 
 void UBehaviacSequence::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -98,17 +116,23 @@ void UBehaviacSequence::LoadFromProperties(int32 Version, const FString& InAgent
 	Super::LoadFromProperties(Version, InAgentType, Properties);
 }
 
-bool UBehaviacSequenceTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSequenceTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	ActiveChildIndex = 0;
 	return true;
 }
 
-void UBehaviacSequenceTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacSequenceTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 }
 
-EBehaviacStatus UBehaviacSequenceTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+bool FBehaviacSequenceTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	// Only the active child is ticked while it runs
+	return ChildTasks.IsValidIndex(ActiveChildIndex) && GetChildWakeCondition(ChildTasks[ActiveChildIndex], Agent, OutCondition);
+}
+
+EBehaviacStatus FBehaviacSequenceTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// If current child is running, keep running
 	if (ChildStatus == EBehaviacStatus::Running)
@@ -165,9 +189,9 @@ UBehaviacParallel::UBehaviacParallel()
 {
 }
 
-UBehaviacBehaviorTask* UBehaviacParallel::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacParallel::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacParallelTask>(Outer);
+	return Allocator.New<FBehaviacParallelTask>();
 }
 
 void UBehaviacParallel::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -213,13 +237,13 @@ void UBehaviacParallel::LoadFromProperties(int32 Version, const FString& InAgent
 		(int32)FailurePolicy, (int32)SuccessPolicy, (int32)ChildFinishPolicy);
 }
 
-UBehaviacParallelTask::UBehaviacParallelTask()
+FBehaviacParallelTask::FBehaviacParallelTask()
 {
 }
 
-void UBehaviacParallelTask::Init(UBehaviacBehaviorNode* InNode)
+void FBehaviacParallelTask::CreateChildTasks(FBehaviacTaskAllocator& Allocator)
 {
-	Super::Init(InNode);
+	Super::CreateChildTasks(Allocator);
 	ChildStatuses.SetNum(ChildTasks.Num());
 	for (int32 i = 0; i < ChildStatuses.Num(); i++)
 	{
@@ -227,7 +251,7 @@ void UBehaviacParallelTask::Init(UBehaviacBehaviorNode* InNode)
 	}
 }
 
-void UBehaviacParallelTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacParallelTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Super::Reset(Agent);
 	for (int32 i = 0; i < ChildStatuses.Num(); i++)
@@ -236,7 +260,7 @@ void UBehaviacParallelTask::Reset(UBehaviacAgentComponent* Agent)
 	}
 }
 
-bool UBehaviacParallelTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacParallelTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacParallel* ParallelNode = Cast<UBehaviacParallel>(Node);
 	UE_LOG(LogBehaviac, Log,
@@ -248,7 +272,7 @@ bool UBehaviacParallelTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
-EBehaviacStatus UBehaviacParallelTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacParallelTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacParallel* ParallelNode = Cast<UBehaviacParallel>(Node);
 	if (!ParallelNode)
@@ -329,17 +353,17 @@ EBehaviacStatus UBehaviacParallelTask::OnUpdate(UBehaviacAgentComponent* Agent,
 // IF-ELSE
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacIfElse::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacIfElse::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacIfElseTask>(Outer);
+	return Allocator.New<FBehaviacIfElseTask>();
 }
 
-bool UBehaviacIfElseTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacIfElseTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	return ChildTasks.Num() >= 2;
 }
 
-EBehaviacStatus UBehaviacIfElseTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacIfElseTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTasks.Num() < 2)
 	{
@@ -373,18 +397,98 @@ EBehaviacStatus UBehaviacIfElseTask::OnUpdate(UBehaviacAgentComponent* Agent, EB
 // SELECTOR LOOP
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSelectorLoop::CreateTask(UObject* Outer) const
+UBehaviacSelectorLoop::UBehaviacSelectorLoop()
+	: bObserveGuards(true)
+{
+}
+
+FBehaviacBehaviorTask* UBehaviacSelectorLoop::CreateTask(FBehaviacTaskAllocator& Allocator) const
+{
+	return Allocator.New<FBehaviacSelectorLoopTask>();
+}
+
+void UBehaviacSelectorLoop::ResolveOperands()
+{
+	Super::ResolveOperands();
+
+	ObservedGuards.Reset();
+	ObservedGuards.SetNum(Children.Num());
+	for (int32 i = 0; i < Children.Num(); i++)
+	{
+		UBehaviacBehaviorNode* Child = Children[i];
+		if (!Child || Child->HasAttachments())
+		{
+			continue;
+		}
+
+		// A WithPrecondition is guarded by its precondition; any other child must be a pure condition
+		UBehaviacBehaviorNode* Guard = Child->IsA<UBehaviacWithPrecondition>() ? Child->GetChild(0) : Child;
+		if (!Guard)
+		{
+			continue;
+		}
+
+		Guard->EnsureSubtreeOperandsResolved();
+		FBehaviacObservedKeys Keys;
+		if (Guard->GatherObservedKeys(Keys))
+		{
+			ObservedGuards[i] = MoveTemp(Keys);
+		}
+	}
+}
+
+const FBehaviacObservedKeys* UBehaviacSelectorLoop::GetObservedGuardKeys(int32 Index) const
 {
-	return NewObject<UBehaviacSelectorLoopTask>(Outer);
+	if (!bObserveGuards || !ObservedGuards.IsValidIndex(Index) || !ObservedGuards[Index].IsSet())
+	{
+		return nullptr;
+	}
+	return &ObservedGuards[Index].GetValue();
 }
 
-bool UBehaviacSelectorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSelectorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	ActiveChildIndex = 0;
+	GuardFailureSerials.Init(NoGuardFailure, ChildTasks.Num());
 	return true;
 }
 
-EBehaviacStatus UBehaviacSelectorLoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+uint64 FBehaviacSelectorLoopTask::ReadBlackboardSerial(UBehaviacAgentComponent* Agent) const
+{
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	return Agent->GetBlackboard().GetWriteSerial();
+}
+
+void FBehaviacSelectorLoopTask::RecordGuardResult(int32 Index, EBehaviacStatus Result, uint64 SerialBefore)
+{
+	if (!GuardFailureSerials.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	// A WithPrecondition that ran its action and failed there must be retried every tick
+	bool bGuardFailed = Result == EBehaviacStatus::Failure;
+	if (const FBehaviacWithPreconditionTask* Guarded = BehaviacCastTask<FBehaviacWithPreconditionTask>(ChildTasks[Index]))
+	{
+		bGuardFailed = bGuardFailed && Guarded->DidPreconditionFail();
+	}
+	GuardFailureSerials[Index] = bGuardFailed ? SerialBefore : NoGuardFailure;
+}
+
+bool FBehaviacSelectorLoopTask::IsGuardFailureCurrent(UBehaviacAgentComponent* Agent, int32 Index) const
+{
+	const UBehaviacSelectorLoop* LoopNode = Cast<UBehaviacSelectorLoop>(Node);
+	const FBehaviacObservedKeys* Keys = LoopNode ? LoopNode->GetObservedGuardKeys(Index) : nullptr;
+	if (!Keys || !GuardFailureSerials.IsValidIndex(Index) || GuardFailureSerials[Index] == NoGuardFailure)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&Agent->GetBlackboardLock());
+	return !Keys->HaveChangedSince(Agent->GetBlackboard(), GuardFailureSerials[Index]);
+}
+
+EBehaviacStatus FBehaviacSelectorLoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	BEHAVIAC_VLOG(TEXT("[SelectorLoop] OnUpdate — ActiveChild=%d, ChildCount=%d"), ActiveChildIndex, ChildTasks.Num());
 
@@ -397,9 +501,18 @@ EBehaviacStatus UBehaviacSelectorLoopTask::OnUpdate(UBehaviacAgentComponent* Age
 			UBehaviacBehaviorNode* ChildNode = Node ? Node->GetChild(i) : nullptr;
 			if (ChildNode)
 			{
+				// Observer abort: its guard failed and nothing it reads has changed
+				if (IsGuardFailureCurrent(Agent, i))
+				{
+					++NumGuardsSkipped;
+					continue;
+				}
+
 				// Reset and try this child
+				const uint64 SerialBefore = ReadBlackboardSerial(Agent);
 				EBehaviacStatus Result = ChildTasks[i]->Execute(Agent, EBehaviacStatus::Invalid);
 				BEHAVIAC_VLOG(TEXT("[SelectorLoop] High-priority check child[%d] → %d"), i, (int32)Result);
+				RecordGuardResult(i, Result, SerialBefore);
 				if (Result != EBehaviacStatus::Failure)
 				{
 					// Interrupt current child
@@ -415,8 +528,10 @@ EBehaviacStatus UBehaviacSelectorLoopTask::OnUpdate(UBehaviacAgentComponent* Age
 		}
 		else if (i == ActiveChildIndex)
 		{
+			const uint64 SerialBefore = ReadBlackboardSerial(Agent);
 			EBehaviacStatus Result = ChildTasks[i]->Execute(Agent, ChildStatus);
 			BEHAVIAC_VLOG(TEXT("[SelectorLoop] Active child[%d] → %d"), i, (int32)Result);
+			RecordGuardResult(i, Result, SerialBefore);
 
 			if (Result == EBehaviacStatus::Running)
 			{
@@ -440,12 +555,12 @@ EBehaviacStatus UBehaviacSelectorLoopTask::OnUpdate(UBehaviacAgentComponent* Age
 // SELECTOR PROBABILITY
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSelectorProbability::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacSelectorProbability::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacSelectorProbabilityTask>(Outer);
+	return Allocator.New<FBehaviacSelectorProbabilityTask>();
 }
 
-bool UBehaviacSelectorProbabilityTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSelectorProbabilityTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	if (ChildTasks.Num() == 0) return false;
 
@@ -493,7 +608,7 @@ bool UBehaviacSelectorProbabilityTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
-EBehaviacStatus UBehaviacSelectorProbabilityTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacSelectorProbabilityTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTasks.Num() == 0)
 	{
@@ -513,22 +628,22 @@ EBehaviacStatus UBehaviacSelectorProbabilityTask::OnUpdate(UBehaviacAgentCompone
 // SELECTOR STOCHASTIC
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSelectorStochastic::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacSelectorStochastic::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacSelectorStochasticTask>(Outer);
+	return Allocator.New<FBehaviacSelectorStochasticTask>();
 }
 
-UBehaviacSelectorStochasticTask::UBehaviacSelectorStochasticTask()
+FBehaviacSelectorStochasticTask::FBehaviacSelectorStochasticTask()
 {
 }
 
-void UBehaviacSelectorStochasticTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacSelectorStochasticTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Super::Reset(Agent);
 	ShuffledOrder.Empty();
 }
 
-bool UBehaviacSelectorStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSelectorStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	ActiveChildIndex = 0;
 
@@ -549,7 +664,7 @@ bool UBehaviacSelectorStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
-EBehaviacStatus UBehaviacSelectorStochasticTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacSelectorStochasticTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildStatus == EBehaviacStatus::Success)
 	{
@@ -582,22 +697,22 @@ EBehaviacStatus UBehaviacSelectorStochasticTask::OnUpdate(UBehaviacAgentComponen
 // SEQUENCE STOCHASTIC
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacSequenceStochastic::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacSequenceStochastic::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacSequenceStochasticTask>(Outer);
+	return Allocator.New<FBehaviacSequenceStochasticTask>();
 }
 
-UBehaviacSequenceStochasticTask::UBehaviacSequenceStochasticTask()
+FBehaviacSequenceStochasticTask::FBehaviacSequenceStochasticTask()
 {
 }
 
-void UBehaviacSequenceStochasticTask::Reset(UBehaviacAgentComponent* Agent)
+void FBehaviacSequenceStochasticTask::Reset(UBehaviacAgentComponent* Agent)
 {
 	Super::Reset(Agent);
 	ShuffledOrder.Empty();
 }
 
-bool UBehaviacSequenceStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacSequenceStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	ActiveChildIndex = 0;
 
@@ -616,7 +731,7 @@ bool UBehaviacSequenceStochasticTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
-EBehaviacStatus UBehaviacSequenceStochasticTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacSequenceStochasticTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildStatus == EBehaviacStatus::Failure)
 	{
@@ -649,9 +764,9 @@ EBehaviacStatus UBehaviacSequenceStochasticTask::OnUpdate(UBehaviacAgentComponen
 // REFERENCE BEHAVIOR
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacReferenceBehavior::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacReferenceBehavior::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacReferenceBehaviorTask>(Outer);
+	return Allocator.New<FBehaviacReferenceBehaviorTask>();
 }
 
 void UBehaviacReferenceBehavior::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -667,37 +782,67 @@ void UBehaviacReferenceBehavior::LoadFromProperties(int32 Version, const FString
 	}
 }
 
-bool UBehaviacReferenceBehaviorTask::OnEnter(UBehaviacAgentComponent* Agent)
+#if WITH_EDITOR
+void UBehaviacReferenceBehavior::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	// The sub-tree is loaded via the workspace and linked during Init
-	return true;
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Link.Reset();
 }
+#endif
 
-EBehaviacStatus UBehaviacReferenceBehaviorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void FBehaviacReferenceBehaviorTask::Reset(UBehaviacAgentComponent* Agent)
 {
-	if (SubTreeTask)
+	Super::Reset(Agent);
+	if (SubTree.IsValid())
 	{
-		return SubTreeTask->Tick(Agent);
+		SubTree.GetRoot()->Reset(Agent);
 	}
+}
 
+void FBehaviacReferenceBehaviorTask::Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler)
+{
+	Super::Traverse(bChildFirst, Handler);
+	if (SubTree.IsValid())
+	{
+		SubTree.GetRoot()->Traverse(bChildFirst, Handler);
+	}
+}
+
+bool FBehaviacReferenceBehaviorTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	if (ChildTask)
+	{
+		return GetChildWakeCondition(ChildTask, Agent, OutCondition);
+	}
+	return SubTree.IsValid() && GetChildWakeCondition(SubTree.GetRoot(), Agent, OutCondition);
+}
+
+EBehaviacStatus FBehaviacReferenceBehaviorTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+{
 	if (ChildTask)
 	{
 		return ChildTask->Execute(Agent, ChildStatus);
 	}
 
-	return EBehaviacStatus::Failure;
+	const UBehaviacReferenceBehavior* RefNode = Cast<UBehaviacReferenceBehavior>(GetNode());
+	if (!RefNode || RefNode->ReferencedTreePath.IsEmpty())
+	{
+		return EBehaviacStatus::Failure;
+	}
+
+	return BehaviacTickSubtree(Agent, RefNode, RefNode->Link, RefNode->ReferencedTreePath, SubTree);
 }
 
 // ===================================================================
 // WITH PRECONDITION
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacWithPrecondition::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWithPrecondition::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWithPreconditionTask>(Outer);
+	return Allocator.New<FBehaviacWithPreconditionTask>();
 }
 
-EBehaviacStatus UBehaviacWithPreconditionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacWithPreconditionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTasks.Num() < 2)
 	{
@@ -705,6 +850,8 @@ EBehaviacStatus UBehaviacWithPreconditionTask::OnUpdate(UBehaviacAgentComponent*
 		return EBehaviacStatus::Failure;
 	}
 
+	bPreconditionFailed = false;
+
 	// 如果第二个子节点正在运行，继续执行它，不重新检查条件
 	if (ChildStatus == EBehaviacStatus::Running)
 	{
@@ -718,7 +865,8 @@ EBehaviacStatus UBehaviacWithPreconditionTask::OnUpdate(UBehaviacAgentComponent*
 	UE_LOG(LogBehaviac, Verbose, TEXT("[WithPrecondition] 条件检查 → %s"),
 		PrecondResult == EBehaviacStatus::Success ? TEXT("通过") : TEXT("失败"));
 
-	if (PrecondResult != EBehaviacStatus::Success)
+	bPreconditionFailed = PrecondResult != EBehaviacStatus::Success;
+	if (bPreconditionFailed)
 	{
 		return EBehaviacStatus::Failure;
 	}
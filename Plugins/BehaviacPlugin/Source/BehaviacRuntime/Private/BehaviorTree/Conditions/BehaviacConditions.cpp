@@ -3,14 +3,21 @@
 
 #include "BehaviorTree/Conditions/BehaviacConditions.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+BEHAVIAC_REGISTER_NODE(Condition, UBehaviacCondition);
+BEHAVIAC_REGISTER_NODE(And, UBehaviacAnd);
+BEHAVIAC_REGISTER_NODE(Or, UBehaviacOr);
+BEHAVIAC_REGISTER_NODE(True, UBehaviacTrue);
+BEHAVIAC_REGISTER_NODE(False, UBehaviacFalse);
 
 // ===================================================================
 // CONDITION
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacCondition::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacCondition::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacConditionTask>(Outer);
+	return Allocator.New<FBehaviacConditionTask>();
 }
 
 void UBehaviacCondition::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -40,97 +47,65 @@ void UBehaviacCondition::LoadFromProperties(int32 Version, const FString& InAgen
 	}
 }
 
-EBehaviacStatus UBehaviacConditionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void UBehaviacCondition::ResolveOperands()
 {
-	const UBehaviacCondition* CondNode = Cast<UBehaviacCondition>(Node);
-	if (!CondNode || !Agent)
-	{
-		return EBehaviacStatus::Failure;
-	}
+	Super::ResolveOperands();
 
-	FString LeftStr = CondNode->LeftOperand;
-	FString RightStr = CondNode->RightOperand;
+	// "Self.X" reads property X, or calls method X when no such property is set
+	Comparison.Resolve(
+		LeftOperand, EBehaviacOperandMode::PropertyOrMethod,
+		RightOperand, EBehaviacOperandMode::PropertyOrMethod,
+		Operator);
+}
 
-	// 解析左操作数：先尝试作为属性，如果为空则尝试作为方法
-	if (LeftStr.StartsWith(TEXT("Self.")))
+bool UBehaviacCondition::GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const
+{
+	if (HasAttachments())
 	{
-		FString PropName = LeftStr.Mid(5); // 移除 "Self." 前缀
-		LeftStr = Agent->GetPropertyValue(LeftStr);
-
-		// 如果属性不存在（返回空字符串），尝试作为方法调用
-		if (LeftStr.IsEmpty())
-		{
-			EBehaviacStatus MethodResult = Agent->ExecuteMethod(PropName);
-			// 将方法结果转换为字符串：Success=true, 其他=false
-			LeftStr = (MethodResult == EBehaviacStatus::Success) ? TEXT("true") : TEXT("false");
-			UE_LOG(LogBehaviac, Verbose, TEXT("[Condition] 调用方法 '%s'，结果: %s"), *PropName, *LeftStr);
-		}
+		return false;
 	}
 
-	// 解析右操作数
-	if (RightStr.StartsWith(TEXT("Self.")))
-	{
-		FString PropName = RightStr.Mid(5);
-		RightStr = Agent->GetPropertyValue(RightStr);
+	Comparison.Left.GatherObservedKeys(OutKeys);
+	Comparison.Right.GatherObservedKeys(OutKeys);
+	return true;
+}
 
-		if (RightStr.IsEmpty())
-		{
-			EBehaviacStatus MethodResult = Agent->ExecuteMethod(PropName);
-			RightStr = (MethodResult == EBehaviacStatus::Success) ? TEXT("true") : TEXT("false");
-			UE_LOG(LogBehaviac, Verbose, TEXT("[Condition] 调用方法 '%s'，结果: %s"), *PropName, *RightStr);
-		}
-	}
+void UBehaviacCondition::GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates)
+{
+	Super::GatherPredicates(OutPredicates);
+	OutPredicates.Add(&Comparison);
+}
 
-	return EvaluateComparison(LeftStr, RightStr, CondNode->Operator) ?
-		EBehaviacStatus::Success : EBehaviacStatus::Failure;
+FBehaviacConditionTask::FBehaviacConditionTask()
+{
+	SlotHints[0] = INDEX_NONE;
+	SlotHints[1] = INDEX_NONE;
 }
 
-bool UBehaviacConditionTask::EvaluateComparison(const FString& Left, const FString& Right, EBehaviacOperatorType Op) const
+EBehaviacStatus FBehaviacConditionTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	// Try numeric comparison
-	if (Left.IsNumeric() && Right.IsNumeric())
+	const UBehaviacCondition* CondNode = Cast<UBehaviacCondition>(Node);
+	if (!CondNode || !Agent)
 	{
-		double LeftVal = FCString::Atod(*Left);
-		double RightVal = FCString::Atod(*Right);
-
-		switch (Op)
-		{
-		case EBehaviacOperatorType::Equal:			return FMath::IsNearlyEqual(LeftVal, RightVal);
-		case EBehaviacOperatorType::NotEqual:		return !FMath::IsNearlyEqual(LeftVal, RightVal);
-		case EBehaviacOperatorType::Greater:			return LeftVal > RightVal;
-		case EBehaviacOperatorType::Less:			return LeftVal < RightVal;
-		case EBehaviacOperatorType::GreaterEqual:	return LeftVal >= RightVal;
-		case EBehaviacOperatorType::LessEqual:		return LeftVal <= RightVal;
-		default: return false;
-		}
+		return EBehaviacStatus::Failure;
 	}
 
-	// String comparison
-	int32 Cmp = Left.Compare(Right);
-	switch (Op)
-	{
-	case EBehaviacOperatorType::Equal:			return Cmp == 0;
-	case EBehaviacOperatorType::NotEqual:		return Cmp != 0;
-	case EBehaviacOperatorType::Greater:			return Cmp > 0;
-	case EBehaviacOperatorType::Less:			return Cmp < 0;
-	case EBehaviacOperatorType::GreaterEqual:	return Cmp >= 0;
-	case EBehaviacOperatorType::LessEqual:		return Cmp <= 0;
-	default: return false;
-	}
+	return CondNode->GetComparison().Evaluate(Agent, SlotHints) ?
+		EBehaviacStatus::Success : EBehaviacStatus::Failure;
 }
 
 // ===================================================================
 // AND
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacAnd::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacAnd::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacAndTask>(Outer);
+	return Allocator.New<FBehaviacAndTask>();
 }
 
-EBehaviacStatus UBehaviacAndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacAndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	for (UBehaviacBehaviorTask* Child : ChildTasks)
+	for (FBehaviacBehaviorTask* Child : ChildTasks)
 	{
 		if (!Child) continue;
 
@@ -147,14 +122,14 @@ EBehaviacStatus UBehaviacAndTask::OnUpdate(UBehaviacAgentComponent* Agent, EBeha
 // OR
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacOr::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacOr::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacOrTask>(Outer);
+	return Allocator.New<FBehaviacOrTask>();
 }
 
-EBehaviacStatus UBehaviacOrTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacOrTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	for (UBehaviacBehaviorTask* Child : ChildTasks)
+	for (FBehaviacBehaviorTask* Child : ChildTasks)
 	{
 		if (!Child) continue;
 
@@ -175,22 +150,22 @@ EBehaviacStatus UBehaviacOrTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehav
 // TRUE / FALSE
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacTrue::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacTrue::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacTrueTask>(Outer);
+	return Allocator.New<FBehaviacTrueTask>();
 }
 
-EBehaviacStatus UBehaviacTrueTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacTrueTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return EBehaviacStatus::Success;
 }
 
-UBehaviacBehaviorTask* UBehaviacFalse::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacFalse::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacFalseTask>(Outer);
+	return Allocator.New<FBehaviacFalseTask>();
 }
 
-EBehaviacStatus UBehaviacFalseTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacFalseTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return EBehaviacStatus::Failure;
 }
@@ -3,6 +3,24 @@
 
 #include "BehaviorTree/Decorators/BehaviacDecorators.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+BEHAVIAC_REGISTER_NODE(DecoratorAlwaysFailure, UBehaviacDecoratorAlwaysFailure);
+BEHAVIAC_REGISTER_NODE(DecoratorAlwaysRunning, UBehaviacDecoratorAlwaysRunning);
+BEHAVIAC_REGISTER_NODE(DecoratorAlwaysSuccess, UBehaviacDecoratorAlwaysSuccess);
+BEHAVIAC_REGISTER_NODE(DecoratorNot, UBehaviacDecoratorNot);
+BEHAVIAC_REGISTER_NODE(DecoratorLoop, UBehaviacDecoratorLoop);
+BEHAVIAC_REGISTER_NODE(DecoratorLoopUntil, UBehaviacDecoratorLoopUntil);
+BEHAVIAC_REGISTER_NODE(DecoratorRepeat, UBehaviacDecoratorRepeat);
+BEHAVIAC_REGISTER_NODE(DecoratorCount, UBehaviacDecoratorCount);
+BEHAVIAC_REGISTER_NODE(DecoratorCountLimit, UBehaviacDecoratorCountLimit);
+BEHAVIAC_REGISTER_NODE(DecoratorTime, UBehaviacDecoratorTime);
+BEHAVIAC_REGISTER_NODE(DecoratorFrames, UBehaviacDecoratorFrames);
+BEHAVIAC_REGISTER_NODE(DecoratorFailureUntil, UBehaviacDecoratorFailureUntil);
+BEHAVIAC_REGISTER_NODE(DecoratorSuccessUntil, UBehaviacDecoratorSuccessUntil);
+BEHAVIAC_REGISTER_NODE(DecoratorIterator, UBehaviacDecoratorIterator);
+BEHAVIAC_REGISTER_NODE(DecoratorLog, UBehaviacDecoratorLog);
+BEHAVIAC_REGISTER_NODE(DecoratorWeight, UBehaviacDecoratorWeight);
 
 DEFINE_LOG_CATEGORY_STATIC(LogBehaviacDecorator, Log, All);
 
@@ -10,14 +28,14 @@ DEFINE_LOG_CATEGORY_STATIC(LogBehaviacDecorator, Log, All);
 // BASE DECORATOR TASK
 // ===================================================================
 
-EBehaviacStatus UBehaviacDecoratorTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// Route through OnUpdate so DecorateResult is applied.
-	// (UBehaviacSingleChildTask::UpdateCurrent skips OnUpdate, so we override here.)
+	// (FBehaviacSingleChildTask::UpdateCurrent skips OnUpdate, so we override here.)
 	return OnUpdate(Agent, ChildStatus);
 }
 
-EBehaviacStatus UBehaviacDecoratorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask)
 	{
@@ -28,21 +46,26 @@ EBehaviacStatus UBehaviacDecoratorTask::OnUpdate(UBehaviacAgentComponent* Agent,
 	return DecorateResult(Result);
 }
 
-EBehaviacStatus UBehaviacDecoratorTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	return ChildResult;
 }
 
+bool FBehaviacDecoratorTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	return ForwardsWhileRunning() && GetChildWakeCondition(ChildTask, Agent, OutCondition);
+}
+
 // ===================================================================
 // AlwaysFailure
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorAlwaysFailure::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorAlwaysFailure::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorAlwaysFailureTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorAlwaysFailureTask>();
 }
 
-EBehaviacStatus UBehaviacDecoratorAlwaysFailureTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorAlwaysFailureTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	if (ChildResult == EBehaviacStatus::Running)
 		return EBehaviacStatus::Running;
@@ -53,12 +76,12 @@ EBehaviacStatus UBehaviacDecoratorAlwaysFailureTask::DecorateResult(EBehaviacSta
 // AlwaysRunning
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorAlwaysRunning::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorAlwaysRunning::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorAlwaysRunningTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorAlwaysRunningTask>();
 }
 
-EBehaviacStatus UBehaviacDecoratorAlwaysRunningTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorAlwaysRunningTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	return EBehaviacStatus::Running;
 }
@@ -67,12 +90,12 @@ EBehaviacStatus UBehaviacDecoratorAlwaysRunningTask::DecorateResult(EBehaviacSta
 // AlwaysSuccess
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorAlwaysSuccess::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorAlwaysSuccess::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorAlwaysSuccessTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorAlwaysSuccessTask>();
 }
 
-EBehaviacStatus UBehaviacDecoratorAlwaysSuccessTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorAlwaysSuccessTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	if (ChildResult == EBehaviacStatus::Running)
 		return EBehaviacStatus::Running;
@@ -83,12 +106,12 @@ EBehaviacStatus UBehaviacDecoratorAlwaysSuccessTask::DecorateResult(EBehaviacSta
 // Not (Inverter)
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorNot::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorNot::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorNotTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorNotTask>();
 }
 
-EBehaviacStatus UBehaviacDecoratorNotTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorNotTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	if (ChildResult == EBehaviacStatus::Success) return EBehaviacStatus::Failure;
 	if (ChildResult == EBehaviacStatus::Failure) return EBehaviacStatus::Success;
@@ -99,9 +122,9 @@ EBehaviacStatus UBehaviacDecoratorNotTask::DecorateResult(EBehaviacStatus ChildR
 // Loop
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorLoop::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorLoop::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorLoopTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorLoopTask>();
 }
 
 void UBehaviacDecoratorLoop::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -118,12 +141,12 @@ void UBehaviacDecoratorLoop::LoadFromProperties(int32 Version, const FString& In
 	}
 }
 
-UBehaviacDecoratorLoopTask::UBehaviacDecoratorLoopTask()
+FBehaviacDecoratorLoopTask::FBehaviacDecoratorLoopTask()
 	: CurrentCount(0), TargetCount(-1)
 {
 }
 
-bool UBehaviacDecoratorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacDecoratorLoop* LoopNode = Cast<UBehaviacDecoratorLoop>(Node);
 	TargetCount = LoopNode ? LoopNode->LoopCount : -1;
@@ -131,7 +154,7 @@ bool UBehaviacDecoratorLoopTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorLoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorLoopTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask)
 	{
@@ -163,9 +186,9 @@ EBehaviacStatus UBehaviacDecoratorLoopTask::OnUpdate(UBehaviacAgentComponent* Ag
 // LoopUntil
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorLoopUntil::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorLoopUntil::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorLoopUntilTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorLoopUntilTask>();
 }
 
 void UBehaviacDecoratorLoopUntil::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -182,7 +205,7 @@ void UBehaviacDecoratorLoopUntil::LoadFromProperties(int32 Version, const FStrin
 	}
 }
 
-EBehaviacStatus UBehaviacDecoratorLoopUntilTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorLoopUntilTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask)
 	{
@@ -216,9 +239,9 @@ EBehaviacStatus UBehaviacDecoratorLoopUntilTask::OnUpdate(UBehaviacAgentComponen
 // Repeat
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorRepeat::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorRepeat::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorRepeatTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorRepeatTask>();
 }
 
 void UBehaviacDecoratorRepeat::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -235,18 +258,18 @@ void UBehaviacDecoratorRepeat::LoadFromProperties(int32 Version, const FString&
 	}
 }
 
-UBehaviacDecoratorRepeatTask::UBehaviacDecoratorRepeatTask()
+FBehaviacDecoratorRepeatTask::FBehaviacDecoratorRepeatTask()
 	: CurrentCount(0)
 {
 }
 
-bool UBehaviacDecoratorRepeatTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorRepeatTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentCount = 0;
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorRepeatTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorRepeatTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask) return EBehaviacStatus::Failure;
 
@@ -272,9 +295,9 @@ EBehaviacStatus UBehaviacDecoratorRepeatTask::OnUpdate(UBehaviacAgentComponent*
 // Count
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorCount::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorCount::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorCountTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorCountTask>();
 }
 
 void UBehaviacDecoratorCount::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -291,15 +314,15 @@ void UBehaviacDecoratorCount::LoadFromProperties(int32 Version, const FString& I
 	}
 }
 
-UBehaviacDecoratorCountTask::UBehaviacDecoratorCountTask() : CurrentCount(0) {}
+FBehaviacDecoratorCountTask::FBehaviacDecoratorCountTask() : CurrentCount(0) {}
 
-bool UBehaviacDecoratorCountTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorCountTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentCount++;
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorCountTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorCountTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask) return EBehaviacStatus::Failure;
 	return ChildTask->Execute(Agent, ChildStatus);
@@ -309,9 +332,9 @@ EBehaviacStatus UBehaviacDecoratorCountTask::OnUpdate(UBehaviacAgentComponent* A
 // CountLimit
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorCountLimit::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorCountLimit::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorCountLimitTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorCountLimitTask>();
 }
 
 void UBehaviacDecoratorCountLimit::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -328,9 +351,9 @@ void UBehaviacDecoratorCountLimit::LoadFromProperties(int32 Version, const FStri
 	}
 }
 
-UBehaviacDecoratorCountLimitTask::UBehaviacDecoratorCountLimitTask() : ExecutionCount(0) {}
+FBehaviacDecoratorCountLimitTask::FBehaviacDecoratorCountLimitTask() : ExecutionCount(0) {}
 
-bool UBehaviacDecoratorCountLimitTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorCountLimitTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacDecoratorCountLimit* CLNode = Cast<UBehaviacDecoratorCountLimit>(Node);
 	int32 Max = CLNode ? CLNode->CountMax : 1;
@@ -348,9 +371,9 @@ bool UBehaviacDecoratorCountLimitTask::OnEnter(UBehaviacAgentComponent* Agent)
 // Time
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorTime::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorTime::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorTimeTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorTimeTask>();
 }
 
 void UBehaviacDecoratorTime::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -367,23 +390,28 @@ void UBehaviacDecoratorTime::LoadFromProperties(int32 Version, const FString& In
 	}
 }
 
-bool UBehaviacDecoratorTimeTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorTimeTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
-	StartTime = Agent ? Agent->GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
+	StartTime = Agent ? Agent->GetTimeSeconds() : FPlatformTime::Seconds();
+
+	const UBehaviacDecoratorTime* TimeNode = Cast<UBehaviacDecoratorTime>(Node);
+	const float Duration = TimeNode ? TimeNode->TimeDuration : 1.0f;
+	Timer.SetAt(Agent, StartTime + Duration);
+
+	// The time limit must end on time even when tick LOD skips frames
+	if (Agent)
+	{
+		Agent->RequestTickAt(StartTime + Duration);
+	}
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorTimeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorTimeTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask) return EBehaviacStatus::Failure;
 
-	const UBehaviacDecoratorTime* TimeNode = Cast<UBehaviacDecoratorTime>(Node);
-	float Duration = TimeNode ? TimeNode->TimeDuration : 1.0f;
-
-	double CurrentTime = Agent ? Agent->GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
-
 	// Time expired: stop ticking child and succeed
-	if ((CurrentTime - StartTime) >= Duration)
+	if (Timer.HasFired())
 	{
 		return EBehaviacStatus::Success;
 	}
@@ -392,13 +420,37 @@ EBehaviacStatus UBehaviacDecoratorTimeTask::OnUpdate(UBehaviacAgentComponent* Ag
 	return ChildTask->Execute(Agent, ChildStatus);
 }
 
+void FBehaviacDecoratorTimeTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Timer.Clear();
+}
+
+void FBehaviacDecoratorTimeTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
+}
+
+bool FBehaviacDecoratorTimeTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	// The child keeps being ticked until the time limit; sleep only if it can
+	if (!GetChildWakeCondition(ChildTask, Agent, OutCondition))
+	{
+		return false;
+	}
+
+	const UBehaviacDecoratorTime* TimeNode = Cast<UBehaviacDecoratorTime>(Node);
+	OutCondition.AddDeadline(StartTime + (TimeNode ? TimeNode->TimeDuration : 1.0f));
+	return true;
+}
+
 // ===================================================================
 // Frames
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorFrames::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorFrames::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorFramesTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorFramesTask>();
 }
 
 void UBehaviacDecoratorFrames::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -415,21 +467,20 @@ void UBehaviacDecoratorFrames::LoadFromProperties(int32 Version, const FString&
 	}
 }
 
-bool UBehaviacDecoratorFramesTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorFramesTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
-	StartFrame = static_cast<int32>(GFrameCounter);
+	const UBehaviacDecoratorFrames* FramesNode = Cast<UBehaviacDecoratorFrames>(Node);
+	const int32 Target = FramesNode ? FramesNode->FrameCount : 1;
+	EndFrame = GFrameCounter + FMath::Max(0, Target);
+	Timer.SetAtFrame(Agent, EndFrame);
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorFramesTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorFramesTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask) return EBehaviacStatus::Failure;
 
-	const UBehaviacDecoratorFrames* FramesNode = Cast<UBehaviacDecoratorFrames>(Node);
-	int32 Target = FramesNode ? FramesNode->FrameCount : 1;
-	int32 Elapsed = static_cast<int32>(GFrameCounter) - StartFrame;
-
-	if (Elapsed >= Target)
+	if (Timer.HasFired())
 	{
 		return EBehaviacStatus::Success;
 	}
@@ -438,13 +489,36 @@ EBehaviacStatus UBehaviacDecoratorFramesTask::OnUpdate(UBehaviacAgentComponent*
 	return EBehaviacStatus::Running;
 }
 
+void FBehaviacDecoratorFramesTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Timer.Clear();
+}
+
+void FBehaviacDecoratorFramesTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
+}
+
+bool FBehaviacDecoratorFramesTask::GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const
+{
+	// The child keeps being ticked until the frame limit; sleep only if it can
+	if (!GetChildWakeCondition(ChildTask, Agent, OutCondition))
+	{
+		return false;
+	}
+
+	OutCondition.AddFrameDeadline(EndFrame);
+	return true;
+}
+
 // ===================================================================
 // FailureUntil
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorFailureUntil::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorFailureUntil::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorFailureUntilTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorFailureUntilTask>();
 }
 
 void UBehaviacDecoratorFailureUntil::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -461,15 +535,15 @@ void UBehaviacDecoratorFailureUntil::LoadFromProperties(int32 Version, const FSt
 	}
 }
 
-UBehaviacDecoratorFailureUntilTask::UBehaviacDecoratorFailureUntilTask() : CurrentCount(0) {}
+FBehaviacDecoratorFailureUntilTask::FBehaviacDecoratorFailureUntilTask() : CurrentCount(0) {}
 
-bool UBehaviacDecoratorFailureUntilTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorFailureUntilTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentCount = 0;
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorFailureUntilTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorFailureUntilTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	const UBehaviacDecoratorFailureUntil* FUNode = Cast<UBehaviacDecoratorFailureUntil>(Node);
 	int32 Target = FUNode ? FUNode->UntilCount : 1;
@@ -490,9 +564,9 @@ EBehaviacStatus UBehaviacDecoratorFailureUntilTask::DecorateResult(EBehaviacStat
 // SuccessUntil
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorSuccessUntil::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorSuccessUntil::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorSuccessUntilTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorSuccessUntilTask>();
 }
 
 void UBehaviacDecoratorSuccessUntil::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -509,15 +583,15 @@ void UBehaviacDecoratorSuccessUntil::LoadFromProperties(int32 Version, const FSt
 	}
 }
 
-UBehaviacDecoratorSuccessUntilTask::UBehaviacDecoratorSuccessUntilTask() : CurrentCount(0) {}
+FBehaviacDecoratorSuccessUntilTask::FBehaviacDecoratorSuccessUntilTask() : CurrentCount(0) {}
 
-bool UBehaviacDecoratorSuccessUntilTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorSuccessUntilTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentCount = 0;
 	return true;
 }
 
-EBehaviacStatus UBehaviacDecoratorSuccessUntilTask::DecorateResult(EBehaviacStatus ChildResult)
+EBehaviacStatus FBehaviacDecoratorSuccessUntilTask::DecorateResult(EBehaviacStatus ChildResult)
 {
 	const UBehaviacDecoratorSuccessUntil* SUNode = Cast<UBehaviacDecoratorSuccessUntil>(Node);
 	int32 Target = SUNode ? SUNode->UntilCount : 1;
@@ -538,9 +612,9 @@ EBehaviacStatus UBehaviacDecoratorSuccessUntilTask::DecorateResult(EBehaviacStat
 // Iterator
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorIterator::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorIterator::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorIteratorTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorIteratorTask>();
 }
 
 void UBehaviacDecoratorIterator::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -556,12 +630,12 @@ void UBehaviacDecoratorIterator::LoadFromProperties(int32 Version, const FString
 	}
 }
 
-UBehaviacDecoratorIteratorTask::UBehaviacDecoratorIteratorTask()
+FBehaviacDecoratorIteratorTask::FBehaviacDecoratorIteratorTask()
 	: CurrentIndex(0), ArrayCount(0)
 {
 }
 
-bool UBehaviacDecoratorIteratorTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacDecoratorIteratorTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	CurrentIndex = 0;
 	// Get array count from agent
@@ -574,7 +648,7 @@ bool UBehaviacDecoratorIteratorTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return ArrayCount > 0;
 }
 
-EBehaviacStatus UBehaviacDecoratorIteratorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorIteratorTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTask) return EBehaviacStatus::Failure;
 
@@ -596,9 +670,9 @@ EBehaviacStatus UBehaviacDecoratorIteratorTask::OnUpdate(UBehaviacAgentComponent
 // Log
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorLog::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorLog::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorLogTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorLogTask>();
 }
 
 void UBehaviacDecoratorLog::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -614,7 +688,7 @@ void UBehaviacDecoratorLog::LoadFromProperties(int32 Version, const FString& InA
 	}
 }
 
-EBehaviacStatus UBehaviacDecoratorLogTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorLogTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacDecoratorLog* LogNode = Cast<UBehaviacDecoratorLog>(Node);
 	if (LogNode)
@@ -634,9 +708,9 @@ EBehaviacStatus UBehaviacDecoratorLogTask::OnUpdate(UBehaviacAgentComponent* Age
 // Weight
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacDecoratorWeight::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacDecoratorWeight::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacDecoratorWeightTask>(Outer);
+	return Allocator.New<FBehaviacDecoratorWeightTask>();
 }
 
 void UBehaviacDecoratorWeight::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -653,7 +727,7 @@ void UBehaviacDecoratorWeight::LoadFromProperties(int32 Version, const FString&
 	}
 }
 
-EBehaviacStatus UBehaviacDecoratorWeightTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacDecoratorWeightTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// Weight decorator just passes through to child; the weight is used by parent SelectorProbability
 	if (ChildTask)
@@ -3,6 +3,9 @@
 
 #include "FSM/BehaviacFSM.h"
 #include "BehaviacAgent.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+BEHAVIAC_REGISTER_NODE(FSM, UBehaviacFSMNode);
 
 // ===================================================================
 // FSM TRANSITIONS
@@ -33,40 +36,62 @@ bool UBehaviacTransitionCondition::Evaluate(UBehaviacAgentComponent* Agent) cons
 {
 	if (!Agent) return false;
 
-	FString LeftStr = LeftOperand;
-	FString RightStr = RightOperand;
-
-	if (LeftStr.StartsWith(TEXT("Self.")))
-		LeftStr = Agent->GetPropertyValue(LeftStr);
-	if (RightStr.StartsWith(TEXT("Self.")))
-		RightStr = Agent->GetPropertyValue(RightStr);
-
-	if (LeftStr.IsNumeric() && RightStr.IsNumeric())
+	// Resolved with the owning state when the tree is compiled; only a
+	// transition built or edited by hand since resolves here
+	if (!Comparison.IsResolved())
 	{
-		double Left = FCString::Atod(*LeftStr);
-		double Right = FCString::Atod(*RightStr);
-
-		switch (Operator)
-		{
-		case EBehaviacOperatorType::Equal:			return FMath::IsNearlyEqual(Left, Right);
-		case EBehaviacOperatorType::NotEqual:		return !FMath::IsNearlyEqual(Left, Right);
-		case EBehaviacOperatorType::Greater:			return Left > Right;
-		case EBehaviacOperatorType::Less:			return Left < Right;
-		case EBehaviacOperatorType::GreaterEqual:	return Left >= Right;
-		case EBehaviacOperatorType::LessEqual:		return Left <= Right;
-		default: return false;
-		}
+		check(IsInGameThread());
+		const_cast<UBehaviacTransitionCondition*>(this)->ResolveOperands();
 	}
+	return Comparison.Evaluate(Agent);
+}
 
-	return LeftStr == RightStr;
+void UBehaviacTransitionCondition::ResolveOperands()
+{
+	// Transitions always compared strings with FString ==, which ignores case
+	Comparison.Resolve(
+		LeftOperand, EBehaviacOperandMode::PropertyOrConstant,
+		RightOperand, EBehaviacOperandMode::PropertyOrConstant,
+		Operator, ESearchCase::IgnoreCase);
+}
+
+#if WITH_EDITOR
+void UBehaviacTransitionCondition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Comparison.Invalidate();
+}
+#endif
+
+UBehaviacWaitTransition::UBehaviacWaitTransition()
+	: WaitDuration(1.0f)
+{
 }
 
 bool UBehaviacWaitTransition::Evaluate(UBehaviacAgentComponent* Agent) const
 {
-	// Wait transitions are time-based; evaluation is handled by the state task
+	// Without the state it leaves there is no time to measure the wait from
 	return false;
 }
 
+bool UBehaviacWaitTransition::EvaluateInState(UBehaviacAgentComponent* Agent, const FBehaviacFSMStateTask* StateTask, int32 TransitionIndex) const
+{
+	return StateTask && StateTask->HasTransitionTimerFired(TransitionIndex);
+}
+
+void UBehaviacWaitTransition::LoadFromProperties(const TArray<FBehaviacProperty>& Properties)
+{
+	Super::LoadFromProperties(Properties);
+
+	for (const FBehaviacProperty& Prop : Properties)
+	{
+		if (Prop.Name == TEXT("Time") || Prop.Name == TEXT("WaitDuration"))
+		{
+			WaitDuration = FCString::Atof(*Prop.Value);
+		}
+	}
+}
+
 // ===================================================================
 // FSM STATE
 // ===================================================================
@@ -78,9 +103,9 @@ UBehaviacFSMState::UBehaviacFSMState()
 {
 }
 
-UBehaviacBehaviorTask* UBehaviacFSMState::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacFSMState::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacFSMStateTask>(Outer);
+	return Allocator.New<FBehaviacFSMStateTask>();
 }
 
 void UBehaviacFSMState::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -112,26 +137,85 @@ void UBehaviacFSMState::LoadFromProperties(int32 Version, const FString& InAgent
 	}
 }
 
-bool UBehaviacFSMStateTask::OnEnter(UBehaviacAgentComponent* Agent)
+void UBehaviacFSMState::ResolveOperands()
+{
+	Super::ResolveOperands();
+	EnterMethodId = FBehaviacMethodRegistry::FindOrAdd(EnterAction);
+	ExitMethodId = FBehaviacMethodRegistry::FindOrAdd(ExitAction);
+
+	for (UBehaviacFSMTransition* Transition : Transitions)
+	{
+		if (Transition)
+		{
+			Transition->ResolveOperands();
+		}
+	}
+}
+
+bool FBehaviacFSMStateTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacFSMState* StateNode = Cast<UBehaviacFSMState>(Node);
-	if (StateNode && !StateNode->EnterAction.IsEmpty() && Agent)
+	if (StateNode && StateNode->EnterMethodId != BEHAVIAC_INVALID_METHOD_ID && Agent)
 	{
-		Agent->ExecuteMethod(StateNode->EnterAction);
+		Agent->ExecuteMethodById(StateNode->EnterMethodId);
+	}
+
+	// Timed transitions count from entering the state
+	if (StateNode)
+	{
+		TransitionTimers.SetNum(StateNode->Transitions.Num());
+		double Now = -1.0;
+		for (int32 Index = 0; Index < StateNode->Transitions.Num(); ++Index)
+		{
+			const UBehaviacFSMTransition* Transition = StateNode->Transitions[Index];
+			const float Duration = Transition ? Transition->GetTimerDuration() : -1.f;
+			if (Duration >= 0.f)
+			{
+				if (Now < 0.0)
+				{
+					Now = Agent ? Agent->GetTimeSeconds() : FPlatformTime::Seconds();
+				}
+				TransitionTimers[Index].SetAt(Agent, Now + Duration);
+				if (Agent)
+				{
+					Agent->RequestTickAt(Now + Duration);
+				}
+			}
+		}
 	}
 	return true;
 }
 
-void UBehaviacFSMStateTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacFSMStateTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 	const UBehaviacFSMState* StateNode = Cast<UBehaviacFSMState>(Node);
-	if (StateNode && !StateNode->ExitAction.IsEmpty() && Agent)
+	if (StateNode && StateNode->ExitMethodId != BEHAVIAC_INVALID_METHOD_ID && Agent)
 	{
-		Agent->ExecuteMethod(StateNode->ExitAction);
+		Agent->ExecuteMethodById(StateNode->ExitMethodId);
+	}
+
+	for (FBehaviacTaskTimer& Timer : TransitionTimers)
+	{
+		Timer.Clear();
 	}
 }
 
-EBehaviacStatus UBehaviacFSMStateTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+void FBehaviacFSMStateTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+
+	for (FBehaviacTaskTimer& Timer : TransitionTimers)
+	{
+		Timer.Clear();
+	}
+}
+
+bool FBehaviacFSMStateTask::HasTransitionTimerFired(int32 TransitionIndex) const
+{
+	return TransitionTimers.IsValidIndex(TransitionIndex) && TransitionTimers[TransitionIndex].HasFired();
+}
+
+EBehaviacStatus FBehaviacFSMStateTask::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// FSM states are often leaf-like (no child behavior node).
 	// Always route through OnUpdate rather than deferring to SingleChildTask
@@ -139,7 +223,7 @@ EBehaviacStatus UBehaviacFSMStateTask::UpdateCurrent(UBehaviacAgentComponent* Ag
 	return OnUpdate(Agent, ChildStatus);
 }
 
-EBehaviacStatus UBehaviacFSMStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacFSMStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	const UBehaviacFSMState* StateNode = Cast<UBehaviacFSMState>(Node);
 
@@ -161,9 +245,9 @@ EBehaviacStatus UBehaviacFSMStateTask::OnUpdate(UBehaviacAgentComponent* Agent,
 // WAIT FRAMES STATE / WAIT STATE
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacWaitFramesState::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWaitFramesState::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWaitFramesStateTask>(Outer);
+	return Allocator.New<FBehaviacWaitFramesStateTask>();
 }
 
 void UBehaviacWaitFramesState::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -180,9 +264,9 @@ void UBehaviacWaitFramesState::LoadFromProperties(int32 Version, const FString&
 	}
 }
 
-UBehaviacBehaviorTask* UBehaviacWaitState::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacWaitState::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacWaitStateTask>(Outer);
+	return Allocator.New<FBehaviacWaitStateTask>();
 }
 
 void UBehaviacWaitState::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -208,9 +292,9 @@ UBehaviacFSMNode::UBehaviacFSMNode()
 {
 }
 
-UBehaviacBehaviorTask* UBehaviacFSMNode::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacFSMNode::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacFSMTask>(Outer);
+	return Allocator.New<FBehaviacFSMTask>();
 }
 
 void UBehaviacFSMNode::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -230,12 +314,12 @@ void UBehaviacFSMNode::LoadFromProperties(int32 Version, const FString& InAgentT
 // FSM TASK
 // ===================================================================
 
-UBehaviacFSMTask::UBehaviacFSMTask()
+FBehaviacFSMTask::FBehaviacFSMTask()
 	: CurrentStateIndex(-1)
 {
 }
 
-bool UBehaviacFSMTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacFSMTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	const UBehaviacFSMNode* FSMNode = Cast<UBehaviacFSMNode>(Node);
 	if (!FSMNode)
@@ -246,7 +330,7 @@ bool UBehaviacFSMTask::OnEnter(UBehaviacAgentComponent* Agent)
 	// Find the initial state
 	for (int32 i = 0; i < ChildTasks.Num(); i++)
 	{
-		if (UBehaviacBehaviorTask* Task = ChildTasks[i])
+		if (FBehaviacBehaviorTask* Task = ChildTasks[i])
 		{
 			const UBehaviacFSMState* StateNode = Cast<UBehaviacFSMState>(Task->GetNode());
 			if (StateNode && StateNode->StateId == FSMNode->InitialStateId)
@@ -262,7 +346,7 @@ bool UBehaviacFSMTask::OnEnter(UBehaviacAgentComponent* Agent)
 	return CurrentStateIndex >= 0;
 }
 
-void UBehaviacFSMTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+void FBehaviacFSMTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
 {
 	// Exit current state
 	if (ChildTasks.IsValidIndex(CurrentStateIndex))
@@ -271,12 +355,12 @@ void UBehaviacFSMTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus In
 	}
 }
 
-EBehaviacStatus UBehaviacFSMTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacFSMTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	return UpdateFSM(Agent, ChildStatus);
 }
 
-EBehaviacStatus UBehaviacFSMTask::UpdateFSM(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacFSMTask::UpdateFSM(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (!ChildTasks.IsValidIndex(CurrentStateIndex))
 	{
@@ -284,7 +368,7 @@ EBehaviacStatus UBehaviacFSMTask::UpdateFSM(UBehaviacAgentComponent* Agent, EBeh
 	}
 
 	// Execute current state
-	UBehaviacBehaviorTask* CurrentStateTask = ChildTasks[CurrentStateIndex];
+	FBehaviacBehaviorTask* CurrentStateTask = ChildTasks[CurrentStateIndex];
 	EBehaviacStatus StateResult = CurrentStateTask->Execute(Agent, ChildStatus);
 
 	// Check transitions from current state
@@ -298,15 +382,17 @@ EBehaviacStatus UBehaviacFSMTask::UpdateFSM(UBehaviacAgentComponent* Agent, EBeh
 		}
 
 		// Check transitions
-		for (UBehaviacFSMTransition* Transition : CurrentState->Transitions)
+		const FBehaviacFSMStateTask* CurrentStateTaskFSM = BehaviacCastTask<FBehaviacFSMStateTask>(CurrentStateTask);
+		for (int32 TransitionIndex = 0; TransitionIndex < CurrentState->Transitions.Num(); ++TransitionIndex)
 		{
-			if (Transition && Transition->Evaluate(Agent))
+			const UBehaviacFSMTransition* Transition = CurrentState->Transitions[TransitionIndex];
+			if (Transition && Transition->EvaluateInState(Agent, CurrentStateTaskFSM, TransitionIndex))
 			{
 				// Exit current state
 				CurrentStateTask->Reset(Agent);
 
 				// Find and enter target state
-				UBehaviacBehaviorTask* TargetTask = FindStateTaskById(Transition->TargetStateId);
+				FBehaviacBehaviorTask* TargetTask = FindStateTaskById(Transition->TargetStateId);
 				if (TargetTask)
 				{
 					for (int32 i = 0; i < ChildTasks.Num(); i++)
@@ -327,9 +413,9 @@ EBehaviacStatus UBehaviacFSMTask::UpdateFSM(UBehaviacAgentComponent* Agent, EBeh
 	return StateResult == EBehaviacStatus::Running ? EBehaviacStatus::Running : StateResult;
 }
 
-UBehaviacBehaviorTask* UBehaviacFSMTask::FindStateTaskById(int32 StateId) const
+FBehaviacBehaviorTask* FBehaviacFSMTask::FindStateTaskById(int32 StateId) const
 {
-	for (UBehaviacBehaviorTask* Task : ChildTasks)
+	for (FBehaviacBehaviorTask* Task : ChildTasks)
 	{
 		if (Task)
 		{
@@ -347,13 +433,12 @@ UBehaviacBehaviorTask* UBehaviacFSMTask::FindStateTaskById(int32 StateId) const
 // WAIT FRAMES STATE TASK
 // ===================================================================
 
-UBehaviacWaitFramesStateTask::UBehaviacWaitFramesStateTask()
-	: StartFrame(0)
-	, TargetFrames(1)
+FBehaviacWaitFramesStateTask::FBehaviacWaitFramesStateTask()
+	: TargetFrames(1)
 {
 }
 
-bool UBehaviacWaitFramesStateTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacWaitFramesStateTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	// Run base state enter (EnterAction, etc.)
 	if (!Super::OnEnter(Agent))
@@ -363,31 +448,38 @@ bool UBehaviacWaitFramesStateTask::OnEnter(UBehaviacAgentComponent* Agent)
 
 	const UBehaviacWaitFramesState* WFNode = Cast<UBehaviacWaitFramesState>(Node);
 	TargetFrames = WFNode ? FMath::Max(1, WFNode->WaitFrameCount) : 1;
-	StartFrame = static_cast<int32>(GFrameCounter);
+	Timer.SetAtFrame(Agent, GFrameCounter + TargetFrames);
 	return true;
 }
 
-EBehaviacStatus UBehaviacWaitFramesStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacWaitFramesStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	int32 Elapsed = static_cast<int32>(GFrameCounter) - StartFrame;
-	if (Elapsed >= TargetFrames)
-	{
-		return EBehaviacStatus::Success;
-	}
-	return EBehaviacStatus::Running;
+	return Timer.HasFired() ? EBehaviacStatus::Success : EBehaviacStatus::Running;
+}
+
+void FBehaviacWaitFramesStateTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Super::OnExit(Agent, InStatus);
+	Timer.Clear();
+}
+
+void FBehaviacWaitFramesStateTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
 }
 
 // ===================================================================
 // WAIT STATE TASK
 // ===================================================================
 
-UBehaviacWaitStateTask::UBehaviacWaitStateTask()
+FBehaviacWaitStateTask::FBehaviacWaitStateTask()
 	: StartTime(0.0)
 	, WaitDuration(1.0f)
 {
 }
 
-bool UBehaviacWaitStateTask::OnEnter(UBehaviacAgentComponent* Agent)
+bool FBehaviacWaitStateTask::OnEnter(UBehaviacAgentComponent* Agent)
 {
 	if (!Super::OnEnter(Agent))
 	{
@@ -397,33 +489,29 @@ bool UBehaviacWaitStateTask::OnEnter(UBehaviacAgentComponent* Agent)
 	const UBehaviacWaitState* WaitNode = Cast<UBehaviacWaitState>(Node);
 	WaitDuration = WaitNode ? FMath::Max(0.0f, WaitNode->WaitDuration) : 1.0f;
 
-	if (UWorld* World = Agent ? Agent->GetWorld() : nullptr)
+	StartTime = Agent ? Agent->GetTimeSeconds() : FPlatformTime::Seconds();
+	Timer.SetAt(Agent, StartTime + WaitDuration);
+	if (Agent)
 	{
-		StartTime = World->GetTimeSeconds();
-	}
-	else
-	{
-		StartTime = FPlatformTime::Seconds();
+		Agent->RequestTickAt(StartTime + WaitDuration);
 	}
 
 	return true;
 }
 
-EBehaviacStatus UBehaviacWaitStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacWaitStateTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
-	double CurrentTime = 0.0;
-	if (UWorld* World = Agent ? Agent->GetWorld() : nullptr)
-	{
-		CurrentTime = World->GetTimeSeconds();
-	}
-	else
-	{
-		CurrentTime = FPlatformTime::Seconds();
-	}
+	return Timer.HasFired() ? EBehaviacStatus::Success : EBehaviacStatus::Running;
+}
 
-	if ((CurrentTime - StartTime) >= WaitDuration)
-	{
-		return EBehaviacStatus::Success;
-	}
-	return EBehaviacStatus::Running;
+void FBehaviacWaitStateTask::OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus)
+{
+	Super::OnExit(Agent, InStatus);
+	Timer.Clear();
+}
+
+void FBehaviacWaitStateTask::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	Timer.Clear();
 }
@@ -8,9 +8,9 @@
 // HTN TASK
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacHTNTask::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacHTNTask::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacHTNTaskExecution>(Outer);
+	return Allocator.New<FBehaviacHTNTaskExecution>();
 }
 
 void UBehaviacHTNTask::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -31,12 +31,35 @@ void UBehaviacHTNTask::LoadFromProperties(int32 Version, const FString& InAgentT
 	}
 }
 
-EBehaviacStatus UBehaviacHTNTaskExecution::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+#if WITH_EDITOR
+void UBehaviacHTNTask::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Link.Reset();
+}
+#endif
+
+void FBehaviacHTNTaskExecution::Reset(UBehaviacAgentComponent* Agent)
+{
+	Super::Reset(Agent);
+	if (SubTree.IsValid())
+	{
+		SubTree.GetRoot()->Reset(Agent);
+	}
+}
+
+EBehaviacStatus FBehaviacHTNTaskExecution::UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	if (ChildTask)
 	{
 		return ChildTask->Execute(Agent, ChildStatus);
 	}
+
+	const UBehaviacHTNTask* TaskNode = Cast<UBehaviacHTNTask>(GetNode());
+	if (TaskNode && !TaskNode->ReferencedTreePath.IsEmpty())
+	{
+		return BehaviacTickSubtree(Agent, TaskNode, TaskNode->Link, TaskNode->ReferencedTreePath, SubTree);
+	}
 	return EBehaviacStatus::Success;
 }
 
@@ -44,9 +67,9 @@ EBehaviacStatus UBehaviacHTNTaskExecution::OnUpdate(UBehaviacAgentComponent* Age
 // HTN METHOD
 // ===================================================================
 
-UBehaviacBehaviorTask* UBehaviacHTNMethod::CreateTask(UObject* Outer) const
+FBehaviacBehaviorTask* UBehaviacHTNMethod::CreateTask(FBehaviacTaskAllocator& Allocator) const
 {
-	return NewObject<UBehaviacHTNMethodTask>(Outer);
+	return Allocator.New<FBehaviacHTNMethodTask>();
 }
 
 void UBehaviacHTNMethod::LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties)
@@ -62,7 +85,7 @@ void UBehaviacHTNMethod::LoadFromProperties(int32 Version, const FString& InAgen
 	}
 }
 
-EBehaviacStatus UBehaviacHTNMethodTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
+EBehaviacStatus FBehaviacHTNMethodTask::OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus)
 {
 	// Execute children sequentially (method body)
 	while (ChildTasks.IsValidIndex(ActiveChildIndex))
@@ -94,7 +117,6 @@ UBehaviacHTNPlanner::UBehaviacHTNPlanner()
 	, Agent(nullptr)
 	, RootTaskNode(nullptr)
 	, CurrentPlanStep(0)
-	, CurrentTaskExecution(nullptr)
 {
 }
 
@@ -104,7 +126,7 @@ void UBehaviacHTNPlanner::Init(UBehaviacAgentComponent* InAgent, UBehaviacHTNTas
 	RootTaskNode = InRootTask;
 	CurrentPlan.Empty();
 	CurrentPlanStep = 0;
-	CurrentTaskExecution = nullptr;
+	CurrentTaskExecution.Reset();
 }
 
 void UBehaviacHTNPlanner::Uninit()
@@ -113,7 +135,7 @@ void UBehaviacHTNPlanner::Uninit()
 	RootTaskNode = nullptr;
 	CurrentPlan.Empty();
 	CurrentPlanStep = 0;
-	CurrentTaskExecution = nullptr;
+	CurrentTaskExecution.Reset();
 }
 
 EBehaviacStatus UBehaviacHTNPlanner::Update()
@@ -141,7 +163,7 @@ EBehaviacStatus UBehaviacHTNPlanner::Update()
 	{
 		CurrentPlan.Empty();
 		CurrentPlanStep = 0;
-		CurrentTaskExecution = nullptr;
+		CurrentTaskExecution.Reset();
 		return EBehaviacStatus::Running; // Will replan next tick
 	}
 
@@ -175,10 +197,11 @@ EBehaviacStatus UBehaviacHTNPlanner::ExecutePlan()
 	// Create execution task if needed
 	if (!CurrentTaskExecution)
 	{
-		CurrentTaskExecution = CurrentTask->CreateTask(this);
+		FBehaviacTaskAllocator HeapAllocator;
+		CurrentTaskExecution.Reset(CurrentTask->CreateTask(HeapAllocator));
 		if (CurrentTaskExecution)
 		{
-			CurrentTaskExecution->Init(CurrentTask);
+			CurrentTaskExecution->Init(CurrentTask, HeapAllocator);
 		}
 	}
 
@@ -193,7 +216,7 @@ EBehaviacStatus UBehaviacHTNPlanner::ExecutePlan()
 	{
 		// Move to next step
 		CurrentPlanStep++;
-		CurrentTaskExecution = nullptr;
+		CurrentTaskExecution.Reset();
 
 		if (CurrentPlanStep >= CurrentPlan.Num())
 		{
@@ -213,8 +236,8 @@ bool UBehaviacHTNPlanner::DecomposeTask(UBehaviacHTNTask* Task, TArray<UBehaviac
 		return false;
 	}
 
-	// Primitive tasks go directly into the plan
-	if (Task->bIsPrimitive)
+	// Primitive tasks, and tasks that run a referenced tree, go directly into the plan
+	if (Task->bIsPrimitive || Task->RunsReferencedTree())
 	{
 		OutPlan.Add(Task);
 		return true;
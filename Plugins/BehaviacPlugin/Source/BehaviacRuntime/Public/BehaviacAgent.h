@@ -6,14 +6,23 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "BehaviacTypes.h"
+#include "BehaviacBlackboard.h"
+#include "BehaviacMethods.h"
+#include "BehaviacTickLOD.h"
+#include "BehaviacCommandBuffer.h"
+#include "BehaviacSignals.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+#include "BehaviorTree/BehaviacOperand.h"
 #include "BehaviacAgent.generated.h"
 
 class UBehaviacBehaviorTree;
-class UBehaviacBehaviorTreeTask;
 class UBehaviacBehaviorNode;
+class UBehaviacTaskView;
+class UBehaviacTickManager;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBehaviacMethodDelegate, const FString&, MethodName, EBehaviacStatus&, OutResult);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacSignalDelegate, const FString&, SignalName);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBehaviacTreeLoadedSignature, UBehaviacBehaviorTree*, Tree, bool, bSuccess);
 
 /**
  * Single-parameter delegate used for TypeScript method handlers.
@@ -22,6 +31,29 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacSignalDelegate, const FStri
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacMethodNameDelegate, const FString&, MethodName);
 
+/** How often an agent's shared conditions were answered from its predicate cache */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacPredicateCacheStats
+{
+	GENERATED_BODY()
+
+	/** Evaluations answered with a result memoized earlier in the tick */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|Agent")
+	int64 Hits = 0;
+
+	/** Evaluations with no result memoized this tick */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|Agent")
+	int64 Misses = 0;
+
+	/** Evaluations whose memoized result was dropped because a key it reads was written */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|Agent")
+	int64 Invalidations = 0;
+
+	/** Hits over all lookups, 0 when there were none */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|Agent")
+	float HitRate = 0.f;
+};
+
 /**
  * UBehaviacAgentComponent: The central AI agent component for Unreal Engine 5.
  *
@@ -30,7 +62,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBehaviacMethodNameDelegate, const F
  *
  * Features:
  * - Load and execute behavior trees by asset path
- * - Property system (blackboard-like key/value store)
+ * - Typed blackboard keyed by interned FNames (string API kept for compatibility)
  * - Method binding via delegates and Blueprint events
  * - Signal system for WaitForSignal nodes
  * - Multiple behavior tree support (stack)
@@ -48,10 +80,13 @@ public:
 	virtual void BeginPlay() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 
 	// --- Behavior Tree Management ---
 
-	/** Load and start a behavior tree from an asset */
+	/** Load and start a behavior tree from an asset, taking a state slab from the tree's pool */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	bool LoadBehaviorTree(UBehaviacBehaviorTree* TreeAsset);
 
@@ -59,15 +94,42 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	bool LoadBehaviorTreeByPath(const FString& RelativePath);
 
+	// --- Asynchronous loading ---
+	//
+	// The tree loads in the background (see FBehaviacTreeAsyncLoader) and starts
+	// on the game thread when it arrives. FallbackTree, if given, runs from now
+	// until then, and keeps running if the load fails. A later load or
+	// StopBehaviorTree supersedes a load still in flight.
+
+	/** Load and start the tree a registry path names, in the background */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	void LoadBehaviorTreeByPathAsync(const FString& RelativePath, UBehaviacBehaviorTree* FallbackTree = nullptr);
+
+	/** Load and start a tree file (XML or compiled), in the background */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	void LoadBehaviorTreeFromFileAsync(const FString& FilePath, UBehaviacBehaviorTree* FallbackTree = nullptr);
+
+	/** Stream in and start a tree asset */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	void LoadBehaviorTreeAssetAsync(TSoftObjectPtr<UBehaviacBehaviorTree> TreeAsset, UBehaviacBehaviorTree* FallbackTree = nullptr);
+
+	/** Whether an asynchronous load is in flight for this agent */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	bool IsLoadingBehaviorTree() const { return PendingTreeLoad != 0 && PendingTreeLoad == TreeLoadSerial; }
+
+	/** Fired when an asynchronous load finishes; bSuccess is false if the tree could not be started */
+	UPROPERTY(BlueprintAssignable, Category = "Behaviac|Agent")
+	FBehaviacTreeLoadedSignature OnBehaviorTreeLoaded;
+
 	/** Execute one tick of the current behavior tree */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	EBehaviacStatus TickBehaviorTree();
 
-	/** Stop and unload the current behavior tree */
+	/** Stop and unload the current behavior tree, returning its state slab to the tree's pool */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	void StopBehaviorTree();
 
-	/** Reset the current behavior tree to its initial state */
+	/** Reset the current behavior tree to its initial state, in place */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
 	void ResetBehaviorTree();
 
@@ -79,7 +141,154 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Agent")
 	bool bAutoTick;
 
+	/** Tree asset currently running (nullptr if none) */
+	UBehaviacBehaviorTree* GetBehaviorTreeAsset() const { return CurrentTreeAsset; }
+
+	/** Whether a tree is loaded and can be ticked */
+	bool HasBehaviorTree() const { return TreeInstance.IsValid(); }
+
+	/** Root task of the running tree (nullptr if none) */
+	FBehaviacBehaviorTreeTask* GetBehaviorTreeTask() const { return TreeInstance.GetRoot(); }
+
+	/** This agent's instance of the running tree: its tasks and their state block */
+	const FBehaviacTreeInstance& GetTreeInstance() const { return TreeInstance; }
+
+	/** Bumped whenever the task tree is created or destroyed, so task views can tell they are stale */
+	uint32 GetTaskTreeSerial() const { return TaskTreeSerial; }
+
+	/** Blueprint view of the running tree's root task (nullptr if none), made on each call */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	UBehaviacTaskView* InspectBehaviorTree();
+
+	/** Results of conditions shared within a tick (see FBehaviacPredicateCache). Hold GetBlackboardLock(). */
+	FBehaviacPredicateCache& GetPredicateCache() { return PredicateCache; }
+
+	/** Hit counts of this agent's predicate cache since it was created */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	FBehaviacPredicateCacheStats GetPredicateCacheStats() const;
+
+	// --- Managed ticking ---
+
+	/**
+	 * Tick from the world's UBehaviacTickManager instead of this component's own
+	 * tick function. Managed agents are ticked by the manager whatever bAutoTick
+	 * says, so owners that tick the tree by hand should stop doing so.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behaviac|Agent")
+	bool bUseTickManager;
+
+	/** Tick group the manager ticks this agent in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behaviac|Agent")
+	TEnumAsByte<ETickingGroup> ManagedTickGroup;
+
+	/** Switch managed ticking on or off at runtime */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	void SetUseTickManager(bool bInUseTickManager);
+
+	/** Whether a tick manager is currently ticking this agent */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	bool IsTickManaged() const { return TickManager.IsValid(); }
+
+	// --- Parallel ticking ---
+
+	/**
+	 * Let the tick manager tick this tree on a worker thread when
+	 * Behaviac.TickManager.Parallel is on. Node evaluation and blackboard access
+	 * then run off the game thread. Only agents whose methods are all C++
+	 * handlers registered as thread-safe qualify; while any other handler is
+	 * registered, or TypeScript or Blueprint can answer methods, the agent
+	 * ticks on the game thread as usual, so results never depend on where it
+	 * ticked.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Agent")
+	bool bTickInParallel;
+
+	/** Whether the tree is being ticked on a worker thread right now */
+	bool IsTickingInParallel() const { return bInParallelTick; }
+
+	/**
+	 * Run Command on the game thread: right away normally, or after the parallel
+	 * phase when called from a thread-safe handler of this agent during it.
+	 */
+	void EnqueueGameThreadCommand(TFunction<void()> Command);
+
+	// --- Tick LOD ---
+
+	/**
+	 * Tick the tree less often when far from every viewer or off screen.
+	 * Applies to both the component tick and managed ticking.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	bool bEnableTickLOD;
+
+	/** Tiers from nearest to farthest; the last one catches everything beyond */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	TArray<FBehaviacLODTier> LODTiers;
+
+	/** Tiers to demote by when the owner was not rendered recently (0 = ignore visibility) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	int32 OffscreenTierPenalty;
+
+	/** Seconds since last render for the owner to still count as visible */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	float RecentlyRenderedTolerance;
+
+	/** Use this tier instead of computing one (-1 = compute) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	int32 ForcedLODTier;
+
+	/** Tier picked by the last LOD check */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|LOD")
+	int32 GetLODTier() const { return CurrentLODTier; }
+
+	/** World time, or platform time for agents outside a world */
+	double GetTimeSeconds() const;
+
+	/**
+	 * Make sure the tree ticks at or soon after Time even when LOD would skip it.
+	 * Time-based nodes call this with their deadline so they finish on time.
+	 */
+	void RequestTickAt(double Time);
+
+	/**
+	 * LOD gate: whether the tree is due a tick at Now. Picks the tier from
+	 * ViewerLocations and, when it says yes, schedules the next tick.
+	 */
+	bool ShouldTickForLOD(double Now, const TArray<FVector>& ViewerLocations);
+
+	// --- Sleeping ---
+
+	/**
+	 * Skip ticks while the tree is blocked on a signal, a deadline or a frame
+	 * count (WaitForSignal, Wait, WaitFrames under Sequence/Selector and
+	 * pass-through decorators). SendSignal, FireEvent or the deadline wake it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Agent")
+	bool bAllowSleeping;
+
+	/**
+	 * Start each tick at the task left running below Sequence, Selector,
+	 * IfElse and pass-through decorators instead of descending from the root.
+	 * Reactive nodes (SelectorLoop, Parallel, timed decorators) still tick.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Agent")
+	bool bResumeRunningPath;
+
+	/** Whether the tree is asleep until its wake condition is met */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	bool IsSleeping() const { return bSleeping; }
+
+	/** Resume ticking a sleeping agent */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Agent")
+	void WakeUp();
+
+	/** What the sleeping tree is waiting for */
+	const FBehaviacWakeCondition& GetWakeCondition() const { return WakeCondition; }
+
 	// --- Property System (Blackboard) ---
+	//
+	// The FString accessors below are a compatibility layer over the typed
+	// blackboard: they strip "Self." and intern the key, then store a typed value.
 
 	/** Set a property value by name */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
@@ -113,7 +322,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
 	void SetBoolProperty(const FString& PropertyName, bool Value);
 
-	/** Get a boolean property */
+	/** Get a boolean property: true if it reads "true" or "1" (an int 7 or a float is false; GetBoolValue tests truthiness) */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
 	bool GetBoolProperty(const FString& PropertyName) const;
 
@@ -125,12 +334,110 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Properties")
 	int64 GetInt64Property(const FString& PropertyName) const;
 
+	// --- Typed Blackboard (FName keys) ---
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetIntValue(FName Key, int32 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	int32 GetIntValue(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetInt64Value(FName Key, int64 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	int64 GetInt64Value(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetFloatValue(FName Key, float Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	float GetFloatValue(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetBoolValue(FName Key, bool Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	bool GetBoolValue(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetVectorValue(FName Key, FVector Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	FVector GetVectorValue(FName Key) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetNameValue(FName Key, FName Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	FName GetNameValue(FName Key) const;
+
+	/** Objects are held weakly; a destroyed object reads back as null. */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	void SetObjectValue(FName Key, UObject* Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	UObject* GetObjectValue(FName Key) const;
+
+	/** Type currently stored under Key (None if absent) */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	EBehaviacValueType GetValueType(FName Key) const;
+
+	/** All keys that currently hold a value */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Blackboard")
+	TArray<FName> GetBlackboardKeys() const;
+
+	/** Set a raw typed value */
+	void SetBlackboardValue(FName Key, const FBehaviacValue& Value);
+
+	/** Read a raw typed value; returns false if Key holds nothing */
+	bool GetBlackboardValue(FName Key, FBehaviacValue& OutValue) const;
+
+	// --- Slot access ---
+	//
+	// A slot is a stable index for one key on this agent. Resolve it once
+	// (e.g. at tree load) and use the slot overloads on the hot path.
+
+	/** Slot for Key, creating it if needed */
+	int32 FindOrAddBlackboardSlot(FName Key);
+
+	/** Slot for Key, or INDEX_NONE */
+	int32 FindBlackboardSlot(FName Key) const;
+
+	void SetBlackboardSlotValue(int32 Slot, const FBehaviacValue& Value);
+
+	/** Read a slot; returns false if the slot is invalid or empty */
+	bool GetBlackboardSlotValue(int32 Slot, FBehaviacValue& OutValue) const;
+
+	/**
+	 * Direct blackboard access for resolved operands, which read values in place
+	 * instead of copying them. Hold GetBlackboardLock() while using the reference.
+	 */
+	FBehaviacBlackboard& GetBlackboard() { return Blackboard; }
+	const FBehaviacBlackboard& GetBlackboard() const { return Blackboard; }
+	FCriticalSection& GetBlackboardLock() const { return PropertyLock; }
+
 	// --- Method System ---
 
 	/** Execute a named method on this agent. Override in Blueprints or bind delegates. */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Methods")
 	EBehaviacStatus ExecuteMethod(const FString& MethodName);
 
+	/**
+	 * Execute a method resolved with FBehaviacMethodRegistry. The first call per
+	 * id probes TS, C++ handlers and Blueprint in the usual order and caches the
+	 * route that answered (or that none did); later calls go straight to it.
+	 */
+	EBehaviacStatus ExecuteMethodById(int32 MethodId);
+
+	/**
+	 * Drop cached method routes. Registering a C++ handler does this automatically;
+	 * call it after binding TS/Blueprint handlers for methods that were already
+	 * resolved as unhandled while the delegates were already bound.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Methods")
+	void InvalidateMethodRoutes();
+
 	/** Blueprint event called when a method needs to be executed */
 	UFUNCTION(BlueprintImplementableEvent, Category = "Behaviac|Methods")
 	EBehaviacStatus OnExecuteMethod(const FString& MethodName);
@@ -139,8 +446,13 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Behaviac|Methods")
 	FBehaviacMethodDelegate OnMethodCalled;
 
-	/** Register a method handler (C++ callback) */
-	void RegisterMethodHandler(const FString& MethodName, TFunction<EBehaviacStatus()> Handler);
+	/**
+	 * Register a method handler (C++ callback).
+	 * @param bThreadSafe  The handler only reads/writes this agent's blackboard and
+	 *                     its own data, so it may run on a worker thread during
+	 *                     parallel ticking. Engine calls belong in EnqueueGameThreadCommand.
+	 */
+	void RegisterMethodHandler(const FString& MethodName, TFunction<EBehaviacStatus()> Handler, bool bThreadSafe = false);
 
 	/**
 	 * TypeScript method handler bridge.
@@ -153,8 +465,9 @@ public:
 	 *       }
 	 *   });
 	 *
-	 * Fired synchronously by ExecuteMethod when no C++ handler is registered for
-	 * the method. Because Puerts runs on the game thread, the TS callback completes
+	 * Fired synchronously by ExecuteMethod the first time each method runs; once TS
+	 * answers a method, later calls of it go straight to TS, and methods TS left
+	 * unanswered are not offered to it again until the routes are invalidated. Because Puerts runs on the game thread, the TS callback completes
 	 * before Broadcast() returns, so SetTSMethodResult() is always called before
 	 * ExecuteMethod reads the stored value.
 	 */
@@ -187,6 +500,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Signals")
 	void ClearAllSignals();
 
+	/** Send SignalName to every agent in Agents, interning the name once */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Signals")
+	static void BroadcastSignal(const TArray<UBehaviacAgentComponent*>& Agents, const FString& SignalName);
+
+	/** Signal API by FBehaviacSignalRegistry id (what WaitForSignal uses) */
+	void SendSignalById(int32 SignalId);
+	bool IsSignalSetById(int32 SignalId) const { return ActiveSignals.Contains(SignalId); }
+	void ClearSignalById(int32 SignalId) { ActiveSignals.Remove(SignalId); }
+
 	/** Delegate fired when a signal is received */
 	UPROPERTY(BlueprintAssignable, Category = "Behaviac|Signals")
 	FBehaviacSignalDelegate OnSignalReceived;
@@ -203,37 +525,122 @@ public:
 	/** Consume a pending event */
 	void ConsumeEvent(const FString& EventName);
 
+	/** Event API by FBehaviacSignalRegistry id */
+	void FireEventById(int32 EventId);
+	bool HasPendingEventById(int32 EventId) const { return PendingEvents.Contains(EventId); }
+	void ConsumeEventById(int32 EventId) { PendingEvents.Remove(EventId); }
+
 protected:
 	/** Property storage (blackboard) */
-	UPROPERTY()
-	TMap<FString, FString> Properties;
+	FBehaviacBlackboard Blackboard;
 
-	/** Active signals */
-	UPROPERTY()
-	TSet<FString> ActiveSignals;
+	/** Active signals, by FBehaviacSignalRegistry id */
+	FBehaviacSignalSet ActiveSignals;
 
-	/** Pending events */
-	UPROPERTY()
-	TSet<FString> PendingEvents;
+	/** Pending events, by FBehaviacSignalRegistry id */
+	FBehaviacSignalSet PendingEvents;
 
-	/** Current behavior tree task (runtime execution) */
-	UPROPERTY()
-	UBehaviacBehaviorTreeTask* CurrentTreeTask;
+	/**
+	 * Runtime tasks of the current tree, built in one state block from the
+	 * asset's compiled tree (branch by branch, for lazy trees). Plain C++,
+	 * owned here and invisible to the garbage collector; CurrentTreeAsset is
+	 * what keeps the nodes it runs alive.
+	 */
+	FBehaviacTreeInstance TreeInstance;
+	uint32 TaskTreeSerial = 0;
+
+	/** Bumped by every load and stop; an asynchronous load only lands if it is still current */
+	uint32 TreeLoadSerial = 0;
+	uint32 PendingTreeLoad = 0;
+
+	/** Memoized results of the tree's shared conditions, guarded by PropertyLock */
+	FBehaviacPredicateCache PredicateCache;
 
 	/** Loaded behavior tree definition */
 	UPROPERTY()
 	UBehaviacBehaviorTree* CurrentTreeAsset;
 
-	/** Registered C++ method handlers */
-	TMap<FString, TFunction<EBehaviacStatus()>> MethodHandlers;
+	/** Manager ticking this agent, when managed */
+	TWeakObjectPtr<UBehaviacTickManager> TickManager;
+
+	/** Tick LOD state */
+	int32 CurrentLODTier = 0;
+	double LastLODTickTime = -1.0;
+	double RequestedTickTime = TNumericLimits<double>::Max();
+
+	/** Sleep state */
+	bool bSleeping = false;
+	bool bSleepDisabledComponentTick = false;
+	FBehaviacWakeCondition WakeCondition;
+
+	/** Next time idle lazy branches are looked for (GetTimeSeconds) */
+	double NextBranchReclaimTime = 0.0;
+
+	/** Parallel tick state; the sleep check waits for the game thread */
+	bool bInParallelTick = false;
+	bool bPendingSleepCheck = false;
+	FBehaviacCommandBuffer CommandBuffer;
+
+	/** Registered C++ method handlers, indexed by method id */
+	TArray<TFunction<EBehaviacStatus()>> MethodHandlers;
+	TBitArray<> ThreadSafeMethodHandlers;
+	int32 NumMethodHandlers = 0;
+	int32 NumThreadSafeMethodHandlers = 0;
+
+	/** Cached dispatch route per method id; TS is still asked first on every call while it is bound */
+	TArray<EBehaviacMethodRoute> MethodRoutes;
+
+	/** Delegate binding state the cached routes were resolved against */
+	bool bRoutesSawScriptBound = false;
+	bool bRoutesSawDelegateBound = false;
+
+	/** Whether OnExecuteMethod has a Blueprint implementation (-1 = not checked yet) */
+	int8 BlueprintMethodEventState = -1;
 
 	/**
-	 * Pending results written by TypeScript via SetTSMethodResult().
-	 * Consumed immediately by ExecuteMethod() after OnMethodNameCalled fires.
+	 * Result written by TypeScript via SetTSMethodResult() for the method whose
+	 * OnMethodNameCalled broadcast is in flight. Consumed right after the broadcast.
 	 */
-	TMap<FString, EBehaviacStatus> MethodNameResults;
+	int32 ScriptCallMethodId = BEHAVIAC_INVALID_METHOD_ID;
+	EBehaviacStatus ScriptCallResult = EBehaviacStatus::Invalid;
+	bool bScriptCallAnswered = false;
 
 	/** Critical section for thread safety */
 
 	mutable FCriticalSection PropertyLock;
+
+private:
+	friend class UBehaviacTickManager;
+
+	void NotifyTickManagerTreeChanged();
+
+	/** Unregister from the tick manager, if managed, so it never holds a dead agent */
+	void LeaveTickManager();
+
+	/** Start FallbackTree, if any, and return the serial the load in flight must match */
+	uint32 BeginTreeLoad(UBehaviacBehaviorTree* FallbackTree);
+
+	/** Completion of the asynchronous load started with Serial */
+	void FinishTreeLoad(uint32 Serial, UBehaviacBehaviorTree* Tree);
+
+	void TryFallAsleep();
+	bool IsWakeConditionMet() const;
+
+	/** Reclaim lazy branches idle for the tree's IdleBranchReclaimTime, a few times per period */
+	void ReclaimIdleBranches();
+
+	/** Called by the tick manager around the parallel phase */
+	void BeginParallelTick() { bInParallelTick = true; }
+	void EndParallelTick() { bInParallelTick = false; }
+
+	/** Replay the command buffer on the game thread, then do the deferred sleep check */
+	void FlushCommandBuffer();
+
+	/** Whether every method this agent can call may run on a worker; checked before each parallel phase */
+	bool CanTickInParallel();
+
+	EBehaviacMethodRoute ResolveMethodRoute(int32 MethodId, EBehaviacStatus& OutResult, bool bSkipScript);
+	bool CallScriptMethod(int32 MethodId, EBehaviacStatus& OutResult);
+	bool CallBlueprintMethod(int32 MethodId, EBehaviacStatus& OutResult);
+	bool HasBlueprintMethodEvent();
 };
@@ -0,0 +1,226 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "BehaviacBlackboard.generated.h"
+
+/** Type tag stored alongside every blackboard value. */
+UENUM(BlueprintType)
+enum class EBehaviacValueType : uint8
+{
+	None,
+	Int,
+	Int64,
+	Float,
+	Bool,
+	Vector,
+	Name,
+	Object,
+	/** Written through the string compatibility API (SetPropertyValue) */
+	String,
+};
+
+/**
+ * FBehaviacValue: tagged variant holding one blackboard value.
+ *
+ * Scalars share a union (floats are held at double precision, matching what the
+ * string API used to round-trip); vector, name, object and string payloads live
+ * in their own members so that reading a typed value never parses or allocates.
+ * Strings written through the legacy API cache their numeric interpretation at
+ * write time, so numeric reads of "42" cost the same as reads of a real int.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacValue
+{
+	FBehaviacValue()
+		: Type(EBehaviacValueType::None)
+		, bNumericString(false)
+	{
+		Int64Value = 0;
+	}
+
+	static FBehaviacValue MakeInt(int32 Value);
+	static FBehaviacValue MakeInt64(int64 Value);
+	static FBehaviacValue MakeFloat(double Value);
+	static FBehaviacValue MakeBool(bool Value);
+	static FBehaviacValue MakeVector(const FVector& Value);
+	static FBehaviacValue MakeName(FName Value);
+	static FBehaviacValue MakeObject(UObject* Value);
+	static FBehaviacValue MakeString(const FString& Value);
+
+	EBehaviacValueType GetType() const { return Type; }
+	bool IsSet() const { return Type != EBehaviacValueType::None; }
+
+	/** True for Int/Int64/Float and for strings that parse as a number. */
+	bool IsNumeric() const
+	{
+		return Type == EBehaviacValueType::Int || Type == EBehaviacValueType::Int64
+			|| Type == EBehaviacValueType::Float
+			|| (Type == EBehaviacValueType::String && bNumericString);
+	}
+
+	/** Numeric view of the value; 0 for non-numeric types. */
+	double AsDouble() const;
+
+	int32 AsInt() const;
+	int64 AsInt64() const;
+	float AsFloat() const { return (float)AsDouble(); }
+	bool AsBool() const;
+	FVector AsVector() const;
+	FName AsName() const;
+	UObject* AsObject() const;
+
+	/** Raw string payload (only meaningful for String values). */
+	const FString& GetString() const { return StringValue; }
+
+	/** String form, matching the formatting the string-keyed property API always used. */
+	FString ToString() const;
+
+	/** Append the string form to a builder; avoids a heap allocation for scalar types. */
+	void AppendString(FStringBuilderBase& Out) const;
+
+	/** Same type and same payload. */
+	bool Identical(const FBehaviacValue& Other) const;
+
+private:
+	EBehaviacValueType Type;
+
+	/** For String values: whether StringValue parsed as a number (cached in DoubleValue). */
+	bool bNumericString;
+
+	union
+	{
+		int32 IntValue;
+		int64 Int64Value;
+		double FloatValue;
+		bool BoolValue;
+		double DoubleValue;
+	};
+
+	FVector VectorValue = FVector::ZeroVector;
+	FName NameValue;
+	TWeakObjectPtr<UObject> ObjectValue;
+	FString StringValue;
+};
+
+/**
+ * FBehaviacBlackboard: per-agent typed key/value store.
+ *
+ * Keys are interned FNames; each key owns a stable integer slot for the lifetime
+ * of the blackboard, so callers that resolve a slot once can read and write by
+ * index afterwards. Slots are never removed, only cleared.
+ *
+ * Every write that changes a value stamps its slot with a new serial, so
+ * observers (see UBehaviacSelectorLoop) can tell whether the keys they read
+ * changed since they last looked without comparing values.
+ *
+ * Not thread-safe on its own — UBehaviacAgentComponent guards access.
+ */
+class BEHAVIACRUNTIME_API FBehaviacBlackboard
+{
+public:
+	/**
+	 * Convert a property name as written in tree data ("Self.HP" or "HP") to a key.
+	 * With FNAME_Find a name that was never interned yields NAME_None, which lets
+	 * lookups of unknown keys avoid growing the name table. An empty name, or a
+	 * bare "Self.", also yields NAME_None. NAME_None is never a key: lookups of
+	 * it miss and writes to it are dropped.
+	 */
+	static FName MakeKey(const FString& PropertyName, EFindName FindType = FNAME_Add);
+
+	/** Slot for Key, or INDEX_NONE if the key has never been written or is NAME_None. */
+	int32 FindSlot(FName Key) const
+	{
+		const int32* Slot = Key.IsNone() ? nullptr : SlotIndex.Find(Key);
+		return Slot ? *Slot : INDEX_NONE;
+	}
+
+	/** Slot for Key, creating an empty one if needed; INDEX_NONE for NAME_None. */
+	int32 FindOrAddSlot(FName Key);
+
+	int32 Num() const { return Values.Num(); }
+	bool IsValidSlot(int32 Slot) const { return Values.IsValidIndex(Slot); }
+
+	FName GetKey(int32 Slot) const { return SlotKeys[Slot]; }
+	const FBehaviacValue& GetValue(int32 Slot) const { return Values[Slot]; }
+	void SetValue(int32 Slot, const FBehaviacValue& Value)
+	{
+		if (!Values[Slot].Identical(Value))
+		{
+			Values[Slot] = Value;
+			SlotSerials[Slot] = ++WriteSerial;
+		}
+	}
+
+	/** Value stored under Key, or nullptr when the key is absent or cleared. */
+	const FBehaviacValue* Find(FName Key) const
+	{
+		const int32 Slot = FindSlot(Key);
+		return (Slot != INDEX_NONE && Values[Slot].IsSet()) ? &Values[Slot] : nullptr;
+	}
+
+	/**
+	 * Find using a cached slot. InOutSlot is validated against Key and refreshed
+	 * when stale, so callers can keep one hint per (agent, operand) pair.
+	 */
+	const FBehaviacValue* FindWithHint(FName Key, int32& InOutSlot) const
+	{
+		if (!IsValidSlot(InOutSlot) || SlotKeys[InOutSlot] != Key)
+		{
+			InOutSlot = FindSlot(Key);
+		}
+		return (InOutSlot != INDEX_NONE && Values[InOutSlot].IsSet()) ? &Values[InOutSlot] : nullptr;
+	}
+
+	/** FindOrAddSlot using a cached slot (see FindWithHint). */
+	int32 FindOrAddSlotWithHint(FName Key, int32& InOutSlot)
+	{
+		if (!IsValidSlot(InOutSlot) || SlotKeys[InOutSlot] != Key)
+		{
+			InOutSlot = FindOrAddSlot(Key);
+		}
+		return InOutSlot;
+	}
+
+	void Set(FName Key, const FBehaviacValue& Value)
+	{
+		const int32 Slot = FindOrAddSlot(Key);
+		if (Slot != INDEX_NONE)
+		{
+			SetValue(Slot, Value);
+		}
+	}
+
+	bool Contains(FName Key) const { return Find(Key) != nullptr; }
+
+	/** Clear every value but keep the slot assignments. */
+	void ClearValues();
+
+	/** Drop all keys and slots. */
+	void Empty();
+
+	void GetKeys(TArray<FName>& OutKeys) const;
+
+	/** Serial of the most recent change to any value */
+	uint64 GetWriteSerial() const { return WriteSerial; }
+
+	/** Serial of the most recent change to Key's value (0 if it never changed) */
+	uint64 GetKeySerial(FName Key) const
+	{
+		const int32 Slot = FindSlot(Key);
+		return Slot != INDEX_NONE ? SlotSerials[Slot] : EmptySerial;
+	}
+
+private:
+	TMap<FName, int32> SlotIndex;
+	TArray<FName> SlotKeys;
+	TArray<FBehaviacValue> Values;
+	TArray<uint64> SlotSerials;
+
+	uint64 WriteSerial = 0;
+
+	/** Serial of the last Empty(), which changed every key it dropped */
+	uint64 EmptySerial = 0;
+};
@@ -0,0 +1,34 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Game-thread work recorded by one agent while its tree ticks on a worker thread.
+ *
+ * Thread-safe handlers queue the engine-side half of what they do (such as
+ * starting a move) as commands; the owning agent runs them on the game thread,
+ * in the order they were recorded, once the parallel phase is over. Only side
+ * effects wait: every method call still returns its status right away, since
+ * agents with methods that must run on the game thread do not tick in
+ * parallel.
+ *
+ * Only the agent that owns the buffer may touch it during the parallel phase.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacCommandBuffer
+{
+	/** Queue Command to run on the game thread */
+	void AddCommand(TFunction<void()> Command);
+
+	/** Move the recorded commands out */
+	void TakeCommands(TArray<TFunction<void()>>& OutCommands);
+
+	bool HasEntries() const { return Commands.Num() > 0; }
+
+	void Reset();
+
+private:
+	TArray<TFunction<void()>> Commands;
+};
@@ -0,0 +1,48 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Method id for names that were never registered or resolved. */
+#define BEHAVIAC_INVALID_METHOD_ID INDEX_NONE
+
+/** Where an agent dispatches a resolved method id. */
+enum class EBehaviacMethodRoute : uint8
+{
+	/** Not resolved yet for this agent */
+	Unresolved,
+	/** A C++ handler registered with RegisterMethodHandler */
+	Native,
+	/** TypeScript, via OnMethodNameCalled / SetTSMethodResult */
+	Script,
+	/** OnMethodCalled delegate and/or the OnExecuteMethod Blueprint event */
+	Blueprint,
+	/** Nothing handles the method (negative cache) */
+	None,
+};
+
+/**
+ * FBehaviacMethodRegistry: process-wide table of method names.
+ *
+ * Every method name used by tree data or registered by an agent gets a small,
+ * stable integer id, so agents can keep their handlers and dispatch routes in
+ * flat arrays indexed by id. Names compare case-insensitively, as the
+ * string-keyed handler map did. Thread-safe; ids are never recycled.
+ */
+class BEHAVIACRUNTIME_API FBehaviacMethodRegistry
+{
+public:
+	/** Id for MethodName, registering it if needed. Empty names yield BEHAVIAC_INVALID_METHOD_ID. */
+	static int32 FindOrAdd(const FString& MethodName);
+
+	/** Id for MethodName, or BEHAVIAC_INVALID_METHOD_ID if it was never registered. */
+	static int32 Find(const FString& MethodName);
+
+	/** Name for an id (NAME_None for invalid ids). */
+	static FName GetName(int32 MethodId);
+
+	/** Number of ids handed out so far. */
+	static int32 Num();
+};
@@ -23,4 +23,8 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("BehaviacRuntime");
 	}
+
+private:
+	/** Registers the nodes of modules loaded later (see FBehaviacNodeRegistry) */
+	FDelegateHandle ModulesChangedHandle;
 };
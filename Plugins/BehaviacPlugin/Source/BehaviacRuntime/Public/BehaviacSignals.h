@@ -0,0 +1,74 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Signal id for names that were never registered. */
+#define BEHAVIAC_INVALID_SIGNAL_ID INDEX_NONE
+
+/**
+ * FBehaviacSignalRegistry: process-wide table of signal and event names.
+ *
+ * WaitForSignal nodes and event attachments intern their names when the tree
+ * is loaded, so agents keep signals and pending events as bits indexed by id
+ * instead of hashing strings on every check. Names compare case-insensitively,
+ * as the string sets did. Thread-safe; ids are never recycled.
+ */
+class BEHAVIACRUNTIME_API FBehaviacSignalRegistry
+{
+public:
+	/** Id for SignalName, registering it if needed. Empty names yield BEHAVIAC_INVALID_SIGNAL_ID. */
+	static int32 FindOrAdd(const FString& SignalName);
+
+	/** Id for SignalName, or BEHAVIAC_INVALID_SIGNAL_ID if it was never registered. */
+	static int32 Find(const FString& SignalName);
+
+	/** Name for an id (NAME_None for invalid ids). */
+	static FName GetName(int32 SignalId);
+
+	/** Number of ids handed out so far. */
+	static int32 Num();
+};
+
+/**
+ * FBehaviacSignalSet: membership of signal ids, one bit each.
+ * The first 128 ids fit without a heap allocation.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacSignalSet
+{
+	void Add(int32 SignalId)
+	{
+		if (SignalId < 0)
+		{
+			return;
+		}
+		if (SignalId >= Bits.Num())
+		{
+			Bits.Add(false, SignalId + 1 - Bits.Num());
+		}
+		Bits[SignalId] = true;
+	}
+
+	bool Contains(int32 SignalId) const
+	{
+		return Bits.IsValidIndex(SignalId) && Bits[SignalId];
+	}
+
+	void Remove(int32 SignalId)
+	{
+		if (Bits.IsValidIndex(SignalId))
+		{
+			Bits[SignalId] = false;
+		}
+	}
+
+	/** Clear every bit; keeps the storage */
+	void Reset() { Bits.SetRange(0, Bits.Num(), false); }
+
+	bool IsEmpty() const { return Bits.Find(true) == INDEX_NONE; }
+
+private:
+	TBitArray<> Bits;
+};
@@ -0,0 +1,65 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviacTickLOD.generated.h"
+
+class UWorld;
+class UBehaviacAgentComponent;
+
+/** One tick LOD tier: how often an agent in range of it ticks its tree. */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacLODTier
+{
+	GENERATED_BODY()
+
+	/** Agents within this distance of the nearest viewer use this tier (<= 0 = any distance) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	float MaxDistance = 0.f;
+
+	/** Seconds between tree ticks (0 = every frame) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|LOD")
+	float TickInterval = 0.f;
+
+	FBehaviacLODTier() {}
+	FBehaviacLODTier(float InMaxDistance, float InTickInterval)
+		: MaxDistance(InMaxDistance)
+		, TickInterval(InTickInterval)
+	{
+	}
+};
+
+/**
+ * Significance helpers shared by the component tick and UBehaviacTickManager.
+ *
+ * A tier is picked from the owner's distance to the nearest viewer (tiers are
+ * checked in order, first match wins), then demoted when the owner has not been
+ * rendered recently. The tier each agent was last given is recorded per world,
+ * whichever path ticks it, so tier counts cover every LOD-enabled agent.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacTickLOD
+{
+	/** View locations of every player controller in World */
+	static void GatherViewerLocations(const UWorld* World, TArray<FVector>& OutLocations);
+
+	/**
+	 * View locations in World, gathered on the first call each frame and
+	 * shared by every later one that frame. Game thread only; the array is
+	 * valid until the next frame.
+	 */
+	static const TArray<FVector>& GetViewerLocations(const UWorld* World);
+
+	/** Tier index for Agent; 0 when it has no owner or there are no viewers */
+	static int32 ComputeTier(const UBehaviacAgentComponent& Agent, const TArray<FVector>& ViewerLocations);
+
+	/** Record the tier Agent was given this frame in World (game thread only) */
+	static void NoteTier(const UWorld* World, const UBehaviacAgentComponent& Agent, int32 Tier);
+
+	/**
+	 * Agents per tier in World (index = tier), from the latest frame any were
+	 * recorded in, this one or the last. Each agent counts once per frame.
+	 */
+	static void GetAgentsPerTier(const UWorld* World, TArray<int32>& OutCounts);
+};
@@ -0,0 +1,244 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviacTimerWheel.h"
+#include "UObject/ObjectKey.h"
+#include "BehaviacTickManager.generated.h"
+
+class UBehaviacAgentComponent;
+class UBehaviacBehaviorTree;
+class UBehaviacTickManager;
+
+/**
+ * Frame budget for managed agents, in milliseconds (0 = unlimited).
+ * Agents not reached within the budget are ticked first on the next frame.
+ */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<float> CVarBehaviacTickBudgetMs;
+
+/**
+ * Tick agents with bTickInParallel on worker threads (0 = off, default).
+ * Their method calls that are not thread-safe run on the game thread afterwards.
+ */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacParallelTick;
+
+/** Counters from the most recent frame, summed over all tick groups. */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacTickManagerStats
+{
+	GENERATED_BODY()
+
+	/** Agents registered with the manager */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumAgents = 0;
+
+	/** Distinct tree assets the agents are grouped by */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumBuckets = 0;
+
+	/** Agents whose tree was ticked last frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumTicked = 0;
+
+	/** Of NumTicked, the agents ticked on worker threads */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumTickedInParallel = 0;
+
+	/** Agents pushed to the next frame because the budget ran out */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumDeferred = 0;
+
+	/** Agents asleep until a signal, event or deadline wakes them */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumSleeping = 0;
+
+	/** Agents whose tree was not due a tick last frame under their tick LOD */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int32 NumSkippedByLOD = 0;
+
+	/** LOD-enabled agents of the world per tier last frame (index = tier), component-ticked ones included */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	TArray<int32> AgentsPerLODTier;
+
+	/** Time spent ticking agents last frame, parallel phase included */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	float TickTimeMs = 0.f;
+
+	/** Shared conditions the registered agents answered from their predicate caches */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	int64 PredicateCacheHits = 0;
+
+	/** PredicateCacheHits over all predicate cache lookups of the registered agents */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|TickManager")
+	float PredicateCacheHitRate = 0.f;
+};
+
+/** Tick function that runs one tick group's worth of managed agents. */
+struct FBehaviacManagerTickFunction : public FTickFunction
+{
+	UBehaviacTickManager* Manager = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+/**
+ * UBehaviacTickManager: ticks every managed Behaviac agent of a world from one loop.
+ *
+ * Agents opt in with bUseTickManager. Their component tick is disabled and the
+ * manager ticks them from one tick function per ETickingGroup in use, walking
+ * agents bucketed by tree asset so the shared node data stays hot in cache.
+ * With a frame budget set, the walk stops when the budget is spent and resumes
+ * from the same place on the next frame, so every agent still gets its turn.
+ * Agents with bEnableTickLOD are skipped on frames their LOD tier is not due.
+ * Sleeping agents leave their bucket entirely until they are woken.
+ *
+ * With parallel ticking on, agents with bTickInParallel whose methods are all
+ * thread-safe are collected during the walk and ticked together with
+ * ParallelFor once it is over; the game-thread commands they queued then run
+ * agent by agent. Other agents tick during the walk. The frame budget only
+ * limits the serial walk, so parallel agents count towards it at collection.
+ * Timers are advanced on the game thread just before the parallel phase, so
+ * parallel agents see every deadline due by then. The wheels do not advance
+ * during the phase: a timer a parallel agent sets for a deadline that is
+ * already due is seen as fired from the next frame on.
+ *
+ * Agents are held weakly; they unregister themselves when they end play or
+ * are unregistered or destroyed, and a collected one is skipped until then.
+ */
+UCLASS()
+class BEHAVIACRUNTIME_API UBehaviacTickManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Manager for the world of WorldContext, or nullptr (no world, or not a game/PIE world) */
+	static UBehaviacTickManager* Get(const UObject* WorldContext);
+
+	virtual void Deinitialize() override;
+
+	/** Start ticking Agent from this manager; disables its component tick. */
+	void RegisterAgent(UBehaviacAgentComponent* Agent);
+
+	/** Stop ticking Agent; restores its component tick. */
+	void UnregisterAgent(UBehaviacAgentComponent* Agent);
+
+	/** Re-bucket Agent after it loaded or stopped a tree, or changed tick group. */
+	void OnAgentTreeChanged(UBehaviacAgentComponent* Agent);
+
+	bool IsAgentRegistered(const UBehaviacAgentComponent* Agent) const { return AgentEntries.Contains(Agent); }
+
+	/** Take a sleeping agent out of its bucket and schedule its deadline wake, if any. */
+	void OnAgentSleep(UBehaviacAgentComponent* Agent);
+
+	/** Put a woken agent back into its bucket. */
+	void OnAgentWake(UBehaviacAgentComponent* Agent);
+
+	/**
+	 * Send SignalName to every registered agent, or to those running Tree only,
+	 * sleeping ones included. Returns the number of agents signalled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	int32 BroadcastSignal(const FString& SignalName, const UBehaviacBehaviorTree* Tree = nullptr);
+
+	/** Tick every agent registered for Group (called by the group's tick function). */
+	void TickManagedGroup(ETickingGroup InTickGroup, float DeltaTime);
+
+	/** Override the frame budget in milliseconds; negative uses Behaviac.TickManager.FrameBudgetMs */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	void SetFrameBudgetMs(float InBudgetMs) { FrameBudgetMs = InBudgetMs; }
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	float GetFrameBudgetMs() const;
+
+	/** Override Behaviac.TickManager.Parallel for this manager */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	void SetUseParallelTicking(bool bInUseParallel) { ParallelOverride = bInUseParallel ? 1 : 0; }
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	bool IsParallelTickingEnabled() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|TickManager")
+	FBehaviacTickManagerStats GetStats() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Agents sharing one tree asset within a tick group */
+	struct FBucket
+	{
+		const UBehaviacBehaviorTree* Tree = nullptr;
+
+		/** Explicitly null for slots emptied mid-walk until the group is compacted */
+		TArray<TWeakObjectPtr<UBehaviacAgentComponent>> Agents;
+	};
+
+	/** Everything for one ETickingGroup */
+	struct FGroup
+	{
+		ETickingGroup TickGroup = TG_PrePhysics;
+		FBehaviacManagerTickFunction TickFunction;
+		TArray<FBucket> Buckets;
+		int32 NumAgents = 0;
+
+		/** Where a budget-limited walk stopped */
+		int32 ResumeBucket = 0;
+		int32 ResumeIndex = 0;
+
+		/** Agents were removed mid-walk; compact the buckets afterwards */
+		bool bNeedsCompaction = false;
+
+		int32 LastTicked = 0;
+		int32 LastTickedInParallel = 0;
+		int32 LastDeferred = 0;
+		int32 LastSkippedByLOD = 0;
+		double LastTickSeconds = 0.0;
+	};
+
+	/** Where a registered agent currently lives */
+	struct FAgentEntry
+	{
+		ETickingGroup TickGroup = TG_PrePhysics;
+		const UBehaviacBehaviorTree* Tree = nullptr;
+
+		/** Index in its bucket's Agents (INDEX_NONE while asleep) */
+		int32 Slot = INDEX_NONE;
+
+		bool bSleeping = false;
+
+		/** Deadline wakes of the current sleep, on UBehaviacTimerManager */
+		FBehaviacTimerHandle WakeTimeTimer;
+		FBehaviacTimerHandle WakeFrameTimer;
+	};
+
+	FGroup& FindOrAddGroup(ETickingGroup InTickGroup);
+	FGroup* FindGroup(ETickingGroup InTickGroup);
+	void AddToBucket(UBehaviacAgentComponent* Agent, FAgentEntry& Entry);
+	void RemoveFromBucket(UBehaviacAgentComponent* Agent, FAgentEntry& Entry);
+	void CompactGroup(FGroup& Group);
+
+	void ScheduleWake(UBehaviacAgentComponent* Agent, FAgentEntry& Entry);
+	void CancelWake(FAgentEntry& Entry);
+
+	TArray<TUniquePtr<FGroup>> Groups;
+	TMap<TObjectKey<UBehaviacAgentComponent>, FAgentEntry> AgentEntries;
+
+	int32 NumSleeping = 0;
+
+	/** Group currently being walked, if any (registration changes are deferred-safe) */
+	FGroup* TickingGroup = nullptr;
+
+	/** Agents collected for the parallel phase of the current walk */
+	TArray<TWeakObjectPtr<UBehaviacAgentComponent>> ParallelAgents;
+
+	float FrameBudgetMs = -1.f;
+
+	/** -1 = follow Behaviac.TickManager.Parallel */
+	int8 ParallelOverride = -1;
+};
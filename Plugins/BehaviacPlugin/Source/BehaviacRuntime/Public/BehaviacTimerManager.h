@@ -0,0 +1,153 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviacTimerWheel.h"
+#include "BehaviacTimerManager.generated.h"
+
+class UBehaviacAgentComponent;
+
+/**
+ * FBehaviacTimers: a time wheel and a frame wheel with the clock they run on.
+ *
+ * Time deadlines live on a wheel of 10ms ticks in the world clock (the agent
+ * clock, UBehaviacAgentComponent::GetTimeSeconds), or the platform clock
+ * without a world; frame deadlines on a wheel keyed by GFrameCounter.
+ * Timers may be set, polled and cleared from parallel agent ticks; the wheels
+ * only advance (and callbacks only run) on the game thread, so off it a
+ * deadline is seen with one frame of granularity. Callbacks run after
+ * TimerLock is released, so they may use the timers and never hold up workers.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTimers
+{
+public:
+	/** Wheel ticks per second of the time wheel */
+	static constexpr int32 TimeTicksPerSecond = 100;
+
+	/** Timers of objects without a timer manager, on the platform clock */
+	static FBehaviacTimers& GetNoWorld();
+
+	/** Timer due once GetTimeSeconds() reaches Time */
+	FBehaviacTimerHandle SetTimerAt(double Time, TFunction<void()> OnFired = nullptr);
+
+	/** Timer due once GFrameCounter reaches Frame */
+	FBehaviacTimerHandle SetFrameTimerAt(uint64 Frame, TFunction<void()> OnFired = nullptr);
+
+	/** Cancel a pending timer or release a fired one; invalidates Handle. */
+	void ClearTimer(FBehaviacTimerHandle& Handle);
+
+	/**
+	 * Whether the timer is due. On the game thread this catches the wheels up
+	 * first; elsewhere it reports the wheels as of their last advance, which is
+	 * at most one frame behind (the tick manager advances them right before
+	 * its parallel phase).
+	 */
+	bool HasFired(const FBehaviacTimerHandle& Handle);
+
+	bool IsTimerPending(const FBehaviacTimerHandle& Handle) const;
+
+	/** Fire everything due by now. Called every frame, and before timers are polled. */
+	void AdvanceTimers();
+
+	double GetTimeSeconds() const;
+
+	int32 GetNumPendingTimers() const;
+
+	/** Run on World's clock instead of the platform clock */
+	void SetWorld(const UWorld* InWorld) { World = InWorld; }
+
+private:
+	enum EWheel : uint8
+	{
+		Wheel_Time,
+		Wheel_Frame
+	};
+
+	FBehaviacTimerWheel& GetWheel(const FBehaviacTimerHandle& Handle) { return Handle.Wheel == Wheel_Frame ? FrameWheel : TimeWheel; }
+	const FBehaviacTimerWheel& GetWheel(const FBehaviacTimerHandle& Handle) const { return Handle.Wheel == Wheel_Frame ? FrameWheel : TimeWheel; }
+
+	static uint64 ToWheelTick(double Time);
+
+	/** On the game thread, advance once so a wheel that never ran has a current tick */
+	void StartWheels();
+
+	FBehaviacTimerWheel TimeWheel;
+	FBehaviacTimerWheel FrameWheel;
+
+	/** Owner of the clock; null for the platform clock */
+	const UWorld* World = nullptr;
+
+	/** Guards both wheels against parallel agent ticks */
+	mutable FCriticalSection TimerLock;
+};
+
+/**
+ * UBehaviacTimerManager: deadlines of every timed Behaviac node in a world.
+ *
+ * Wait, WaitFrames, DecoratorTime, DecoratorFrames, the wait states and wait
+ * transitions register their deadline here on enter and poll a completion
+ * flag, instead of comparing timestamps every tick. Sleeping agents register
+ * their wake deadline with a callback.
+ *
+ * Game and PIE worlds only, like UBehaviacTickManager. Agents anywhere else
+ * (no world, editor previews) share FBehaviacTimers::GetNoWorld().
+ */
+UCLASS()
+class BEHAVIACRUNTIME_API UBehaviacTimerManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Manager for the world of WorldContext, or nullptr when it has none */
+	static UBehaviacTimerManager* Find(const UObject* WorldContext);
+
+	/** Timers for the world of WorldContext, or the world-less timers when it has no manager */
+	static FBehaviacTimers& Get(const UObject* WorldContext);
+
+	FBehaviacTimers& GetTimers() { return Timers; }
+
+	// UTickableWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FBehaviacTimers Timers;
+};
+
+/**
+ * Timer owned by a task. Remembers where it was set so it can always be
+ * cleared, and clears itself when the owner is destroyed.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacTaskTimer
+{
+	~FBehaviacTaskTimer() { Clear(); }
+
+	/** (Re)arm for Agent's clock time Time */
+	void SetAt(const UBehaviacAgentComponent* Agent, double Time);
+
+	/** (Re)arm for frame Frame */
+	void SetAtFrame(const UBehaviacAgentComponent* Agent, uint64 Frame);
+
+	/** Whether the armed deadline has passed */
+	bool HasFired() const;
+
+	void Clear();
+
+	bool IsSet() const { return Handle.IsValid(); }
+
+private:
+	/** Timers the handle belongs to, or nullptr once its world's manager is gone */
+	FBehaviacTimers* GetTimers() const;
+
+	/** Manager the timer was set on; unset for the world-less timers */
+	TWeakObjectPtr<UBehaviacTimerManager> Manager;
+	FBehaviacTimerHandle Handle;
+	bool bNoWorld = false;
+};
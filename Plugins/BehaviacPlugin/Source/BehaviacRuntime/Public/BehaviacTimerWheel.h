@@ -0,0 +1,116 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Handle to a timer in a FBehaviacTimerWheel; stale handles are detected by serial. */
+struct BEHAVIACRUNTIME_API FBehaviacTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	/** Which wheel of its owner the timer lives in */
+	uint8 Wheel = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Hierarchical timer wheel over integer ticks.
+ *
+ * Five levels of 64 slots cover 2^30 ticks ahead; timers further out wait in an
+ * overflow list that is re-sorted whenever the top level wraps. Adding,
+ * cancelling and firing a timer are O(1). Advancing jumps from one occupied
+ * slot or cascade to the next (found with a bitmask per level), so an empty
+ * stretch of the wheel costs nothing however many ticks it spans.
+ *
+ * Each timer also keeps its exact deadline: a timer in the current tick fires
+ * only once Now reaches it, so expiry is as precise as comparing timestamps.
+ *
+ * Timers without a callback stay "fired" until their owner removes them, so the
+ * owner can poll HasFired(). Timers with a callback are released after it runs.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTimerWheel
+{
+public:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr int32 NumLevels = 5;
+
+	FBehaviacTimerWheel();
+
+	/** Add a timer for DeadlineTick (the tick containing Deadline). Advance() must have been called once. */
+	FBehaviacTimerHandle Add(uint64 DeadlineTick, double Deadline, TFunction<void()> OnFired = nullptr);
+
+	/** Cancel a pending timer or release a fired one; invalidates Handle. */
+	void Remove(FBehaviacTimerHandle& Handle);
+
+	bool HasFired(const FBehaviacTimerHandle& Handle) const;
+	bool IsPending(const FBehaviacTimerHandle& Handle) const;
+
+	/** Move time forward to NowTick/Now, firing every timer whose deadline has passed. */
+	void Advance(uint64 NowTick, double Now);
+
+	/**
+	 * Same, but hand the callbacks of the fired timers to the caller instead of
+	 * running them, so an owner can run them after releasing its own lock.
+	 */
+	void Advance(uint64 NowTick, double Now, TArray<TFunction<void()>>& OutCallbacks);
+
+	bool HasStarted() const { return bStarted; }
+	uint64 GetCurrentTick() const { return CurrentTick; }
+	int32 NumPending() const { return NumPendingTimers; }
+	int32 NumAllocated() const { return Timers.Num() - FreeIndices.Num(); }
+
+private:
+	enum class EState : uint8
+	{
+		Free,
+		Pending,
+		Fired
+	};
+
+	struct FTimer
+	{
+		uint64 Tick = 0;
+		double Deadline = 0.0;
+		TFunction<void()> OnFired;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int32 List = INDEX_NONE;
+		uint32 Serial = 0;
+		EState State = EState::Free;
+	};
+
+	/** List ids: Level * NumSlots + Slot, then these two */
+	static constexpr int32 DueList = NumLevels * NumSlots;
+	static constexpr int32 OverflowList = DueList + 1;
+	static constexpr int32 NumLists = OverflowList + 1;
+
+	bool IsCurrent(const FBehaviacTimerHandle& Handle) const;
+	void Link(int32 Index, int32 List);
+	void Unlink(int32 Index);
+	void Place(int32 Index);
+	void Replace(int32 List);
+
+	/** First tick after CurrentTick whose slot or cascade has timers to move; MAX_uint64 if none */
+	uint64 FindNextBusyTick() const;
+	void ProcessList(int32 List, uint64 NowTick, double Now, TArray<TFunction<void()>>& OutCallbacks);
+	void Fire(int32 Index, TArray<TFunction<void()>>& OutCallbacks);
+	void Release(int32 Index);
+
+	TArray<FTimer> Timers;
+	TArray<int32> FreeIndices;
+	int32 ListHeads[NumLists];
+
+	/** Per level, a bit for each slot whose list is not empty */
+	uint64 OccupiedSlots[NumLevels];
+
+	uint64 CurrentTick = 0;
+	bool bStarted = false;
+	int32 NumPendingTimers = 0;
+	uint32 NextSerial = 0;
+};
@@ -25,7 +25,7 @@ BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacVerboseLoggin
  * Real errors should still use UE_LOG(LogBehaviac, Error, ...) directly.
  */
 #define BEHAVIAC_VLOG(Format, ...) \
-	if (CVarBehaviacVerboseLogging.GetValueOnGameThread() != 0) \
+	if (CVarBehaviacVerboseLogging.GetValueOnAnyThread() != 0) \
 	{ \
 		UE_LOG(LogBehaviac, Log, Format, ##__VA_ARGS__); \
 	}
@@ -111,7 +111,9 @@ enum class EBehaviacEffectorPhase : uint8
 UENUM(BlueprintType)
 enum class EBehaviacFileFormat : uint8
 {
+	/** Tree XML as exported by the behaviac designer */
 	XML,
+	/** Compiled binary tree, ".bhvb" (see FBehaviacTreeBinary) */
 	BSON,
 };
 
@@ -135,3 +137,30 @@ struct BEHAVIACRUNTIME_API FBehaviacProperty
 		: Name(InName), Value(InValue)
 	{}
 };
+
+/**
+ * What a blocked running task is waiting for. An agent whose whole running
+ * path reports one can sleep until any of the conditions is met.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacWakeCondition
+{
+	/** Signal that ends the wait, from FBehaviacSignalRegistry (INDEX_NONE = none) */
+	int32 SignalId = INDEX_NONE;
+
+	/** Agent time (UBehaviacAgentComponent::GetTimeSeconds) the wait ends at */
+	double WakeTime = TNumericLimits<double>::Max();
+
+	/** GFrameCounter value the wait ends at */
+	uint64 WakeFrame = MAX_uint64;
+
+	bool HasSignal() const { return SignalId != INDEX_NONE; }
+	bool HasWakeTime() const { return WakeTime < TNumericLimits<double>::Max(); }
+	bool HasWakeFrame() const { return WakeFrame < MAX_uint64; }
+
+	/** Whether anything at all can end the wait */
+	bool IsValid() const { return HasSignal() || HasWakeTime() || HasWakeFrame(); }
+
+	/** Also end the wait at Time / Frame, whichever of the deadlines comes first */
+	void AddDeadline(double Time) { WakeTime = FMath::Min(WakeTime, Time); }
+	void AddFrameDeadline(uint64 Frame) { WakeFrame = FMath::Min(WakeFrame, Frame); }
+};
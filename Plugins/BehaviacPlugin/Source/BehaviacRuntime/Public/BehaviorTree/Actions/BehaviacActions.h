@@ -6,6 +6,9 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacOperand.h"
+#include "BehaviacTimerManager.h"
+#include "BehaviacSignals.h"
 #include "BehaviacActions.generated.h"
 
 class UBehaviacAgentComponent;
@@ -22,7 +25,7 @@ class BEHAVIACRUNTIME_API UBehaviacAction : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** The method name to call on the agent */
@@ -32,14 +35,71 @@ public:
 	/** Result status when method is called */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Action")
 	EBehaviacStatus ResultOption;
+
+	/** MethodName resolved through FBehaviacMethodRegistry */
+	int32 MethodId = BEHAVIAC_INVALID_METHOD_ID;
+
+protected:
+	virtual void ResolveOperands() override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacActionTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacActionTask : public FBehaviacLeafTask
+{
+	using Super = FBehaviacLeafTask;
+protected:
+	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+};
+
+// ===================================================================
+// GUARDED ACTION
+// ===================================================================
+
+/**
+ * GuardedAction: Sequence(Condition, Action) as one node, produced by the tree
+ * optimizer. The guard is checked once when the node is entered; while the
+ * action runs it is not re-checked, as the Sequence would not re-check it.
+ */
+UCLASS(DisplayName = "Guarded Action")
+class BEHAVIACRUNTIME_API UBehaviacGuardedAction : public UBehaviacAction
 {
 	GENERATED_BODY()
+public:
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Action")
+	FString GuardLeftOperand;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Action")
+	FString GuardRightOperand;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Action")
+	EBehaviacOperatorType GuardOperator;
+
+	/** Guard operands and kernel resolved from the fields above */
+	const FBehaviacComparison& GetGuard() const { return Guard; }
+
+	virtual void GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates) override;
+
+protected:
+	virtual void ResolveOperands() override;
+
+	FBehaviacComparison Guard;
+};
+
+class BEHAVIACRUNTIME_API FBehaviacGuardedActionTask : public FBehaviacActionTask
+{
+	using Super = FBehaviacActionTask;
+public:
+	FBehaviacGuardedActionTask();
+
 protected:
+	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+	/** This agent's blackboard slots for the guard operands */
+	int32 SlotHints[2];
+
+	bool bGuardPassed;
 };
 
 // ===================================================================
@@ -54,7 +114,7 @@ class BEHAVIACRUNTIME_API UBehaviacAssignment : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Assignment")
@@ -65,14 +125,28 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Assignment")
 	bool bCastFromRight;
+
+	/** Resolved target key */
+	FName TargetKey;
+
+	/** Resolved source (constant or property) */
+	FBehaviacOperand Source;
+
+protected:
+	virtual void ResolveOperands() override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacAssignmentTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacAssignmentTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
+public:
+	FBehaviacAssignmentTask();
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+	/** This agent's blackboard slots for the target and source */
+	int32 SlotHints[2];
 };
 
 // ===================================================================
@@ -87,7 +161,7 @@ class BEHAVIACRUNTIME_API UBehaviacCompute : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Compute")
@@ -101,14 +175,28 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Compute")
 	EBehaviacOperatorType Operator;
+
+	/** Resolved result key, operands and arithmetic kernel */
+	FName ResultKey;
+	FBehaviacOperand Left;
+	FBehaviacOperand Right;
+	FBehaviacArithmeticKernel Kernel;
+
+protected:
+	virtual void ResolveOperands() override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacComputeTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacComputeTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
+public:
+	FBehaviacComputeTask();
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+	/** This agent's blackboard slots for the result, left and right operands */
+	int32 SlotHints[3];
 };
 
 // ===================================================================
@@ -123,13 +211,12 @@ class BEHAVIACRUNTIME_API UBehaviacNoop : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacNoopTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacNoopTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -146,7 +233,7 @@ class BEHAVIACRUNTIME_API UBehaviacEnd : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|End")
@@ -156,10 +243,9 @@ public:
 	bool bEndOutermost;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacEndTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacEndTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -176,27 +262,31 @@ class BEHAVIACRUNTIME_API UBehaviacWait : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Wait")
 	float Duration;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWaitTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacWaitTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 public:
-	UBehaviacWaitTask();
+	FBehaviacWaitTask();
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
 	double StartTime;
 	float WaitDuration;
+	FBehaviacTaskTimer Timer;
 };
 
 // ===================================================================
@@ -211,27 +301,31 @@ class BEHAVIACRUNTIME_API UBehaviacWaitFrames : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|WaitFrames")
 	int32 FrameCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWaitFramesTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacWaitFramesTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 public:
-	UBehaviacWaitFramesTask();
+	FBehaviacWaitFramesTask();
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
-	int32 StartFrame;
+	uint64 StartFrame;
 	int32 TargetFrames;
+	FBehaviacTaskTimer Timer;
 };
 
 // ===================================================================
@@ -246,17 +340,25 @@ class BEHAVIACRUNTIME_API UBehaviacWaitForSignal : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|WaitForSignal")
 	FString SignalName;
+
+	/** SignalName interned through FBehaviacSignalRegistry */
+	int32 SignalId = BEHAVIAC_INVALID_SIGNAL_ID;
+
+protected:
+	virtual void ResolveOperands() override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWaitForSignalTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacWaitForSignalTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
+public:
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -6,6 +6,8 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "BehaviacTypes.h"
+#include "BehaviacSignals.h"
+#include "BehaviorTree/BehaviacOperand.h"
 #include "BehaviacAttachment.generated.h"
 
 class UBehaviacAgentComponent;
@@ -34,6 +36,16 @@ public:
 	/** Check if this attachment applies to the given precondition phase */
 	virtual bool AppliesToPhase(EBehaviacPreconditionPhase Phase) const;
 
+	/** Resolve operand strings ahead of evaluation (called by the owning node) */
+	virtual void ResolveOperands();
+
+	/** Add the comparisons Evaluate runs (see UBehaviacBehaviorNode::GatherPredicates) */
+	virtual void GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates) {}
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	/** Precondition phase this applies to */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Attachment")
 	EBehaviacPreconditionPhase PreconditionPhase;
@@ -49,6 +61,23 @@ public:
 	/** Whether to negate the condition result */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Attachment")
 	bool bNegate;
+
+	/**
+	 * Resolve now unless already resolved. The owning tree resolves its
+	 * attachments when it is compiled; evaluating one that is not resolved
+	 * (built or edited by hand since) resolves it first, on the game thread only.
+	 */
+	void EnsureOperandsResolved() const
+	{
+		if (!bOperandsResolved)
+		{
+			check(IsInGameThread());
+			const_cast<UBehaviacAttachment*>(this)->ResolveOperands();
+		}
+	}
+
+protected:
+	bool bOperandsResolved;
 };
 
 /**
@@ -65,6 +94,8 @@ public:
 	virtual void LoadFromProperties(int32 Version, const FString& AgentType, const TArray<FBehaviacProperty>& Properties) override;
 	virtual bool AppliesToPhase(EBehaviacPreconditionPhase Phase) const override;
 	virtual bool Evaluate(UBehaviacAgentComponent* Agent) const override;
+	virtual void ResolveOperands() override;
+	virtual void GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates) override;
 
 	/** The condition expression to evaluate */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Precondition")
@@ -81,6 +112,10 @@ public:
 	/** Right operand */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Precondition")
 	FString RightOperand;
+
+protected:
+	/** Left always names a property; right is a property ("Self.X") or a constant */
+	FBehaviacComparison Comparison;
 };
 
 /**
@@ -95,6 +130,7 @@ public:
 	UBehaviacEffector();
 
 	virtual void Apply(UBehaviacAgentComponent* Agent, bool bSuccess) const override;
+	virtual void ResolveOperands() override;
 
 	/** The action expression to execute */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Effector")
@@ -107,6 +143,10 @@ public:
 	/** Value to set */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Effector")
 	FString PropertyValue;
+
+protected:
+	FName TargetKey;
+	FBehaviacValue ResolvedValue;
 };
 
 /**
@@ -120,10 +160,15 @@ class BEHAVIACRUNTIME_API UBehaviacEventAttachment : public UBehaviacAttachment
 public:
 	UBehaviacEventAttachment();
 
+	virtual void ResolveOperands() override;
+
 	/** Name of the event to listen for */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Event")
 	FString EventName;
 
+	/** EventName interned through FBehaviacSignalRegistry */
+	int32 EventId = BEHAVIAC_INVALID_SIGNAL_ID;
+
 	/** Whether the event triggers once or repeatedly */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Event")
 	bool bTriggeredOnce;
@@ -8,16 +8,18 @@
 #include "BehaviacTypes.h"
 #include "BehaviacBehaviorNode.generated.h"
 
-class UBehaviacBehaviorTask;
+class FBehaviacBehaviorTask;
 class UBehaviacAgentComponent;
 class UBehaviacAttachment;
+struct FBehaviacObservedKeys;
+struct FBehaviacComparison;
 
 /**
  * Base class for all behavior tree nodes.
  * 
  * This mirrors the original behaviac BehaviorNode class, restructured
  * as a UObject for UE5 integration. Each node is a template that defines
- * behavior; the actual runtime state is held in UBehaviacBehaviorTask.
+ * behavior; the actual runtime state is held in FBehaviacBehaviorTask.
  */
 UCLASS(Abstract, Blueprintable, EditInlineNew, DefaultToInstanced)
 class BEHAVIACRUNTIME_API UBehaviacBehaviorNode : public UObject
@@ -51,6 +53,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Node")
 	bool bHasEvents;
 
+	/**
+	 * Ids of the authored nodes the tree optimizer folded into this one
+	 * (collapsed composites and decorators, fused conditions, pruned branches),
+	 * so debugger output can be traced back to the source tree.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|Node")
+	TArray<int32> MergedNodeIds;
+
 	// --- Attachments ---
 
 	/** Precondition attachments evaluated before this node executes */
@@ -73,11 +83,11 @@ public:
 	/** Add a child node */
 	void AddChild(UBehaviacBehaviorNode* Child);
 
-	/** Create the corresponding task instance for this node */
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const;
+	/** Create the corresponding task instance for this node; the caller owns it */
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const;
 
 	/** Check if this node is valid for the given agent */
-	virtual bool IsValid(UBehaviacAgentComponent* Agent, UBehaviacBehaviorTask* Task) const;
+	virtual bool IsValid(UBehaviacAgentComponent* Agent, FBehaviacBehaviorTask* Task) const;
 
 	/** Get the number of children */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|Node")
@@ -94,8 +104,54 @@ public:
 	/** Set parent node */
 	void SetParent(UBehaviacBehaviorNode* InParent) { ParentNode = InParent; }
 
+	/**
+	 * Resolve operand strings (blackboard keys, constants, kernels) ahead of execution.
+	 * Called for every node after XML load and again from task Init so hand-built
+	 * trees are covered; does nothing when already resolved. Resolving writes the
+	 * node, so it must happen on the game thread.
+	 */
+	void EnsureOperandsResolved();
+
+	/**
+	 * EnsureOperandsResolved over this node, its attachments and its subtree.
+	 * Game thread only: the tree resolves everything when it is compiled, so
+	 * tasks (which may tick in parallel) only ever read resolved operands.
+	 */
+	void EnsureSubtreeOperandsResolved();
+
+	/** Mark resolved operands stale (after operand fields were changed at runtime) */
+	void InvalidateResolvedOperands() { bOperandsResolved = false; }
+
+	/**
+	 * Add the blackboard keys this node reads when evaluated as a guard.
+	 * Returns false when its result can depend on anything else (actions, time,
+	 * attachments); observers then re-evaluate it every tick. Operands must be resolved.
+	 */
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const { return false; }
+
+	/**
+	 * Add the comparisons this node and its preconditions evaluate, for the
+	 * tree compiler to find the ones that occur more than once. Operands must be resolved.
+	 */
+	virtual void GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates);
+
+	bool HasAttachments() const { return Preconditions.Num() > 0 || Effectors.Num() > 0 || Events.Num() > 0; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
+	/** Resolve this node's operands. Base resolves attachment operands. */
+	virtual void ResolveOperands();
+
+	/** GatherObservedKeys over every child; false if any child is not observable */
+	bool GatherChildrenObservedKeys(FBehaviacObservedKeys& OutKeys) const;
+
 	/** Parent node reference */
 	UPROPERTY()
 	UBehaviacBehaviorNode* ParentNode;
+
+private:
+	bool bOperandsResolved;
 };
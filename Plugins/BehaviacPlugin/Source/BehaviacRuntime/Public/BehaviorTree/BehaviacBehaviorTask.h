@@ -4,12 +4,86 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "UObject/NoExportTypes.h"
 #include "BehaviacTypes.h"
-#include "BehaviacBehaviorTask.generated.h"
 
 class UBehaviacBehaviorNode;
 class UBehaviacAgentComponent;
+class FBehaviacBehaviorTask;
+class FBehaviacTreeInstance;
+
+/**
+ * Decides where new tasks live. By default each task is its own heap
+ * allocation. Given a state block and the layout FBehaviacCompiledTree
+ * measured for it, tasks are constructed at their fixed offsets in that block
+ * instead, in creation order; a task that does not fit the layout (the node
+ * graph changed since it was measured) falls back to the heap.
+ *
+ * With a deferring instance, tasks leave their children unbuilt until they are
+ * first entered (see FBehaviacTreeInstance::BuildChildTasks).
+ */
+class BEHAVIACRUNTIME_API FBehaviacTaskAllocator
+{
+public:
+	/** Placement of one task in a state block */
+	struct FSlot
+	{
+		uint32 Offset = 0;
+		uint32 Size = 0;
+		uint32 Alignment = 0;
+	};
+
+	/** Heap allocator */
+	FBehaviacTaskAllocator() = default;
+
+	/** Place tasks in State following Layout; with InDeferTo, children wait for their parent to be entered */
+	FBehaviacTaskAllocator(uint8* InState, TArrayView<const FSlot> InLayout, FBehaviacTreeInstance* InDeferTo = nullptr);
+
+	/** Heap allocator that records the state block layout of what it creates */
+	static FBehaviacTaskAllocator MakeMeasuring();
+
+	template<typename TTask>
+	TTask* New()
+	{
+		if (void* Memory = AllocateSlot(sizeof(TTask), alignof(TTask)))
+		{
+			TTask* Task = new (Memory) TTask();
+			static_cast<FBehaviacBehaviorTask*>(Task)->bInStateBlock = true;
+			return Task;
+		}
+		return new TTask();
+	}
+
+	/** Destroy Task (and with it its child tasks), freeing it unless it lives in a state block */
+	static void Destroy(FBehaviacBehaviorTask* Task);
+
+	/** Layout recorded while measuring */
+	const TArray<FSlot>& GetMeasuredLayout() const { return MeasuredLayout; }
+	uint32 GetMeasuredSize() const { return MeasuredSize; }
+	uint32 GetMeasuredAlignment() const { return MeasuredAlignment; }
+
+	/** Whether every task so far went where the layout said */
+	bool MatchedLayout() const { return !bMismatch && State && NextSlot == Layout.Num(); }
+
+	/** Instance that builds child tasks on first entry, or nullptr to build them now */
+	FBehaviacTreeInstance* GetDeferringInstance() const { return DeferTo; }
+
+private:
+	void* AllocateSlot(SIZE_T Size, SIZE_T Alignment);
+
+	uint8* State = nullptr;
+	TArrayView<const FSlot> Layout;
+	int32 NextSlot = 0;
+	FBehaviacTreeInstance* DeferTo = nullptr;
+	bool bMismatch = false;
+
+	bool bMeasuring = false;
+	TArray<FSlot> MeasuredLayout;
+	uint32 MeasuredSize = 0;
+	uint32 MeasuredAlignment = 1;
+};
+
+/** Places a generated tree's task with the allocator it is given (see FBehaviacNativeTreeRegistry) */
+typedef FBehaviacBehaviorTask* (*FBehaviacNativeTreeFactory)(FBehaviacTaskAllocator& Allocator);
 
 /**
  * Base class for behavior task instances (runtime state of a behavior node).
@@ -17,17 +91,24 @@ class UBehaviacAgentComponent;
  * Mirrors the original behaviac BehaviorTask. Each task holds the runtime
  * execution state for one node instance. The node definition is in
  * UBehaviacBehaviorNode; the task is the live execution context.
+ *
+ * Tasks are plain C++ objects, not UObjects: a parent owns its child tasks and
+ * the agent owns the root, so a running tree adds nothing for the garbage
+ * collector to walk. The nodes a task points at stay alive through the tree
+ * asset the agent references. Blueprints inspect tasks through
+ * UBehaviacTaskView, created on demand.
  */
-UCLASS(Abstract, BlueprintType)
-class BEHAVIACRUNTIME_API UBehaviacBehaviorTask : public UObject
+class BEHAVIACRUNTIME_API FBehaviacBehaviorTask
 {
-	GENERATED_BODY()
-
 public:
-	UBehaviacBehaviorTask();
+	FBehaviacBehaviorTask();
+	virtual ~FBehaviacBehaviorTask() = default;
+
+	FBehaviacBehaviorTask(const FBehaviacBehaviorTask&) = delete;
+	FBehaviacBehaviorTask& operator=(const FBehaviacBehaviorTask&) = delete;
 
-	/** Initialize this task with its corresponding node definition */
-	virtual void Init(UBehaviacBehaviorNode* InNode);
+	/** Initialize this task with its corresponding node definition, creating child tasks with Allocator */
+	virtual void Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator);
 
 	// --- Execution ---
 
@@ -35,26 +116,66 @@ public:
 	EBehaviacStatus Execute(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus = EBehaviacStatus::Running);
 
 	/** Get the current status */
-	UFUNCTION(BlueprintCallable, Category = "Behaviac|Task")
 	EBehaviacStatus GetStatus() const { return Status; }
 
 	/** Get the node definition this task is running */
-	UFUNCTION(BlueprintCallable, Category = "Behaviac|Task")
 	UBehaviacBehaviorNode* GetNode() const { return Node; }
 
+	/** Type name of the task class (see BEHAVIAC_DECLARE_TASK_TYPE) */
+	static FName StaticTaskType() { static const FName Type(TEXT("FBehaviacBehaviorTask")); return Type; }
+
+	/** Whether this task is of the task class Type names, or derives from it */
+	virtual bool IsTaskA(FName Type) const { return Type == StaticTaskType(); }
+
 	/** Get the parent task */
-	UBehaviacBehaviorTask* GetParentTask() const { return ParentTask; }
+	FBehaviacBehaviorTask* GetParentTask() const { return ParentTask; }
 
 	/** Set the parent task */
-	void SetParentTask(UBehaviacBehaviorTask* InParent) { ParentTask = InParent; }
+	void SetParentTask(FBehaviacBehaviorTask* InParent) { ParentTask = InParent; }
 
 	/** Reset this task for reuse */
 	virtual void Reset(UBehaviacAgentComponent* Agent);
 
 	/** Traverse the tree to reset all running/completed tasks */
-	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler);
+	virtual void Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler);
+
+	/** Direct child tasks, for inspection */
+	virtual int32 GetNumChildTasks() const { return 0; }
+	virtual FBehaviacBehaviorTask* GetChildTask(int32 Index) const { return nullptr; }
+
+	/** Create the tasks of the node's children with Allocator */
+	virtual void CreateChildTasks(FBehaviacTaskAllocator& Allocator) {}
+
+	/** Destroy the child tasks (and theirs) */
+	virtual void DestroyChildTasks() {}
+
+	/** Whether the child tasks wait to be built until this task is entered */
+	bool HasDeferredChildTasks() const { return DeferredOwner != nullptr; }
+
+	/**
+	 * If this running task would keep returning Running until a signal, a
+	 * deadline or a frame count is reached, describe that in OutCondition and
+	 * return true. Ticking it before then would change nothing.
+	 */
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const;
+
+	/**
+	 * The running child this running task does nothing but tick, if any. A
+	 * tree tick can start below such a task and only come back to it once the
+	 * child finishes.
+	 */
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const { return nullptr; }
 
 protected:
+	/** Whether this running task is safe to skip ticks of (no per-tick preconditions) */
+	bool CanSleep() const;
+
+	/** Child, if this task can be skipped while Child runs */
+	FBehaviacBehaviorTask* ForwardedIfRunning(FBehaviacBehaviorTask* Child) const;
+
+	/** Wake condition of Child when it is this task's running child */
+	bool GetChildWakeCondition(const FBehaviacBehaviorTask* Child, UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const;
+
 	/** Called when entering this node */
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent);
 
@@ -74,79 +195,94 @@ protected:
 	void ApplyEffectors(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) const;
 
 	/** The node definition */
-	UPROPERTY()
 	UBehaviacBehaviorNode* Node;
 
 	/** Current status */
-	UPROPERTY()
 	EBehaviacStatus Status;
 
 	/** Parent task */
-	UPROPERTY()
-	UBehaviacBehaviorTask* ParentTask;
+	FBehaviacBehaviorTask* ParentTask;
 
 	/** Has this task been entered? */
 	bool bHasEntered;
+
+private:
+	friend class FBehaviacTaskAllocator;
+	friend class FBehaviacBehaviorTreeTask;
+	friend class FBehaviacTreeInstance;
+
+	/** Constructed in a state block rather than allocated on its own */
+	bool bInStateBlock = false;
+
+	/** Finished during a resumed tick; the next Execute reports Status to the parent instead of running */
+	bool bResultPending = false;
+
+	/** Instance that builds the child tasks when this task is entered (nullptr once built) */
+	FBehaviacTreeInstance* DeferredOwner = nullptr;
 };
 
 // -------------------------------------------------------------------
 // Composite Task: Base for nodes that manage multiple children
 // -------------------------------------------------------------------
-UCLASS(Abstract)
-class BEHAVIACRUNTIME_API UBehaviacCompositeTask : public UBehaviacBehaviorTask
+class BEHAVIACRUNTIME_API FBehaviacCompositeTask : public FBehaviacBehaviorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacBehaviorTask;
 
 public:
-	UBehaviacCompositeTask();
+	FBehaviacCompositeTask();
+	virtual ~FBehaviacCompositeTask();
 
-	virtual void Init(UBehaviacBehaviorNode* InNode) override;
+	virtual void Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator) override;
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
-	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler) override;
+	virtual void Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler) override;
+	virtual int32 GetNumChildTasks() const override { return ChildTasks.Num(); }
+	virtual FBehaviacBehaviorTask* GetChildTask(int32 Index) const override { return ChildTasks.IsValidIndex(Index) ? ChildTasks[Index] : nullptr; }
+	virtual void CreateChildTasks(FBehaviacTaskAllocator& Allocator) override;
+	virtual void DestroyChildTasks() override;
 
 	/** Get all child tasks */
-	const TArray<UBehaviacBehaviorTask*>& GetChildTasks() const { return ChildTasks; }
+	const TArray<FBehaviacBehaviorTask*>& GetChildTasks() const { return ChildTasks; }
 
 protected:
 	/** Index of the currently active child */
-	UPROPERTY()
 	int32 ActiveChildIndex;
 
-	/** Child task instances */
-	UPROPERTY()
-	TArray<UBehaviacBehaviorTask*> ChildTasks;
+	/** Child task instances (owned) */
+	TArray<FBehaviacBehaviorTask*> ChildTasks;
 };
 
 // -------------------------------------------------------------------
 // Single Child Task: Base for nodes with exactly one child (decorators)
 // -------------------------------------------------------------------
-UCLASS(Abstract)
-class BEHAVIACRUNTIME_API UBehaviacSingleChildTask : public UBehaviacBehaviorTask
+class BEHAVIACRUNTIME_API FBehaviacSingleChildTask : public FBehaviacBehaviorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacBehaviorTask;
 
 public:
-	UBehaviacSingleChildTask();
+	FBehaviacSingleChildTask();
+	virtual ~FBehaviacSingleChildTask();
 
-	virtual void Init(UBehaviacBehaviorNode* InNode) override;
+	virtual void Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator) override;
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
-	virtual void Traverse(bool bChildFirst, TFunction<bool(UBehaviacBehaviorTask*)> Handler) override;
+	virtual void Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler) override;
+	virtual int32 GetNumChildTasks() const override { return ChildTask ? 1 : 0; }
+	virtual FBehaviacBehaviorTask* GetChildTask(int32 Index) const override { return Index == 0 ? ChildTask : nullptr; }
+	virtual void CreateChildTasks(FBehaviacTaskAllocator& Allocator) override;
+	virtual void DestroyChildTasks() override;
 
 protected:
 	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
-	/** The single child task */
-	UPROPERTY()
-	UBehaviacBehaviorTask* ChildTask;
+	/** The single child task (owned) */
+	FBehaviacBehaviorTask* ChildTask;
 };
 
 // -------------------------------------------------------------------
 // Leaf Task: Base for nodes with no children (actions, conditions)
 // -------------------------------------------------------------------
-UCLASS(Abstract)
-class BEHAVIACRUNTIME_API UBehaviacLeafTask : public UBehaviacBehaviorTask
+class BEHAVIACRUNTIME_API FBehaviacLeafTask : public FBehaviacBehaviorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacBehaviorTask;
 
 public:
 	// Leaf tasks have no children, so Init/Traverse are simple
@@ -155,27 +291,73 @@ public:
 // -------------------------------------------------------------------
 // BehaviorTree Task: Root-level task wrapping the entire tree
 // -------------------------------------------------------------------
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacBehaviorTreeTask : public UBehaviacSingleChildTask
+class BEHAVIACRUNTIME_API FBehaviacBehaviorTreeTask : public FBehaviacSingleChildTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacSingleChildTask;
 
 public:
 	/** Override Init to create task from root node itself */
-	virtual void Init(UBehaviacBehaviorNode* InNode) override;
+	virtual void Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator) override;
+
+	/** Init with the task NativeFactory makes (a generated tree) in place of the root node's task */
+	void Init(UBehaviacBehaviorNode* InNode, FBehaviacTaskAllocator& Allocator, FBehaviacNativeTreeFactory NativeFactory);
 	
-	/** Tick the entire behavior tree */
-	EBehaviacStatus Tick(UBehaviacAgentComponent* Agent);
+	/**
+	 * Tick the entire behavior tree. With bResume, the tick starts at the task
+	 * the last one left running below a chain of forwarding ancestors
+	 * (Sequence, Selector, IfElse, pass-through decorators) and climbs back
+	 * up only as tasks finish, instead of descending from the root.
+	 */
+	EBehaviacStatus Tick(UBehaviacAgentComponent* Agent, bool bResume = true);
 
 	/** Get the tree-level status */
-	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
 	EBehaviacStatus GetTreeStatus() const { return Status; }
 	
 	/** Check if child task was created */
 	bool HasChildTask() const { return ChildTask != nullptr; }
 
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const override { return ForwardedIfRunning(ChildTask); }
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+
+	/** Task the next resumed tick starts at (nullptr: the tree task itself) */
+	FBehaviacBehaviorTask* GetResumeTask() const { return ResumeTask; }
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+private:
+	/** Deepest task below From reached through forwarding ancestors */
+	static FBehaviacBehaviorTask* FindResumeTask(FBehaviacBehaviorTask* From);
+
+	FBehaviacBehaviorTask* ResumeTask = nullptr;
 };
+
+/**
+ * Gives a task class its own type for BehaviacCastTask. Put it in the class
+ * body after the class's Super alias; subclasses without it count as their
+ * parent's type.
+ */
+#define BEHAVIAC_DECLARE_TASK_TYPE(TaskClass) \
+public: \
+	static FName StaticTaskType() { static const FName Type(TEXT(#TaskClass)); return Type; } \
+	virtual bool IsTaskA(FName Type) const override { return Type == StaticTaskType() || Super::IsTaskA(Type); }
+
+/**
+ * Cast Task to TTask if it is one. Tasks carry no UClass and the node's class
+ * does not decide which task it creates, so this asks the task itself;
+ * TTask must declare its type with BEHAVIAC_DECLARE_TASK_TYPE.
+ */
+template<typename TTask>
+TTask* BehaviacCastTask(FBehaviacBehaviorTask* Task)
+{
+	return Task && Task->IsTaskA(TTask::StaticTaskType()) ? static_cast<TTask*>(Task) : nullptr;
+}
+
+template<typename TTask>
+const TTask* BehaviacCastTask(const FBehaviacBehaviorTask* Task)
+{
+	return Task && Task->IsTaskA(TTask::StaticTaskType()) ? static_cast<const TTask*>(Task) : nullptr;
+}
@@ -10,12 +10,143 @@
 #include "BehaviacBehaviorTree.generated.h"
 
 class UBehaviacBehaviorNode;
+class FBehaviacCompiledTree;
+
+/** Occupancy of a tree's pool of agent state (see UBehaviacBehaviorTree::GetStatePoolStats) */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacTreePoolStats
+{
+	GENERATED_BODY()
+
+	/** Bytes of one agent's state slab */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 SlabSize = 0;
+
+	/** Slabs held by agents running the tree */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 SlabsInUse = 0;
+
+	/** Slabs returned by stopped agents, ready for the next one */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 SlabsFree = 0;
+
+	/** Most slabs in use at once */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 SlabsHighWater = 0;
+
+	/** Bytes in use, lazy branch blocks included */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 BytesInUse = 0;
+
+	/** Bytes pooled, lazy branch blocks included */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 BytesPooled = 0;
+
+	/** Most bytes in use at once */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 HighWaterBytes = 0;
+};
+
+/** Trees shared between loads of the same XML file (see FBehaviacTreeFileCache) */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacTreeFileCacheStats
+{
+	GENERATED_BODY()
+
+	/** Files with a cached tree */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NumTrees = 0;
+
+	/** Loads answered with a cached tree */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int64 Hits = 0;
+
+	/** Loads that parsed a file for the first time */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int64 Misses = 0;
+
+	/** Loads that parsed a file again after it was edited */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int64 Reloads = 0;
+
+	/** Approximate bytes of the cached trees and their nodes */
+	UPROPERTY(BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int64 Bytes = 0;
+};
+
+/** What the optimizer did to a tree (see UBehaviacBehaviorTree::Optimize) */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacTreeOptimizerStats
+{
+	GENERATED_BODY()
+
+	/** Nodes in the tree as authored */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NodesBefore = 0;
+
+	/** Nodes left after optimizing */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NodesAfter = 0;
+
+	/** Conditions and decorators over constants replaced by True/False */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 ConstantsFolded = 0;
+
+	/** Nodes removed because they could never run or never change the result */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NodesPruned = 0;
+
+	/** Single-child composites, nested composites and redundant decorators removed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NodesCollapsed = 0;
+
+	/** Condition+Action pairs and decorated actions merged into one node */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NodesFused = 0;
+
+	int32 GetNodesRemoved() const { return NodesBefore - NodesAfter; }
+};
+
+/** What the import pipeline produced for a tree asset (see UBehaviacBehaviorTree::CookFromFile) */
+USTRUCT(BlueprintType)
+struct BEHAVIACRUNTIME_API FBehaviacTreeCookInfo
+{
+	GENERATED_BODY()
+
+	/** UBehaviacBehaviorTree::CookPipelineVersion the nodes were cooked with; 0 if never cooked */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 PipelineVersion = 0;
+
+	/** CRC32 of the source XML */
+	UPROPERTY(VisibleAnywhere, Category = "Behaviac|BehaviorTree")
+	uint32 SourceHash = 0;
+
+	/** Timestamp and size of the source XML when it was cooked */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	FDateTime SourceTimeStamp;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int64 SourceFileSize = 0;
+
+	/** Entries in the compiled tree, the tree task excluded */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NumNodes = 0;
+
+	/** Bytes of one agent's state block */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 StateSize = 0;
+
+	/** Conditions that occur more than once and share one result per tick */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	int32 NumSharedPredicates = 0;
+};
 
 /**
  * UBehaviacBehaviorTree: Data asset representing a behavior tree definition.
  *
  * This is the UE5 equivalent of the original behaviac BehaviorTree class.
- * It can be created in the editor or imported from XML/BSON files.
+ * It can be created in the editor, imported from XML, or loaded from XML or
+ * compiled (.bhvb) files.
  */
 UCLASS(BlueprintType)
 class BEHAVIACRUNTIME_API UBehaviacBehaviorTree : public UDataAsset
@@ -45,20 +176,144 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
 	FString AgentType;
 
+	/**
+	 * Build a branch's runtime tasks the first time an agent enters it rather
+	 * than all of them when the tree is loaded. Cheaper spawns and less memory
+	 * per agent for trees with rarely taken branches.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
+	bool bInstantiateBranchesLazily;
+
+	/** With lazy branches, seconds a branch may sit unused before its tasks are reclaimed (0 = keep them) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree", meta = (ClampMin = "0", EditCondition = "bInstantiateBranchesLazily"))
+	float IdleBranchReclaimTime;
+
+	/**
+	 * Run the tree's generated C++ (see the BehaviacGenerateNativeTrees
+	 * commandlet) when it is compiled in and was generated from this exact
+	 * tree. Otherwise, or when this is off, the tree is interpreted.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
+	bool bUseNativeTree;
+
+	/**
+	 * Run the tree as a flat program when every node has a flat form (see
+	 * FBehaviacCompiledTree::IsFlat): one state array per agent and no task
+	 * per node. Task views then stop at the root. Read when the tree is
+	 * compiled; generated code still comes first.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
+	bool bRunFlatProgram;
+
+	/**
+	 * Run the optimizer (see FBehaviacTreeOptimizer) after LoadFromXML and
+	 * LoadFromBinary, unless Behaviac.OptimizeTrees is 0. Turn off to keep the
+	 * tree exactly as authored.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|BehaviorTree")
+	bool bOptimizeOnLoad;
+
+	/** Result of the last optimizer run */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	FBehaviacTreeOptimizerStats OptimizerStats;
+
+	/** Source and result of the last import (see CookFromFile) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac|BehaviorTree")
+	FBehaviacTreeCookInfo CookInfo;
+
+	/** Bump whenever the parser, operand resolution, optimizer or compiler change the nodes they produce */
+	static constexpr int32 CookPipelineVersion = 1;
+
 	/** Get the root node */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
 	UBehaviacBehaviorNode* GetRootNode() const { return RootNode; }
 
-	/** Load from XML string */
-	bool LoadFromXML(const FString& XMLContent);
+	/** Load from XML text, in one pass without building a DOM (see FBehaviacXmlReader) */
+	bool LoadFromXML(FStringView XMLContent);
+
+	/**
+	 * Load from a compiled tree (see FBehaviacTreeBinary). Builds the same
+	 * nodes LoadFromXML would from the XML it was compiled from; data that
+	 * fails the version or checksum check is rejected before the tree is
+	 * touched.
+	 */
+	bool LoadFromBinary(TConstArrayView<uint8> Data);
+
+	/**
+	 * Run the whole import pipeline on the XML file at FilePath: parse,
+	 * resolve operands, optimize (per bOptimizeOnLoad) and compile, then
+	 * record the source in CookInfo. The resulting nodes are what the asset
+	 * saves, so agents running it start from the optimized tree without
+	 * touching the XML.
+	 */
+	bool CookFromFile(const FString& FilePath);
+
+	/**
+	 * Whether the saved nodes were cooked by this CookPipelineVersion from
+	 * SourceFilePath as it is now on disk. Trees whose source is gone count as
+	 * current, and so does every tree with nodes in shipping builds, which
+	 * cannot load the XML (assets imported before cooking existed included).
+	 * A source that was touched but not edited is read once, then remembered
+	 * as matching until its timestamp or size changes again.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	bool IsCookedFromCurrentSource() const;
+
+	/**
+	 * Fold constants, prune dead branches, collapse trivial composites and fuse
+	 * common patterns in RootNode, in place. Behavior is unchanged; removed
+	 * node ids are kept in the survivors' MergedNodeIds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	FBehaviacTreeOptimizerStats Optimize();
+
+	/**
+	 * Compiled form of the tree, shared by every agent running it. Compiled on
+	 * first use and again whenever RootNode changes.
+	 */
+	TSharedPtr<const FBehaviacCompiledTree> GetCompiledTree();
+
+	/** Drop the compiled form after editing nodes in place */
+	void InvalidateCompiledTree() { CompiledTree.Reset(); }
+
+	/**
+	 * Allocate state for NumAgents agents up front, so spawning a wave of
+	 * agents that run this tree takes slabs from the pool instead of the
+	 * general allocator.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	void ReserveAgentStates(int32 NumAgents);
+
+	/** Free the pooled state no agent is using */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	void TrimStatePool();
+
+	/** Occupancy and high-water marks of the agent state pool */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	FBehaviacTreePoolStats GetStatePoolStats();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 #if WITH_EDITORONLY_DATA
 	/** Description for editor display */
 	UPROPERTY(EditAnywhere, Category = "Behaviac|BehaviorTree")
 	FString Description;
 #endif
+
+private:
+	TSharedPtr<const FBehaviacCompiledTree> CompiledTree;
+
+	/** Stamp of the source last compared by content in IsCookedFromCurrentSource, and whether it matched */
+	mutable FDateTime CheckedSourceTimeStamp;
+	mutable int64 CheckedSourceFileSize = -1;
+	mutable bool bCheckedSourceMatches = false;
 };
 
+/** Blueprint completion of an asynchronous tree load: the tree, or nullptr if it could not be loaded */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FBehaviacOnTreeLoaded, UBehaviacBehaviorTree*, Tree);
+
 /**
  * UBehaviacBehaviorTreeLibrary: Static library for behavior tree operations.
  */
@@ -68,7 +323,29 @@ class BEHAVIACRUNTIME_API UBehaviacBehaviorTreeLibrary : public UBlueprintFuncti
 	GENERATED_BODY()
 
 public:
-	/** Load a behavior tree from an XML file path */
+	/**
+	 * Load a behavior tree from an XML file path. Loads of an unchanged file
+	 * share the tree parsed the first time (see FBehaviacTreeFileCache).
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
 	static UBehaviacBehaviorTree* LoadBehaviorTreeFromFile(UObject* WorldContext, const FString& FilePath);
+
+	/**
+	 * Load a behavior tree file in the background (see FBehaviacTreeAsyncLoader).
+	 * OnLoaded runs on the game thread, right away if the file is already cached.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	static void LoadBehaviorTreeFromFileAsync(const FString& FilePath, FBehaviacOnTreeLoaded OnLoaded);
+
+	/** Stream in a behavior tree asset; OnLoaded runs on the game thread */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	static void LoadBehaviorTreeAssetAsync(TSoftObjectPtr<UBehaviacBehaviorTree> TreeAsset, FBehaviacOnTreeLoaded OnLoaded);
+
+	/** Counters and memory of the trees shared between file loads */
+	UFUNCTION(BlueprintPure, Category = "Behaviac|BehaviorTree")
+	static FBehaviacTreeFileCacheStats GetTreeFileCacheStats();
+
+	/** Forget every shared tree; the next load of each file parses it again */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|BehaviorTree")
+	static void FlushTreeFileCache();
 };
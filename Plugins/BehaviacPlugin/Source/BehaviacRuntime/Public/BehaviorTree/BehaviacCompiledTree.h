@@ -0,0 +1,308 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviacBehaviorTask.h"
+
+class UBehaviacBehaviorNode;
+
+/** What a flat program does for an entry (see FBehaviacCompiledTree::IsFlat) */
+enum class EBehaviacFlatOp : uint8
+{
+	/** No flat form; a tree with such an entry runs its tasks */
+	None,
+	/** Entry 0, the tree task */
+	Tree,
+	Sequence,
+	Selector,
+	AlwaysSuccess,
+	AlwaysFailure,
+	Not,
+	Loop,
+	Action,
+	GuardedAction,
+	Condition,
+	Wait,
+	Succeed,
+	Fail,
+};
+
+/** One agent's state for one entry of a flat program */
+struct FBehaviacFlatNodeState
+{
+	/** Composites: entry of the running child (0 = first); Loop: iterations done; GuardedAction: guard passed */
+	int32 Counter = 0;
+
+	/** Slot hints of the entry's comparison */
+	int32 SlotHints[2] = { INDEX_NONE, INDEX_NONE };
+
+	/** Wait: deadline on the agent's clock, < 0 when not started */
+	double EndTime = -1.0;
+};
+
+/** One entry of a compiled tree */
+struct FBehaviacCompiledNode
+{
+	/** Node definition (kept alive by the tree asset) */
+	UBehaviacBehaviorNode* Node = nullptr;
+
+	/** Node class, the entry's kind tag */
+	const UClass* Kind = nullptr;
+
+	/** Operation of the entry in a flat program */
+	EBehaviacFlatOp Op = EBehaviacFlatOp::None;
+
+	/** Index of the parent entry, INDEX_NONE for the root */
+	int32 Parent = INDEX_NONE;
+
+	/** Children are the entries after this one, up to SubtreeEnd; NumChildren of them are direct */
+	int32 NumChildren = 0;
+	int32 SubtreeEnd = 0;
+
+	/** Depth below the tree task */
+	int32 Depth = 0;
+
+	/** Where this entry's task lives in an agent's state block */
+	FBehaviacTaskAllocator::FSlot State;
+
+	/** Placement of the direct children in a branch block, when built on entry (see FBehaviacTreeInstance) */
+	int32 FirstChildSlot = 0;
+	uint32 ChildBlockSize = 0;
+};
+
+/**
+ * Arena of task blocks, by size, shared by every agent instance of one
+ * compiled tree: the agents' state slabs and, for lazy instances, their branch
+ * blocks. Blocks handed back stay pooled for the next agent that needs the
+ * same size, so spawning and despawning agents in waves reuses memory instead
+ * of going back to the general allocator each time. Thread-safe: agents may
+ * tick in parallel.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTaskPool
+{
+public:
+	/** Occupancy of the pool, or of one block size */
+	struct FStats
+	{
+		int32 NumInUse = 0;
+		int32 NumPooled = 0;
+		int32 HighWater = 0;
+		uint32 BytesInUse = 0;
+		uint32 BytesPooled = 0;
+		uint32 HighWaterBytes = 0;
+	};
+
+	explicit FBehaviacTaskPool(uint32 InAlignment) : Alignment(InAlignment) {}
+	~FBehaviacTaskPool();
+
+	FBehaviacTaskPool(const FBehaviacTaskPool&) = delete;
+	FBehaviacTaskPool& operator=(const FBehaviacTaskPool&) = delete;
+
+	/** Take a block of Size bytes, pooled if one is free */
+	uint8* Allocate(uint32 Size);
+
+	/** Return a block taken with Allocate(Size) */
+	void Free(uint8* Block, uint32 Size);
+
+	/** Make sure Count blocks of Size bytes are in use or pooled, allocating the rest now */
+	void Reserve(uint32 Size, int32 Count);
+
+	/** Give the pooled blocks back to the general allocator */
+	void Trim();
+
+	/** Bytes handed out and not yet returned */
+	uint32 GetBytesInUse() const;
+
+	/** Bytes held in free lists */
+	uint32 GetBytesPooled() const;
+
+	/** Occupancy over all block sizes; HighWater is the peak of the total */
+	FStats GetStats() const;
+
+	/** Occupancy of blocks of Size bytes */
+	FStats GetStats(uint32 Size) const;
+
+private:
+	struct FSizeClass
+	{
+		TArray<uint8*> Free;
+		int32 NumInUse = 0;
+		int32 HighWater = 0;
+	};
+
+	mutable FCriticalSection Lock;
+	TMap<uint32, FSizeClass> SizeClasses;
+	uint32 Alignment;
+	int32 NumInUse = 0;
+	int32 HighWater = 0;
+	uint32 BytesInUse = 0;
+	uint32 BytesPooled = 0;
+	uint32 HighWaterBytes = 0;
+};
+
+/**
+ * Immutable, flattened form of a behavior tree, shared by every agent that
+ * runs it.
+ *
+ * Entries are in depth-first order, so a node's subtree is the contiguous
+ * range after it. Entry 0 is the tree task itself (its Node is the root
+ * node), entry 1 the root node's task. Operands are resolved once, here,
+ * and conditions that occur more than once are marked to share one result
+ * per agent tick (see FBehaviacPredicateCache).
+ * Each entry also has a fixed place in a per-agent state block: an agent
+ * builds all of its tasks inside one allocation of GetStateSize() bytes,
+ * laid out in the order the tree is walked, instead of one heap object per
+ * node. Instances that build branches on first entry use the per-entry child
+ * block layouts and the tree's task pool instead.
+ *
+ * A flat program has no task per node at all. Its state block holds the tree
+ * task, one interpreter task in place of the root node's, and an array of
+ * FBehaviacFlatNodeState, one per entry. Ticking walks the entries with a
+ * switch on each one's Op, reading that array, instead of calling into a task
+ * per node. Only trees whose every node has a flat op and no attachments
+ * compile flat.
+ */
+class BEHAVIACRUNTIME_API FBehaviacCompiledTree
+{
+public:
+	/**
+	 * Compile the tree under RootNode; nullptr if there is nothing to run.
+	 * With NativeFactory, the program runs that generated tree instead of
+	 * interpreting the nodes. Otherwise, with bFlat, a tree that has a flat
+	 * form compiles to a flat program.
+	 */
+	static TSharedPtr<const FBehaviacCompiledTree> Compile(UBehaviacBehaviorNode* RootNode, FBehaviacNativeTreeFactory NativeFactory = nullptr, bool bFlat = false);
+
+	UBehaviacBehaviorNode* GetRootNode() const { return RootNode; }
+	const TArray<FBehaviacCompiledNode>& GetNodes() const { return Nodes; }
+
+	/** Generated tree this program runs, or nullptr when it interprets the nodes */
+	FBehaviacNativeTreeFactory GetNativeFactory() const { return NativeFactory; }
+	bool IsNative() const { return NativeFactory != nullptr; }
+
+	/** Whether agents run this program by walking its entries rather than through a task per node */
+	bool IsFlat() const { return bFlat; }
+
+	/** Offset of the per-entry FBehaviacFlatNodeState array in a flat program's state block */
+	uint32 GetFlatStateOffset() const { return FlatStateOffset; }
+
+	/** Size and alignment of one agent's state block */
+	uint32 GetStateSize() const { return StateSize; }
+	uint32 GetStateAlignment() const { return StateAlignment; }
+
+	/** Index of the first entry running Node, or INDEX_NONE */
+	int32 FindNode(const UBehaviacBehaviorNode* Node) const;
+
+	/** Place layout of the state block, in task creation order */
+	const TArray<FBehaviacTaskAllocator::FSlot>& GetLayout() const { return Layout; }
+
+	/** Layout of the state block holding only the tree task and the root node's task */
+	TArrayView<const FBehaviacTaskAllocator::FSlot> GetRootLayout() const { return MakeArrayView(Layout).Left(2); }
+	uint32 GetRootStateSize() const { return RootStateSize; }
+
+	/** Layout of the branch block holding the direct children of entry Index */
+	TArrayView<const FBehaviacTaskAllocator::FSlot> GetChildLayout(int32 Index) const;
+
+	/** Size of an instance's state slab, with or without lazy branches */
+	uint32 GetSlabSize(bool bLazy) const { return bLazy ? RootStateSize : StateSize; }
+
+	/** Arena the state slabs and branch blocks of this tree's instances come from */
+	FBehaviacTaskPool& GetTaskPool() const { return *TaskPool; }
+
+	/** Distinct conditions that occur more than once in the tree, memoized per agent tick */
+	int32 GetNumSharedPredicates() const { return NumSharedPredicates; }
+
+private:
+	UBehaviacBehaviorNode* RootNode = nullptr;
+	FBehaviacNativeTreeFactory NativeFactory = nullptr;
+	bool bFlat = false;
+	uint32 FlatStateOffset = 0;
+	TArray<FBehaviacCompiledNode> Nodes;
+	TMap<const UBehaviacBehaviorNode*, int32> NodeIndices;
+	TArray<FBehaviacTaskAllocator::FSlot> Layout;
+	TArray<FBehaviacTaskAllocator::FSlot> ChildSlots;
+	uint32 StateSize = 0;
+	uint32 StateAlignment = 1;
+	uint32 RootStateSize = 0;
+	int32 NumSharedPredicates = 0;
+	TUniquePtr<FBehaviacTaskPool> TaskPool;
+};
+
+/**
+ * One agent's instance of a compiled tree: every task of the tree, built in a
+ * single state block at the offsets the program laid out. The block is a slab
+ * from the tree's task pool and goes back to it on Release.
+ *
+ * A lazy instance only builds the tree task and the root node's task up
+ * front. Every other task's children are built the first time it is entered,
+ * in a branch block from the tree's task pool, so branches an agent never
+ * takes cost it nothing. Branches idle long enough can be reclaimed: their
+ * tasks are destroyed and the blocks go back to the pool until the branch is
+ * entered again.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeInstance
+{
+public:
+	FBehaviacTreeInstance() = default;
+	~FBehaviacTreeInstance() { Release(); }
+
+	FBehaviacTreeInstance(const FBehaviacTreeInstance&) = delete;
+	FBehaviacTreeInstance& operator=(const FBehaviacTreeInstance&) = delete;
+
+	/**
+	 * Build the tasks of InProgram, all of them or (bLazy) only the top two.
+	 * Returns false if the node graph no longer matches the program; the
+	 * tasks are still built, partly on the heap.
+	 */
+	bool Create(const TSharedPtr<const FBehaviacCompiledTree>& InProgram, bool bLazy = false);
+
+	/** Destroy the tasks and return the state block to the pool */
+	void Release();
+
+	bool IsValid() const { return Root != nullptr; }
+	bool IsLazy() const { return bLazy; }
+	FBehaviacBehaviorTreeTask* GetRoot() const { return Root; }
+	const TSharedPtr<const FBehaviacCompiledTree>& GetProgram() const { return Program; }
+
+	/** Bytes of task state this instance holds in its block */
+	uint32 GetStateSize() const { return State ? StateSize : 0; }
+
+	/** Whether Task lives in this instance's state block */
+	bool OwnsStateOf(const FBehaviacBehaviorTask* Task) const;
+
+	/** Build the deferred child tasks of Task, which is being entered at Now (agent time) */
+	void BuildChildTasks(FBehaviacBehaviorTask* Task, double Now);
+
+	/**
+	 * Reclaim the branches whose owning task has not been seen running for
+	 * IdleSeconds of agent time by Now (checked at each call). Returns how
+	 * many were reclaimed; views of their tasks go stale.
+	 */
+	int32 ReclaimIdleBranches(double Now, double IdleSeconds);
+
+	/** Built branches and the bytes of their blocks */
+	int32 GetNumBranches() const { return Branches.Num(); }
+	uint32 GetBranchBytes() const;
+
+private:
+	/** Children of one task, built in their own block */
+	struct FBranch
+	{
+		uint8* Block = nullptr;
+		uint32 Size = 0;
+		/** Agent time the owning task was last seen running */
+		double LastActive = 0.0;
+	};
+
+	/** Destroy Task's children and return their blocks, and those of branches below */
+	void ReclaimBranch(FBehaviacBehaviorTask* Task);
+
+	TSharedPtr<const FBehaviacCompiledTree> Program;
+	uint8* State = nullptr;
+	uint32 StateSize = 0;
+	FBehaviacBehaviorTreeTask* Root = nullptr;
+	bool bLazy = false;
+	TMap<FBehaviacBehaviorTask*, FBranch> Branches;
+};
@@ -0,0 +1,117 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacOperand.h"
+
+class UBehaviacBehaviorNode;
+class UBehaviacBehaviorTree;
+
+/**
+ * Run trees through their generated C++ when it is compiled in and matches.
+ * Read when a tree is compiled, so it applies to trees loaded afterwards.
+ */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacNativeTrees;
+
+/**
+ * FBehaviacNativeTreeRegistry: generated trees compiled into the binary.
+ *
+ * Generated code registers itself under the tree's name together with a hash
+ * of the node graph it was generated from (see BEHAVIAC_REGISTER_NATIVE_TREE).
+ * A tree asset only runs the generated code while its own graph still hashes
+ * the same, so an edited tree falls back to the interpreter instead of running
+ * stale code. Thread-safe.
+ */
+class BEHAVIACRUNTIME_API FBehaviacNativeTreeRegistry
+{
+public:
+	static void Register(const FString& TreeName, uint32 TreeHash, FBehaviacNativeTreeFactory Factory);
+	static void Unregister(const FString& TreeName);
+
+	/** Factory generated from a graph hashing to TreeHash, or nullptr */
+	static FBehaviacNativeTreeFactory Find(const FString& TreeName, uint32 TreeHash);
+
+	/** Whether any code is registered under TreeName, matching or not */
+	static bool Contains(const FString& TreeName);
+
+	/** Factory Tree should run with, honoring CVarBehaviacNativeTrees and bUseNativeTree */
+	static FBehaviacNativeTreeFactory FindFor(const UBehaviacBehaviorTree* Tree);
+
+	/** Name generated code for Tree registers under: its TreeName, else the asset name */
+	static FString GetTreeName(const UBehaviacBehaviorTree* Tree);
+
+	/** Hash of the node graph under RootNode: node classes, edited properties and structure */
+	static uint32 HashTree(const UBehaviacBehaviorNode* RootNode);
+};
+
+/** Registers a generated tree during static initialization */
+struct BEHAVIACRUNTIME_API FBehaviacNativeTreeRegistrar
+{
+	FBehaviacNativeTreeRegistrar(const TCHAR* InTreeName, uint32 TreeHash, FBehaviacNativeTreeFactory Factory)
+		: TreeName(InTreeName)
+	{
+		FBehaviacNativeTreeRegistry::Register(TreeName, TreeHash, Factory);
+	}
+
+	~FBehaviacNativeTreeRegistrar()
+	{
+		FBehaviacNativeTreeRegistry::Unregister(TreeName);
+	}
+
+private:
+	const TCHAR* TreeName;
+};
+
+#define BEHAVIAC_REGISTER_NATIVE_TREE(TaskClass, TreeName, TreeHash) \
+	static FBehaviacNativeTreeRegistrar GBehaviacNativeTree_##TaskClass(TEXT(TreeName), TreeHash, \
+		[](FBehaviacTaskAllocator& Allocator) -> FBehaviacBehaviorTask* { return Allocator.New<TaskClass>(); });
+
+/**
+ * Base class for generated trees.
+ *
+ * A generated tree is one task that runs the whole tree with its control flow
+ * written out as C++: one member function per node, composite cursors and
+ * wait deadlines held in plain members, methods called by pre-resolved id and
+ * numeric conditions read straight from the blackboard. It stands in for the
+ * root node's task under the tree task, so loading, ticking, resetting and
+ * stopping go through the same agent API as interpreted trees.
+ *
+ * Generated node functions reset their own state whenever they finish, so a
+ * tree that completes starts over cleanly; ResetState() covers aborts.
+ */
+class BEHAVIACRUNTIME_API FBehaviacNativeTreeTask : public FBehaviacLeafTask
+{
+	using Super = FBehaviacLeafTask;
+
+public:
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+
+protected:
+	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+
+	/** Put every node back in its initial state */
+	virtual void ResetState() = 0;
+
+	/** Action: call MethodId and apply ResultOption, as FBehaviacActionTask does */
+	static EBehaviacStatus CallMethod(UBehaviacAgentComponent* Agent, int32 MethodId, EBehaviacStatus ResultOption);
+
+	/**
+	 * Numeric value of blackboard Key, if it is set to a number. Conditions
+	 * compare with it directly and only fall back to EvaluateCondition when
+	 * it is not.
+	 */
+	static bool ReadNumber(UBehaviacAgentComponent* Agent, FName Key, int32& SlotHint, double& OutValue);
+
+	/** Condition, evaluated with the interpreter's comparison rules */
+	static EBehaviacStatus EvaluateCondition(UBehaviacAgentComponent* Agent, const FBehaviacComparison& Comparison, int32* SlotHints);
+
+	/** Comparison resolved the way UBehaviacCondition resolves its operands */
+	static FBehaviacComparison MakeComparison(const TCHAR* Left, EBehaviacOperatorType Operator, const TCHAR* Right);
+
+	/** Wait: Running until Duration seconds after the first call; InOutEndTime < 0 means not started */
+	static EBehaviacStatus WaitFor(UBehaviacAgentComponent* Agent, double Duration, double& InOutEndTime);
+};
@@ -0,0 +1,102 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "BehaviacTypes.h"
+
+class UBehaviacBehaviorNode;
+class UBehaviacAttachment;
+
+/** Which of a node's attachment lists an attachment class goes in */
+enum class EBehaviacAttachmentKind : uint8
+{
+	Precondition,
+	Effector,
+	Event,
+};
+
+/**
+ * FBehaviacNodeRegistry: the node and attachment classes tree data can name.
+ *
+ * Maps the class="..." of a <node> or <attachment> element (and of compiled
+ * trees) to the UClass to instantiate, by FName, so each lookup is one name
+ * table probe and one hash lookup. Namespace prefixes ("behaviac::",
+ * "PluginBehaviac.Events.") are ignored.
+ *
+ * Node classes register themselves with BEHAVIAC_REGISTER_NODE and
+ * BEHAVIAC_REGISTER_ATTACHMENT in their .cpp. Those registrations take
+ * effect when their module has loaded, so a game module can add nodes of its
+ * own, or replace the plugin's, the same way. Classes can also be registered
+ * directly, e.g. from a module's StartupModule. Thread-safe.
+ */
+class BEHAVIACRUNTIME_API FBehaviacNodeRegistry : public FGCObject
+{
+public:
+	static FBehaviacNodeRegistry& Get();
+
+	/** Make ClassName in tree data create NodeClass, replacing any earlier registration */
+	void RegisterNode(FName ClassName, TSubclassOf<UBehaviacBehaviorNode> NodeClass);
+
+	/** Make ClassName in tree data create AttachmentClass, added to the node's Kind list */
+	void RegisterAttachment(FName ClassName, TSubclassOf<UBehaviacAttachment> AttachmentClass, EBehaviacAttachmentKind Kind);
+
+	/** Forget ClassName as a node and as an attachment */
+	void Unregister(FName ClassName);
+
+	/** Class registered for a node class name, or nullptr */
+	UClass* FindNodeClass(FStringView ClassName) const;
+
+	/** New node of the class registered for ClassName, or nullptr (with a warning) if there is none */
+	UBehaviacBehaviorNode* CreateNode(FStringView ClassName, UObject* Outer) const;
+
+	/**
+	 * Create the attachment ClassName names on Node, loaded from Properties.
+	 * Returns false if no attachment class matches.
+	 */
+	bool AddAttachment(UBehaviacBehaviorNode* Node, FStringView ClassName, const TArray<FBehaviacProperty>& Properties) const;
+
+	/** Apply the BEHAVIAC_REGISTER_* registrations of modules loaded since the last call */
+	void RegisterPending();
+
+	/** ClassName without its namespace prefix */
+	static FStringView GetShortName(FStringView ClassName);
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FBehaviacNodeRegistry"); }
+
+private:
+	struct FAttachmentEntry
+	{
+		TObjectPtr<UClass> Class;
+		EBehaviacAttachmentKind Kind = EBehaviacAttachmentKind::Precondition;
+	};
+
+	mutable FRWLock Lock;
+	TMap<FName, TObjectPtr<UClass>> Nodes;
+	TMap<FName, FAttachmentEntry> Attachments;
+};
+
+/** A registration made by BEHAVIAC_REGISTER_NODE or BEHAVIAC_REGISTER_ATTACHMENT, queued until its module has loaded */
+struct BEHAVIACRUNTIME_API FBehaviacNodeRegistrar
+{
+	FBehaviacNodeRegistrar(const TCHAR* InClassName, UClass* (*InGetClass)());
+	FBehaviacNodeRegistrar(const TCHAR* InClassName, UClass* (*InGetClass)(), EBehaviacAttachmentKind InKind);
+
+	const TCHAR* ClassName;
+	UClass* (*GetClass)();
+	EBehaviacAttachmentKind Kind = EBehaviacAttachmentKind::Precondition;
+	bool bAttachment = false;
+	FBehaviacNodeRegistrar* Next = nullptr;
+};
+
+/** Register NodeClass for <node class="Name"> (at file scope in a .cpp) */
+#define BEHAVIAC_REGISTER_NODE(Name, NodeClass) \
+	static FBehaviacNodeRegistrar PREPROCESSOR_JOIN(BehaviacNodeRegistrar_, __LINE__)(TEXT(#Name), &NodeClass::StaticClass)
+
+/** Register AttachmentClass for <attachment class="Name">, going in the node's Kind list */
+#define BEHAVIAC_REGISTER_ATTACHMENT(Name, AttachmentClass, Kind) \
+	static FBehaviacNodeRegistrar PREPROCESSOR_JOIN(BehaviacNodeRegistrar_, __LINE__)(TEXT(#Name), &AttachmentClass::StaticClass, EBehaviacAttachmentKind::Kind)
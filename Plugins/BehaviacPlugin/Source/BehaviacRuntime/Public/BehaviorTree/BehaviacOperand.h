@@ -0,0 +1,244 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviacTypes.h"
+#include "BehaviacBlackboard.h"
+#include "BehaviacMethods.h"
+#include "HAL/IConsoleManager.h"
+
+class UBehaviacAgentComponent;
+
+/** Behaviac.PredicateCache: memoize conditions that occur more than once in a tree, per agent tick */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacPredicateCache;
+
+/** How operand text from tree data is interpreted when it is resolved. */
+enum class EBehaviacOperandMode : uint8
+{
+	/** "Self.X" reads property X; any other text is a constant */
+	PropertyOrConstant,
+	/** Like PropertyOrConstant, but an unset property falls back to calling method X */
+	PropertyOrMethod,
+	/** The text always names a property, with or without "Self." */
+	Property,
+};
+
+/**
+ * FBehaviacObservedKeys: the blackboard keys a guard condition reads.
+ *
+ * Gathered once at load time (UBehaviacBehaviorNode::GatherObservedKeys) so an
+ * observer can skip re-evaluating the guard while none of the keys changed.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacObservedKeys
+{
+	/** Keys whose values the guard compares */
+	TArray<FName> Keys;
+
+	/** Of Keys, those read by "Self.X" operands that call method X while X is unset */
+	TArray<FName> MethodFallbackKeys;
+
+	/**
+	 * Whether the guard could evaluate differently than when the blackboard was
+	 * at Serial: one of its keys changed since, or a fallback method would run.
+	 * Caller holds the agent's blackboard lock.
+	 */
+	bool HaveChangedSince(const FBehaviacBlackboard& Blackboard, uint64 Serial) const;
+};
+
+/**
+ * FBehaviacOperand: one operand resolved at load time.
+ *
+ * Holds either a typed constant or an interned blackboard key (plus the method
+ * to call when PropertyOrMethod finds the key unset). Nothing is parsed per tick.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacOperand
+{
+	enum class EKind : uint8
+	{
+		Constant,
+		Property,
+		PropertyOrMethod,
+	};
+
+	FBehaviacOperand()
+		: Kind(EKind::Constant)
+	{
+	}
+
+	/** Resolve operand text. "true"/"false" become bool constants, other literals keep their text. */
+	static FBehaviacOperand Resolve(const FString& Text, EBehaviacOperandMode Mode);
+
+	bool IsConstant() const { return Kind == EKind::Constant; }
+
+	/**
+	 * Value for this operand, or nullptr when it names an unset property.
+	 * Caller holds the agent's blackboard lock. SlotHint caches the agent's slot.
+	 */
+	const FBehaviacValue* Find(const FBehaviacBlackboard& Blackboard, int32& SlotHint) const
+	{
+		return Kind == EKind::Constant ? &Constant : Blackboard.FindWithHint(Key, SlotHint);
+	}
+
+	/**
+	 * For PropertyOrMethod operands whose property is unset (or empty): call the
+	 * method and return its result as a bool value. Must be called without the lock.
+	 */
+	FBehaviacValue CallFallbackMethod(UBehaviacAgentComponent* Agent) const;
+
+	/** Add the blackboard key this operand reads, if any */
+	void GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const;
+
+	EKind Kind;
+
+	/** Blackboard key (Self. stripped) for Property / PropertyOrMethod */
+	FName Key;
+
+	/** Method called by PropertyOrMethod when the property is unset */
+	int32 MethodId = BEHAVIAC_INVALID_METHOD_ID;
+
+	/** Value for Constant operands */
+	FBehaviacValue Constant;
+};
+
+/** Comparison kernel selected once per resolved comparison. */
+typedef bool (*FBehaviacCompareKernel)(const FBehaviacValue& Left, const FBehaviacValue& Right);
+
+/** Arithmetic kernel selected once per resolved Compute node. */
+typedef double (*FBehaviacArithmeticKernel)(double Left, double Right);
+
+/**
+ * FBehaviacComparison: "Left <op> Right" with both operands and the kernel resolved.
+ *
+ * Numeric values compare as doubles (Equal uses IsNearlyEqual), everything else
+ * compares by its string form — the same rules the string-based evaluators used,
+ * without the per-tick lookups, parsing and copies. String forms compare
+ * case-sensitively unless resolved with ESearchCase::IgnoreCase, which FSM
+ * transitions use to keep FString equality.
+ */
+struct BEHAVIACRUNTIME_API FBehaviacComparison
+{
+	FBehaviacComparison()
+		: Operator(EBehaviacOperatorType::Equal)
+		, Kernel(nullptr)
+	{
+	}
+
+	void Resolve(const FString& LeftText, EBehaviacOperandMode LeftMode,
+		const FString& RightText, EBehaviacOperandMode RightMode,
+		EBehaviacOperatorType InOperator,
+		ESearchCase::Type InStringCase = ESearchCase::CaseSensitive);
+
+	bool IsResolved() const { return Kernel != nullptr; }
+	void Invalidate() { Kernel = nullptr; }
+
+	/**
+	 * Evaluate against an agent. SlotHints (two entries, optional) cache the
+	 * agent's blackboard slots for the left and right operands.
+	 */
+	bool Evaluate(UBehaviacAgentComponent* Agent, int32* SlotHints = nullptr) const;
+
+	static FBehaviacCompareKernel SelectKernel(EBehaviacOperatorType Operator, ESearchCase::Type StringCase = ESearchCase::CaseSensitive);
+
+	/**
+	 * Share results through the agent's FBehaviacPredicateCache. The tree
+	 * compiler turns this on for predicates that occur more than once in a
+	 * tree; resolving the operands again turns it off.
+	 */
+	void SetMemoized(bool bInMemoize);
+	bool IsMemoized() const { return bMemoize; }
+
+	FBehaviacOperand Left;
+	FBehaviacOperand Right;
+	EBehaviacOperatorType Operator;
+	FBehaviacCompareKernel Kernel;
+
+	/** How string forms compare */
+	ESearchCase::Type StringCase = ESearchCase::CaseSensitive;
+
+	/** FBehaviacPredicateRegistry id of "Left <op> Right", INDEX_NONE until resolved */
+	int32 PredicateId = INDEX_NONE;
+
+private:
+	bool bMemoize = false;
+
+	/** Keys whose writes invalidate a memoized result */
+	FBehaviacObservedKeys MemoKeys;
+};
+
+/**
+ * FBehaviacPredicateRegistry: process-wide table of resolved comparisons.
+ *
+ * Comparisons with the same operands and operator get the same small, stable
+ * id wherever they occur, so an agent can keep one memoized result per
+ * predicate in a flat array indexed by id. Property keys compare
+ * case-insensitively and constants case-sensitively; comparisons whose
+ * kernels ignore case get ids of their own.
+ * Thread-safe; ids are never recycled.
+ */
+class BEHAVIACRUNTIME_API FBehaviacPredicateRegistry
+{
+public:
+	/** Id for a resolved comparison, registering it if needed */
+	static int32 FindOrAdd(const FBehaviacComparison& Comparison);
+
+	/** Number of ids handed out so far */
+	static int32 Num();
+};
+
+/**
+ * FBehaviacPredicateCache: one agent's memoized predicate results.
+ *
+ * A result stays valid for the rest of the agent's tick, until a blackboard
+ * key the predicate reads is written. Results that came from a fallback
+ * method are never kept. Accessed under the agent's blackboard lock.
+ */
+class BEHAVIACRUNTIME_API FBehaviacPredicateCache
+{
+public:
+	/** Start a new tick: every result memoized so far goes stale */
+	void BeginTick()
+	{
+		// Epoch 0 marks entries never stored
+		if (++Epoch == 0)
+		{
+			Epoch = 1;
+		}
+	}
+
+	/**
+	 * Result of predicate Id memoized this tick, unless Keys changed since.
+	 * Caller holds the agent's blackboard lock.
+	 */
+	bool Find(int32 Id, const FBehaviacObservedKeys& Keys, const FBehaviacBlackboard& Blackboard, bool& bOutResult);
+
+	/** Memoize a result read while the blackboard was at Serial. Caller holds the lock. */
+	void Store(int32 Id, uint64 Serial, bool bResult);
+
+	/** Lookups answered from the cache */
+	int64 GetHits() const { return Hits; }
+
+	/** Lookups with nothing memoized this tick */
+	int64 GetMisses() const { return Misses; }
+
+	/** Lookups whose result was dropped because a key it reads was written */
+	int64 GetInvalidations() const { return Invalidations; }
+
+private:
+	struct FEntry
+	{
+		uint32 Epoch = 0;
+		bool bResult = false;
+		uint64 Serial = 0;
+	};
+
+	TArray<FEntry> Entries;
+	uint32 Epoch = 1;
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Invalidations = 0;
+};
+
+/** Arithmetic kernel for Add/Subtract/Multiply/Divide (division by zero yields 0). */
+BEHAVIACRUNTIME_API FBehaviacArithmeticKernel BehaviacSelectArithmeticKernel(EBehaviacOperatorType Operator);
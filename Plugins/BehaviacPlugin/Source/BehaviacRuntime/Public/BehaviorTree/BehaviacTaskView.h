@@ -0,0 +1,55 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "BehaviacTypes.h"
+#include "BehaviacTaskView.generated.h"
+
+class FBehaviacBehaviorTask;
+class UBehaviacBehaviorNode;
+class UBehaviacAgentComponent;
+
+/**
+ * Blueprint handle on one task of an agent's running tree.
+ *
+ * Tasks are plain C++ objects, so Blueprints cannot hold them directly. Views
+ * are only made when asked for (UBehaviacAgentComponent::InspectBehaviorTree,
+ * GetChildren) and go stale once the agent loads another tree or stops; a
+ * stale view reports Invalid and no node.
+ */
+UCLASS(BlueprintType)
+class BEHAVIACRUNTIME_API UBehaviacTaskView : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Make a view of Task, which must belong to Agent's current tree */
+	static UBehaviacTaskView* Create(UBehaviacAgentComponent* Agent, const FBehaviacBehaviorTask* Task);
+
+	/** Whether the viewed task still exists */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Behaviac|Task")
+	bool IsTaskAlive() const { return GetTask() != nullptr; }
+
+	/** Get the current status */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Task")
+	EBehaviacStatus GetStatus() const;
+
+	/** Get the node definition the task is running */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Task")
+	UBehaviacBehaviorNode* GetNode() const;
+
+	/** Views of the task's direct children */
+	UFUNCTION(BlueprintCallable, Category = "Behaviac|Task")
+	TArray<UBehaviacTaskView*> GetChildren() const;
+
+	/** The viewed task, or nullptr once the view is stale */
+	const FBehaviacBehaviorTask* GetTask() const;
+
+private:
+	TWeakObjectPtr<UBehaviacAgentComponent> Agent;
+	const FBehaviacBehaviorTask* Task = nullptr;
+	uint32 TreeSerial = 0;
+};
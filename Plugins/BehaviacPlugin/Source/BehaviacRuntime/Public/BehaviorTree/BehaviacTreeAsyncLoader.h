@@ -0,0 +1,55 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+class UBehaviacBehaviorTree;
+
+/** Completion of an asynchronous tree load: the tree, or nullptr if it could not be loaded */
+DECLARE_DELEGATE_OneParam(FBehaviacTreeLoadedDelegate, UBehaviacBehaviorTree*);
+
+/**
+ * FBehaviacTreeAsyncLoader: loads behavior trees without blocking the game
+ * thread.
+ *
+ * Tree files are read, and XML compiled to the binary form (see
+ * FBehaviacTreeBinary), on a worker; only building the nodes from the
+ * compiled data happens on the game thread, and the result joins
+ * FBehaviacTreeFileCache like a synchronous load. Assets stream in through
+ * a streamable manager. Registry paths resolve as FBehaviacTreeRegistry::Load
+ * does, asset first, and are registered when they arrive.
+ *
+ * Requests for a tree that is already loading share the one load. Callbacks
+ * always run on the game thread, immediately when the tree is already
+ * loaded. Requests must be made from the game thread.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeAsyncLoader
+{
+public:
+	static FBehaviacTreeAsyncLoader& Get();
+
+	/** Load the tree file at FilePath (XML, or its compiled sibling when up to date) */
+	void LoadFile(const FString& FilePath, FBehaviacTreeLoadedDelegate OnLoaded);
+
+	/** Stream in the tree asset at AssetPath */
+	void LoadAsset(const FSoftObjectPath& AssetPath, FBehaviacTreeLoadedDelegate OnLoaded);
+
+	/** Load the tree a registry path names (see FBehaviacTreeRegistry) */
+	void LoadPath(const FString& Path, FBehaviacTreeLoadedDelegate OnLoaded);
+
+	/** Loads started and not yet delivered */
+	int32 NumInFlight() const { return Pending.Num(); }
+
+private:
+	/** Queue OnLoaded under Key; true if it is the first request, which must start the load */
+	bool Enqueue(const FString& Key, FBehaviacTreeLoadedDelegate&& OnLoaded);
+
+	/** Deliver Tree to every request queued under Key */
+	void Complete(const FString& Key, UBehaviacBehaviorTree* Tree);
+
+	TMap<FString, TArray<FBehaviacTreeLoadedDelegate>> Pending;
+	FStreamableManager Streamable;
+};
@@ -0,0 +1,188 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/MappedFileHandle.h"
+#include "BehaviacTypes.h"
+
+class UBehaviacBehaviorTree;
+
+/** Behaviac.PreferBinaryTrees: load the compiled .bhvb next to a tree's XML when it is up to date */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacPreferBinaryTrees;
+
+/**
+ * FBehaviacTreeBinary: compiled tree files (EBehaviacFileFormat::BSON, ".bhvb").
+ *
+ * The compiled form is the tree XML with the text taken out: a header, a
+ * table of interned strings, and tables of nodes (in pre-order), attachments
+ * and properties that refer to them by index. Loading it builds the same
+ * nodes LoadFromXML does, from the same properties, without tokenizing,
+ * unescaping or allocating a string per attribute.
+ *
+ * Layout, little endian, every section 4-byte aligned:
+ *   FHeader
+ *   FStringRecord[NumStrings]      offset and length into the string bytes
+ *   FNodeRecord[NumNodes]          pre-order; a node's subtree follows it
+ *   FAttachmentRecord[NumAttachments]
+ *   FPropertyRecord[NumProperties]
+ *   string bytes                   UTF-8, not terminated, padded to 4
+ *
+ * The header carries a format version and a CRC32 of everything after it;
+ * files from another version or that fail the check are rejected, never
+ * half loaded.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeBinary
+{
+public:
+	/** "BHVB" */
+	static constexpr uint32 Magic = 0x42564842;
+
+	/** Bump whenever the layout below changes */
+	static constexpr uint16 FormatVersion = 1;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 FormatVersion;
+		uint16 HeaderSize;
+		/** CRC32 of the PayloadSize bytes after the header */
+		uint32 Checksum;
+		uint32 PayloadSize;
+		/** version attribute of the <behavior> element */
+		int32 TreeVersion;
+		/** String index of the agenttype attribute */
+		int32 AgentType;
+		int32 NumStrings;
+		int32 NumNodes;
+		int32 NumAttachments;
+		int32 NumProperties;
+		uint32 NumStringBytes;
+	};
+
+	struct FStringRecord
+	{
+		uint32 Offset;
+		uint32 Length;
+	};
+
+	struct FNodeRecord
+	{
+		/** String index of the class name, namespace stripped */
+		int32 ClassName;
+		/** Nodes in this node's subtree, itself included */
+		int32 SubtreeSize;
+		int32 FirstProperty;
+		int32 NumProperties;
+		int32 FirstAttachment;
+		int32 NumAttachments;
+	};
+
+	struct FAttachmentRecord
+	{
+		/** String index of the class attribute, as written */
+		int32 ClassName;
+		int32 FirstProperty;
+		int32 NumProperties;
+	};
+
+	struct FPropertyRecord
+	{
+		int32 Name;
+		int32 Value;
+	};
+
+	/** Compile tree XML. Returns false, with the reason in OutError, when it does not parse or has no root node. */
+	static bool CompileXML(FStringView XMLContent, TArray<uint8>& OutData, FString& OutError);
+
+	/**
+	 * Compile the XML file at XmlPath to BinaryPath (by default its .bhvb
+	 * sibling). An up to date file is left alone.
+	 */
+	static bool CompileFile(const FString& XmlPath, const FString& BinaryPath = FString());
+
+	/** XmlPath with its extension replaced by .bhvb */
+	static FString GetBinaryPath(const FString& XmlPath);
+
+	/** Format of a tree file, by extension */
+	static EBehaviacFileFormat GetFileFormat(const FString& FilePath);
+
+	/**
+	 * File to load the tree at FilePath from: its compiled sibling when that
+	 * is at least as new as the XML, else FilePath. Shipping builds always
+	 * pick the compiled file and never parse XML.
+	 */
+	static FString ChooseFile(const FString& FilePath);
+
+	/** Checksum in Data's header, or 0 if Data is too short to have one */
+	static uint32 GetChecksum(TConstArrayView<uint8> Data);
+
+	/** Build a new tree of its own (not cached) from compiled Data, read from FilePath */
+	static UBehaviacBehaviorTree* LoadTree(const FString& FilePath, TConstArrayView<uint8> Data);
+
+	/** Map the compiled file at FilePath and build a new tree from it; nullptr on failure */
+	static UBehaviacBehaviorTree* LoadFile(const FString& FilePath);
+};
+
+/**
+ * FBehaviacTreeBinaryView: checked access to compiled tree data.
+ *
+ * Initialize() validates the header, the checksum and every index and range
+ * in the tables once; the accessors then trust them. The data is read in
+ * place and must outlive the view.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeBinaryView
+{
+public:
+	using FHeader = FBehaviacTreeBinary::FHeader;
+	using FNodeRecord = FBehaviacTreeBinary::FNodeRecord;
+	using FAttachmentRecord = FBehaviacTreeBinary::FAttachmentRecord;
+	using FPropertyRecord = FBehaviacTreeBinary::FPropertyRecord;
+
+	/** False, with the reason in OutError, if Data is not a valid compiled tree of this format version */
+	bool Initialize(TConstArrayView<uint8> Data, FString& OutError);
+
+	const FHeader& GetHeader() const { return *Header; }
+
+	/** String at Index; empty for INDEX_NONE */
+	FString GetString(int32 Index) const;
+
+	TConstArrayView<FNodeRecord> GetNodes() const { return Nodes; }
+	TConstArrayView<FAttachmentRecord> GetAttachments() const { return Attachments; }
+	TConstArrayView<FPropertyRecord> GetProperties() const { return Properties; }
+
+	/** Append the properties [First, First + Num) to OutProperties */
+	void GetProperties(int32 First, int32 Num, TArray<FBehaviacProperty>& OutProperties) const;
+
+private:
+	bool IsString(int32 Index, bool bAllowNone) const;
+
+	const FHeader* Header = nullptr;
+	TConstArrayView<FBehaviacTreeBinary::FStringRecord> Strings;
+	TConstArrayView<FNodeRecord> Nodes;
+	TConstArrayView<FAttachmentRecord> Attachments;
+	TConstArrayView<FPropertyRecord> Properties;
+	const uint8* StringBytes = nullptr;
+};
+
+/**
+ * FBehaviacMappedTreeFile: a compiled tree file mapped into memory, read into
+ * memory instead on platforms that cannot map files.
+ */
+class BEHAVIACRUNTIME_API FBehaviacMappedTreeFile
+{
+public:
+	bool Open(const FString& FilePath);
+
+	TConstArrayView<uint8> GetData() const;
+
+	bool IsMapped() const { return Region.IsValid(); }
+
+private:
+	// Declared in this order so the region is unmapped before its file closes
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+	TArray<uint8> Buffer;
+};
@@ -0,0 +1,89 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/GCObject.h"
+
+class UBehaviacBehaviorTree;
+struct FBehaviacTreeFileCacheStats;
+struct FFileStatData;
+
+/** Behaviac.TreeFileCache: share trees loaded from the same unchanged XML file */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacTreeFileCache;
+
+/**
+ * FBehaviacTreeFileCache: trees parsed from XML or compiled (.bhvb) files, by
+ * full file path.
+ *
+ * UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile goes through here, so
+ * every caller loading the same file gets the one tree parsed from it. Each
+ * lookup checks the file's timestamp and size; when either changed the file is
+ * read again, and parsed again only if its contents differ, so edits to the
+ * XML are picked up without a reimport. Compiled files are mapped rather than
+ * read and compared by the checksum in their header. Cached trees must be
+ * treated as read only. Game thread only.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeFileCache : public FGCObject
+{
+public:
+	static FBehaviacTreeFileCache& Get();
+
+	/** Canonical key for a file path: full, forward slashes */
+	static FString NormalizePath(const FString& FilePath);
+
+	/** Tree parsed from FilePath, parsing it if it is not cached or has changed; nullptr on failure */
+	UBehaviacBehaviorTree* Load(const FString& FilePath);
+
+	/** Tree cached for FilePath if the file has not changed since; never reads the file */
+	UBehaviacBehaviorTree* Find(const FString& FilePath) const;
+
+	/**
+	 * Cache Tree as parsed from FilePath, whose stat data and content hash
+	 * (CRC32 of the XML, or the compiled file's checksum) it was read with.
+	 * For loads that read and parse the file elsewhere, such as on a worker.
+	 */
+	void Add(const FString& FilePath, UBehaviacBehaviorTree* Tree, const FFileStatData& Stat, uint32 ContentHash);
+
+	/** Drop the tree cached for FilePath; the next load parses the file again */
+	bool Invalidate(const FString& FilePath);
+
+	/** Drop every tree parsed from a file named BaseName (any directory, no extension). Returns how many. */
+	int32 InvalidateByName(const FString& BaseName);
+
+	/** Drop every cached tree */
+	void InvalidateAll();
+
+	/** Trees cached */
+	int32 Num() const { return Entries.Num(); }
+
+	/** Counters and approximate memory of the cached trees */
+	FBehaviacTreeFileCacheStats GetStats() const;
+
+	/** Parse Content, read from FilePath, into a new tree of its own (not cached) */
+	static UBehaviacBehaviorTree* Parse(const FString& FilePath, const FString& Content);
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FBehaviacTreeFileCache"); }
+
+private:
+	struct FEntry
+	{
+		TObjectPtr<UBehaviacBehaviorTree> Tree;
+		FDateTime TimeStamp;
+		int64 FileSize = 0;
+		uint32 ContentHash = 0;
+		int64 Bytes = 0;
+	};
+
+	/** Approximate memory of a tree: the tree, its nodes and attachments */
+	static int64 MeasureTree(const UBehaviacBehaviorTree* Tree);
+
+	TMap<FString, FEntry> Entries;
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Reloads = 0;
+};
@@ -0,0 +1,48 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "BehaviorTree/BehaviacBehaviorTree.h"
+
+class UBehaviacBehaviorNode;
+
+/** Behaviac.OptimizeTrees: run FBehaviacTreeOptimizer on trees loaded from XML */
+BEHAVIACRUNTIME_API extern TAutoConsoleVariable<int32> CVarBehaviacOptimizeTrees;
+
+/**
+ * FBehaviacTreeOptimizer: rewrites a node tree into a cheaper one that behaves
+ * the same, so the structure authoring tools leave behind costs nothing per tick.
+ *
+ *  - Constant folding: Conditions comparing two constants, and Not /
+ *    AlwaysSuccess / AlwaysFailure over True, False or Noop, become True/False.
+ *  - Dead branches: children of a Sequence after a False (of a Selector after
+ *    a True or Noop) never run and are removed, as are the Trues and Noops a
+ *    Sequence steps over and the Falses a Selector steps over. IfElse over a
+ *    constant condition becomes the branch it always takes.
+ *  - Collapsing: Sequences and Selectors with one child, a Sequence directly
+ *    in a Sequence (Selector in a Selector), Loop with Count=1, and
+ *    AlwaysSuccess / AlwaysFailure directly over another of those decorators
+ *    or Not.
+ *  - Fusion: Condition followed by Action in a Sequence becomes one
+ *    UBehaviacGuardedAction; AlwaysSuccess / AlwaysFailure over an Action
+ *    becomes the Action with that ResultOption.
+ *
+ * Nodes with attachments are never removed or merged, since their
+ * preconditions, effectors and events observe that node's own enter and exit.
+ * The ids of removed nodes are kept in the surviving node's MergedNodeIds.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeOptimizer
+{
+public:
+	/**
+	 * Optimize the tree under Root in place. New nodes are created in Outer.
+	 * Returns the new root, which is Root unless Root itself was replaced.
+	 */
+	static UBehaviacBehaviorNode* Optimize(UBehaviacBehaviorNode* Root, UObject* Outer, FBehaviacTreeOptimizerStats& OutStats);
+
+	/** Nodes in the tree under Root, Root included */
+	static int32 CountNodes(const UBehaviacBehaviorNode* Root);
+};
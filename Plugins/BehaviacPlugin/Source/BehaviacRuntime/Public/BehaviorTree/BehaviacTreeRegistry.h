@@ -0,0 +1,157 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+
+class UBehaviacBehaviorTree;
+class UBehaviacBehaviorNode;
+class UBehaviacAgentComponent;
+
+/**
+ * FBehaviacTreeRegistry: process-wide table of behavior trees by path.
+ *
+ * Each path is loaded once and the tree kept alive here, so every
+ * ReferencedBehavior node and HTN task naming it, in every tree, runs the one
+ * compiled form the tree asset shares between agents. Paths are the relative
+ * names tree data uses ("Combat/Attack", with or without ".xml"); they
+ * resolve to, in order, a tree registered under that path, the asset under
+ * /Game/BehaviacData, and the XML file (or its compiled .bhvb) under
+ * Content/BehaviacData. Absolute file paths load as they are.
+ *
+ * A path loaded from a file stays current only while the file is unchanged:
+ * on the game thread, lookups check it with FBehaviacTreeFileCache and the
+ * next load parses the edited file again.
+ *
+ * The registry also records which tree runs which as a subtree, and refuses
+ * a link that would close a cycle. Loading is game thread only; the locked
+ * lookups are safe from any thread.
+ */
+class BEHAVIACRUNTIME_API FBehaviacTreeRegistry : public FGCObject
+{
+public:
+	static FBehaviacTreeRegistry& Get();
+
+	/** Canonical form of a tree path: forward slashes, no leading slash, no ".xml" or ".bhvb" */
+	static FString NormalizePath(const FString& Path);
+
+	/** Object path of the asset a normalized relative path names, under /Game/BehaviacData; empty for absolute paths */
+	static FString GetAssetPath(const FString& Key);
+
+	/** XML file a normalized path names, under Content/BehaviacData for relative paths */
+	static FString GetFilePath(const FString& Key);
+
+	/** Tree for Path, loading it on first request; nullptr if nothing is found. Game thread. */
+	UBehaviacBehaviorTree* Load(const FString& Path);
+
+	/**
+	 * Tree already loaded or registered for Path, or nullptr. On the game
+	 * thread, nullptr too when Path was loaded from a file changed since.
+	 */
+	UBehaviacBehaviorTree* Find(const FString& Path) const;
+
+	/**
+	 * Make Path resolve to Tree (trees built in code, or loaded by other means).
+	 * FilePath is the file Tree was parsed from, if any, so edits to it are noticed.
+	 */
+	void Register(const FString& Path, UBehaviacBehaviorTree* Tree, const FString& FilePath = FString());
+
+	/** Forget Path and the subtree links of the tree it resolved to */
+	void Unregister(const FString& Path);
+
+	/** Whether Tree is registered under any path */
+	bool Contains(const UBehaviacBehaviorTree* Tree) const;
+
+	/** Changes with every registration and unregistration, so links can tell they may resolve differently */
+	uint32 GetGeneration() const;
+
+	/**
+	 * Record that From runs To as a subtree. Returns false, recording nothing,
+	 * when To already runs From (directly or through other subtrees) or is From.
+	 */
+	bool AddLink(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To);
+
+	/** Whether From runs To, directly or through other subtrees */
+	bool IsLinked(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To) const;
+
+	/** Trees currently registered */
+	int32 Num() const;
+
+	/** Lock guarding the registry and every FBehaviacSubtreeLink */
+	FCriticalSection& GetLock() const { return Lock; }
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FBehaviacTreeRegistry"); }
+
+private:
+	struct FEntry
+	{
+		TObjectPtr<UBehaviacBehaviorTree> Tree;
+
+		/** File the tree was parsed from; empty for assets and trees built in code */
+		FString FilePath;
+	};
+
+	bool IsLinkedLocked(const UBehaviacBehaviorTree* From, const UBehaviacBehaviorTree* To) const;
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FEntry> Trees;
+	uint32 Generation = 0;
+	TMultiMap<const UBehaviacBehaviorTree*, const UBehaviacBehaviorTree*> Links;
+};
+
+/**
+ * A node's link to the tree it references, made through FBehaviacTreeRegistry
+ * the first time an agent enters the node. Once the registry changes, a link
+ * that failed is tried again and a link to a tree no longer registered is
+ * made anew. Guarded by the registry's lock.
+ */
+class BEHAVIACRUNTIME_API FBehaviacSubtreeLink
+{
+public:
+	/**
+	 * Compiled referenced tree, linking on the first call. nullptr when the
+	 * path cannot be loaded or the link would close a cycle. Off the game
+	 * thread an unlinked reference cannot load: bOutPending is set and the
+	 * caller retries once the game thread has linked it.
+	 */
+	TSharedPtr<const FBehaviacCompiledTree> Resolve(const UBehaviacBehaviorNode* Owner, const FString& Path, bool& bOutPending);
+
+	/** Forget the link (after the path changed) */
+	void Reset();
+
+	/** Tree linked to, or nullptr */
+	UBehaviacBehaviorTree* GetTree() const;
+
+	/** Whether the tree's agents build subtree branches on first entry */
+	bool IsLazy() const;
+
+private:
+	enum class EState : uint8
+	{
+		Unlinked,
+		Linked,
+		Failed,
+	};
+
+	/** Forget the link; registry lock held */
+	void ResetLocked();
+
+	EState State = EState::Unlinked;
+	uint32 Generation = 0;
+	TWeakObjectPtr<UBehaviacBehaviorTree> Tree;
+	TSharedPtr<const FBehaviacCompiledTree> Program;
+	bool bLazy = false;
+};
+
+/**
+ * Tick the subtree a task runs through Link, building the agent's Instance of
+ * it on first use. Off the game thread, an unlinked subtree is linked after
+ * the parallel phase and the task keeps running until then.
+ */
+BEHAVIACRUNTIME_API EBehaviacStatus BehaviacTickSubtree(UBehaviacAgentComponent* Agent, const UBehaviacBehaviorNode* Owner,
+	FBehaviacSubtreeLink& Link, const FString& Path, FBehaviacTreeInstance& Instance);
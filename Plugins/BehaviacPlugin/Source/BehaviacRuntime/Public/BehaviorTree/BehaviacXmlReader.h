@@ -0,0 +1,90 @@
+// Behaviac UE5 Plugin
+// Licensed under the BSD 3-Clause License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What FBehaviacXmlReader::Next stopped at */
+enum class EBehaviacXmlToken : uint8
+{
+	StartElement,
+	EndElement,
+	EndOfDocument,
+	Error,
+};
+
+/**
+ * FBehaviacXmlReader: single-pass pull reader for the XML behaviac trees are
+ * written in.
+ *
+ * Reads the text in place and hands out views into it; nothing is copied
+ * until an attribute is asked for as an FString. Next() steps from tag to tag,
+ * skipping the prolog, comments, processing instructions, DOCTYPE, CDATA and
+ * text between tags, so files on one line and files with comments read the
+ * same. A self-closing tag produces a StartElement followed by an EndElement.
+ * The text must outlive the reader.
+ *
+ * Errors (unterminated tags, mismatched end tags, a missing or second root,
+ * malformed character references) stop the reader; GetErrorMessage() reports
+ * them with their line and column.
+ */
+class BEHAVIACRUNTIME_API FBehaviacXmlReader
+{
+public:
+	explicit FBehaviacXmlReader(FStringView InText);
+
+	/** Advance to the next start or end tag */
+	EBehaviacXmlToken Next();
+
+	/** Skip the content of the element Next() just started, through its end tag */
+	bool SkipElement();
+
+	/** Tag name of the current element */
+	FStringView GetName() const { return Name; }
+
+	/** Raw (undecoded) value of the current start tag's attribute, if present */
+	bool FindAttribute(FStringView AttributeName, FStringView& OutValue) const;
+
+	/** Decoded value of the current start tag's attribute, or empty */
+	FString GetAttribute(FStringView AttributeName) const;
+
+	/** Depth of the current element (the root is 1) */
+	int32 GetDepth() const { return Open.Num() + (bPendingEnd ? 1 : 0); }
+
+	bool HasError() const { return ErrorPos != INDEX_NONE; }
+
+	/** "line L, column C: what went wrong", or empty */
+	FString GetErrorMessage() const;
+
+	/** 1-based line and column of the current tag, or of the error */
+	void GetLocation(int32& OutLine, int32& OutColumn) const;
+
+	/** Replace the five predefined entities and character references in Raw; anything else is kept as written */
+	static FString DecodeText(FStringView Raw);
+
+private:
+	EBehaviacXmlToken Fail(const TCHAR* Message, int32 At);
+	void SkipWhitespace();
+	bool SkipPast(FStringView Terminator);
+	FStringView ReadName();
+	EBehaviacXmlToken ReadStartTag();
+	EBehaviacXmlToken ReadEndTag();
+
+	FStringView Text;
+	int32 Pos = 0;
+	int32 TagStart = 0;
+
+	FStringView Name;
+	TArray<TPair<FStringView, FStringView>, TInlineAllocator<8>> Attributes;
+
+	/** Names of the elements open around the current position */
+	TArray<FStringView, TInlineAllocator<32>> Open;
+
+	/** The current start tag closed itself; Next() reports its end */
+	bool bPendingEnd = false;
+	bool bSeenRoot = false;
+
+	FString Error;
+	int32 ErrorPos = INDEX_NONE;
+};
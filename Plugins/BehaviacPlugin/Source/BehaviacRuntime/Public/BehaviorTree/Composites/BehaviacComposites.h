@@ -6,6 +6,8 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacOperand.h"
+#include "BehaviorTree/BehaviacTreeRegistry.h"
 #include "BehaviacComposites.generated.h"
 
 class UBehaviacAgentComponent;
@@ -23,16 +25,19 @@ class BEHAVIACRUNTIME_API UBehaviacSelector : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 	virtual bool Evaluate(UBehaviacAgentComponent* Agent) const;
 	bool CheckIfInterrupted(UBehaviacAgentComponent* Agent) const;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSelectorTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSelectorTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
+public:
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const override { return ForwardedIfRunning(GetChildTask(ActiveChildIndex)); }
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
@@ -52,14 +57,17 @@ class BEHAVIACRUNTIME_API UBehaviacSequence : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSequenceTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSequenceTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
+public:
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const override { return ForwardedIfRunning(GetChildTask(ActiveChildIndex)); }
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
@@ -81,7 +89,7 @@ class BEHAVIACRUNTIME_API UBehaviacParallel : public UBehaviacBehaviorNode
 public:
 	UBehaviacParallel();
 
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Parallel")
@@ -94,14 +102,13 @@ public:
 	EBehaviacChildFinishPolicy ChildFinishPolicy;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacParallelTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacParallelTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 public:
-	UBehaviacParallelTask();
+	FBehaviacParallelTask();
 
-	virtual void Init(UBehaviacBehaviorNode* InNode) override;
+	virtual void CreateChildTasks(FBehaviacTaskAllocator& Allocator) override;
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 
 protected:
@@ -125,13 +132,15 @@ class BEHAVIACRUNTIME_API UBehaviacIfElse : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacIfElseTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacIfElseTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
+public:
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const override { return ForwardedIfRunning(GetChildTask(ActiveChildIndex)); }
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
@@ -144,22 +153,63 @@ protected:
 /**
  * SelectorLoop: a selector that re-evaluates its conditions on each tick.
  * If a higher-priority child becomes valid, it interrupts the current child.
+ *
+ * With bObserveGuards, a higher-priority child whose guard (the child itself
+ * when it is a pure condition, or a WithPrecondition's precondition) failed is
+ * not re-evaluated until a blackboard key the guard reads changes value.
+ * Children with other guards are re-evaluated every tick as before.
  */
 UCLASS(DisplayName = "SelectorLoop")
 class BEHAVIACRUNTIME_API UBehaviacSelectorLoop : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	UBehaviacSelectorLoop();
+
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+
+	/** Only re-evaluate observable guards when the keys they read change */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|SelectorLoop")
+	bool bObserveGuards;
+
+	/** Keys read by the guard of child Index, or nullptr if it is re-evaluated every tick */
+	const FBehaviacObservedKeys* GetObservedGuardKeys(int32 Index) const;
+
+protected:
+	virtual void ResolveOperands() override;
+
+private:
+	/** Per child, the keys its guard reads when that guard is observable */
+	TArray<TOptional<FBehaviacObservedKeys>> ObservedGuards;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSelectorLoopTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSelectorLoopTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
+	BEHAVIAC_DECLARE_TASK_TYPE(FBehaviacSelectorLoopTask)
+
+	/** Higher-priority re-evaluations skipped because their guard's keys were unchanged */
+	int32 GetNumGuardsSkipped() const { return NumGuardsSkipped; }
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+private:
+	static constexpr uint64 NoGuardFailure = MAX_uint64;
+
+	uint64 ReadBlackboardSerial(UBehaviacAgentComponent* Agent) const;
+
+	/** Remember (or forget) that child Index failed at its guard, evaluated at SerialBefore */
+	void RecordGuardResult(int32 Index, EBehaviacStatus Result, uint64 SerialBefore);
+
+	/** Whether child Index failed at its guard and nothing the guard reads changed since */
+	bool IsGuardFailureCurrent(UBehaviacAgentComponent* Agent, int32 Index) const;
+
+	/** Per child: blackboard serial its guard last failed at, or NoGuardFailure */
+	TArray<uint64> GuardFailureSerials;
+
+	int32 NumGuardsSkipped = 0;
 };
 
 // ===================================================================
@@ -174,13 +224,12 @@ class BEHAVIACRUNTIME_API UBehaviacSelectorProbability : public UBehaviacBehavio
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSelectorProbabilityTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSelectorProbabilityTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
@@ -198,15 +247,14 @@ class BEHAVIACRUNTIME_API UBehaviacSelectorStochastic : public UBehaviacBehavior
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSelectorStochasticTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSelectorStochasticTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 public:
-	UBehaviacSelectorStochasticTask();
+	FBehaviacSelectorStochasticTask();
 
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 
@@ -230,15 +278,14 @@ class BEHAVIACRUNTIME_API UBehaviacSequenceStochastic : public UBehaviacBehavior
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacSequenceStochasticTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacSequenceStochasticTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 public:
-	UBehaviacSequenceStochasticTask();
+	FBehaviacSequenceStochasticTask();
 
 	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 
@@ -255,31 +302,50 @@ protected:
 
 /**
  * ReferenceBehavior: references another behavior tree for execution.
+ * The tree is loaded through FBehaviacTreeRegistry when an agent first
+ * enters the node; every agent then runs that tree's one compiled program
+ * with state of its own. A child node, if the node has one, runs instead.
  */
 UCLASS(DisplayName = "ReferenceBehavior")
 class BEHAVIACRUNTIME_API UBehaviacReferenceBehavior : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Tree the node is linked to, or nullptr before the first entry */
+	UBehaviacBehaviorTree* GetLinkedTree() const { return Link.GetTree(); }
+
 	/** Path to the referenced behavior tree */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Reference")
 	FString ReferencedTreePath;
+
+	/** Link to the referenced tree, shared by the tasks of every agent */
+	mutable FBehaviacSubtreeLink Link;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacReferenceBehaviorTask : public UBehaviacSingleChildTask
+class BEHAVIACRUNTIME_API FBehaviacReferenceBehaviorTask : public FBehaviacSingleChildTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacSingleChildTask;
+	BEHAVIAC_DECLARE_TASK_TYPE(FBehaviacReferenceBehaviorTask)
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+	virtual void Traverse(bool bChildFirst, TFunction<bool(FBehaviacBehaviorTask*)> Handler) override;
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+
+	/** This agent's instance of the referenced tree (invalid before the first entry) */
+	const FBehaviacTreeInstance& GetSubtree() const { return SubTree; }
+
 protected:
-	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
-	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
-	/** The loaded sub-tree task */
-	UPROPERTY()
-	UBehaviacBehaviorTreeTask* SubTreeTask;
+	/** The agent's tasks for the referenced tree (owned) */
+	FBehaviacTreeInstance SubTree;
 };
 
 // ===================================================================
@@ -295,13 +361,20 @@ class BEHAVIACRUNTIME_API UBehaviacWithPrecondition : public UBehaviacBehaviorNo
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWithPreconditionTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacWithPreconditionTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
+	BEHAVIAC_DECLARE_TASK_TYPE(FBehaviacWithPreconditionTask)
+
+	/** Whether the last update failed at the precondition, without running the action */
+	bool DidPreconditionFail() const { return bPreconditionFailed; }
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+private:
+	bool bPreconditionFailed = false;
 };
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacOperand.h"
 #include "BehaviacConditions.generated.h"
 
 class UBehaviacAgentComponent;
@@ -22,7 +23,7 @@ class BEHAVIACRUNTIME_API UBehaviacCondition : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Condition")
@@ -33,17 +34,30 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Condition")
 	EBehaviacOperatorType Operator;
+
+	/** Operands and kernel resolved from the fields above */
+	const FBehaviacComparison& GetComparison() const { return Comparison; }
+
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const override;
+	virtual void GatherPredicates(TArray<FBehaviacComparison*>& OutPredicates) override;
+
+protected:
+	virtual void ResolveOperands() override;
+
+	FBehaviacComparison Comparison;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacConditionTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacConditionTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
+public:
+	FBehaviacConditionTask();
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
-	/** Evaluate a comparison between two string values using the given operator */
-	bool EvaluateComparison(const FString& Left, const FString& Right, EBehaviacOperatorType Op) const;
+	/** This agent's blackboard slots for the left/right operands */
+	int32 SlotHints[2];
 };
 
 // ===================================================================
@@ -59,13 +73,13 @@ class BEHAVIACRUNTIME_API UBehaviacAnd : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const override { return !HasAttachments() && GatherChildrenObservedKeys(OutKeys); }
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacAndTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacAndTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -83,13 +97,13 @@ class BEHAVIACRUNTIME_API UBehaviacOr : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const override { return !HasAttachments() && GatherChildrenObservedKeys(OutKeys); }
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacOrTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacOrTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -106,13 +120,13 @@ class BEHAVIACRUNTIME_API UBehaviacTrue : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const override { return !HasAttachments(); }
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacTrueTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacTrueTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -129,13 +143,13 @@ class BEHAVIACRUNTIME_API UBehaviacFalse : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
+	virtual bool GatherObservedKeys(FBehaviacObservedKeys& OutKeys) const override { return !HasAttachments(); }
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacFalseTask : public UBehaviacLeafTask
+class BEHAVIACRUNTIME_API FBehaviacFalseTask : public FBehaviacLeafTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacLeafTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviacTimerManager.h"
 #include "BehaviacDecorators.generated.h"
 
 class UBehaviacAgentComponent;
@@ -26,14 +27,20 @@ public:
 };
 
 /** Base task for decorators */
-UCLASS(Abstract)
-class BEHAVIACRUNTIME_API UBehaviacDecoratorTask : public UBehaviacSingleChildTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorTask : public FBehaviacSingleChildTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacSingleChildTask;
+public:
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+	virtual FBehaviacBehaviorTask* GetForwardedChild() const override { return ForwardsWhileRunning() ? ForwardedIfRunning(ChildTask) : nullptr; }
+
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 	virtual EBehaviacStatus DecorateResult(EBehaviacStatus ChildResult);
+
+	/** Whether ticking this decorator does nothing but tick its running child (lets the agent sleep through it and ticks resume below it) */
+	virtual bool ForwardsWhileRunning() const { return false; }
 };
 
 // ===================================================================
@@ -45,15 +52,15 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysFailure : public UBehaviacDeco
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysFailureTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorAlwaysFailureTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus DecorateResult(EBehaviacStatus ChildResult) override;
+	virtual bool ForwardsWhileRunning() const override { return true; }
 };
 
 // ===================================================================
@@ -65,15 +72,15 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysRunning : public UBehaviacDeco
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysRunningTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorAlwaysRunningTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus DecorateResult(EBehaviacStatus ChildResult) override;
+	virtual bool ForwardsWhileRunning() const override { return true; }
 };
 
 // ===================================================================
@@ -85,15 +92,15 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysSuccess : public UBehaviacDeco
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorAlwaysSuccessTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorAlwaysSuccessTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus DecorateResult(EBehaviacStatus ChildResult) override;
+	virtual bool ForwardsWhileRunning() const override { return true; }
 };
 
 // ===================================================================
@@ -105,15 +112,15 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorNot : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorNotTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorNotTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus DecorateResult(EBehaviacStatus ChildResult) override;
+	virtual bool ForwardsWhileRunning() const override { return true; }
 };
 
 // ===================================================================
@@ -125,7 +132,7 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorLoop : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** Number of times to loop. -1 means infinite. */
@@ -133,12 +140,11 @@ public:
 	int32 LoopCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorLoopTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorLoopTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorLoopTask();
+	FBehaviacDecoratorLoopTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -158,7 +164,7 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorLoopUntil : public UBehaviacDecorato
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** Loop until child returns this status */
@@ -166,10 +172,9 @@ public:
 	bool bUntilSuccess;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorLoopUntilTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorLoopUntilTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -183,19 +188,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorRepeat : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 RepeatCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorRepeatTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorRepeatTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorRepeatTask();
+	FBehaviacDecoratorRepeatTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -214,19 +218,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorCount : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 CountLimit;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorCountTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorCountTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorCountTask();
+	FBehaviacDecoratorCountTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -245,19 +248,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorCountLimit : public UBehaviacDecorat
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 CountMax;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorCountLimitTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorCountLimitTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorCountLimitTask();
+	FBehaviacDecoratorCountLimitTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -275,23 +277,28 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorTime : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	float TimeDuration;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorTimeTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorTimeTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
+public:
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
-	double StartTime;
+	double StartTime = 0.0;
+	FBehaviacTaskTimer Timer;
 };
 
 // ===================================================================
@@ -303,23 +310,28 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorFrames : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 FrameCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorFramesTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorFramesTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
+public:
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+	virtual bool GetWakeCondition(UBehaviacAgentComponent* Agent, FBehaviacWakeCondition& OutCondition) const override;
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
-	int32 StartFrame;
+	uint64 EndFrame = 0;
+	FBehaviacTaskTimer Timer;
 };
 
 // ===================================================================
@@ -331,19 +343,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorFailureUntil : public UBehaviacDecor
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 UntilCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorFailureUntilTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorFailureUntilTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorFailureUntilTask();
+	FBehaviacDecoratorFailureUntilTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -362,19 +373,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorSuccessUntil : public UBehaviacDecor
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	int32 UntilCount;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorSuccessUntilTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorSuccessUntilTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorSuccessUntilTask();
+	FBehaviacDecoratorSuccessUntilTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -393,19 +403,18 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorIterator : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	FString ArrayProperty;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorIteratorTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorIteratorTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 public:
-	UBehaviacDecoratorIteratorTask();
+	FBehaviacDecoratorIteratorTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -425,17 +434,16 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorLog : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	FString LogMessage;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorLogTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorLogTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -449,17 +457,16 @@ class BEHAVIACRUNTIME_API UBehaviacDecoratorWeight : public UBehaviacDecorator
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|Decorator")
 	float Weight;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacDecoratorWeightTask : public UBehaviacDecoratorTask
+class BEHAVIACRUNTIME_API FBehaviacDecoratorWeightTask : public FBehaviacDecoratorTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacDecoratorTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
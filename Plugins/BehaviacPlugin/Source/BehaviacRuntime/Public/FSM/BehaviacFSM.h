@@ -7,9 +7,12 @@
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
 #include "BehaviacTypes.h"
+#include "BehaviorTree/BehaviacOperand.h"
+#include "BehaviacTimerManager.h"
 #include "BehaviacFSM.generated.h"
 
 class UBehaviacAgentComponent;
+class FBehaviacFSMStateTask;
 
 // ===================================================================
 // FSM TRANSITION (base)
@@ -28,6 +31,15 @@ public:
 	/** Evaluate whether this transition should fire */
 	virtual bool Evaluate(UBehaviacAgentComponent* Agent) const;
 
+	/** Evaluate for the state task it leaves; TransitionIndex is its index in the state's Transitions */
+	virtual bool EvaluateInState(UBehaviacAgentComponent* Agent, const FBehaviacFSMStateTask* StateTask, int32 TransitionIndex) const
+	{
+		return Evaluate(Agent);
+	}
+
+	/** Seconds after the state is entered at which this transition is due (< 0 = not timed) */
+	virtual float GetTimerDuration() const { return -1.f; }
+
 	/** Target state ID to transition to */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
 	int32 TargetStateId;
@@ -38,6 +50,9 @@ public:
 
 	/** Load from properties */
 	virtual void LoadFromProperties(const TArray<FBehaviacProperty>& Properties);
+
+	/** Resolve operand strings ahead of evaluation (called by the owning state) */
+	virtual void ResolveOperands() {}
 };
 
 /**
@@ -49,6 +64,11 @@ class BEHAVIACRUNTIME_API UBehaviacTransitionCondition : public UBehaviacFSMTran
 	GENERATED_BODY()
 public:
 	virtual bool Evaluate(UBehaviacAgentComponent* Agent) const override;
+	virtual void ResolveOperands() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
 	FString LeftOperand;
@@ -58,6 +78,9 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
 	EBehaviacOperatorType Operator;
+
+protected:
+	FBehaviacComparison Comparison;
 };
 
 /**
@@ -79,10 +102,19 @@ class BEHAVIACRUNTIME_API UBehaviacWaitTransition : public UBehaviacFSMTransitio
 {
 	GENERATED_BODY()
 public:
+	UBehaviacWaitTransition();
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
 	float WaitDuration;
 
+	/** Never fires on its own: the wait is timed from when its state was entered */
 	virtual bool Evaluate(UBehaviacAgentComponent* Agent) const override;
+
+	/** Fires once the state task's timer for this transition has */
+	virtual bool EvaluateInState(UBehaviacAgentComponent* Agent, const FBehaviacFSMStateTask* StateTask, int32 TransitionIndex) const override;
+
+	virtual float GetTimerDuration() const override { return FMath::Max(0.f, WaitDuration); }
+	virtual void LoadFromProperties(const TArray<FBehaviacProperty>& Properties) override;
 };
 
 // ===================================================================
@@ -100,7 +132,7 @@ class BEHAVIACRUNTIME_API UBehaviacFSMState : public UBehaviacBehaviorNode
 public:
 	UBehaviacFSMState();
 
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** Unique state ID within the FSM */
@@ -126,56 +158,78 @@ public:
 	/** Transitions out of this state */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Instanced, Category = "Behaviac|FSM")
 	TArray<UBehaviacFSMTransition*> Transitions;
+
+	/** EnterAction / ExitAction resolved through FBehaviacMethodRegistry */
+	int32 EnterMethodId = BEHAVIAC_INVALID_METHOD_ID;
+	int32 ExitMethodId = BEHAVIAC_INVALID_METHOD_ID;
+
+protected:
+	virtual void ResolveOperands() override;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacFSMStateTask : public UBehaviacSingleChildTask
+class BEHAVIACRUNTIME_API FBehaviacFSMStateTask : public FBehaviacSingleChildTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacSingleChildTask;
+	BEHAVIAC_DECLARE_TASK_TYPE(FBehaviacFSMStateTask)
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+
+	/** Whether the timer armed on enter for Transitions[TransitionIndex] has fired */
+	bool HasTransitionTimerFired(int32 TransitionIndex) const;
+
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
 	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 	/** Routes through OnUpdate even when there is no child node. */
 	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+private:
+	/** Timed transitions of the state, by transition index (unset for untimed ones) */
+	TArray<FBehaviacTaskTimer> TransitionTimers;
 };
 
 /**
  * Task for WaitFramesState: returns Running for N frames, then succeeds.
  */
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWaitFramesStateTask : public UBehaviacFSMStateTask
+class BEHAVIACRUNTIME_API FBehaviacWaitFramesStateTask : public FBehaviacFSMStateTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacFSMStateTask;
 public:
-	UBehaviacWaitFramesStateTask();
+	FBehaviacWaitFramesStateTask();
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
-	int32 StartFrame;
 	int32 TargetFrames;
+	FBehaviacTaskTimer Timer;
 };
 
 /**
  * Task for WaitState: returns Running for a duration, then succeeds.
  */
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacWaitStateTask : public UBehaviacFSMStateTask
+class BEHAVIACRUNTIME_API FBehaviacWaitStateTask : public FBehaviacFSMStateTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacFSMStateTask;
 public:
-	UBehaviacWaitStateTask();
+	FBehaviacWaitStateTask();
+
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
+	virtual void OnExit(UBehaviacAgentComponent* Agent, EBehaviacStatus InStatus) override;
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 
 private:
 	double StartTime;
 	float WaitDuration;
+	FBehaviacTaskTimer Timer;
 };
 
 /**
@@ -186,7 +240,7 @@ class BEHAVIACRUNTIME_API UBehaviacWaitFramesState : public UBehaviacFSMState
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
@@ -201,7 +255,7 @@ class BEHAVIACRUNTIME_API UBehaviacWaitState : public UBehaviacFSMState
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|FSM")
@@ -223,7 +277,7 @@ class BEHAVIACRUNTIME_API UBehaviacFSMNode : public UBehaviacBehaviorNode
 public:
 	UBehaviacFSMNode();
 
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** ID of the initial state */
@@ -231,12 +285,11 @@ public:
 	int32 InitialStateId;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacFSMTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacFSMTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 public:
-	UBehaviacFSMTask();
+	FBehaviacFSMTask();
 
 protected:
 	virtual bool OnEnter(UBehaviacAgentComponent* Agent) override;
@@ -247,7 +300,7 @@ protected:
 	EBehaviacStatus UpdateFSM(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus);
 
 	/** Find the task for a given state ID */
-	UBehaviacBehaviorTask* FindStateTaskById(int32 StateId) const;
+	FBehaviacBehaviorTask* FindStateTaskById(int32 StateId) const;
 
 private:
 	/** Currently active state index in ChildTasks */
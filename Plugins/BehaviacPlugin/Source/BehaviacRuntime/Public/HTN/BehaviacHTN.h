@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacTreeRegistry.h"
 #include "BehaviacTypes.h"
 #include "BehaviacHTN.generated.h"
 
@@ -23,24 +24,39 @@ class BEHAVIACRUNTIME_API UBehaviacHTNTask : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** Whether this is a primitive (directly executable) task */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|HTN")
 	bool bIsPrimitive;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Whether the task runs a referenced tree rather than decomposing through methods */
+	bool RunsReferencedTree() const { return Children.Num() == 0 && !ReferencedTreePath.IsEmpty(); }
+
 	/** Referenced behavior tree path (for compound tasks) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac|HTN")
 	FString ReferencedTreePath;
+
+	/** Link to the referenced tree, made on first execution (see FBehaviacTreeRegistry) */
+	mutable FBehaviacSubtreeLink Link;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacHTNTaskExecution : public UBehaviacSingleChildTask
+class BEHAVIACRUNTIME_API FBehaviacHTNTaskExecution : public FBehaviacSingleChildTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacSingleChildTask;
+public:
+	virtual void Reset(UBehaviacAgentComponent* Agent) override;
+
 protected:
-	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+	virtual EBehaviacStatus UpdateCurrent(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
+
+	/** The agent's tasks for the referenced tree, if the task runs one (owned) */
+	FBehaviacTreeInstance SubTree;
 };
 
 // ===================================================================
@@ -56,7 +72,7 @@ class BEHAVIACRUNTIME_API UBehaviacHTNMethod : public UBehaviacBehaviorNode
 {
 	GENERATED_BODY()
 public:
-	virtual UBehaviacBehaviorTask* CreateTask(UObject* Outer) const override;
+	virtual FBehaviacBehaviorTask* CreateTask(FBehaviacTaskAllocator& Allocator) const override;
 	virtual void LoadFromProperties(int32 Version, const FString& InAgentType, const TArray<FBehaviacProperty>& Properties) override;
 
 	/** Precondition for this method to be applicable */
@@ -64,10 +80,9 @@ public:
 	FString MethodPrecondition;
 };
 
-UCLASS()
-class BEHAVIACRUNTIME_API UBehaviacHTNMethodTask : public UBehaviacCompositeTask
+class BEHAVIACRUNTIME_API FBehaviacHTNMethodTask : public FBehaviacCompositeTask
 {
-	GENERATED_BODY()
+	using Super = FBehaviacCompositeTask;
 protected:
 	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override;
 };
@@ -131,9 +146,8 @@ private:
 	/** Current step in the plan */
 	int32 CurrentPlanStep;
 
-	/** Current task execution */
-	UPROPERTY()
-	UBehaviacBehaviorTask* CurrentTaskExecution;
+	/** Current task execution (owned) */
+	TUniquePtr<FBehaviacBehaviorTask> CurrentTaskExecution;
 
 	/** Maximum decomposition depth to prevent infinite recursion */
 	static constexpr int32 MAX_DECOMPOSITION_DEPTH = 256;
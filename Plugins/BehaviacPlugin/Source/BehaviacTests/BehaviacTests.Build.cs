@@ -21,5 +21,15 @@ public class BehaviacTests : ModuleRules
 		{
 			"AutomationController",
 		});
+
+		// The native tree generator test runs the editor-side generator
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[]
+			{
+				"BehaviacEditor",
+				"Projects",
+			});
+		}
 	}
 }
@@ -8,6 +8,7 @@
 #include "BehaviacTypes.h"
 #include "BehaviorTree/BehaviacBehaviorNode.h"
 #include "BehaviorTree/BehaviacBehaviorTask.h"
+#include "BehaviorTree/BehaviacTaskView.h"
 #include "BehaviorTree/BehaviacBehaviorTree.h"
 #include "BehaviorTree/Composites/BehaviacComposites.h"
 #include "BehaviorTree/Actions/BehaviacActions.h"
@@ -29,13 +30,14 @@ static UBehaviacAgentComponent* BT_MakeAgent()
 }
 
 /**
- * Build a UBehaviacBehaviorTreeTask from a root node.
- * UBehaviacBehaviorTreeTask::Init() builds the full child-task hierarchy.
+ * Build a FBehaviacBehaviorTreeTask from a root node.
+ * FBehaviacBehaviorTreeTask::Init() builds the full child-task hierarchy.
  */
-static UBehaviacBehaviorTreeTask* BT_BuildTree(UBehaviacBehaviorNode* RootNode)
+static TUniquePtr<FBehaviacBehaviorTreeTask> BT_BuildTree(UBehaviacBehaviorNode* RootNode)
 {
-	UBehaviacBehaviorTreeTask* TreeTask = NewObject<UBehaviacBehaviorTreeTask>(GetTransientPackage());
-	TreeTask->Init(RootNode);
+	FBehaviacTaskAllocator HeapAllocator;
+	TUniquePtr<FBehaviacBehaviorTreeTask> TreeTask = MakeUnique<FBehaviacBehaviorTreeTask>();
+	TreeTask->Init(RootNode, HeapAllocator);
 	return TreeTask;
 }
 
@@ -45,14 +47,15 @@ static UBehaviacBehaviorTreeTask* BT_BuildTree(UBehaviacBehaviorNode* RootNode)
  */
 static EBehaviacStatus BT_ExecOnce(UBehaviacBehaviorNode* Node, UBehaviacAgentComponent* Agent)
 {
-	UBehaviacBehaviorTask* Task = Node->CreateTask(GetTransientPackage());
-	Task->Init(Node);
+	FBehaviacTaskAllocator HeapAllocator;
+	TUniquePtr<FBehaviacBehaviorTask> Task(Node->CreateTask(HeapAllocator));
+	Task->Init(Node, HeapAllocator);
 	// Pass Invalid so composites treat this as a fresh start (not mid-flight Running).
 	return Task->Execute(Agent, EBehaviacStatus::Invalid);
 }
 
 /** Tick a tree task N times; returns last status. */
-static EBehaviacStatus BT_TickN(UBehaviacBehaviorTreeTask* Tree, UBehaviacAgentComponent* Agent, int32 N)
+static EBehaviacStatus BT_TickN(const TUniquePtr<FBehaviacBehaviorTreeTask>& Tree, UBehaviacAgentComponent* Agent, int32 N)
 {
 	EBehaviacStatus Last = EBehaviacStatus::Invalid;
 	for (int32 i = 0; i < N; i++)
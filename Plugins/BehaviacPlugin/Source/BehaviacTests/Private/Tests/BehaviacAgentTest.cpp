@@ -58,6 +58,18 @@ bool FBehaviacAgent_PropertyBool::RunTest(const FString&)
 	TestTrue(TEXT("Bool true round-trip"), A->GetBoolProperty(TEXT("IsAlive")));
 	A->SetBoolProperty(TEXT("IsAlive"), false);
 	TestFalse(TEXT("Bool false round-trip"), A->GetBoolProperty(TEXT("IsAlive")));
+
+	// Other types read as they did when properties were stored as strings
+	A->SetIntProperty(TEXT("Flag"), 1);
+	TestTrue(TEXT("Int 1 is true"), A->GetBoolProperty(TEXT("Flag")));
+	A->SetIntProperty(TEXT("Flag"), 7);
+	TestFalse(TEXT("Int 7 is not"), A->GetBoolProperty(TEXT("Flag")));
+	A->SetFloatProperty(TEXT("Flag"), 1.f);
+	TestFalse(TEXT("Float 1.0 is not"), A->GetBoolProperty(TEXT("Flag")));
+	A->SetPropertyValue(TEXT("Flag"), TEXT("TRUE"));
+	TestTrue(TEXT("String TRUE is true"), A->GetBoolProperty(TEXT("Flag")));
+	A->SetIntProperty(TEXT("Flag"), 7);
+	TestTrue(TEXT("Typed read tests truthiness"), A->GetBoolValue(TEXT("Flag")));
 	return true;
 }
 
@@ -71,6 +83,85 @@ bool FBehaviacAgent_HasProperty::RunTest(const FString&)
 	TestFalse(TEXT("Not present before set"), A->HasProperty(TEXT("X")));
 	A->SetPropertyValue(TEXT("X"), TEXT("1"));
 	TestTrue(TEXT("Present after set"), A->HasProperty(TEXT("X")));
+
+	// Empty names and never-interned lookups both map to NAME_None, which is never a key
+	A->SetPropertyValue(TEXT(""), TEXT("empty"));
+	A->SetPropertyValue(TEXT("Self."), TEXT("bare"));
+	TestFalse(TEXT("Unknown key still absent"), A->HasProperty(TEXT("NeverInternedProperty_7f3a91")));
+	TestEqual(TEXT("Unknown key reads empty"), A->GetPropertyValue(TEXT("NeverInternedProperty_7f3a91")), FString());
+	TestFalse(TEXT("Empty key not stored"), A->HasProperty(TEXT("")));
+	TestFalse(TEXT("NAME_None not a key"), A->GetBlackboardKeys().Contains(NAME_None));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Typed blackboard
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_BlackboardTypedValues,
+	"BehaviacPlugin.Agent.BlackboardTypedValues",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_BlackboardTypedValues::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetIntValue(TEXT("HP"), 42);
+	A->SetVectorValue(TEXT("Home"), FVector(1.0f, 2.0f, 3.0f));
+	A->SetNameValue(TEXT("Mode"), TEXT("Patrol"));
+	A->SetObjectValue(TEXT("Self"), A);
+
+	TestEqual(TEXT("Int stored typed"), A->GetValueType(TEXT("HP")), EBehaviacValueType::Int);
+	TestEqual(TEXT("Int read back"), A->GetIntValue(TEXT("HP")), 42);
+	TestEqual(TEXT("Vector read back"), A->GetVectorValue(TEXT("Home")), FVector(1.0f, 2.0f, 3.0f));
+	TestEqual(TEXT("Name read back"), A->GetNameValue(TEXT("Mode")), FName(TEXT("Patrol")));
+	TestTrue(TEXT("Object read back"), A->GetObjectValue(TEXT("Self")) == A);
+	TestEqual(TEXT("Missing key is None"), A->GetValueType(TEXT("Nope")), EBehaviacValueType::None);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_BlackboardStringCompat,
+	"BehaviacPlugin.Agent.BlackboardStringCompat",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_BlackboardStringCompat::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	// "Self." prefix and FName keys address the same slot
+	A->SetIntProperty(TEXT("Self.Ammo"), 7);
+	TestEqual(TEXT("Typed read of string-keyed write"), A->GetIntValue(TEXT("Ammo")), 7);
+	TestEqual(TEXT("String view of typed int"), A->GetPropertyValue(TEXT("Ammo")), TEXT("7"));
+
+	// Strings written through the legacy API read back verbatim and as numbers
+	A->SetPropertyValue(TEXT("Range"), TEXT("12.50"));
+	TestEqual(TEXT("String round-trip is verbatim"), A->GetPropertyValue(TEXT("Self.Range")), TEXT("12.50"));
+	TestTrue(TEXT("Numeric string reads as float"), FMath::IsNearlyEqual(A->GetFloatValue(TEXT("Range")), 12.5f));
+
+	A->SetBoolValue(TEXT("Alert"), true);
+	TestEqual(TEXT("Bool string view"), A->GetPropertyValue(TEXT("Alert")), TEXT("true"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_BlackboardSlots,
+	"BehaviacPlugin.Agent.BlackboardSlots",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_BlackboardSlots::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	TestEqual(TEXT("Unknown key has no slot"), A->FindBlackboardSlot(TEXT("Score")), (int32)INDEX_NONE);
+
+	const int32 Slot = A->FindOrAddBlackboardSlot(TEXT("Score"));
+	TestFalse(TEXT("Fresh slot holds no value"), A->HasProperty(TEXT("Score")));
+
+	A->SetBlackboardSlotValue(Slot, FBehaviacValue::MakeInt64(1234567890123LL));
+	A->SetFloatValue(TEXT("Other"), 1.0f);
+	TestEqual(TEXT("Slot stable after other keys added"), A->FindBlackboardSlot(TEXT("Score")), Slot);
+
+	FBehaviacValue V;
+	TestTrue(TEXT("Slot readable"), A->GetBlackboardSlotValue(Slot, V));
+	TestEqual(TEXT("Slot value"), V.AsInt64(), 1234567890123LL);
+	TestEqual(TEXT("Same value via key"), A->GetInt64Property(TEXT("Score")), 1234567890123LL);
 	return true;
 }
 
@@ -110,6 +201,39 @@ bool FBehaviacAgent_ClearAllSignals::RunTest(const FString&)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_SignalIds,
+	"BehaviacPlugin.Agent.SignalIds",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_SignalIds::RunTest(const FString&)
+{
+	const int32 Id = FBehaviacSignalRegistry::FindOrAdd(TEXT("SignalIdsTest"));
+	TestEqual(TEXT("Interning is stable"), FBehaviacSignalRegistry::FindOrAdd(TEXT("SignalIdsTest")), Id);
+	TestEqual(TEXT("Names compare case-insensitively"), FBehaviacSignalRegistry::Find(TEXT("signalidstest")), Id);
+	TestEqual(TEXT("Unknown names are not interned by lookups"),
+		FBehaviacSignalRegistry::Find(TEXT("SignalIdsTest_NeverSent")), BEHAVIAC_INVALID_SIGNAL_ID);
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SendSignalById(Id);
+	TestTrue(TEXT("Set by id, seen by name"), A->IsSignalSet(TEXT("SignalIdsTest")));
+	TestFalse(TEXT("Unknown name is not set"), A->IsSignalSet(TEXT("SignalIdsTest_NeverSent")));
+	A->ClearSignal(TEXT("SignalIdsTest"));
+	TestFalse(TEXT("Cleared by name, seen by id"), A->IsSignalSetById(Id));
+
+	A->FireEvent(TEXT("SignalIdsEvent"));
+	TestTrue(TEXT("Event pending"), A->HasPendingEventById(FBehaviacSignalRegistry::Find(TEXT("SignalIdsEvent"))));
+	TestFalse(TEXT("Events and signals are separate sets"), A->IsSignalSet(TEXT("SignalIdsEvent")));
+	A->ConsumeEvent(TEXT("SignalIdsEvent"));
+	TestFalse(TEXT("Event consumed"), A->HasPendingEvent(TEXT("SignalIdsEvent")));
+
+	// Broadcast: one lookup, every agent signalled
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	UBehaviacAgentComponent::BroadcastSignal({ A, nullptr, B }, TEXT("SignalIdsBroadcast"));
+	TestTrue(TEXT("A got the broadcast"), A->IsSignalSet(TEXT("SignalIdsBroadcast")));
+	TestTrue(TEXT("B got the broadcast"), B->IsSignalSet(TEXT("SignalIdsBroadcast")));
+	return true;
+}
+
 // ---------------------------------------------------------------------------
 // Method dispatch
 // ---------------------------------------------------------------------------
@@ -160,3 +284,194 @@ bool FBehaviacAgent_MethodHandlerUnknown::RunTest(const FString&)
 		Result, EBehaviacStatus::Invalid);
 	return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_MethodRouteInvalidation,
+	"BehaviacPlugin.Agent.MethodRouteInvalidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_MethodRouteInvalidation::RunTest(const FString&)
+{
+	// A cached miss must not hide a handler registered afterwards
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	TestEqual(TEXT("Unhandled method → Invalid"), A->ExecuteMethod(TEXT("LateMethod")), EBehaviacStatus::Invalid);
+	TestEqual(TEXT("Cached miss → Invalid"), A->ExecuteMethod(TEXT("LateMethod")), EBehaviacStatus::Invalid);
+
+	A->RegisterMethodHandler(TEXT("LateMethod"), []() -> EBehaviacStatus
+	{
+		return EBehaviacStatus::Success;
+	});
+	TestEqual(TEXT("Handler registered later → Success"), A->ExecuteMethod(TEXT("LateMethod")), EBehaviacStatus::Success);
+
+	// Re-registering replaces the cached native route
+	A->RegisterMethodHandler(TEXT("LateMethod"), []() -> EBehaviacStatus
+	{
+		return EBehaviacStatus::Failure;
+	});
+	TestEqual(TEXT("Replaced handler → Failure"), A->ExecuteMethod(TEXT("LateMethod")), EBehaviacStatus::Failure);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_MethodById,
+	"BehaviacPlugin.Agent.MethodById",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_MethodById::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	A->RegisterMethodHandler(TEXT("CountMe"), [&Calls]() -> EBehaviacStatus
+	{
+		++Calls;
+		return EBehaviacStatus::Success;
+	});
+
+	// Ids are case-insensitive, like the old string-keyed handler map
+	const int32 Id = FBehaviacMethodRegistry::FindOrAdd(TEXT("CountMe"));
+	TestEqual(TEXT("Same id regardless of case"), FBehaviacMethodRegistry::Find(TEXT("countme")), Id);
+	TestEqual(TEXT("Empty name has no id"), FBehaviacMethodRegistry::FindOrAdd(FString()), BEHAVIAC_INVALID_METHOD_ID);
+
+	TestEqual(TEXT("ExecuteMethodById → Success"), A->ExecuteMethodById(Id), EBehaviacStatus::Success);
+	TestEqual(TEXT("Invalid id → Invalid"), A->ExecuteMethodById(BEHAVIAC_INVALID_METHOD_ID), EBehaviacStatus::Invalid);
+
+	// Action nodes resolve their method id when the task is initialised
+	UBehaviacAction* Node = NewObject<UBehaviacAction>(GetTransientPackage());
+	Node->MethodName = TEXT("CountMe");
+	Node->ResultOption = EBehaviacStatus::Running;
+	TestEqual(TEXT("Action via id → Success"), BT_ExecOnce(Node, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Action resolved its id"), Node->MethodId, Id);
+	TestEqual(TEXT("Handler called twice"), Calls, 2);
+	return true;
+}
+
+// ------------------------------------------------------------------
+// Sleeping
+// ------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_SleepUntilSignal,
+	"BehaviacPlugin.Agent.SleepUntilSignal",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_SleepUntilSignal::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 AfterCalls = 0;
+	A->RegisterMethodHandler(TEXT("AfterGo"), [&AfterCalls]() -> EBehaviacStatus
+	{
+		++AfterCalls;
+		return EBehaviacStatus::Success;
+	});
+
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacAction* After = NewObject<UBehaviacAction>(GetTransientPackage());
+	After->MethodName = TEXT("AfterGo");
+	After->ResultOption = EBehaviacStatus::Running;
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ Wait, After });
+	A->LoadBehaviorTree(Tree);
+
+	TestEqual(TEXT("Blocked on the signal → Running"), A->TickBehaviorTree(), EBehaviacStatus::Running);
+	TestTrue(TEXT("Agent fell asleep"), A->IsSleeping());
+	TestEqual(TEXT("Wake condition is the signal"), A->GetWakeCondition().SignalId, FBehaviacSignalRegistry::Find(TEXT("Go")));
+	TestEqual(TEXT("Asleep → Running"), A->TickBehaviorTree(), EBehaviacStatus::Running);
+
+	A->SendSignal(TEXT("Other"));
+	TestTrue(TEXT("Other signals do not wake it"), A->IsSleeping());
+
+	A->SendSignal(TEXT("Go"));
+	TestFalse(TEXT("Its signal wakes it"), A->IsSleeping());
+	TestEqual(TEXT("Woken tree completes"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Action after the wait ran once"), AfterCalls, 1);
+
+	// Opting out keeps the agent awake
+	A->ClearAllSignals();
+	A->bAllowSleeping = false;
+	A->LoadBehaviorTree(Tree);
+	A->TickBehaviorTree();
+	TestFalse(TEXT("bAllowSleeping=false → awake"), A->IsSleeping());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_NoSleepWithUpdatePrecondition,
+	"BehaviacPlugin.Agent.NoSleepWithUpdatePrecondition",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_NoSleepWithUpdatePrecondition::RunTest(const FString&)
+{
+	// A precondition re-checked every tick must keep being ticked
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	A->SetPropertyValue(TEXT("X"), TEXT("5"));
+	UBehaviacPrecondition* Pre = NewObject<UBehaviacPrecondition>(Wait);
+	Pre->LeftOperand  = TEXT("Self.X");
+	Pre->Operator     = EBehaviacOperatorType::Equal;
+	Pre->RightOperand = TEXT("5");
+	Pre->PreconditionPhase = EBehaviacPreconditionPhase::Both;
+	Wait->Preconditions.Add(Pre);
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = Wait;
+	A->LoadBehaviorTree(Tree);
+	TestEqual(TEXT("Precondition holds → Running"), A->TickBehaviorTree(), EBehaviacStatus::Running);
+	TestFalse(TEXT("Update precondition → awake"), A->IsSleeping());
+	return true;
+}
+
+// ------------------------------------------------------------------
+// Task inspection
+// ------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacAgent_TaskView,
+	"BehaviacPlugin.Agent.TaskView",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacAgent_TaskView::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	TestNull(TEXT("No tree → no view"), A->InspectBehaviorTree());
+
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacSequence* Seq = BT_MakeSequence({ BT_MakeNoop(), Wait });
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = Seq;
+	A->LoadBehaviorTree(Tree);
+	A->TickBehaviorTree();
+
+	UBehaviacTaskView* Root = A->InspectBehaviorTree();
+	TestNotNull(TEXT("Running tree → root view"), Root);
+	if (!Root)
+	{
+		return false;
+	}
+	TestTrue(TEXT("Root view is alive"), Root->IsTaskAlive());
+	TestEqual(TEXT("Root view status"), Root->GetStatus(), EBehaviacStatus::Running);
+
+	// The tree task wraps the root node's task
+	const TArray<UBehaviacTaskView*> Top = Root->GetChildren();
+	TestEqual(TEXT("Tree task has one child"), Top.Num(), 1);
+	const TArray<UBehaviacTaskView*> Kids = Top.Num() == 1 ? Top[0]->GetChildren() : TArray<UBehaviacTaskView*>();
+	TestEqual(TEXT("Sequence view node"), Top.Num() == 1 ? Top[0]->GetNode() : nullptr, (UBehaviacBehaviorNode*)Seq);
+	TestEqual(TEXT("Sequence has two child views"), Kids.Num(), 2);
+	if (Kids.Num() == 2)
+	{
+		TestEqual(TEXT("Noop finished"), Kids[0]->GetStatus(), EBehaviacStatus::Success);
+		TestEqual(TEXT("Wait is running"), Kids[1]->GetStatus(), EBehaviacStatus::Running);
+		TestEqual(TEXT("Wait view node"), Kids[1]->GetNode(), (UBehaviacBehaviorNode*)Wait);
+	}
+
+	// Stopping frees the tasks; old views must not reach them
+	A->StopBehaviorTree();
+	TestFalse(TEXT("Stopped → view is stale"), Root->IsTaskAlive());
+	TestEqual(TEXT("Stale view → Invalid"), Root->GetStatus(), EBehaviacStatus::Invalid);
+	TestNull(TEXT("Stale view → no node"), Root->GetNode());
+	TestEqual(TEXT("Stale view → no children"), Root->GetChildren().Num(), 0);
+
+	A->LoadBehaviorTree(Tree);
+	TestFalse(TEXT("Reloaded tree does not revive old views"), Root->IsTaskAlive());
+	return true;
+}
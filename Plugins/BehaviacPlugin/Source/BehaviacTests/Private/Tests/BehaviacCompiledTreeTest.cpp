@@ -0,0 +1,334 @@
+// Behaviac UE5 Plugin — Compiled Tree Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.CompiledTree
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+
+// ---------------------------------------------------------------------------
+// Flattening
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_Flatten,
+	"BehaviacPlugin.CompiledTree.Flatten",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_Flatten::RunTest(const FString&)
+{
+	// Selector(Sequence(Noop, True), Not(False))
+	UBehaviacNoop* Noop = BT_MakeNoop();
+	UBehaviacTrue* True = BT_MakeTrue();
+	UBehaviacFalse* False = BT_MakeFalse();
+	UBehaviacSequence* Seq = BT_MakeSequence({ Noop, True });
+	UBehaviacDecoratorNot* Not = BT_WrapDecorator<UBehaviacDecoratorNot>(False);
+	UBehaviacSelector* Sel = BT_MakeSelector({ Seq, Not });
+
+	TSharedPtr<const FBehaviacCompiledTree> Program = FBehaviacCompiledTree::Compile(Sel);
+	TestTrue(TEXT("Compiled"), Program.IsValid());
+	if (!Program.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<FBehaviacCompiledNode>& Nodes = Program->GetNodes();
+	TestEqual(TEXT("Tree task + 6 nodes"), Nodes.Num(), 7);
+	if (Nodes.Num() != 7)
+	{
+		return false;
+	}
+
+	// Depth-first: tree task, Sel, Seq, Noop, True, Not, False
+	const UBehaviacBehaviorNode* Expected[] = { Sel, Sel, Seq, Noop, True, Not, False };
+	for (int32 Index = 0; Index < 7; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Entry %d node"), Index), (const UBehaviacBehaviorNode*)Nodes[Index].Node, Expected[Index]);
+	}
+
+	TestEqual(TEXT("Kind is the node class"), Nodes[2].Kind, (const UClass*)UBehaviacSequence::StaticClass());
+	TestEqual(TEXT("Tree task has no parent"), Nodes[0].Parent, (int32)INDEX_NONE);
+	TestEqual(TEXT("Selector has two children"), Nodes[1].NumChildren, 2);
+	TestEqual(TEXT("Selector subtree ends the program"), Nodes[1].SubtreeEnd, 7);
+	TestEqual(TEXT("Sequence subtree is Noop, True"), Nodes[2].SubtreeEnd, 5);
+	TestEqual(TEXT("Not is a child of Selector"), Nodes[5].Parent, 1);
+	TestEqual(TEXT("False is a child of Not"), Nodes[6].Parent, 5);
+	TestEqual(TEXT("False depth"), Nodes[6].Depth, 3);
+	TestEqual(TEXT("FindNode skips the tree task"), Program->FindNode(Sel), 1);
+
+	// Every task has its own, aligned place in the state block
+	uint32 End = 0;
+	for (const FBehaviacCompiledNode& Entry : Nodes)
+	{
+		TestTrue(TEXT("Slot follows the previous one"), Entry.State.Offset >= End);
+		TestEqual(TEXT("Slot is aligned"), Entry.State.Offset % FMath::Max(Entry.State.Alignment, 1u), 0u);
+		End = Entry.State.Offset + Entry.State.Size;
+	}
+	TestEqual(TEXT("State size covers every slot"), Program->GetStateSize(), End);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Shared program, per-agent state
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_SharedProgram,
+	"BehaviacPlugin.CompiledTree.SharedProgram",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_SharedProgram::RunTest(const FString&)
+{
+	UBehaviacWaitFrames* Wait = NewObject<UBehaviacWaitFrames>(GetTransientPackage());
+	Wait->FrameCount = 2;
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ BT_MakeNoop(), Wait });
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	A->LoadBehaviorTree(Tree);
+	B->LoadBehaviorTree(Tree);
+
+	const FBehaviacTreeInstance& InstA = A->GetTreeInstance();
+	const FBehaviacTreeInstance& InstB = B->GetTreeInstance();
+	TestTrue(TEXT("Agents share one program"), InstA.GetProgram().Get() == InstB.GetProgram().Get());
+	TestTrue(TEXT("Program is the asset's"), InstA.GetProgram() == Tree->GetCompiledTree());
+	TestTrue(TEXT("Agents have their own state"), InstA.GetRoot() != InstB.GetRoot());
+
+	// All tasks live in the agent's state block
+	int32 NumTasks = 0;
+	int32 NumInBlock = 0;
+	InstA.GetRoot()->Traverse(false, [&](FBehaviacBehaviorTask* Task)
+	{
+		++NumTasks;
+		NumInBlock += InstA.OwnsStateOf(Task) ? 1 : 0;
+		return true;
+	});
+	TestEqual(TEXT("Every task is in the state block"), NumInBlock, NumTasks);
+	TestEqual(TEXT("One task per program entry"), NumTasks, InstA.GetProgram()->GetNodes().Num());
+
+	// Running one agent leaves the other's state alone
+	A->TickBehaviorTree();
+	TestEqual(TEXT("A running"), A->GetBehaviorTreeStatus(), EBehaviacStatus::Running);
+	TestEqual(TEXT("B untouched"), B->GetBehaviorTreeStatus(), EBehaviacStatus::Invalid);
+
+	// Replacing the root recompiles
+	Tree->RootNode = BT_MakeNoop();
+	TestTrue(TEXT("New root → new program"), Tree->GetCompiledTree().Get() != InstA.GetProgram().Get());
+
+	A->StopBehaviorTree();
+	TestFalse(TEXT("Stopped → instance released"), A->GetTreeInstance().IsValid());
+	TestEqual(TEXT("Stopped → no state"), A->GetTreeInstance().GetStateSize(), 0u);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Flat programs
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_FlatProgram,
+	"BehaviacPlugin.CompiledTree.FlatProgram",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_FlatProgram::RunTest(const FString&)
+{
+	// Selector(Sequence(Self.Hp > 5, Step), Not(True)); Step runs every other call
+	UBehaviacAction* Step = NewObject<UBehaviacAction>(GetTransientPackage());
+	Step->MethodName = TEXT("FlatStep");
+	Step->ResultOption = EBehaviacStatus::Running;
+	UBehaviacSelector* Root = BT_MakeSelector({
+		BT_MakeSequence({ BT_MakeCondition(TEXT("Self.Hp"), EBehaviacOperatorType::Greater, TEXT("5")), Step }),
+		BT_WrapDecorator<UBehaviacDecoratorNot>(BT_MakeTrue()) });
+
+	UBehaviacBehaviorTree* FlatTree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	FlatTree->RootNode = Root;
+	FlatTree->bRunFlatProgram = true;
+	UBehaviacBehaviorTree* TaskTree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	TaskTree->RootNode = Root;
+
+	UBehaviacAgentComponent* Flat = BT_MakeAgent();
+	UBehaviacAgentComponent* Tasks = BT_MakeAgent();
+	int32 FlatCalls = 0;
+	int32 TaskCalls = 0;
+	Flat->RegisterMethodHandler(TEXT("FlatStep"), [&FlatCalls]() { return ++FlatCalls % 2 ? EBehaviacStatus::Running : EBehaviacStatus::Success; });
+	Tasks->RegisterMethodHandler(TEXT("FlatStep"), [&TaskCalls]() { return ++TaskCalls % 2 ? EBehaviacStatus::Running : EBehaviacStatus::Success; });
+	Flat->LoadBehaviorTree(FlatTree);
+	Tasks->LoadBehaviorTree(TaskTree);
+
+	const FBehaviacTreeInstance& Instance = Flat->GetTreeInstance();
+	TestTrue(TEXT("Flat tree compiles flat"), Instance.GetProgram()->IsFlat());
+	TestFalse(TEXT("Trees are task-based by default"), Tasks->GetTreeInstance().GetProgram()->IsFlat());
+	TestTrue(TEXT("Root node entry runs Selector"), Instance.GetProgram()->GetNodes()[1].Op == EBehaviacFlatOp::Selector);
+
+	// Only the tree task and the interpreter are tasks; the rest is state
+	int32 NumTasks = 0;
+	Instance.GetRoot()->Traverse(false, [&NumTasks](FBehaviacBehaviorTask*) { ++NumTasks; return true; });
+	TestEqual(TEXT("Two tasks"), NumTasks, 2);
+	TestEqual(TEXT("One state per entry after the tasks"), Instance.GetStateSize(),
+		Instance.GetProgram()->GetFlatStateOffset() + Instance.GetProgram()->GetNodes().Num() * (uint32)sizeof(FBehaviacFlatNodeState));
+
+	// Same statuses, tick by tick, through running, finishing and failing
+	const TCHAR* Hp[] = { TEXT("10"), TEXT("10"), TEXT("10"), TEXT("1"), TEXT("10"), TEXT("10"), TEXT("1"), TEXT("1") };
+	for (int32 Tick = 0; Tick < UE_ARRAY_COUNT(Hp); ++Tick)
+	{
+		Flat->SetPropertyValue(TEXT("Hp"), Hp[Tick]);
+		Tasks->SetPropertyValue(TEXT("Hp"), Hp[Tick]);
+		Flat->TickBehaviorTree();
+		Tasks->TickBehaviorTree();
+		TestTrue(FString::Printf(TEXT("Tick %d status matches"), Tick), Flat->GetBehaviorTreeStatus() == Tasks->GetBehaviorTreeStatus());
+	}
+	TestEqual(TEXT("Step called as often"), FlatCalls, TaskCalls);
+
+	// A node without a flat form keeps the whole tree on tasks
+	UBehaviacBehaviorTree* Mixed = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Mixed->RootNode = BT_MakeSequence({ BT_MakeNoop(), NewObject<UBehaviacWaitFrames>(GetTransientPackage()) });
+	Mixed->bRunFlatProgram = true;
+	TestFalse(TEXT("WaitFrames has no flat form"), Mixed->GetCompiledTree()->IsFlat());
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Lazy branches
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_LazyBranches,
+	"BehaviacPlugin.CompiledTree.LazyBranches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_LazyBranches::RunTest(const FString&)
+{
+	// Selector(Sequence(True, WaitForSignal), Rare: Sequence(Noop, Noop, Noop))
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacSequence* Rare = BT_MakeSequence({ BT_MakeNoop(), BT_MakeNoop(), BT_MakeNoop() });
+	UBehaviacSelector* Sel = BT_MakeSelector({ BT_MakeSequence({ BT_MakeTrue(), Wait }), Rare });
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = Sel;
+	Tree->bInstantiateBranchesLazily = true;
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->LoadBehaviorTree(Tree);
+	const FBehaviacTreeInstance& Instance = A->GetTreeInstance();
+	TestTrue(TEXT("Instance is lazy"), Instance.IsLazy());
+	TestTrue(TEXT("Only the top tasks in the state block"), Instance.GetStateSize() < Instance.GetProgram()->GetStateSize());
+	TestEqual(TEXT("No branch built yet"), Instance.GetNumBranches(), 0);
+
+	const FBehaviacBehaviorTask* RootTask = Instance.GetRoot()->GetChildTask(0);
+	TestTrue(TEXT("Root task waits to build its children"), RootTask && RootTask->HasDeferredChildTasks());
+
+	TestEqual(TEXT("Blocked on the signal"), A->TickBehaviorTree(), EBehaviacStatus::Running);
+
+	// Built: tree task, Selector, both Sequences, True, Wait. The rare branch's leaves are not.
+	int32 NumTasks = 0;
+	const FBehaviacBehaviorTask* RareTask = nullptr;
+	Instance.GetRoot()->Traverse(false, [&](FBehaviacBehaviorTask* Task)
+	{
+		++NumTasks;
+		RareTask = Task->GetNode() == Rare ? Task : RareTask;
+		return true;
+	});
+	TestEqual(TEXT("Six of nine tasks built"), NumTasks, 6);
+	TestEqual(TEXT("Program still has every entry"), Instance.GetProgram()->GetNodes().Num(), 9);
+	TestTrue(TEXT("Untaken branch left unbuilt"), RareTask && RareTask->HasDeferredChildTasks() && RareTask->GetNumChildTasks() == 0);
+	TestEqual(TEXT("Selector and first Sequence built their branches"), Instance.GetNumBranches(), 2);
+	TestTrue(TEXT("Branch blocks come from the tree's pool"), Instance.GetProgram()->GetTaskPool().GetBytesInUse() >= Instance.GetBranchBytes());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_ReclaimIdleBranches,
+	"BehaviacPlugin.CompiledTree.ReclaimIdleBranches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_ReclaimIdleBranches::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	// Sequence(Once: Sequence(Noop, Noop), WaitForSignal)
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacSequence* Once = BT_MakeSequence({ BT_MakeNoop(), BT_MakeNoop() });
+	TSharedPtr<const FBehaviacCompiledTree> Program = FBehaviacCompiledTree::Compile(BT_MakeSequence({ Once, Wait }));
+
+	FBehaviacTreeInstance Instance;
+	Instance.Create(Program, true);
+	TestEqual(TEXT("Running on the wait"), Instance.GetRoot()->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Root and Once branches built"), Instance.GetNumBranches(), 2);
+
+	const FBehaviacBehaviorTask* OnceTask = Instance.GetRoot()->GetChildTask(0)->GetChildTask(0);
+	TestTrue(TEXT("Once finished"), OnceTask && OnceTask->GetStatus() == EBehaviacStatus::Success);
+
+	// The finished branch is idle; the root's branch stays while the tree runs
+	TestEqual(TEXT("One branch reclaimed"), Instance.ReclaimIdleBranches(A->GetTimeSeconds(), 0.0), 1);
+	TestTrue(TEXT("Reclaimed branch waits to be rebuilt"), OnceTask->HasDeferredChildTasks() && OnceTask->GetNumChildTasks() == 0);
+	const uint32 Pooled = Program->GetTaskPool().GetBytesPooled();
+	TestTrue(TEXT("Its block went back to the pool"), Pooled > 0);
+
+	A->SendSignal(TEXT("Go"));
+	TestEqual(TEXT("Tree completes"), Instance.GetRoot()->Tick(A), EBehaviacStatus::Success);
+
+	// Restarting enters the branch again, rebuilding it from the pooled block
+	A->ClearAllSignals();
+	Instance.GetRoot()->Tick(A);
+	TestFalse(TEXT("Branch rebuilt on entry"), OnceTask->HasDeferredChildTasks());
+	TestTrue(TEXT("Pooled block reused"), Program->GetTaskPool().GetBytesPooled() < Pooled);
+
+	Instance.Release();
+	TestEqual(TEXT("Released instance holds no blocks"), Program->GetTaskPool().GetBytesInUse(), 0u);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// State pool
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacCompiledTree_StatePool,
+	"BehaviacPlugin.CompiledTree.StatePool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacCompiledTree_StatePool::RunTest(const FString&)
+{
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ BT_MakeNoop(), BT_MakeSelector({ BT_MakeFalse(), BT_MakeTrue() }) });
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	UBehaviacAgentComponent* C = BT_MakeAgent();
+	A->LoadBehaviorTree(Tree);
+	B->LoadBehaviorTree(Tree);
+	C->LoadBehaviorTree(Tree);
+
+	FBehaviacTreePoolStats Stats = Tree->GetStatePoolStats();
+	TestEqual(TEXT("Slab is one agent's state"), Stats.SlabSize, (int32)A->GetTreeInstance().GetStateSize());
+	TestEqual(TEXT("Three slabs in use"), Stats.SlabsInUse, 3);
+	TestEqual(TEXT("High-water mark"), Stats.SlabsHighWater, 3);
+
+	// Despawn returns the slab; the next spawn reuses it
+	const FBehaviacBehaviorTreeTask* OldRoot = B->GetTreeInstance().GetRoot();
+	B->StopBehaviorTree();
+	Stats = Tree->GetStatePoolStats();
+	TestEqual(TEXT("Two in use after a stop"), Stats.SlabsInUse, 2);
+	TestEqual(TEXT("One free after a stop"), Stats.SlabsFree, 1);
+
+	UBehaviacAgentComponent* D = BT_MakeAgent();
+	D->LoadBehaviorTree(Tree);
+	TestTrue(TEXT("New agent built in the returned slab"), D->GetTreeInstance().GetRoot() == OldRoot);
+	TestEqual(TEXT("Reused agent runs"), D->TickBehaviorTree(), EBehaviacStatus::Success);
+	Stats = Tree->GetStatePoolStats();
+	TestEqual(TEXT("Nothing left pooled"), Stats.SlabsFree, 0);
+	TestEqual(TEXT("High-water mark unchanged"), Stats.SlabsHighWater, 3);
+
+	// Reserving for a wave fills the pool up front
+	Tree->ReserveAgentStates(8);
+	Stats = Tree->GetStatePoolStats();
+	TestEqual(TEXT("Reserved slabs pooled"), Stats.SlabsFree, 5);
+	TestEqual(TEXT("Pooled bytes"), Stats.BytesPooled, 5 * Stats.SlabSize);
+
+	Tree->TrimStatePool();
+	TestEqual(TEXT("Trim frees the pool"), Tree->GetStatePoolStats().SlabsFree, 0);
+
+	A->StopBehaviorTree();
+	C->StopBehaviorTree();
+	D->StopBehaviorTree();
+	TestEqual(TEXT("All slabs returned"), Tree->GetStatePoolStats().SlabsInUse, 0);
+	return true;
+}
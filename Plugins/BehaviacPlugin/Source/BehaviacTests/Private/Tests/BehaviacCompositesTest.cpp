@@ -407,3 +407,151 @@ bool FBehaviacComposites_SelectorProbability_WeightedSelection::RunTest(const FS
 	TestEqual(TEXT("Weight=1 child always selected (10/10)"), CountB, 10);
 	return true;
 }
+
+// ===========================================================================
+// RUNNING PATH RESUME
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_Resume_StartsAtRunningLeaf,
+	"BehaviacPlugin.Composites.Resume.StartsAtRunningLeaf",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_Resume_StartsAtRunningLeaf::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 AfterCount = 0;
+
+	// Sequence(Noop, AlwaysSuccess(Selector(False, WaitForSignal)), After)
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacSelector* Sel = BT_MakeSelector({ BT_MakeFalse(), Wait });
+	UBehaviacSequence* Seq = BT_MakeSequence({
+		BT_MakeNoop(),
+		BT_WrapDecorator<UBehaviacDecoratorAlwaysSuccess>(Sel),
+		MakeCountedAction(A, AfterCount, EBehaviacStatus::Success, TEXT("ResumeAfter")) });
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Seq);
+	TestEqual(TEXT("Blocked on the signal"), Tree->Tick(A), EBehaviacStatus::Running);
+	const FBehaviacBehaviorTask* Resume = Tree->GetResumeTask();
+	TestTrue(TEXT("Next tick starts at the wait"), Resume && Resume->GetNode() == Wait);
+
+	TestEqual(TEXT("Resumed tick still running"), BT_TickN(Tree, A, 3), EBehaviacStatus::Running);
+	TestTrue(TEXT("Resume point unchanged"), Tree->GetResumeTask() == Resume);
+	TestEqual(TEXT("Nothing after the wait ran"), AfterCount, 0);
+
+	// The wait finishing climbs back up through the decorator and on to the next child
+	A->SendSignal(TEXT("Go"));
+	TestEqual(TEXT("Signal → tree completes"), Tree->Tick(A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Next child ran once"), AfterCount, 1);
+	TestNull(TEXT("Finished tree → no resume point"), Tree->GetResumeTask());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_Resume_StopsAtReactiveNodes,
+	"BehaviacPlugin.Composites.Resume.StopsAtReactiveNodes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_Resume_StopsAtReactiveNodes::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	// A Parallel re-ticks all its children itself, so ticks resume at it
+	UBehaviacWaitForSignal* Wait = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait->SignalName = TEXT("Go");
+	UBehaviacParallel* Par = NewObject<UBehaviacParallel>(GetTransientPackage());
+	Par->AddChild(Wait);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(BT_MakeSequence({ Par }));
+	Tree->Tick(A);
+	TestTrue(TEXT("Resume at the Parallel"), Tree->GetResumeTask() && Tree->GetResumeTask()->GetNode() == Par);
+
+	// An update precondition on an ancestor is checked every tick, so ticks start above it
+	UBehaviacWaitForSignal* Wait2 = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	Wait2->SignalName = TEXT("Go");
+	UBehaviacSequence* Guarded = BT_MakeSequence({ Wait2 });
+	A->SetPropertyValue(TEXT("X"), TEXT("5"));
+	UBehaviacPrecondition* Pre = NewObject<UBehaviacPrecondition>(Guarded);
+	Pre->LeftOperand  = TEXT("Self.X");
+	Pre->Operator     = EBehaviacOperatorType::Equal;
+	Pre->RightOperand = TEXT("5");
+	Pre->PreconditionPhase = EBehaviacPreconditionPhase::Update;
+	Guarded->Preconditions.Add(Pre);
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> GuardedTree = BT_BuildTree(BT_MakeSequence({ Guarded }));
+	TestEqual(TEXT("Guarded wait running"), GuardedTree->Tick(A), EBehaviacStatus::Running);
+	TestTrue(TEXT("Resume at the guarded sequence, not below it"), GuardedTree->GetResumeTask() && GuardedTree->GetResumeTask()->GetNode() == Guarded);
+
+	A->SetPropertyValue(TEXT("X"), TEXT("6"));
+	TestEqual(TEXT("Failing update precondition still seen"), GuardedTree->Tick(A), EBehaviacStatus::Failure);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_Resume_MatchesFullDescent,
+	"BehaviacPlugin.Composites.Resume.MatchesFullDescent",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_Resume_MatchesFullDescent::RunTest(const FString&)
+{
+	// Each action runs for two ticks, then returns its status
+	auto MakeSlowAction = [](UBehaviacAgentComponent* Agent, int32& Calls, EBehaviacStatus Final, const FString& Name)
+	{
+		Agent->RegisterMethodHandler(Name, [&Calls, Final]() -> EBehaviacStatus
+		{
+			return ++Calls % 3 == 0 ? Final : EBehaviacStatus::Running;
+		});
+		UBehaviacAction* Node = NewObject<UBehaviacAction>(GetTransientPackage());
+		Node->MethodName = Name;
+		Node->ResultOption = EBehaviacStatus::Running;
+		return Node;
+	};
+
+	TArray<EBehaviacStatus> Statuses[2];
+	int32 Calls[2][3] = {};
+	for (int32 Mode = 0; Mode < 2; ++Mode)
+	{
+		UBehaviacAgentComponent* A = BT_MakeAgent();
+
+		// Selector(Sequence(Slow→Success, Slow→Failure), Not(Slow→Failure))
+		UBehaviacSelector* Root = BT_MakeSelector({
+			BT_MakeSequence({
+				MakeSlowAction(A, Calls[Mode][0], EBehaviacStatus::Success, TEXT("SlowA")),
+				MakeSlowAction(A, Calls[Mode][1], EBehaviacStatus::Failure, TEXT("SlowB")) }),
+			BT_WrapDecorator<UBehaviacDecoratorNot>(MakeSlowAction(A, Calls[Mode][2], EBehaviacStatus::Failure, TEXT("SlowC"))) });
+
+		TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Root);
+		for (int32 Tick = 0; Tick < 12; ++Tick)
+		{
+			Statuses[Mode].Add(Tree->Tick(A, Mode == 1));
+		}
+	}
+
+	TestTrue(TEXT("Same statuses with and without resume"), Statuses[1] == Statuses[0]);
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Action %d ran as often"), Index), Calls[1][Index], Calls[0][Index]);
+	}
+	// A: 3 ticks, B: 3 ticks (its first alongside A's last), C: 3 ticks (likewise)
+	TestEqual(TEXT("Tree completes on the 7th tick"), Statuses[0].IsValidIndex(6) ? Statuses[0][6] : EBehaviacStatus::Invalid, EBehaviacStatus::Success);
+	return true;
+}
+
+// ===========================================================================
+// Task casts follow the task's own type, not its node's
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacComposites_TaskCast,
+	"BehaviacPlugin.Composites.TaskCast",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacComposites_TaskCast::RunTest(const FString&)
+{
+	FBehaviacSelectorLoopTask SelectorLoop;
+	FBehaviacSequenceTask Sequence;
+	FBehaviacWaitStateTask WaitState;
+
+	TestTrue(TEXT("Own type"), BehaviacCastTask<FBehaviacSelectorLoopTask>(&SelectorLoop) == &SelectorLoop);
+	TestNull(TEXT("Other composite"), BehaviacCastTask<FBehaviacSelectorLoopTask>(&Sequence));
+	TestNull(TEXT("Other declared type"), BehaviacCastTask<FBehaviacWithPreconditionTask>(&SelectorLoop));
+	TestTrue(TEXT("Subclass casts to its parent"), BehaviacCastTask<FBehaviacFSMStateTask>(&WaitState) == &WaitState);
+	TestNull(TEXT("Null task"), BehaviacCastTask<FBehaviacSelectorLoopTask>(static_cast<FBehaviacBehaviorTask*>(nullptr)));
+	return true;
+}
@@ -194,6 +194,53 @@ bool FBehaviacConditions_PropertyRef::RunTest(const FString&)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacConditions_TypedProperty,
+	"BehaviacPlugin.Conditions.Condition.TypedProperty",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacConditions_TypedProperty::RunTest(const FString&)
+{
+	// Typed blackboard values compare against resolved literal constants
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetIntValue(TEXT("HP"), 10);
+	A->SetFloatValue(TEXT("Speed"), 2.5f);
+	TestEqual(TEXT("Self.HP(int 10) > 5 → Success"),
+		BT_ExecOnce(BT_MakeCondition(TEXT("Self.HP"), EBehaviacOperatorType::Greater, TEXT("5")), A),
+		EBehaviacStatus::Success);
+	TestEqual(TEXT("Self.Speed(float 2.5) < 3 → Success"),
+		BT_ExecOnce(BT_MakeCondition(TEXT("Self.Speed"), EBehaviacOperatorType::Less, TEXT("3")), A),
+		EBehaviacStatus::Success);
+	TestEqual(TEXT("Self.HP == Self.HP → Success"),
+		BT_ExecOnce(BT_MakeCondition(TEXT("Self.HP"), EBehaviacOperatorType::Equal, TEXT("Self.HP")), A),
+		EBehaviacStatus::Success);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacConditions_MethodFallback,
+	"BehaviacPlugin.Conditions.Condition.MethodFallback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacConditions_MethodFallback::RunTest(const FString&)
+{
+	// An unset "Self.X" operand calls method X and compares its success as a bool
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	A->RegisterMethodHandler(TEXT("IsReady"), [&Calls]() -> EBehaviacStatus
+	{
+		++Calls;
+		return EBehaviacStatus::Success;
+	});
+	UBehaviacCondition* Node = BT_MakeCondition(TEXT("Self.IsReady"), EBehaviacOperatorType::Equal, TEXT("true"));
+	TestEqual(TEXT("IsReady() == true → Success"), BT_ExecOnce(Node, A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Method was called once"), Calls, 1);
+
+	// Once the property exists it wins over the method
+	A->SetBoolValue(TEXT("IsReady"), false);
+	TestEqual(TEXT("IsReady(false) == true → Failure"), BT_ExecOnce(Node, A), EBehaviacStatus::Failure);
+	TestEqual(TEXT("Method not called again"), Calls, 1);
+	return true;
+}
+
 // ---------------------------------------------------------------------------
 // And / Or
 // ---------------------------------------------------------------------------
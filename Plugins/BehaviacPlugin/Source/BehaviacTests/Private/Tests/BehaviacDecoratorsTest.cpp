@@ -142,7 +142,7 @@ bool FBehaviacDecorators_Loop_RunsNTimes::RunTest(const FString&)
 	UBehaviacDecoratorLoop* Loop = BT_WrapDecorator<UBehaviacDecoratorLoop>(ActionNode);
 	Loop->LoopCount = 3;
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Loop);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Loop);
 
 	// A Loop(3) around a Success child should tick Running for 3 iterations, then Success
 	// Tick until not-Running (max 10 guards)
@@ -168,7 +168,7 @@ bool FBehaviacDecorators_Loop_Infinite::RunTest(const FString&)
 	UBehaviacDecoratorLoop* Loop = BT_WrapDecorator<UBehaviacDecoratorLoop>(BT_MakeNoop());
 	Loop->LoopCount = -1; // infinite
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Loop);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Loop);
 
 	// Tick 10 times — should always return Running
 	for (int32 i = 0; i < 10; i++)
@@ -205,7 +205,7 @@ bool FBehaviacDecorators_LoopUntil_UntilSuccess::RunTest(const FString&)
 	UBehaviacDecoratorLoopUntil* LU = BT_WrapDecorator<UBehaviacDecoratorLoopUntil>(ActionNode);
 	LU->bUntilSuccess = true;
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(LU);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(LU);
 
 	EBehaviacStatus S = EBehaviacStatus::Running;
 	int32 Guard = 0;
@@ -242,7 +242,7 @@ bool FBehaviacDecorators_Repeat_RunsNTimes::RunTest(const FString&)
 	UBehaviacDecoratorRepeat* Rep = BT_WrapDecorator<UBehaviacDecoratorRepeat>(ActionNode);
 	Rep->RepeatCount = 3;
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Rep);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Rep);
 
 	EBehaviacStatus S = EBehaviacStatus::Running;
 	int32 Guard = 0;
@@ -287,7 +287,7 @@ bool FBehaviacDecorators_CountLimit_LimitReached::RunTest(const FString&)
 	CL->CountMax = 1;
 
 	// Build the tree once and tick twice (Enter is checked each time the BT re-enters)
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(CL);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(CL);
 	EBehaviacStatus First  = Tree->Tick(A); // enters, runs → Success (count=1)
 	EBehaviacStatus Second = Tree->Tick(A); // tries to enter, count already at limit → Failure
 	TestTrue(TEXT("CountLimit first allowed"),
@@ -39,7 +39,7 @@ bool FBehaviacFSM_EntersInitialState::RunTest(const FString&)
 	UBehaviacFSMNode* FSM = NewObject<UBehaviacFSMNode>(GetTransientPackage());
 	FSM->AddChild(State0);
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(FSM);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(FSM);
 	EBehaviacStatus S = Tree->Tick(A);
 
 	// Initial+final state should run once and succeed
@@ -81,7 +81,7 @@ bool FBehaviacFSM_Transition_AlwaysTransition::RunTest(const FString&)
 	FSM->AddChild(State0);
 	FSM->AddChild(State1);
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(FSM);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(FSM);
 
 	// Tick 1: enters State0, fires transition → moves to State1
 	// Tick 2: State1 is final → returns Success
@@ -117,7 +117,7 @@ bool FBehaviacFSM_WaitState::RunTest(const FString&)
 	UBehaviacFSMNode* FSM = NewObject<UBehaviacFSMNode>(GetTransientPackage());
 	FSM->AddChild(WS);
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(FSM);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(FSM);
 
 	// Should succeed within 2 ticks
 	EBehaviacStatus S1 = Tree->Tick(A);
@@ -148,7 +148,7 @@ bool FBehaviacFSM_WaitFramesState::RunTest(const FString&)
 	UBehaviacFSMNode* FSM = NewObject<UBehaviacFSMNode>(GetTransientPackage());
 	FSM->AddChild(WFS);
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(FSM);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(FSM);
 
 	// Tick 1: Running (0 frames elapsed)
 	EBehaviacStatus S1 = Tree->Tick(A);
@@ -165,3 +165,89 @@ bool FBehaviacFSM_WaitFramesState::RunTest(const FString&)
 
 	return true;
 }
+
+// ===========================================================================
+// FSM: WaitTransition fires on its state's timer
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacFSM_Transition_WaitTransition,
+	"BehaviacPlugin.FSM.Transition.WaitTransition",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacFSM_Transition_WaitTransition::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	// State 0 waits 100s to reach state 2, but 0s to reach state 1
+	UBehaviacFSMState* State0 = NewObject<UBehaviacFSMState>(GetTransientPackage());
+	State0->StateId         = 0;
+	State0->bIsInitialState = true;
+
+	UBehaviacWaitTransition* Slow = NewObject<UBehaviacWaitTransition>(GetTransientPackage());
+	Slow->TargetStateId = 2;
+	Slow->WaitDuration  = 100.f;
+	State0->Transitions.Add(Slow);
+
+	UBehaviacWaitTransition* Fast = NewObject<UBehaviacWaitTransition>(GetTransientPackage());
+	Fast->TargetStateId = 1;
+	Fast->WaitDuration  = 0.f;
+	State0->Transitions.Add(Fast);
+
+	TestFalse(TEXT("WaitTransition does not fire outside a state"), Fast->Evaluate(A));
+
+	UBehaviacFSMState* State1 = NewObject<UBehaviacFSMState>(GetTransientPackage());
+	State1->StateId       = 1;
+	State1->bIsFinalState = true;
+
+	UBehaviacFSMState* State2 = NewObject<UBehaviacFSMState>(GetTransientPackage());
+	State2->StateId       = 2;
+	State2->bIsFinalState = true;
+
+	UBehaviacFSMNode* FSM = NewObject<UBehaviacFSMNode>(GetTransientPackage());
+	FSM->AddChild(State0);
+	FSM->AddChild(State1);
+	FSM->AddChild(State2);
+
+	FBehaviacTimers& Timers = UBehaviacTimerManager::Get(A);
+	const int32 PendingBefore = Timers.GetNumPendingTimers();
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(FSM);
+
+	// Tick 1: enters State0, the 0s wait is already due → moves to State1
+	TestEqual(TEXT("Tick 1 transitions"), Tree->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Leaving State0 cancelled the 100s timer"), Timers.GetNumPendingTimers(), PendingBefore);
+
+	// Tick 2: State1 is final
+	TestEqual(TEXT("Tick 2 reaches State1"), Tree->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+// ===========================================================================
+// FSM: Condition transitions compare strings ignoring case
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacFSM_Transition_ConditionIgnoresCase,
+	"BehaviacPlugin.FSM.Transition.ConditionIgnoresCase",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacFSM_Transition_ConditionIgnoresCase::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetPropertyValue(TEXT("Mode"), TEXT("chase"));
+
+	UBehaviacTransitionCondition* Trans = NewObject<UBehaviacTransitionCondition>(GetTransientPackage());
+	Trans->LeftOperand  = TEXT("Self.Mode");
+	Trans->Operator     = EBehaviacOperatorType::Equal;
+	Trans->RightOperand = TEXT("Chase");
+	TestTrue(TEXT("\"chase\" == \"Chase\""), Trans->Evaluate(A));
+
+	Trans->Operator = EBehaviacOperatorType::NotEqual;
+	Trans->ResolveOperands();
+	TestFalse(TEXT("\"chase\" != \"Chase\" is false"), Trans->Evaluate(A));
+
+	Trans->Operator     = EBehaviacOperatorType::Equal;
+	Trans->RightOperand = TEXT("Flee");
+	Trans->ResolveOperands();
+	TestFalse(TEXT("Different strings still differ"), Trans->Evaluate(A));
+	return true;
+}
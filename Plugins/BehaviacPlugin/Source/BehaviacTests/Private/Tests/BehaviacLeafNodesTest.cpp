@@ -203,6 +203,31 @@ bool FBehaviacNodes_Compute_Divide::RunTest(const FString&)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNodes_Compute_TypedResult,
+	"BehaviacPlugin.Nodes.Compute.TypedResult",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNodes_Compute_TypedResult::RunTest(const FString&)
+{
+	// Typed operands feed the kernel directly; the result is stored as a Float
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->SetIntValue(TEXT("Count"), 6);
+	UBehaviacCompute* Node = NewObject<UBehaviacCompute>(GetTransientPackage());
+	Node->ResultProperty = TEXT("Self.Out");
+	Node->LeftOperand    = TEXT("Self.Count");
+	Node->Operator       = EBehaviacOperatorType::Multiply;
+	Node->RightOperand   = TEXT("1.5");
+	BT_ExecOnce(Node, A);
+	TestEqual(TEXT("Result type is Float"), A->GetValueType(TEXT("Out")), EBehaviacValueType::Float);
+	TestTrue(TEXT("6 * 1.5 == 9"), FMath::IsNearlyEqual(A->GetFloatValue(TEXT("Out")), 9.0f));
+
+	// The same node re-reads the property on the next run
+	A->SetIntValue(TEXT("Count"), 2);
+	BT_ExecOnce(Node, A);
+	TestTrue(TEXT("2 * 1.5 == 3"), FMath::IsNearlyEqual(A->GetFloatValue(TEXT("Out")), 3.0f));
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FBehaviacNodes_Compute_DivideByZero,
 	"BehaviacPlugin.Nodes.Compute.DivideByZero",
@@ -235,7 +260,7 @@ bool FBehaviacNodes_WaitFrames::RunTest(const FString&)
 	UBehaviacAgentComponent* A = BT_MakeAgent();
 	UBehaviacWaitFrames* Node = NewObject<UBehaviacWaitFrames>(GetTransientPackage());
 	Node->FrameCount = 3;
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Node);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Node);
 
 	// Tick 1: should be Running (frame counter hasn't advanced)
 	EBehaviacStatus S1 = Tree->Tick(A);
@@ -271,7 +296,7 @@ bool FBehaviacNodes_WaitForSignal_Waiting::RunTest(const FString&)
 	UBehaviacAgentComponent* A = BT_MakeAgent();
 	UBehaviacWaitForSignal* Node = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
 	Node->SignalName = TEXT("Proceed");
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Node);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Node);
 
 	EBehaviacStatus S = Tree->Tick(A);
 	TestEqual(TEXT("WaitForSignal returns Running before signal"), S, EBehaviacStatus::Running);
@@ -287,7 +312,7 @@ bool FBehaviacNodes_WaitForSignal_Signaled::RunTest(const FString&)
 	UBehaviacAgentComponent* A = BT_MakeAgent();
 	UBehaviacWaitForSignal* Node = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
 	Node->SignalName = TEXT("Go");
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Node);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Node);
 
 	// First tick: still waiting
 	Tree->Tick(A);
@@ -0,0 +1,329 @@
+// Behaviac UE5 Plugin — Native Tree Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.NativeTree
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+#include "BehaviorTree/BehaviacNativeTree.h"
+#if WITH_EDITOR
+#include "BehaviacNativeTreeGenerator.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#endif
+
+namespace
+{
+	int32 GNativeTreeTestUpdates = 0;
+
+	/** Sequence(Action NativeTreeTest_Act, Condition Self.NativeTreeTest_Value < 5), written the way the generator writes it */
+	class FNativeTreeTestTask final : public FBehaviacNativeTreeTask
+	{
+	protected:
+		virtual void ResetState() override { State = FState(); }
+
+		virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override
+		{
+			++GNativeTreeTestUpdates;
+			return Node0(Agent);
+		}
+
+	private:
+		struct FState
+		{
+			int32 Cursor0 = 0;
+			int32 Hints2[2] = { INDEX_NONE, INDEX_NONE };
+		};
+		FState State;
+
+		EBehaviacStatus Node1(UBehaviacAgentComponent* Agent)
+		{
+			static const int32 MethodId = FBehaviacMethodRegistry::FindOrAdd(TEXT("NativeTreeTest_Act"));
+			return CallMethod(Agent, MethodId, EBehaviacStatus::Running);
+		}
+
+		EBehaviacStatus Node2(UBehaviacAgentComponent* Agent)
+		{
+			static const FName Key(TEXT("NativeTreeTest_Value"));
+			double Value;
+			if (ReadNumber(Agent, Key, State.Hints2[0], Value))
+			{
+				return Value < 5.0 ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+			}
+			static const FBehaviacComparison Comparison = MakeComparison(TEXT("Self.NativeTreeTest_Value"), EBehaviacOperatorType::Less, TEXT("5"));
+			return EvaluateCondition(Agent, Comparison, State.Hints2);
+		}
+
+		EBehaviacStatus Node0(UBehaviacAgentComponent* Agent)
+		{
+			for (;;)
+			{
+				EBehaviacStatus Result = EBehaviacStatus::Invalid;
+				switch (State.Cursor0)
+				{
+				case 0: Result = Node1(Agent); break;
+				case 1: Result = Node2(Agent); break;
+				default: State.Cursor0 = 0; return EBehaviacStatus::Success;
+				}
+				if (Result == EBehaviacStatus::Running)
+				{
+					return Result;
+				}
+				if (Result == EBehaviacStatus::Failure)
+				{
+					State.Cursor0 = 0;
+					return Result;
+				}
+				++State.Cursor0;
+			}
+		}
+	};
+
+	FBehaviacBehaviorTask* MakeNativeTreeTestTask(FBehaviacTaskAllocator& Allocator)
+	{
+		return Allocator.New<FNativeTreeTestTask>();
+	}
+
+	UBehaviacBehaviorTree* MakeNativeTreeTestTree(UBehaviacAgentComponent* Agent, int32& OutCalls)
+	{
+		OutCalls = 0;
+		Agent->RegisterMethodHandler(TEXT("NativeTreeTest_Act"), [&OutCalls]()
+		{
+			++OutCalls;
+			return EBehaviacStatus::Success;
+		});
+
+		UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+		Tree->TreeName = TEXT("NativeTreeTest");
+		Tree->RootNode = BT_MakeSequence({
+			BT_MakeAction(Agent, EBehaviacStatus::Running, TEXT("NativeTreeTest_Act")),
+			BT_MakeCondition(TEXT("Self.NativeTreeTest_Value"), EBehaviacOperatorType::Less, TEXT("5")) });
+		return Tree;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_RunsMatchingTree,
+	"BehaviacPlugin.NativeTree.RunsMatchingTree",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_RunsMatchingTree::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	UBehaviacBehaviorTree* Tree = MakeNativeTreeTestTree(A, Calls);
+	FBehaviacNativeTreeRegistrar Registrar(TEXT("NativeTreeTest"), FBehaviacNativeTreeRegistry::HashTree(Tree->RootNode), &MakeNativeTreeTestTask);
+
+	GNativeTreeTestUpdates = 0;
+	A->LoadBehaviorTree(Tree);
+	TestTrue(TEXT("Program runs the generated tree"), Tree->GetCompiledTree()->IsNative());
+	TestEqual(TEXT("Tree task and generated task only"), Tree->GetCompiledTree()->GetNodes().Num(), 2);
+
+	A->SetFloatValue(TEXT("NativeTreeTest_Value"), 3.f);
+	TestEqual(TEXT("Action then passing condition"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Method called"), Calls, 1);
+	TestEqual(TEXT("Generated code ran"), GNativeTreeTestUpdates, 1);
+
+	A->SetFloatValue(TEXT("NativeTreeTest_Value"), 7.f);
+	TestEqual(TEXT("Condition fails"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestEqual(TEXT("Method called again"), Calls, 2);
+
+	A->StopBehaviorTree();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_FallsBackToInterpreter,
+	"BehaviacPlugin.NativeTree.FallsBackToInterpreter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_FallsBackToInterpreter::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	UBehaviacBehaviorTree* Tree = MakeNativeTreeTestTree(A, Calls);
+	FBehaviacNativeTreeRegistrar Registrar(TEXT("NativeTreeTest"), FBehaviacNativeTreeRegistry::HashTree(Tree->RootNode), &MakeNativeTreeTestTask);
+
+	// Opted out per tree
+	Tree->bUseNativeTree = false;
+	Tree->InvalidateCompiledTree();
+	TestFalse(TEXT("Opted-out tree is interpreted"), Tree->GetCompiledTree()->IsNative());
+	Tree->bUseNativeTree = true;
+
+	// Edited since generation: the code no longer matches
+	AddExpectedError(TEXT("out of date"), EAutomationExpectedErrorFlags::Contains, 1);
+	Cast<UBehaviacCondition>(Tree->RootNode->GetChild(1))->RightOperand = TEXT("10");
+	Tree->RootNode->GetChild(1)->InvalidateResolvedOperands();
+	Tree->InvalidateCompiledTree();
+
+	GNativeTreeTestUpdates = 0;
+	A->LoadBehaviorTree(Tree);
+	TestFalse(TEXT("Stale generated code not used"), Tree->GetCompiledTree()->IsNative());
+
+	A->SetFloatValue(TEXT("NativeTreeTest_Value"), 7.f);
+	TestEqual(TEXT("Interpreter sees the edit"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Method called by the interpreter"), Calls, 1);
+	TestEqual(TEXT("Generated code did not run"), GNativeTreeTestUpdates, 0);
+
+	A->StopBehaviorTree();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_HashTree,
+	"BehaviacPlugin.NativeTree.HashTree",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_HashTree::RunTest(const FString&)
+{
+	auto MakeTree = [](const FString& Method, bool bSwap)
+	{
+		UBehaviacAction* Action = NewObject<UBehaviacAction>(GetTransientPackage());
+		Action->MethodName = Method;
+		UBehaviacNoop* Noop = BT_MakeNoop();
+		return bSwap ? BT_MakeSequence({ Noop, Action }) : BT_MakeSequence({ Action, Noop });
+	};
+
+	const uint32 Hash = FBehaviacNativeTreeRegistry::HashTree(MakeTree(TEXT("Patrol"), false));
+	TestEqual(TEXT("Same graph, same hash"), FBehaviacNativeTreeRegistry::HashTree(MakeTree(TEXT("Patrol"), false)), Hash);
+	TestNotEqual(TEXT("Property edit changes the hash"), FBehaviacNativeTreeRegistry::HashTree(MakeTree(TEXT("Chase"), false)), Hash);
+	TestNotEqual(TEXT("Reordering changes the hash"), FBehaviacNativeTreeRegistry::HashTree(MakeTree(TEXT("Patrol"), true)), Hash);
+	return true;
+}
+
+#if WITH_EDITOR
+
+// ---------------------------------------------------------------------------
+// Generator
+//
+// Generated/BehaviacNativeTree_NativeTreeSample.cpp is the generator's output
+// for MakeNativeTreeSample, checked in so the generated form keeps compiling.
+// When the generator changes on purpose, copy the file the failing test saves
+// over it.
+// ---------------------------------------------------------------------------
+
+namespace
+{
+	const TCHAR* NativeTreeSampleName = TEXT("NativeTreeSample");
+
+	/** The tree the checked-in sample was generated from */
+	UBehaviacBehaviorTree* MakeNativeTreeSample()
+	{
+		auto WithId = [](UBehaviacBehaviorNode* Node, int32 Id)
+		{
+			Node->NodeId = Id;
+			return Node;
+		};
+
+		UBehaviacAction* Act = NewObject<UBehaviacAction>(GetTransientPackage());
+		Act->MethodName = TEXT("NativeSample_Act");
+		Act->ResultOption = EBehaviacStatus::Running;
+		UBehaviacWait* Wait = NewObject<UBehaviacWait>(GetTransientPackage());
+		Wait->Duration = 0.5f;
+
+		UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+		Tree->TreeName = NativeTreeSampleName;
+		Tree->RootNode = WithId(BT_MakeSequence({
+			WithId(BT_MakeCondition(TEXT("Self.NativeSample_Value"), EBehaviacOperatorType::Less, TEXT("5")), 2),
+			WithId(BT_MakeSelector({ WithId(Act, 4), WithId(Wait, 5) }), 3),
+			WithId(BT_WrapDecorator<UBehaviacDecoratorNot>(WithId(BT_MakeFalse(), 7)), 6) }), 1);
+		return Tree;
+	}
+
+	FString GetNativeTreeSamplePath()
+	{
+		return IPluginManager::Get().FindPlugin(TEXT("BehaviacPlugin"))->GetBaseDir()
+			/ TEXT("Source/BehaviacTests/Private/Tests/Generated")
+			/ FBehaviacNativeTreeGenerator::GetFileName(NativeTreeSampleName);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_GeneratorMatchesSample,
+	"BehaviacPlugin.NativeTree.GeneratorMatchesSample",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_GeneratorMatchesSample::RunTest(const FString&)
+{
+	FString Code, Error;
+	if (!TestTrue(TEXT("Sample generated"), FBehaviacNativeTreeGenerator::Generate(MakeNativeTreeSample(), Code, Error))) return false;
+
+	const FString ExpectedPath = GetNativeTreeSamplePath();
+	FString Expected;
+	if (!TestTrue(TEXT("Checked-in sample read"), FFileHelper::LoadFileToString(Expected, *ExpectedPath))) return false;
+	Expected.ReplaceInline(TEXT("\r\n"), TEXT("\n"));
+
+	// The registration hash is compared too: a stale one would leave the sample interpreted
+	if (Code != Expected)
+	{
+		const FString ActualPath = FPaths::ProjectSavedDir() / TEXT("Automation") / FBehaviacNativeTreeGenerator::GetFileName(NativeTreeSampleName);
+		FFileHelper::SaveStringToFile(Code, *ActualPath);
+		AddError(FString::Printf(TEXT("Generated code differs from %s; the generator's output is in %s"), *ExpectedPath, *ActualPath));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_RunsGeneratedSample,
+	"BehaviacPlugin.NativeTree.RunsGeneratedSample",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_RunsGeneratedSample::RunTest(const FString&)
+{
+	// The compiled-in sample must be registered under the hash of the tree it was generated from
+	UBehaviacBehaviorTree* Tree = MakeNativeTreeSample();
+	const uint32 TreeHash = FBehaviacNativeTreeRegistry::HashTree(Tree->RootNode);
+	if (!TestTrue(TEXT("Sample compiled in under the tree's hash"), FBehaviacNativeTreeRegistry::Find(NativeTreeSampleName, TreeHash) != nullptr)) return false;
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	A->RegisterMethodHandler(TEXT("NativeSample_Act"), [&Calls]()
+	{
+		++Calls;
+		return EBehaviacStatus::Success;
+	});
+
+	A->LoadBehaviorTree(Tree);
+	TestTrue(TEXT("Program runs the sample"), Tree->GetCompiledTree()->IsNative());
+
+	A->SetFloatValue(TEXT("NativeSample_Value"), 3.f);
+	TestEqual(TEXT("Condition, action and inverted False pass"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Method called"), Calls, 1);
+
+	A->SetFloatValue(TEXT("NativeSample_Value"), 7.f);
+	TestEqual(TEXT("Condition fails"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestEqual(TEXT("Method not called"), Calls, 1);
+
+	A->StopBehaviorTree();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNativeTree_GeneratorRejectsNonFinite,
+	"BehaviacPlugin.NativeTree.GeneratorRejectsNonFinite",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNativeTree_GeneratorRejectsNonFinite::RunTest(const FString&)
+{
+	FString Code, Error;
+
+	// A Wait can only be generated with a finite duration, which "inf" in tree data is not
+	UBehaviacWait* Wait = NewObject<UBehaviacWait>(GetTransientPackage());
+	Wait->Duration = FCString::Atof(TEXT("inf"));
+	UBehaviacBehaviorTree* WaitTree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	WaitTree->TreeName = TEXT("NativeTreeInfiniteWait");
+	WaitTree->RootNode = Wait;
+	TestFalse(TEXT("Infinite wait not generated"), FBehaviacNativeTreeGenerator::Generate(WaitTree, Code, Error));
+	TestTrue(TEXT("Error names the duration"), Error.Contains(TEXT("non-finite duration")));
+
+	// A constant too large for a double is compared by the interpreter's rules
+	UBehaviacBehaviorTree* ConditionTree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	ConditionTree->TreeName = TEXT("NativeTreeHugeConstant");
+	ConditionTree->RootNode = BT_MakeCondition(TEXT("Self.NativeSample_Value"), EBehaviacOperatorType::Less, FString::ChrN(400, TEXT('9')));
+	if (!TestTrue(TEXT("Condition generated"), FBehaviacNativeTreeGenerator::Generate(ConditionTree, Code, Error))) return false;
+	TestFalse(TEXT("No direct numeric comparison"), Code.Contains(TEXT("ReadNumber")));
+	TestFalse(TEXT("No inf literal"), Code.Contains(TEXT("inf")));
+	return true;
+}
+
+#endif // WITH_EDITOR
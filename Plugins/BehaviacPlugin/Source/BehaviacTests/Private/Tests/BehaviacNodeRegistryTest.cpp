@@ -0,0 +1,78 @@
+// Behaviac UE5 Plugin — Node Registry Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.NodeRegistry
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacNodeRegistry.h"
+
+// ---------------------------------------------------------------------------
+// Built-in classes register themselves
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNodeRegistry_FindsBuiltins,
+	"BehaviacPlugin.NodeRegistry.FindsBuiltins",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNodeRegistry_FindsBuiltins::RunTest(const FString&)
+{
+	const FBehaviacNodeRegistry& Registry = FBehaviacNodeRegistry::Get();
+
+	TestTrue(TEXT("Composite"), Registry.FindNodeClass(TEXT("Selector")) == UBehaviacSelector::StaticClass());
+	TestTrue(TEXT("Action"), Registry.FindNodeClass(TEXT("WaitforSignal")) == UBehaviacWaitForSignal::StaticClass());
+	TestTrue(TEXT("Condition"), Registry.FindNodeClass(TEXT("True")) == UBehaviacTrue::StaticClass());
+	TestTrue(TEXT("Decorator"), Registry.FindNodeClass(TEXT("DecoratorWeight")) == UBehaviacDecoratorWeight::StaticClass());
+	TestTrue(TEXT("Namespace ignored"), Registry.FindNodeClass(TEXT("behaviac::Sequence")) == UBehaviacSequence::StaticClass());
+	TestNull(TEXT("Unknown class"), Registry.FindNodeClass(TEXT("NoSuchRegisteredNode")));
+	TestNull(TEXT("Attachments are not nodes"), Registry.FindNodeClass(TEXT("Precondition")));
+
+	TestEqual(TEXT("Short name"), FString(FBehaviacNodeRegistry::GetShortName(TEXT("PluginBehaviac.Events.Effector"))), FString(TEXT("Effector")));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Classes registered by other modules load from XML
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacNodeRegistry_LoadsRegisteredClasses,
+	"BehaviacPlugin.NodeRegistry.LoadsRegisteredClasses",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacNodeRegistry_LoadsRegisteredClasses::RunTest(const FString&)
+{
+	FBehaviacNodeRegistry& Registry = FBehaviacNodeRegistry::Get();
+	Registry.RegisterNode(TEXT("FusedWaitStep"), UBehaviacWait::StaticClass());
+	Registry.RegisterAttachment(TEXT("GuardCheck"), UBehaviacPrecondition::StaticClass(), EBehaviacAttachmentKind::Precondition);
+
+	const TCHAR* XML =
+		TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+			"<behavior version=\"5\" agenttype=\"TestAgent\">\n"
+			"  <node class=\"game::FusedWaitStep\" id=\"1\">\n"
+			"    <attachment class=\"GuardCheck\" id=\"2\"/>\n"
+			"    <attachment class=\"PluginBehaviac.Events.Effector\" id=\"3\"/>\n"
+			"    <attachment class=\"PreconditionAttachment\" id=\"4\"/>\n"
+			"    <attachment class=\"NoSuchAttachment\" id=\"5\"/>\n"
+			"  </node>\n"
+			"</behavior>\n");
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->bOptimizeOnLoad = false;
+	const bool bLoaded = Tree->LoadFromXML(XML);
+	Registry.Unregister(TEXT("FusedWaitStep"));
+	Registry.Unregister(TEXT("GuardCheck"));
+
+	if (!TestTrue(TEXT("Loaded"), bLoaded)) return false;
+	const UBehaviacBehaviorNode* Root = Tree->RootNode;
+	if (!TestNotNull(TEXT("Root built"), Root)) return false;
+	TestTrue(TEXT("Registered class created"), Root->IsA(UBehaviacWait::StaticClass()));
+	TestEqual(TEXT("Name from the data kept"), Root->NodeClassName, FString(TEXT("FusedWaitStep")));
+	TestEqual(TEXT("Registered and loosely named preconditions"), Root->Preconditions.Num(), 2);
+	TestEqual(TEXT("Namespaced effector"), Root->Effectors.Num(), 1);
+	TestEqual(TEXT("Unknown attachment skipped"), Root->Events.Num(), 0);
+
+	// Unregistered again, the class is unknown
+	AddExpectedError(TEXT("Unknown node class: FusedWaitStep"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestNull(TEXT("Unregistered"), Registry.CreateNode(TEXT("FusedWaitStep"), GetTransientPackage()));
+	return true;
+}
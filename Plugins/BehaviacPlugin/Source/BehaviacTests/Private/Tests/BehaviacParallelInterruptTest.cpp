@@ -93,7 +93,7 @@ bool FBehaviacParallelInterrupt_ParallelLoopReticks::RunTest(const FString&)
 	// Replace child[0] with real updater
 	Par->Children[0] = UpdaterNode;
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Par);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Par);
 
 	const int32 Ticks = 5;
 	BT_TickN(Tree, Agent, Ticks);
@@ -144,7 +144,7 @@ bool FBehaviacParallelInterrupt_ParallelOnceSkipsChild0::RunTest(const FString&)
 	Par->AddChild(UpdaterNode);
 	Par->AddChild(MakeInfiniteLoop(WorkerNode));
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Par);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Par);
 	BT_TickN(Tree, Agent, 5);
 
 	UE_LOG(LogTemp, Warning, TEXT("[Test] ParallelOnce: UpdaterCount=%d (expected 1)"), UpdaterCount);
@@ -206,7 +206,7 @@ bool FBehaviacParallelInterrupt_SelectorLoopInterrupts::RunTest(const FString&)
 	SL->AddChild(MakeGuardedBranch(TEXT("AIState"), TEXT("Chase"), MakeInfiniteLoop(ChaseNode)));
 	SL->AddChild(BT_MakeSequence({ MakeInfiniteLoop(PatrolNode) }));
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(SL);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(SL);
 
 	const int32 TotalTicks = 6;
 	for (int32 i = 0; i < TotalTicks; i++)
@@ -305,7 +305,7 @@ bool FBehaviacParallelInterrupt_FullSimulation::RunTest(const FString&)
 	Par->AddChild(UpdateWrapper);
 	Par->AddChild(SLLoop);
 
-	UBehaviacBehaviorTreeTask* Tree = BT_BuildTree(Par);
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Par);
 
 	const int32 TotalTicks = 6;
 	for (int32 i = 0; i < TotalTicks; i++)
@@ -329,3 +329,73 @@ bool FBehaviacParallelInterrupt_FullSimulation::RunTest(const FString&)
 
 	return true;
 }
+
+// ===========================================================================
+// TEST 5 — SelectorLoop observer: unchanged guards are not re-evaluated
+//
+// Tree:
+//   SelectorLoop
+//     [0] WithPrecondition(AIState=="Chase")  → Action("ObsChase")
+//     [1] Sequence → Action("ObsPatrol")      [rewrites AIState every tick]
+//
+// Rewriting the same value is not a change, so the Chase guard is skipped
+// until Patrol writes "Chase" on tick 3; tick 4 then switches branches.
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacParallelInterrupt_SelectorLoopObserver,
+	"BehaviacPlugin.ParallelInterrupt.SelectorLoop_ObserverSkipsUnchangedGuards",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacParallelInterrupt_SelectorLoopObserver::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* Agent = BT_MakeAgent();
+
+	int32 ChaseCount  = 0;
+	int32 PatrolCount = 0;
+
+	Agent->SetPropertyValue(TEXT("AIState"), TEXT("Patrol"));
+	Agent->RegisterMethodHandler(TEXT("ObsChase"), [&]() -> EBehaviacStatus {
+		ChaseCount++;
+		return EBehaviacStatus::Running;
+	});
+	Agent->RegisterMethodHandler(TEXT("ObsPatrol"), [&]() -> EBehaviacStatus {
+		PatrolCount++;
+		Agent->SetPropertyValue(TEXT("AIState"), PatrolCount >= 3 ? TEXT("Chase") : TEXT("Patrol"));
+		return EBehaviacStatus::Running;
+	});
+
+	UBehaviacAction* ChaseNode = NewObject<UBehaviacAction>(GetTransientPackage());
+	ChaseNode->MethodName = TEXT("ObsChase");
+	UBehaviacAction* PatrolNode = NewObject<UBehaviacAction>(GetTransientPackage());
+	PatrolNode->MethodName = TEXT("ObsPatrol");
+
+	UBehaviacSelectorLoop* SL = NewObject<UBehaviacSelectorLoop>(GetTransientPackage());
+	SL->AddChild(MakeGuardedBranch(TEXT("AIState"), TEXT("Chase"), ChaseNode));
+	SL->AddChild(BT_MakeSequence({ PatrolNode }));
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(SL);
+
+	FBehaviacSelectorLoopTask* SLTask = nullptr;
+	Tree->Traverse(false, [&SLTask](FBehaviacBehaviorTask* Task)
+	{
+		SLTask = SLTask ? SLTask : BehaviacCastTask<FBehaviacSelectorLoopTask>(Task);
+		return true;
+	});
+	TestNotNull(TEXT("SelectorLoop task found"), SLTask);
+	TestNotNull(TEXT("Chase guard is observable"), SL->GetObservedGuardKeys(0));
+	TestNull(TEXT("Sequence fallthrough is not"), SL->GetObservedGuardKeys(1));
+	if (!SLTask)
+	{
+		return false;
+	}
+
+	BT_TickN(Tree, Agent, 3);
+	TestEqual(TEXT("Patrol ran ticks 1-3"), PatrolCount, 3);
+	TestEqual(TEXT("Guard skipped on ticks 2-3"), SLTask->GetNumGuardsSkipped(), 2);
+
+	BT_TickN(Tree, Agent, 2);
+	TestEqual(TEXT("Changed key re-evaluated the guard"), SLTask->GetNumGuardsSkipped(), 2);
+	TestEqual(TEXT("Chase took over on tick 4"), ChaseCount, 2);
+	TestEqual(TEXT("Patrol stopped"), PatrolCount, 3);
+	return true;
+}
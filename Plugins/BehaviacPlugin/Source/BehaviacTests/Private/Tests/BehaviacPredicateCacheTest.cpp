@@ -0,0 +1,135 @@
+// Behaviac UE5 Plugin — Predicate Cache Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.PredicateCache
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacCompiledTree.h"
+
+namespace
+{
+	UBehaviacCondition* MakeChaseCheck()
+	{
+		return BT_MakeCondition(TEXT("Self.AIState"), EBehaviacOperatorType::Equal, TEXT("Chase"));
+	}
+
+	/** Sequence(AIState == Chase, Step, AIState == Chase, HP > 0) loaded into A */
+	UBehaviacBehaviorTree* LoadChaseTree(UBehaviacAgentComponent* A, UBehaviacCondition*& OutFirst, UBehaviacCondition*& OutUnique)
+	{
+		OutFirst = MakeChaseCheck();
+		OutUnique = BT_MakeCondition(TEXT("Self.HP"), EBehaviacOperatorType::Greater, TEXT("0"));
+
+		UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+		Tree->RootNode = BT_MakeSequence({
+			OutFirst,
+			BT_MakeAction(A, EBehaviacStatus::Success, TEXT("PredicateCacheStep")),
+			MakeChaseCheck(),
+			OutUnique });
+
+		A->SetPropertyValue(TEXT("AIState"), TEXT("Chase"));
+		A->SetFloatValue(TEXT("HP"), 10.f);
+		A->LoadBehaviorTree(Tree);
+		return Tree;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacPredicateCache_Registry,
+	"BehaviacPlugin.PredicateCache.Registry",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacPredicateCache_Registry::RunTest(const FString&)
+{
+	auto Resolve = [](const TCHAR* Left, EBehaviacOperatorType Op, const TCHAR* Right)
+	{
+		FBehaviacComparison Comparison;
+		Comparison.Resolve(Left, EBehaviacOperandMode::PropertyOrMethod, Right, EBehaviacOperandMode::PropertyOrMethod, Op);
+		return Comparison.PredicateId;
+	};
+
+	const int32 Chase = Resolve(TEXT("Self.AIState"), EBehaviacOperatorType::Equal, TEXT("Chase"));
+	TestTrue(TEXT("Resolved comparisons get an id"), Chase != INDEX_NONE);
+	TestEqual(TEXT("Same predicate, same id"), Resolve(TEXT("Self.AIState"), EBehaviacOperatorType::Equal, TEXT("Chase")), Chase);
+	TestNotEqual(TEXT("Constants are case-sensitive"), Resolve(TEXT("Self.AIState"), EBehaviacOperatorType::Equal, TEXT("chase")), Chase);
+	TestNotEqual(TEXT("Operator is part of the predicate"), Resolve(TEXT("Self.AIState"), EBehaviacOperatorType::NotEqual, TEXT("Chase")), Chase);
+	TestNotEqual(TEXT("Operand order matters"), Resolve(TEXT("Chase"), EBehaviacOperatorType::Equal, TEXT("Self.AIState")), Chase);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Sharing within a tick
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacPredicateCache_SharesWithinTick,
+	"BehaviacPlugin.PredicateCache.SharesWithinTick",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacPredicateCache_SharesWithinTick::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacCondition* First = nullptr;
+	UBehaviacCondition* Unique = nullptr;
+	UBehaviacBehaviorTree* Tree = LoadChaseTree(A, First, Unique);
+
+	TestEqual(TEXT("One shared predicate"), Tree->GetCompiledTree()->GetNumSharedPredicates(), 1);
+	TestTrue(TEXT("Repeated condition memoized"), First->GetComparison().IsMemoized());
+	TestFalse(TEXT("Single condition evaluated directly"), Unique->GetComparison().IsMemoized());
+
+	TestEqual(TEXT("First tick succeeds"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	FBehaviacPredicateCacheStats Stats = A->GetPredicateCacheStats();
+	TestEqual(TEXT("First occurrence evaluates"), Stats.Misses, (int64)1);
+	TestEqual(TEXT("Second occurrence reuses it"), Stats.Hits, (int64)1);
+	TestEqual(TEXT("Half the lookups hit"), Stats.HitRate, 0.5f);
+
+	// A new tick starts with nothing memoized
+	A->TickBehaviorTree();
+	Stats = A->GetPredicateCacheStats();
+	TestEqual(TEXT("Misses once per tick"), Stats.Misses, (int64)2);
+	TestEqual(TEXT("Hits once per tick"), Stats.Hits, (int64)2);
+
+	// Switched off, every occurrence evaluates
+	const int32 Previous = CVarBehaviacPredicateCache.GetValueOnGameThread();
+	CVarBehaviacPredicateCache->Set(0);
+	A->TickBehaviorTree();
+	CVarBehaviacPredicateCache->Set(Previous);
+	TestEqual(TEXT("Disabled cache not consulted"), A->GetPredicateCacheStats().Hits + A->GetPredicateCacheStats().Misses, (int64)4);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Invalidation
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacPredicateCache_InvalidatesOnWrite,
+	"BehaviacPlugin.PredicateCache.InvalidatesOnWrite",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacPredicateCache_InvalidatesOnWrite::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacCondition* First = nullptr;
+	UBehaviacCondition* Unique = nullptr;
+	LoadChaseTree(A, First, Unique);
+
+	// Writing a key the predicate does not read keeps the result
+	FName WrittenKey = TEXT("Target");
+	A->RegisterMethodHandler(TEXT("PredicateCacheStep"), [A, &WrittenKey]()
+	{
+		A->SetPropertyValue(WrittenKey.ToString(), TEXT("Flee"));
+		return EBehaviacStatus::Success;
+	});
+	TestEqual(TEXT("Unrelated write"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Result reused"), A->GetPredicateCacheStats().Hits, (int64)1);
+
+	// Writing the key it reads drops the result mid-tick
+	WrittenKey = TEXT("AIState");
+	TestEqual(TEXT("Second check sees the write"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	const FBehaviacPredicateCacheStats Stats = A->GetPredicateCacheStats();
+	TestEqual(TEXT("No new hit"), Stats.Hits, (int64)1);
+	TestEqual(TEXT("Invalidated once"), Stats.Invalidations, (int64)1);
+	return true;
+}
@@ -0,0 +1,515 @@
+// Behaviac UE5 Plugin — Tick Manager Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TickManager
+//
+// The manager is created outside a world here, so its tick functions are not
+// registered and groups are ticked by hand with TickManagedGroup().
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviacTickManager.h"
+
+/** Tree asset whose root is an action counting its calls in Counter. */
+static UBehaviacBehaviorTree* TM_MakeCountingTree(UBehaviacAgentComponent* Agent, const FString& MethodName, int32& Counter)
+{
+	UBehaviacAction* Root = NewObject<UBehaviacAction>(GetTransientPackage());
+	Root->MethodName = MethodName;
+	Root->ResultOption = EBehaviacStatus::Running;
+	Agent->RegisterMethodHandler(MethodName, [&Counter]() -> EBehaviacStatus
+	{
+		++Counter;
+		return EBehaviacStatus::Running;
+	});
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = Root;
+	return Tree;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_TicksRegisteredAgents,
+	"BehaviacPlugin.TickManager.TicksRegisteredAgents",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_TicksRegisteredAgents::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+
+	int32 CountA = 0, CountB = 0, CountC = 0;
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	UBehaviacAgentComponent* C = BT_MakeAgent();
+	UBehaviacBehaviorTree* SharedTree = TM_MakeCountingTree(A, TEXT("TickA"), CountA);
+	A->LoadBehaviorTree(SharedTree);
+	B->RegisterMethodHandler(TEXT("TickA"), [&CountB]() { ++CountB; return EBehaviacStatus::Running; });
+	B->LoadBehaviorTree(SharedTree);
+	C->LoadBehaviorTree(TM_MakeCountingTree(C, TEXT("TickC"), CountC));
+
+	Manager->RegisterAgent(A);
+	Manager->RegisterAgent(B);
+	Manager->RegisterAgent(C);
+
+	TestTrue(TEXT("A is managed"), A->IsTickManaged());
+	TestFalse(TEXT("Managed agent's component tick is off"), A->IsComponentTickEnabled());
+
+	FBehaviacTickManagerStats Stats = Manager->GetStats();
+	TestEqual(TEXT("3 agents"), Stats.NumAgents, 3);
+	TestEqual(TEXT("2 buckets (one per tree asset)"), Stats.NumBuckets, 2);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("A ticked twice"), CountA, 2);
+	TestEqual(TEXT("B ticked twice"), CountB, 2);
+	TestEqual(TEXT("C ticked twice"), CountC, 2);
+	TestEqual(TEXT("Stats: 3 ticked last frame"), Manager->GetStats().NumTicked, 3);
+
+	// Other groups do not tick these agents
+	Manager->TickManagedGroup(TG_PostPhysics, 0.016f);
+	TestEqual(TEXT("PostPhysics leaves A alone"), CountA, 2);
+
+	Manager->UnregisterAgent(C);
+	TestFalse(TEXT("C no longer managed"), C->IsTickManaged());
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Unregistered C not ticked"), CountC, 2);
+	TestEqual(TEXT("A still ticked"), CountA, 3);
+	TestEqual(TEXT("1 bucket left"), Manager->GetStats().NumBuckets, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_TreeChangeRebuckets,
+	"BehaviacPlugin.TickManager.TreeChangeRebuckets",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_TreeChangeRebuckets::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+
+	int32 CountA = 0, CountB = 0;
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacBehaviorTree* TreeA = TM_MakeCountingTree(A, TEXT("TreeA"), CountA);
+	UBehaviacBehaviorTree* TreeB = TM_MakeCountingTree(A, TEXT("TreeB"), CountB);
+
+	// Registered before any tree is loaded, then switches trees
+	Manager->RegisterAgent(A);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("No tree → nothing ticked"), Manager->GetStats().NumTicked, 0);
+
+	A->LoadBehaviorTree(TreeA);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("TreeA ticked"), CountA, 1);
+
+	A->LoadBehaviorTree(TreeB);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("TreeA not ticked after switch"), CountA, 1);
+	TestEqual(TEXT("TreeB ticked"), CountB, 1);
+	TestEqual(TEXT("Agent counted once"), Manager->GetStats().NumAgents, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_FrameBudgetRoundRobin,
+	"BehaviacPlugin.TickManager.FrameBudgetRoundRobin",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_FrameBudgetRoundRobin::RunTest(const FString&)
+{
+	// A budget too small for more than one agent per frame: every agent must
+	// still be ticked exactly once over three frames.
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.000001f);
+
+	int32 Counts[3] = { 0, 0, 0 };
+	for (int32 i = 0; i < 3; ++i)
+	{
+		UBehaviacAgentComponent* Agent = BT_MakeAgent();
+		Agent->LoadBehaviorTree(TM_MakeCountingTree(Agent, FString::Printf(TEXT("Budget%d"), i), Counts[i]));
+		Manager->RegisterAgent(Agent);
+	}
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("One agent per frame"), Manager->GetStats().NumTicked, 1);
+	TestEqual(TEXT("Two deferred"), Manager->GetStats().NumDeferred, 2);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Agent 0 ticked once"), Counts[0], 1);
+	TestEqual(TEXT("Agent 1 ticked once"), Counts[1], 1);
+	TestEqual(TEXT("Agent 2 ticked once"), Counts[2], 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_FrameBudgetSurvivesCompaction,
+	"BehaviacPlugin.TickManager.FrameBudgetSurvivesCompaction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_FrameBudgetSurvivesCompaction::RunTest(const FString&)
+{
+	// One agent per frame; the second unregisters itself while it is ticked,
+	// emptying its bucket. The walk must go on with the third, not restart.
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.000001f);
+
+	int32 Counts[3] = { 0, 0, 0 };
+	UBehaviacAgentComponent* Agents[3];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		Agents[i] = BT_MakeAgent();
+		Agents[i]->LoadBehaviorTree(TM_MakeCountingTree(Agents[i], FString::Printf(TEXT("Compact%d"), i), Counts[i]));
+		Manager->RegisterAgent(Agents[i]);
+	}
+	UBehaviacAgentComponent* Leaving = Agents[1];
+	Leaving->RegisterMethodHandler(TEXT("Compact1"), [Manager, Leaving, &Counts]() -> EBehaviacStatus
+	{
+		++Counts[1];
+		Manager->UnregisterAgent(Leaving);
+		return EBehaviacStatus::Running;
+	});
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Bucket of the leaving agent removed"), Manager->GetStats().NumBuckets, 2);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Agent 0 ticked once"), Counts[0], 1);
+	TestEqual(TEXT("Agent 1 ticked once"), Counts[1], 1);
+	TestEqual(TEXT("Agent 2 reached after the compaction"), Counts[2], 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_DestroyedAgentLeaves,
+	"BehaviacPlugin.TickManager.DestroyedAgentLeaves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_DestroyedAgentLeaves::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+
+	int32 CountKept = 0, CountGone = 0;
+	UBehaviacAgentComponent* Kept = BT_MakeAgent();
+	UBehaviacAgentComponent* Gone = BT_MakeAgent();
+	UBehaviacBehaviorTree* Tree = TM_MakeCountingTree(Kept, TEXT("DestroyedShared"), CountKept);
+	Gone->RegisterMethodHandler(TEXT("DestroyedShared"), [&CountGone]() { ++CountGone; return EBehaviacStatus::Running; });
+	Kept->LoadBehaviorTree(Tree);
+	Gone->LoadBehaviorTree(Tree);
+	Manager->RegisterAgent(Gone);
+	Manager->RegisterAgent(Kept);
+
+	// Destroying the component takes it out of the manager, not just EndPlay
+	Gone->DestroyComponent();
+	TestFalse(TEXT("Destroyed agent unregistered"), Manager->IsAgentRegistered(Gone));
+	TestEqual(TEXT("One agent left"), Manager->GetStats().NumAgents, 1);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Remaining agent ticked"), CountKept, 1);
+	TestEqual(TEXT("Destroyed agent not ticked"), CountGone, 0);
+	return true;
+}
+
+// ------------------------------------------------------------------
+// Tick LOD
+// ------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_LODSkipsFarTiers,
+	"BehaviacPlugin.TickManager.LODSkipsFarTiers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_LODSkipsFarTiers::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+
+	int32 CountNear = 0, CountFar = 0, CountOff = 0;
+	UBehaviacAgentComponent* Near = BT_MakeAgent();
+	UBehaviacAgentComponent* Far = BT_MakeAgent();
+	UBehaviacAgentComponent* Off = BT_MakeAgent();
+	Near->LoadBehaviorTree(TM_MakeCountingTree(Near, TEXT("LODNear"), CountNear));
+	Far->LoadBehaviorTree(TM_MakeCountingTree(Far, TEXT("LODFar"), CountFar));
+	Off->LoadBehaviorTree(TM_MakeCountingTree(Off, TEXT("LODOff"), CountOff));
+
+	// Default tiers: 0 = every frame, 2 = once a second
+	Near->bEnableTickLOD = true;
+	Near->ForcedLODTier = 0;
+	Far->bEnableTickLOD = true;
+	Far->ForcedLODTier = 2;
+
+	Manager->RegisterAgent(Near);
+	Manager->RegisterAgent(Far);
+	Manager->RegisterAgent(Off);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Tier 0 ticks every frame"), CountNear, 2);
+	TestEqual(TEXT("Tier 2 ticks once, then waits for its interval"), CountFar, 1);
+	TestEqual(TEXT("LOD disabled ticks every frame"), CountOff, 2);
+
+	const FBehaviacTickManagerStats Stats = Manager->GetStats();
+	TestEqual(TEXT("One agent skipped by LOD"), Stats.NumSkippedByLOD, 1);
+	TestEqual(TEXT("Two agents ticked"), Stats.NumTicked, 2);
+	TestEqual(TEXT("Tier counts cover tiers 0..2"), Stats.AgentsPerLODTier.Num(), 3);
+	if (Stats.AgentsPerLODTier.Num() == 3)
+	{
+		TestEqual(TEXT("One agent in tier 0"), Stats.AgentsPerLODTier[0], 1);
+		TestEqual(TEXT("None in tier 1"), Stats.AgentsPerLODTier[1], 0);
+		TestEqual(TEXT("One agent in tier 2"), Stats.AgentsPerLODTier[2], 1);
+	}
+
+	// A tick request overrides the interval
+	Far->RequestTickAt(Far->GetTimeSeconds());
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Requested tick runs"), CountFar, 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_LODCountsComponentTicked,
+	"BehaviacPlugin.TickManager.LODCountsComponentTicked",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_LODCountsComponentTicked::RunTest(const FString&)
+{
+	// Agents ticked by their component never reach the manager; their tiers still count
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	const TArray<int32> Before = Manager->GetStats().AgentsPerLODTier;
+	const int32 TierBefore = Before.IsValidIndex(1) ? Before[1] : 0;
+
+	UBehaviacAgentComponent* Agent = BT_MakeAgent();
+	Agent->bEnableTickLOD = true;
+	Agent->ForcedLODTier = 1;
+	Agent->ShouldTickForLOD(Agent->GetTimeSeconds(), TArray<FVector>());
+	Agent->ShouldTickForLOD(Agent->GetTimeSeconds(), TArray<FVector>());
+
+	const TArray<int32> After = Manager->GetStats().AgentsPerLODTier;
+	TestTrue(TEXT("Tier 1 is counted"), After.IsValidIndex(1));
+	if (After.IsValidIndex(1))
+	{
+		TestEqual(TEXT("Counted once however often it is checked"), After[1], TierBefore + 1);
+	}
+	TestFalse(TEXT("Manager does not tick it"), Manager->IsAgentRegistered(Agent));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_LODWaitDeadline,
+	"BehaviacPlugin.TickManager.LODWaitDeadline",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_LODWaitDeadline::RunTest(const FString&)
+{
+	// A Wait under a long LOD interval must still get a tick when it expires
+	UBehaviacAgentComponent* Agent = BT_MakeAgent();
+	Agent->bEnableTickLOD = true;
+	Agent->LODTiers = { FBehaviacLODTier(0.f, 100.f) };
+	Agent->ForcedLODTier = 0;
+
+	UBehaviacWait* Wait = NewObject<UBehaviacWait>(GetTransientPackage());
+	Wait->Duration = 5.f;
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = Wait;
+	Agent->LoadBehaviorTree(Tree);
+
+	const TArray<FVector> NoViewers;
+	TestTrue(TEXT("First check after load ticks"), Agent->ShouldTickForLOD(Agent->GetTimeSeconds(), NoViewers));
+	Agent->TickBehaviorTree();
+	const double Entered = Agent->GetTimeSeconds();
+
+	TestFalse(TEXT("Mid-wait frame is skipped"), Agent->ShouldTickForLOD(Entered + 1.0, NoViewers));
+	TestTrue(TEXT("Frame at the deadline ticks"), Agent->ShouldTickForLOD(Entered + 5.0, NoViewers));
+	TestFalse(TEXT("Request consumed"), Agent->ShouldTickForLOD(Entered + 6.0, NoViewers));
+	return true;
+}
+
+// ------------------------------------------------------------------
+// Sleeping
+// ------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_SleepingAgentsLeaveTickSet,
+	"BehaviacPlugin.TickManager.SleepingAgentsLeaveTickSet",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_SleepingAgentsLeaveTickSet::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+
+	// Signal sleeper: WaitForSignal, then a counting action
+	int32 SignalCount = 0;
+	UBehaviacAgentComponent* SignalAgent = BT_MakeAgent();
+	UBehaviacWaitForSignal* WaitSignal = NewObject<UBehaviacWaitForSignal>(GetTransientPackage());
+	WaitSignal->SignalName = TEXT("Wake");
+	UBehaviacBehaviorTree* SignalTree = TM_MakeCountingTree(SignalAgent, TEXT("AfterSignal"), SignalCount);
+	SignalTree->RootNode = BT_MakeSequence({ WaitSignal, SignalTree->RootNode });
+	SignalAgent->LoadBehaviorTree(SignalTree);
+
+	// Timer sleeper: a short Wait, then a counting action
+	int32 TimerCount = 0;
+	UBehaviacAgentComponent* TimerAgent = BT_MakeAgent();
+	UBehaviacWait* Wait = NewObject<UBehaviacWait>(GetTransientPackage());
+	Wait->Duration = 0.2f;
+	UBehaviacBehaviorTree* TimerTree = TM_MakeCountingTree(TimerAgent, TEXT("AfterTimer"), TimerCount);
+	TimerTree->RootNode = BT_MakeSequence({ Wait, TimerTree->RootNode });
+	TimerAgent->LoadBehaviorTree(TimerTree);
+
+	Manager->RegisterAgent(SignalAgent);
+	Manager->RegisterAgent(TimerAgent);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestTrue(TEXT("Signal agent asleep"), SignalAgent->IsSleeping());
+	TestTrue(TEXT("Timer agent asleep"), TimerAgent->IsSleeping());
+	TestEqual(TEXT("Stats: 2 sleeping"), Manager->GetStats().NumSleeping, 2);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("Sleeping agents are not ticked"), Manager->GetStats().NumTicked, 0);
+
+	TestEqual(TEXT("Broadcast to another tree signals nobody"), Manager->BroadcastSignal(TEXT("Wake"), NewObject<UBehaviacBehaviorTree>(GetTransientPackage())), 0);
+	TestTrue(TEXT("Signal agent still asleep"), SignalAgent->IsSleeping());
+	TestEqual(TEXT("Broadcast to its tree reaches the sleeper"), Manager->BroadcastSignal(TEXT("Wake"), SignalTree), 1);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestFalse(TEXT("Signal woke its agent"), SignalAgent->IsSleeping());
+	TestEqual(TEXT("Woken agent ticked past the wait"), SignalCount, 1);
+	TestTrue(TEXT("Timer agent still asleep"), TimerAgent->IsSleeping());
+
+	FPlatformProcess::Sleep(0.3f);
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestFalse(TEXT("Deadline woke the timer agent"), TimerAgent->IsSleeping());
+	TestEqual(TEXT("Timer agent ticked past the wait"), TimerCount, 1);
+	TestEqual(TEXT("Stats: none sleeping"), Manager->GetStats().NumSleeping, 0);
+	return true;
+}
+
+// ------------------------------------------------------------------
+// Parallel ticking
+// ------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_ParallelKeepsUnsafeOnGameThread,
+	"BehaviacPlugin.TickManager.ParallelKeepsUnsafeOnGameThread",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_ParallelKeepsUnsafeOnGameThread::RunTest(const FString&)
+{
+	UBehaviacTickManager* Manager = NewObject<UBehaviacTickManager>(GetTransientPackage());
+	Manager->SetFrameBudgetMs(0.f);
+	Manager->SetUseParallelTicking(true);
+
+	// Thread-safe: keeps running and hands its engine work to the game thread
+	int32 SafeCalls = 0, SafeCallsInParallel = 0, Commands = 0;
+	bool bCommandRanInParallel = false;
+	auto RegisterSafe = [&SafeCalls, &SafeCallsInParallel, &Commands, &bCommandRanInParallel](UBehaviacAgentComponent* Agent)
+	{
+		Agent->RegisterMethodHandler(TEXT("Safe"), [Agent, &SafeCalls, &SafeCallsInParallel, &Commands, &bCommandRanInParallel]()
+		{
+			++SafeCalls;
+			SafeCallsInParallel += Agent->IsTickingInParallel() ? 1 : 0;
+			Agent->EnqueueGameThreadCommand([Agent, &Commands, &bCommandRanInParallel]()
+			{
+				++Commands;
+				bCommandRanInParallel |= Agent->IsTickingInParallel();
+			});
+			return EBehaviacStatus::Running;
+		}, true);
+	};
+
+	UBehaviacAction* Unsafe = NewObject<UBehaviacAction>(GetTransientPackage());
+	Unsafe->MethodName = TEXT("Unsafe");
+	Unsafe->ResultOption = EBehaviacStatus::Running;
+	UBehaviacAction* Safe = NewObject<UBehaviacAction>(GetTransientPackage());
+	Safe->MethodName = TEXT("Safe");
+	Safe->ResultOption = EBehaviacStatus::Running;
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSequence({ Unsafe, Safe });
+
+	// A: has a handler that must only ever run on the game thread
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	A->bTickInParallel = true;
+	int32 UnsafeCalls = 0;
+	bool bUnsafeRanInParallel = false;
+	A->RegisterMethodHandler(TEXT("Unsafe"), [A, &UnsafeCalls, &bUnsafeRanInParallel]()
+	{
+		++UnsafeCalls;
+		bUnsafeRanInParallel |= A->IsTickingInParallel();
+		return EBehaviacStatus::Success;
+	});
+	RegisterSafe(A);
+	A->LoadBehaviorTree(Tree);
+	Manager->RegisterAgent(A);
+
+	// A ticks on the game thread, and Unsafe answers in the tick that calls it
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("A not ticked in parallel"), Manager->GetStats().NumTickedInParallel, 0);
+	TestEqual(TEXT("Unsafe called once"), UnsafeCalls, 1);
+	TestEqual(TEXT("Its Success reached Safe in the same tick"), SafeCalls, 1);
+	TestEqual(TEXT("Command ran immediately"), Commands, 1);
+	Manager->UnregisterAgent(A);
+
+	// B: only thread-safe handlers, so it ticks on a worker and its commands wait
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+	B->bTickInParallel = true;
+	B->RegisterMethodHandler(TEXT("Unsafe"), []() { return EBehaviacStatus::Success; }, true);
+	RegisterSafe(B);
+	B->LoadBehaviorTree(Tree);
+	Manager->RegisterAgent(B);
+
+	Manager->TickManagedGroup(TG_PrePhysics, 0.016f);
+	TestEqual(TEXT("B ticked in parallel"), Manager->GetStats().NumTickedInParallel, 1);
+	TestEqual(TEXT("Safe called in parallel"), SafeCallsInParallel, 1);
+	TestEqual(TEXT("Buffered command ran after the phase"), Commands, 2);
+
+	TestFalse(TEXT("Unsafe handler never ran in parallel"), bUnsafeRanInParallel);
+	TestFalse(TEXT("Commands never ran in parallel"), bCommandRanInParallel);
+	TestTrue(TEXT("Trees still running"), A->GetBehaviorTreeStatus() == EBehaviacStatus::Running && B->GetBehaviorTreeStatus() == EBehaviacStatus::Running);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTickManager_ParallelMatchesSerial,
+	"BehaviacPlugin.TickManager.ParallelMatchesSerial",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTickManager_ParallelMatchesSerial::RunTest(const FString&)
+{
+	// Selector(Sequence(Self.CanAct == true, Work), Idle): CanAct is a method read
+	// through the property fallback, Work runs every other call
+	UBehaviacAction* Work = NewObject<UBehaviacAction>(GetTransientPackage());
+	Work->MethodName = TEXT("Work");
+	Work->ResultOption = EBehaviacStatus::Running;
+	UBehaviacAction* Idle = NewObject<UBehaviacAction>(GetTransientPackage());
+	Idle->MethodName = TEXT("Idle");
+	Idle->ResultOption = EBehaviacStatus::Running;
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Tree->RootNode = BT_MakeSelector({
+		BT_MakeSequence({ BT_MakeCondition(TEXT("Self.CanAct"), EBehaviacOperatorType::Equal, TEXT("true")), Work }),
+		Idle });
+
+	for (const bool bThreadSafe : { false, true })
+	{
+		UBehaviacTickManager* Parallel = NewObject<UBehaviacTickManager>(GetTransientPackage());
+		Parallel->SetFrameBudgetMs(0.f);
+		Parallel->SetUseParallelTicking(true);
+		UBehaviacTickManager* Serial = NewObject<UBehaviacTickManager>(GetTransientPackage());
+		Serial->SetFrameBudgetMs(0.f);
+		Serial->SetUseParallelTicking(false);
+
+		int32 Calls[2] = { 0, 0 };
+		UBehaviacAgentComponent* Agents[2] = { BT_MakeAgent(), BT_MakeAgent() };
+		for (int32 Index = 0; Index < 2; ++Index)
+		{
+			int32& AgentCalls = Calls[Index];
+			Agents[Index]->bTickInParallel = true;
+			Agents[Index]->RegisterMethodHandler(TEXT("CanAct"), [&AgentCalls]() { return AgentCalls < 3 ? EBehaviacStatus::Success : EBehaviacStatus::Failure; }, bThreadSafe);
+			Agents[Index]->RegisterMethodHandler(TEXT("Work"), [&AgentCalls]() { return ++AgentCalls % 2 ? EBehaviacStatus::Running : EBehaviacStatus::Success; }, true);
+			Agents[Index]->RegisterMethodHandler(TEXT("Idle"), []() { return EBehaviacStatus::Success; }, true);
+			Agents[Index]->LoadBehaviorTree(Tree);
+		}
+		Parallel->RegisterAgent(Agents[0]);
+		Serial->RegisterAgent(Agents[1]);
+
+		for (int32 Tick = 0; Tick < 6; ++Tick)
+		{
+			Parallel->TickManagedGroup(TG_PrePhysics, 0.016f);
+			Serial->TickManagedGroup(TG_PrePhysics, 0.016f);
+			TestTrue(FString::Printf(TEXT("%s handlers, tick %d: same status"), bThreadSafe ? TEXT("Safe") : TEXT("Unsafe"), Tick),
+				Agents[0]->GetBehaviorTreeStatus() == Agents[1]->GetBehaviorTreeStatus());
+		}
+		TestEqual(TEXT("Work called as often"), Calls[0], Calls[1]);
+		TestEqual(TEXT("Ticked in parallel only with thread-safe handlers"), Parallel->GetStats().NumTickedInParallel, bThreadSafe ? 1 : 0);
+	}
+	return true;
+}
@@ -0,0 +1,208 @@
+// Behaviac UE5 Plugin — Timer Wheel Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.Timers
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviacTimerWheel.h"
+#include "BehaviacTimerManager.h"
+#include "Async/Async.h"
+
+// ---------------------------------------------------------------------------
+// Add / cancel / fire
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_AddCancelFire,
+	"BehaviacPlugin.Timers.AddCancelFire",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_AddCancelFire::RunTest(const FString&)
+{
+	FBehaviacTimerWheel Wheel;
+	Wheel.Advance(0, 0.0);
+
+	FBehaviacTimerHandle Kept = Wheel.Add(10, 10.0);
+	FBehaviacTimerHandle Cancelled = Wheel.Add(10, 10.0);
+	TestEqual(TEXT("Two pending"), Wheel.NumPending(), 2);
+
+	Wheel.Remove(Cancelled);
+	TestFalse(TEXT("Removed handle is invalidated"), Cancelled.IsValid());
+	TestEqual(TEXT("One pending after cancel"), Wheel.NumPending(), 1);
+
+	Wheel.Advance(9, 9.0);
+	TestFalse(TEXT("Not fired before its tick"), Wheel.HasFired(Kept));
+
+	Wheel.Advance(10, 10.0);
+	TestTrue(TEXT("Fired on its tick"), Wheel.HasFired(Kept));
+	TestEqual(TEXT("Nothing pending"), Wheel.NumPending(), 0);
+
+	// Flag timers stay fired until removed; the slot is then reused under a new serial
+	Wheel.Remove(Kept);
+	FBehaviacTimerHandle Reused = Wheel.Add(20, 20.0);
+	TestEqual(TEXT("Slot reused"), Reused.Index, 0);
+	TestFalse(TEXT("Stale handle does not see the new timer"), Wheel.IsPending(Kept));
+	TestTrue(TEXT("New timer pending"), Wheel.IsPending(Reused));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Exact deadline within a tick
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_ExactDeadline,
+	"BehaviacPlugin.Timers.ExactDeadline",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_ExactDeadline::RunTest(const FString&)
+{
+	FBehaviacTimerWheel Wheel;
+	Wheel.Advance(0, 0.0);
+
+	FBehaviacTimerHandle Handle = Wheel.Add(5, 5.5);
+	Wheel.Advance(5, 5.2);
+	TestFalse(TEXT("Same tick, deadline not reached"), Wheel.HasFired(Handle));
+	Wheel.Advance(5, 5.5);
+	TestTrue(TEXT("Fires at its exact deadline"), Wheel.HasFired(Handle));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Long delays cascade down the levels; callbacks fire once
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_CascadeAndCallbacks,
+	"BehaviacPlugin.Timers.CascadeAndCallbacks",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_CascadeAndCallbacks::RunTest(const FString&)
+{
+	FBehaviacTimerWheel Wheel;
+	Wheel.Advance(3, 3.0);
+
+	TArray<uint64> FiredAt;
+	const uint64 Deadlines[] = { 70, 4100, 263000, 300000 };
+	for (uint64 Deadline : Deadlines)
+	{
+		Wheel.Add(Deadline, (double)Deadline, [&FiredAt, &Wheel]() { FiredAt.Add(Wheel.GetCurrentTick()); });
+	}
+	FBehaviacTimerHandle Overflow = Wheel.Add(uint64(1) << 32, (double)(uint64(1) << 32));
+
+	// Advance in uneven steps; every timer must fire on the step that reaches it
+	uint64 Now = 3;
+	for (uint64 Step : { 50ull, 17ull, 4000ull, 1ull, 258880ull, 37100ull })
+	{
+		Now += Step;
+		const int32 Before = FiredAt.Num();
+		Wheel.Advance(Now, (double)Now);
+		for (int32 Index = Before; Index < FiredAt.Num(); ++Index)
+		{
+			TestEqual(TEXT("Fired on the advancing step"), FiredAt[Index], Now);
+		}
+	}
+
+	TestEqual(TEXT("All four callbacks ran once"), FiredAt.Num(), 4);
+	TestTrue(TEXT("Far timer still pending"), Wheel.IsPending(Overflow));
+	TestEqual(TEXT("Callback timers released"), Wheel.NumAllocated(), 1);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Advancing skips empty stretches and matches stepping one tick at a time
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_SkipMatchesStepping,
+	"BehaviacPlugin.Timers.SkipMatchesStepping",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_SkipMatchesStepping::RunTest(const FString&)
+{
+	FBehaviacTimerWheel Jumping;
+	FBehaviacTimerWheel Stepping;
+	Jumping.Advance(5, 5.0);
+	Stepping.Advance(5, 5.0);
+
+	FRandomStream Random(7);
+	TArray<FBehaviacTimerHandle> JumpingHandles;
+	TArray<FBehaviacTimerHandle> SteppingHandles;
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		const uint64 Deadline = 5 + (uint64)Random.RandRange(1, 1 << (Index % 20));
+		JumpingHandles.Add(Jumping.Add(Deadline, (double)Deadline));
+		SteppingHandles.Add(Stepping.Add(Deadline, (double)Deadline));
+	}
+
+	// One call covering the whole range, against every tick in turn
+	const uint64 End = 5 + (1 << 19);
+	Jumping.Advance(End / 3, (double)(End / 3));
+	for (uint64 Tick = 6; Tick <= End / 3; ++Tick)
+	{
+		Stepping.Advance(Tick, (double)Tick);
+	}
+
+	bool bSame = Jumping.NumPending() == Stepping.NumPending();
+	for (int32 Index = 0; Index < JumpingHandles.Num(); ++Index)
+	{
+		bSame &= Jumping.HasFired(JumpingHandles[Index]) == Stepping.HasFired(SteppingHandles[Index]);
+	}
+	TestTrue(TEXT("Same timers fired"), bSame);
+	TestTrue(TEXT("Some fired, some still pending"), Jumping.NumPending() > 0 && Jumping.NumPending() < JumpingHandles.Num());
+
+	Jumping.Advance(End, (double)End);
+	TestEqual(TEXT("All fired by the end"), Jumping.NumPending(), 0);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Callbacks run outside the timer lock
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_CallbacksOutsideLock,
+	"BehaviacPlugin.Timers.CallbacksOutsideLock",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_CallbacksOutsideLock::RunTest(const FString&)
+{
+	FBehaviacTimers Timers;
+	Timers.AdvanceTimers();
+
+	// A worker using the timers while a callback runs must not wait for the callback
+	bool bWorkerFinished = false;
+	Timers.SetTimerAt(Timers.GetTimeSeconds(), [&Timers, &bWorkerFinished]()
+	{
+		TFuture<int32> Worker = Async(EAsyncExecution::ThreadPool, [&Timers]() { return Timers.GetNumPendingTimers(); });
+		bWorkerFinished = Worker.WaitFor(FTimespan::FromSeconds(5.0));
+	});
+	Timers.AdvanceTimers();
+	TestTrue(TEXT("Worker got the lock during the callback"), bWorkerFinished);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Reset cancels a running Wait's timer
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTimers_WaitResetCancels,
+	"BehaviacPlugin.Timers.WaitResetCancels",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTimers_WaitResetCancels::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	FBehaviacTimers& Timers = UBehaviacTimerManager::Get(A);
+	const int32 PendingBefore = Timers.GetNumPendingTimers();
+
+	UBehaviacWait* Wait = NewObject<UBehaviacWait>(GetTransientPackage());
+	Wait->Duration = 100.f;
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(Wait);
+
+	TestEqual(TEXT("Wait is running"), Tree->Tick(A), EBehaviacStatus::Running);
+	TestEqual(TEXT("Wait registered one timer"), Timers.GetNumPendingTimers(), PendingBefore + 1);
+
+	Tree->Tick(A);
+	TestEqual(TEXT("Re-ticking does not add timers"), Timers.GetNumPendingTimers(), PendingBefore + 1);
+
+	Tree->Reset(A);
+	TestEqual(TEXT("Reset cancelled the timer"), Timers.GetNumPendingTimers(), PendingBefore);
+	return true;
+}
@@ -0,0 +1,170 @@
+// Behaviac UE5 Plugin — Async Tree Loading Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TreeAsyncLoader
+//
+// Completions are queued for the game thread, which these tests pump by hand
+// until the loader has nothing in flight.
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacTreeAsyncLoader.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+
+namespace
+{
+	FString WriteAsyncTestTree(const TCHAR* Name, const TCHAR* Method)
+	{
+		const FString File = FPaths::ProjectSavedDir() / TEXT("Automation") / Name;
+		FFileHelper::SaveStringToFile(FString::Printf(
+			TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+				"<behavior agenttype=\"TestAgent\" version=\"5\">"
+				"  <node class=\"Action\" id=\"1\">"
+				"    <property name=\"Method\" value=\"%s\"/>"
+				"    <property name=\"ResultOption\" value=\"BT_RUNNING\"/>"
+				"  </node>"
+				"</behavior>"), Method), *File);
+		FBehaviacTreeFileCache::Get().Invalidate(FBehaviacTreeBinary::ChooseFile(File));
+		return File;
+	}
+
+	/** Run game thread work until every load has been delivered, or give up after a few seconds */
+	bool PumpUntilLoaded()
+	{
+		const double GiveUpTime = FPlatformTime::Seconds() + 5.0;
+		while (FBehaviacTreeAsyncLoader::Get().NumInFlight() > 0)
+		{
+			if (FPlatformTime::Seconds() > GiveUpTime)
+			{
+				return false;
+			}
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Requests for the same file share one load
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeAsyncLoader_SharesInFlightLoads,
+	"BehaviacPlugin.TreeAsyncLoader.SharesInFlightLoads",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeAsyncLoader_SharesInFlightLoads::RunTest(const FString&)
+{
+	const FString File = WriteAsyncTestTree(TEXT("TreeAsyncShared.xml"), TEXT("AsyncShared"));
+	FBehaviacTreeAsyncLoader& Loader = FBehaviacTreeAsyncLoader::Get();
+
+	UBehaviacBehaviorTree* First = nullptr;
+	UBehaviacBehaviorTree* Second = nullptr;
+	bool bAllOnGameThread = true;
+	auto Capture = [&bAllOnGameThread](UBehaviacBehaviorTree*& Out)
+	{
+		return FBehaviacTreeLoadedDelegate::CreateLambda([&Out, &bAllOnGameThread](UBehaviacBehaviorTree* Tree)
+		{
+			bAllOnGameThread &= IsInGameThread();
+			Out = Tree;
+		});
+	};
+
+	Loader.LoadFile(File, Capture(First));
+	Loader.LoadFile(File, Capture(Second));
+	TestEqual(TEXT("One load in flight"), Loader.NumInFlight(), 1);
+	TestNull(TEXT("Not delivered before the game thread runs"), First);
+
+	if (!TestTrue(TEXT("Load finished"), PumpUntilLoaded())) return false;
+	if (!TestNotNull(TEXT("Tree delivered"), First)) return false;
+	TestTrue(TEXT("Both requests got the one tree"), First == Second);
+	TestTrue(TEXT("Delivered on the game thread"), bAllOnGameThread);
+	TestNotNull(TEXT("Nodes built"), First->RootNode);
+
+	// Now cached: answered right away, and shared with synchronous loads
+	UBehaviacBehaviorTree* Cached = nullptr;
+	Loader.LoadFile(File, Capture(Cached));
+	TestTrue(TEXT("Cached tree delivered at once"), Cached == First);
+	TestTrue(TEXT("Same tree as a synchronous load"), UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, File) == First);
+
+	// A missing file completes with nullptr
+	AddExpectedError(TEXT("Failed to load behavior tree from file"), EAutomationExpectedErrorFlags::Contains, 1);
+	bool bMissingDelivered = false;
+	UBehaviacBehaviorTree* Missing = First;
+	Loader.LoadFile(FPaths::ProjectSavedDir() / TEXT("Automation/NoSuchAsyncTree.xml"),
+		FBehaviacTreeLoadedDelegate::CreateLambda([&bMissingDelivered, &Missing](UBehaviacBehaviorTree* Tree)
+		{
+			bMissingDelivered = true;
+			Missing = Tree;
+		}));
+	PumpUntilLoaded();
+	TestTrue(TEXT("Failure delivered"), bMissingDelivered);
+	TestNull(TEXT("No tree for a missing file"), Missing);
+
+	FBehaviacTreeFileCache::Get().Invalidate(File);
+	IFileManager::Get().Delete(*File);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Agents: fallback tree, completion, superseded loads
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeAsyncLoader_AgentFallback,
+	"BehaviacPlugin.TreeAsyncLoader.AgentFallback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeAsyncLoader_AgentFallback::RunTest(const FString&)
+{
+	const FString File = WriteAsyncTestTree(TEXT("TreeAsyncAgent.xml"), TEXT("AsyncLoaded"));
+	UBehaviacAgentComponent* Agent = BT_MakeAgent();
+
+	int32 FallbackTicks = 0, LoadedTicks = 0;
+	Agent->RegisterMethodHandler(TEXT("AsyncFallback"), [&FallbackTicks]() { ++FallbackTicks; return EBehaviacStatus::Running; });
+	Agent->RegisterMethodHandler(TEXT("AsyncLoaded"), [&LoadedTicks]() { ++LoadedTicks; return EBehaviacStatus::Running; });
+
+	UBehaviacAction* FallbackRoot = NewObject<UBehaviacAction>(GetTransientPackage());
+	FallbackRoot->MethodName = TEXT("AsyncFallback");
+	FallbackRoot->ResultOption = EBehaviacStatus::Running;
+	UBehaviacBehaviorTree* Fallback = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Fallback->RootNode = FallbackRoot;
+
+	// The fallback runs until the file arrives
+	Agent->LoadBehaviorTreeFromFileAsync(File, Fallback);
+	TestTrue(TEXT("Loading"), Agent->IsLoadingBehaviorTree());
+	TestTrue(TEXT("Fallback running"), Agent->GetBehaviorTreeAsset() == Fallback);
+	Agent->TickBehaviorTree();
+	TestEqual(TEXT("Fallback ticked"), FallbackTicks, 1);
+
+	if (!TestTrue(TEXT("Load finished"), PumpUntilLoaded())) return false;
+	TestFalse(TEXT("No longer loading"), Agent->IsLoadingBehaviorTree());
+	TestTrue(TEXT("Loaded tree replaced the fallback"), Agent->GetBehaviorTreeAsset() && Agent->GetBehaviorTreeAsset() != Fallback);
+	Agent->TickBehaviorTree();
+	TestEqual(TEXT("Loaded tree ticked"), LoadedTicks, 1);
+	TestEqual(TEXT("Fallback no longer ticked"), FallbackTicks, 1);
+
+	// A failed load leaves the fallback running
+	AddExpectedError(TEXT("Failed to load behavior tree from file"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("asynchronous tree load failed"), EAutomationExpectedErrorFlags::Contains, 1);
+	Agent->LoadBehaviorTreeFromFileAsync(FPaths::ProjectSavedDir() / TEXT("Automation/NoSuchAsyncTree.xml"), Fallback);
+	PumpUntilLoaded();
+	TestTrue(TEXT("Fallback kept after a failure"), Agent->GetBehaviorTreeAsset() == Fallback);
+
+	// A tree loaded meanwhile wins over a load still in flight
+	FBehaviacTreeFileCache::Get().Invalidate(FBehaviacTreeBinary::ChooseFile(File));
+	Agent->LoadBehaviorTreeFromFileAsync(File);
+	Agent->LoadBehaviorTree(Fallback);
+	TestFalse(TEXT("Superseded load not pending"), Agent->IsLoadingBehaviorTree());
+	PumpUntilLoaded();
+	TestTrue(TEXT("Superseded load dropped"), Agent->GetBehaviorTreeAsset() == Fallback);
+
+	Agent->StopBehaviorTree();
+	FBehaviacTreeFileCache::Get().Invalidate(File);
+	IFileManager::Get().Delete(*File);
+	return true;
+}
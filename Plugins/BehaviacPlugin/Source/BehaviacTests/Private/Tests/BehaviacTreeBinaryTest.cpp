@@ -0,0 +1,181 @@
+// Behaviac UE5 Plugin — Compiled Tree Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TreeBinary
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+
+namespace
+{
+	const TCHAR* CompiledTreeXML =
+		TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+			"<behavior version=\"3\" agenttype=\"TestAgent\">\n"
+			"  <node class=\"behaviac::Sequence\" id=\"1\">\n"
+			"    <node class=\"Condition\" id=\"2\">\n"
+			"      <property name=\"Opl\" value=\"Self.AIState\"/>\n"
+			"      <property name=\"Operator\" value=\"Equal\"/>\n"
+			"      <property name=\"Opr\" value=\"&quot;Chase&quot;\"/>\n"
+			"    </node>\n"
+			"    <node class=\"NoSuchNode\" id=\"5\">\n"
+			"      <node class=\"Noop\" id=\"6\"/>\n"
+			"    </node>\n"
+			"    <node class=\"Action\" id=\"3\">\n"
+			"      <attachment class=\"Precondition\" id=\"4\">\n"
+			"        <property name=\"Opl\" value=\"Self.HP\"/>\n"
+			"        <property name=\"Operator\" value=\"Greater\"/>\n"
+			"        <property name=\"Opr\" value=\"0\"/>\n"
+			"      </attachment>\n"
+			"      <property name=\"Method\" value=\"CompiledStep\"/>\n"
+			"    </node>\n"
+			"  </node>\n"
+			"</behavior>\n");
+
+	UBehaviacBehaviorTree* NewUnoptimizedTree()
+	{
+		UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+		Tree->bOptimizeOnLoad = false;
+		return Tree;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Same tree as the XML
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeBinary_MatchesXML,
+	"BehaviacPlugin.TreeBinary.MatchesXML",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeBinary_MatchesXML::RunTest(const FString&)
+{
+	TArray<uint8> Data;
+	FString Error;
+	if (!TestTrue(TEXT("XML compiles"), FBehaviacTreeBinary::CompileXML(CompiledTreeXML, Data, Error))) return false;
+
+	// Unknown classes are skipped on load, as LoadFromXML skips them
+	AddExpectedError(TEXT("Unknown node class: NoSuchNode"), EAutomationExpectedErrorFlags::Contains, 2);
+	UBehaviacBehaviorTree* FromXML = NewUnoptimizedTree();
+	UBehaviacBehaviorTree* FromBinary = NewUnoptimizedTree();
+	if (!TestTrue(TEXT("XML loads"), FromXML->LoadFromXML(CompiledTreeXML))) return false;
+	if (!TestTrue(TEXT("Compiled tree loads"), FromBinary->LoadFromBinary(Data))) return false;
+
+	TestEqual(TEXT("Version"), FromBinary->Version, 3);
+	TestEqual(TEXT("Agent type"), FromBinary->AgentType, FString(TEXT("TestAgent")));
+
+	const UBehaviacBehaviorNode* Root = FromBinary->RootNode;
+	TestEqual(TEXT("Root id"), Root->NodeId, FromXML->RootNode->NodeId);
+	TestEqual(TEXT("Same children"), Root->GetChildCount(), FromXML->RootNode->GetChildCount());
+	TestEqual(TEXT("Unknown subtree skipped"), Root->GetChildCount(), 2);
+
+	const UBehaviacCondition* Condition = Cast<UBehaviacCondition>(Root->GetChild(0));
+	if (TestNotNull(TEXT("Condition loaded"), Condition))
+	{
+		TestEqual(TEXT("Left operand"), Condition->LeftOperand, FString(TEXT("Self.AIState")));
+		TestEqual(TEXT("Entities decoded at compile time"), Condition->RightOperand, FString(TEXT("\"Chase\"")));
+	}
+
+	const UBehaviacAction* Action = Cast<UBehaviacAction>(Root->GetChild(1));
+	if (TestNotNull(TEXT("Action loaded"), Action))
+	{
+		TestEqual(TEXT("Method"), Action->MethodName, FString(TEXT("CompiledStep")));
+		TestEqual(TEXT("Action id"), Action->NodeId, 3);
+		TestEqual(TEXT("Precondition attached"), Action->Preconditions.Num(), 1);
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Damaged and stale files
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeBinary_RejectsBadData,
+	"BehaviacPlugin.TreeBinary.RejectsBadData",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeBinary_RejectsBadData::RunTest(const FString&)
+{
+	TArray<uint8> Data;
+	FString Error;
+	if (!TestTrue(TEXT("XML compiles"), FBehaviacTreeBinary::CompileXML(CompiledTreeXML, Data, Error))) return false;
+
+	FBehaviacTreeBinaryView View;
+	TestTrue(TEXT("Intact data validates"), View.Initialize(Data, Error));
+
+	TArray<uint8> Corrupt = Data;
+	Corrupt.Last() ^= 0x5A;
+	TestFalse(TEXT("Flipped byte rejected"), View.Initialize(Corrupt, Error));
+	TestTrue(TEXT("Reported as a checksum failure"), Error.Contains(TEXT("checksum")));
+
+	TArray<uint8> Stale = Data;
+	((FBehaviacTreeBinary::FHeader*)Stale.GetData())->FormatVersion = FBehaviacTreeBinary::FormatVersion + 1;
+	TestFalse(TEXT("Other format version rejected"), View.Initialize(Stale, Error));
+	TestTrue(TEXT("Reported as a version mismatch"), Error.Contains(TEXT("format version")));
+
+	TArray<uint8> Truncated = Data;
+	Truncated.SetNum(Data.Num() / 2);
+	TestFalse(TEXT("Truncated file rejected"), View.Initialize(Truncated, Error));
+
+	TArray<uint8> Xml;
+	Xml.Append((const uint8*)"<behavior/>", 11);
+	Xml.AddZeroed(64);
+	TestFalse(TEXT("XML is not a compiled tree"), View.Initialize(Xml, Error));
+
+	// A rejected load leaves the tree as it was
+	AddExpectedError(TEXT("Failed to load compiled tree"), EAutomationExpectedErrorFlags::Contains, 1);
+	UBehaviacBehaviorTree* Tree = NewUnoptimizedTree();
+	TestFalse(TEXT("Corrupt data does not load"), Tree->LoadFromBinary(Corrupt));
+	TestNull(TEXT("Tree untouched"), Tree->RootNode);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Compiled siblings on disk
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeBinary_LoadsCompiledSibling,
+	"BehaviacPlugin.TreeBinary.LoadsCompiledSibling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeBinary_LoadsCompiledSibling::RunTest(const FString&)
+{
+	const FString XmlFile = FPaths::ProjectSavedDir() / TEXT("Automation/TreeBinaryTest.xml");
+	const FString BinaryFile = FBehaviacTreeBinary::GetBinaryPath(XmlFile);
+	AddExpectedError(TEXT("Unknown node class: NoSuchNode"), EAutomationExpectedErrorFlags::Contains, 1);
+	if (!TestTrue(TEXT("XML written"), FFileHelper::SaveStringToFile(CompiledTreeXML, *XmlFile))) return false;
+	if (!TestTrue(TEXT("Compiled next to the XML"), FBehaviacTreeBinary::CompileFile(XmlFile))) return false;
+	TestTrue(TEXT("Sibling is compiled"), FBehaviacTreeBinary::GetFileFormat(BinaryFile) == EBehaviacFileFormat::BSON);
+
+	{
+		// Closed again before the file is deleted below
+		FBehaviacMappedTreeFile Mapped;
+		if (TestTrue(TEXT("Compiled file opens"), Mapped.Open(BinaryFile)))
+		{
+			TestEqual(TEXT("Whole file visible"), (int64)Mapped.GetData().Num(), IFileManager::Get().FileSize(*BinaryFile));
+		}
+	}
+
+	// Up to date: loading the XML path reads the compiled file
+	TestEqual(TEXT("Compiled file chosen"), FBehaviacTreeBinary::ChooseFile(XmlFile), BinaryFile);
+	FBehaviacTreeFileCache::Get().Invalidate(BinaryFile);
+	UBehaviacBehaviorTree* Tree = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, XmlFile);
+	if (TestNotNull(TEXT("Tree loaded"), Tree))
+	{
+		TestEqual(TEXT("Loaded from the compiled file"), Tree->SourceFilePath, BinaryFile);
+		TestNotNull(TEXT("Root built"), Tree->RootNode);
+	}
+
+	// The XML edited after compiling wins until it is compiled again
+	IFileManager::Get().SetTimeStamp(*XmlFile, IFileManager::Get().GetTimeStamp(*BinaryFile) + FTimespan::FromSeconds(10));
+	TestEqual(TEXT("Newer XML chosen"), FBehaviacTreeBinary::ChooseFile(XmlFile), XmlFile);
+
+	FBehaviacTreeFileCache::Get().Invalidate(BinaryFile);
+	IFileManager::Get().Delete(*XmlFile);
+	IFileManager::Get().Delete(*BinaryFile);
+	return true;
+}
@@ -0,0 +1,80 @@
+// Behaviac UE5 Plugin — Tree Cook Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TreeCook
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "BehaviacTestHelpers.h"
+
+namespace
+{
+	/** A Sequence around one action: the optimizer collapses it */
+	FString MakeCookXML(const TCHAR* Method)
+	{
+		return FString::Printf(
+			TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+				"<behavior agenttype=\"TestAgent\" version=\"5\">"
+				"  <node class=\"Sequence\" id=\"1\">"
+				"    <node class=\"Action\" id=\"2\">"
+				"      <property name=\"Method\" value=\"%s\"/>"
+				"    </node>"
+				"  </node>"
+				"</behavior>"), Method);
+	}
+
+	FString GetCookTestFile()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Automation/TreeCookTest.xml");
+	}
+}
+
+// ---------------------------------------------------------------------------
+// The pipeline runs once, at import
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeCook_RunsPipeline,
+	"BehaviacPlugin.TreeCook.RunsPipeline",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeCook_RunsPipeline::RunTest(const FString&)
+{
+	const FString File = GetCookTestFile();
+	if (!TestTrue(TEXT("XML written"), FFileHelper::SaveStringToFile(MakeCookXML(TEXT("CookStep")), *File))) return false;
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	TestFalse(TEXT("Uncooked tree is not current"), Tree->IsCookedFromCurrentSource());
+	if (!TestTrue(TEXT("Cooked"), Tree->CookFromFile(File))) return false;
+
+	TestEqual(TEXT("Pipeline version recorded"), Tree->CookInfo.PipelineVersion, UBehaviacBehaviorTree::CookPipelineVersion);
+	TestEqual(TEXT("Source recorded"), Tree->SourceFilePath, File);
+	TestTrue(TEXT("Optimized"), Tree->RootNode && Tree->RootNode->IsA(UBehaviacAction::StaticClass()));
+	TestEqual(TEXT("Laid out"), Tree->CookInfo.NumNodes, 1);
+	TestTrue(TEXT("State size recorded"), Tree->CookInfo.StateSize > 0);
+	TestTrue(TEXT("Current right after cooking"), Tree->IsCookedFromCurrentSource());
+
+	// Touched without edits is still current
+	IFileManager::Get().SetTimeStamp(*File, FDateTime::UtcNow() + FTimespan::FromSeconds(10));
+	TestTrue(TEXT("Touched source still current"), Tree->IsCookedFromCurrentSource());
+
+	// The touched stamp is remembered: the file is not read again while it keeps that stamp
+	const FDateTime Touched = IFileManager::Get().GetTimeStamp(*File);
+	FFileHelper::SaveStringToFile(MakeCookXML(TEXT("CookPace")), *File);
+	IFileManager::Get().SetTimeStamp(*File, Touched);
+	TestTrue(TEXT("Same stamp not read again"), Tree->IsCookedFromCurrentSource());
+
+	// Edited, the asset is stale until it is cooked again
+	FFileHelper::SaveStringToFile(MakeCookXML(TEXT("CookStepEdited")), *File);
+	IFileManager::Get().SetTimeStamp(*File, FDateTime::UtcNow() + FTimespan::FromSeconds(20));
+	TestFalse(TEXT("Edited source makes it stale"), Tree->IsCookedFromCurrentSource());
+
+	// Cooked by an older pipeline
+	Tree->CookFromFile(File);
+	Tree->CookInfo.PipelineVersion = UBehaviacBehaviorTree::CookPipelineVersion - 1;
+	TestFalse(TEXT("Older pipeline is stale"), Tree->IsCookedFromCurrentSource());
+
+	IFileManager::Get().Delete(*File);
+	return true;
+}
@@ -0,0 +1,127 @@
+// Behaviac UE5 Plugin — Tree File Cache Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TreeFileCache
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacTreeFileCache.h"
+
+namespace
+{
+	FString MakeActionXML(const TCHAR* Method)
+	{
+		return FString::Printf(
+			TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+				"<behavior agenttype=\"TestAgent\" version=\"5\">"
+				"  <node class=\"behaviac::Action\" id=\"1\">"
+				"    <property name=\"Method\" value=\"%s\"/>"
+				"  </node>"
+				"</behavior>"), Method);
+	}
+
+	/** Write Content to File and move its timestamp on, so the change is seen within the same second */
+	bool WriteTreeFile(const FString& File, const FString& Content, int32 SecondsAhead)
+	{
+		if (!FFileHelper::SaveStringToFile(Content, *File))
+		{
+			return false;
+		}
+		IFileManager::Get().SetTimeStamp(*File, FDateTime::UtcNow() + FTimespan::FromSeconds(SecondsAhead));
+		return true;
+	}
+
+	FString GetTestFile()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Automation/TreeFileCacheTest.xml");
+	}
+}
+
+// ---------------------------------------------------------------------------
+// One parse per file
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeFileCache_SharesParse,
+	"BehaviacPlugin.TreeFileCache.SharesParse",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeFileCache_SharesParse::RunTest(const FString&)
+{
+	const FString File = GetTestFile();
+	if (!TestTrue(TEXT("XML written"), WriteTreeFile(File, MakeActionXML(TEXT("TreeFileCacheStep")), 0))) return false;
+	FBehaviacTreeFileCache::Get().Invalidate(File);
+
+	const FBehaviacTreeFileCacheStats Before = UBehaviacBehaviorTreeLibrary::GetTreeFileCacheStats();
+	UBehaviacBehaviorTree* First = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, File);
+	if (!TestNotNull(TEXT("Tree loaded"), First)) return false;
+
+	// A hundred guards spawning
+	bool bAllShared = true;
+	for (int32 i = 0; i < 99; i++)
+	{
+		bAllShared &= UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, File) == First;
+	}
+	TestTrue(TEXT("Every load shares the first tree"), bAllShared);
+	TestTrue(TEXT("Relative and full paths are one entry"),
+		UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, FPaths::ConvertRelativePathToFull(File)) == First);
+
+	const FBehaviacTreeFileCacheStats After = UBehaviacBehaviorTreeLibrary::GetTreeFileCacheStats();
+	TestEqual(TEXT("Parsed once"), After.Misses - Before.Misses, (int64)1);
+	TestEqual(TEXT("Other loads hit"), After.Hits - Before.Hits, (int64)100);
+	TestTrue(TEXT("Memory accounted"), After.Bytes > Before.Bytes);
+
+	// Switched off, every load parses
+	const int32 Previous = CVarBehaviacTreeFileCache.GetValueOnGameThread();
+	CVarBehaviacTreeFileCache->Set(0);
+	UBehaviacBehaviorTree* Uncached = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(nullptr, File);
+	CVarBehaviacTreeFileCache->Set(Previous);
+	TestTrue(TEXT("Disabled cache parses a new tree"), Uncached && Uncached != First);
+
+	FBehaviacTreeFileCache::Get().Invalidate(File);
+	IFileManager::Get().Delete(*File);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Edits and invalidation
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeFileCache_PicksUpEdits,
+	"BehaviacPlugin.TreeFileCache.PicksUpEdits",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeFileCache_PicksUpEdits::RunTest(const FString&)
+{
+	FBehaviacTreeFileCache& Cache = FBehaviacTreeFileCache::Get();
+	const FString File = GetTestFile();
+	if (!TestTrue(TEXT("XML written"), WriteTreeFile(File, MakeActionXML(TEXT("TreeFileCacheOld")), 0))) return false;
+	Cache.Invalidate(File);
+
+	UBehaviacBehaviorTree* Original = Cache.Load(File);
+	if (!TestNotNull(TEXT("Tree loaded"), Original)) return false;
+
+	// Saved again without changes: nothing to parse
+	WriteTreeFile(File, MakeActionXML(TEXT("TreeFileCacheOld")), 10);
+	TestTrue(TEXT("Touched file keeps the tree"), Cache.Load(File) == Original);
+
+	// Edited: parsed again
+	const int64 Reloads = Cache.GetStats().Reloads;
+	WriteTreeFile(File, MakeActionXML(TEXT("TreeFileCacheNew")), 20);
+	UBehaviacBehaviorTree* Edited = Cache.Load(File);
+	if (!TestNotNull(TEXT("Edited tree loaded"), Edited)) return false;
+	TestTrue(TEXT("Edit gives a new tree"), Edited != Original);
+	TestEqual(TEXT("Counted as a reload"), Cache.GetStats().Reloads, Reloads + 1);
+	const UBehaviacAction* Action = Cast<UBehaviacAction>(Edited->RootNode);
+	TestTrue(TEXT("New tree has the edit"), Action && Action->MethodName == TEXT("TreeFileCacheNew"));
+
+	// Dropped by name, as Behaviac.ReimportBT does
+	TestEqual(TEXT("Dropped by base name"), Cache.InvalidateByName(TEXT("TreeFileCacheTest")), 1);
+	TestTrue(TEXT("Next load parses again"), Cache.Load(File) != Edited);
+
+	Cache.Invalidate(File);
+	IFileManager::Get().Delete(*File);
+	return true;
+}
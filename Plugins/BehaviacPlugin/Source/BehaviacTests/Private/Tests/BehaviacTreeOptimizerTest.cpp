@@ -0,0 +1,158 @@
+// Behaviac UE5 Plugin — Tree Optimizer Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.Optimizer
+
+#include "Misc/AutomationTest.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacTreeOptimizer.h"
+
+namespace
+{
+	template <typename T>
+	T* WithId(T* Node, int32 Id)
+	{
+		Node->NodeId = Id;
+		return Node;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Constant folding and dead branches
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacOptimizer_FoldsAndPrunes,
+	"BehaviacPlugin.Optimizer.FoldsAndPrunes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacOptimizer_FoldsAndPrunes::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAction* X = WithId(BT_MakeAction(A, EBehaviacStatus::Failure, TEXT("OptimizerX")), 6);
+	UBehaviacAction* Y = WithId(BT_MakeAction(A, EBehaviacStatus::Success, TEXT("OptimizerY")), 7);
+
+	// Selector(False, Sequence(Noop, 3 < 5, X), Y)
+	UBehaviacSelector* Root = WithId(BT_MakeSelector({
+		WithId(BT_MakeFalse(), 2),
+		WithId(BT_MakeSequence({
+			WithId(BT_MakeNoop(), 4),
+			WithId(BT_MakeCondition(TEXT("3"), EBehaviacOperatorType::Less, TEXT("5")), 5),
+			X }), 3),
+		Y }), 1);
+
+	FBehaviacTreeOptimizerStats Stats;
+	UBehaviacBehaviorNode* NewRoot = FBehaviacTreeOptimizer::Optimize(Root, GetTransientPackage(), Stats);
+
+	TestTrue(TEXT("Selector kept"), NewRoot == Root);
+	TestEqual(TEXT("Selector(X, Y) left"), Root->GetChildCount(), 2);
+	TestTrue(TEXT("Sequence collapsed into X"), Root->GetChild(0) == X);
+	TestTrue(TEXT("Y kept"), Root->GetChild(1) == Y);
+	TestTrue(TEXT("X parented to the selector"), X->GetParent() == Root);
+
+	TestEqual(TEXT("Nodes before"), Stats.NodesBefore, 7);
+	TestEqual(TEXT("Nodes after"), Stats.NodesAfter, 3);
+	TestEqual(TEXT("Nodes removed"), Stats.GetNodesRemoved(), 4);
+	TestEqual(TEXT("Constant condition folded"), Stats.ConstantsFolded, 1);
+	TestEqual(TEXT("Noop, folded condition and False pruned"), Stats.NodesPruned, 3);
+	TestEqual(TEXT("Sequence collapsed"), Stats.NodesCollapsed, 1);
+
+	TestTrue(TEXT("X remembers the sequence"), X->MergedNodeIds.Contains(3));
+	TestTrue(TEXT("X remembers the noop"), X->MergedNodeIds.Contains(4));
+	TestTrue(TEXT("X remembers the condition"), X->MergedNodeIds.Contains(5));
+	TestTrue(TEXT("Selector remembers the false"), Root->MergedNodeIds.Contains(2));
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(NewRoot);
+	TestEqual(TEXT("X fails, Y succeeds"), Tree->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacOptimizer_CollapsesDecorators,
+	"BehaviacPlugin.Optimizer.CollapsesDecorators",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacOptimizer_CollapsesDecorators::RunTest(const FString&)
+{
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAction* Act = BT_MakeAction(A, EBehaviacStatus::Failure, TEXT("OptimizerFails"));
+
+	UBehaviacDecoratorLoop* Once = BT_WrapDecorator<UBehaviacDecoratorLoop>(Act);
+	Once->LoopCount = 1;
+
+	// Sequence(Not(False), AlwaysSuccess(AlwaysFailure(Loop(1, Act))))
+	UBehaviacSequence* Root = BT_MakeSequence({
+		BT_WrapDecorator<UBehaviacDecoratorNot>(BT_MakeFalse()),
+		BT_WrapDecorator<UBehaviacDecoratorAlwaysSuccess>(BT_WrapDecorator<UBehaviacDecoratorAlwaysFailure>(Once)) });
+
+	FBehaviacTreeOptimizerStats Stats;
+	UBehaviacBehaviorNode* NewRoot = FBehaviacTreeOptimizer::Optimize(Root, GetTransientPackage(), Stats);
+
+	TestTrue(TEXT("Everything but the action removed"), NewRoot == Act);
+	TestEqual(TEXT("AlwaysSuccess became the result option"), Act->ResultOption, EBehaviacStatus::Success);
+	TestEqual(TEXT("Nodes after"), Stats.NodesAfter, 1);
+	TestEqual(TEXT("Both decorators fused into the action"), Stats.NodesFused, 2);
+	TestEqual(TEXT("Loop and sequence collapsed"), Stats.NodesCollapsed, 2);
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Tree = BT_BuildTree(NewRoot);
+	TestEqual(TEXT("Failure still reported as success"), Tree->Tick(A), EBehaviacStatus::Success);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Fusion on load
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacOptimizer_FusesGuardedAction,
+	"BehaviacPlugin.Optimizer.FusesGuardedAction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacOptimizer_FusesGuardedAction::RunTest(const FString&)
+{
+	const FString XML =
+		TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+			"<behavior agenttype=\"TestAgent\" version=\"5\">"
+			"  <node class=\"behaviac::Sequence\" id=\"1\">"
+			"    <node class=\"behaviac::Condition\" id=\"2\">"
+			"      <property name=\"Opl\" value=\"Self.HP\"/>"
+			"      <property name=\"Operator\" value=\"Greater\"/>"
+			"      <property name=\"Opr\" value=\"0\"/>"
+			"    </node>"
+			"    <node class=\"behaviac::Action\" id=\"3\">"
+			"      <property name=\"Method\" value=\"OptimizerAttack\"/>"
+			"    </node>"
+			"  </node>"
+			"</behavior>");
+
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	if (!TestTrue(TEXT("Tree loaded"), Tree->LoadFromXML(XML))) return false;
+
+	UBehaviacGuardedAction* Fused = Cast<UBehaviacGuardedAction>(Tree->RootNode);
+	if (!TestNotNull(TEXT("Sequence(Condition, Action) fused"), Fused)) return false;
+	TestEqual(TEXT("Keeps the action's id"), Fused->NodeId, 3);
+	TestTrue(TEXT("Remembers the sequence"), Fused->MergedNodeIds.Contains(1));
+	TestTrue(TEXT("Remembers the condition"), Fused->MergedNodeIds.Contains(2));
+	TestEqual(TEXT("Removed count reported"), Tree->OptimizerStats.GetNodesRemoved(), 2);
+
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	int32 Calls = 0;
+	A->RegisterMethodHandler(TEXT("OptimizerAttack"), [&Calls]()
+	{
+		++Calls;
+		return EBehaviacStatus::Success;
+	});
+
+	TUniquePtr<FBehaviacBehaviorTreeTask> Task = BT_BuildTree(Tree->RootNode);
+	A->SetFloatValue(TEXT("HP"), 5.f);
+	TestEqual(TEXT("Guard passes"), Task->Tick(A), EBehaviacStatus::Success);
+	TestEqual(TEXT("Action ran"), Calls, 1);
+
+	A->SetFloatValue(TEXT("HP"), 0.f);
+	TestEqual(TEXT("Guard fails"), Task->Tick(A), EBehaviacStatus::Failure);
+	TestEqual(TEXT("Action skipped"), Calls, 1);
+
+	// Opting out keeps the tree as authored
+	UBehaviacBehaviorTree* Authored = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Authored->bOptimizeOnLoad = false;
+	Authored->LoadFromXML(XML);
+	TestTrue(TEXT("Unoptimized root is the sequence"), Authored->RootNode && Authored->RootNode->IsA<UBehaviacSequence>());
+	return true;
+}
@@ -0,0 +1,211 @@
+// Behaviac UE5 Plugin — Tree Registry Tests
+// Licensed under the BSD 3-Clause License.
+//
+// Run via: Automation RunTests BehaviacPlugin.TreeRegistry
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "BehaviacTestHelpers.h"
+#include "BehaviorTree/BehaviacTreeRegistry.h"
+
+namespace
+{
+	/** Tree whose root references Path; the node's outer is the tree, as when loaded from XML */
+	UBehaviacBehaviorTree* MakeReferencingTree(const FString& Path, UBehaviacReferenceBehavior*& OutNode)
+	{
+		UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+		OutNode = NewObject<UBehaviacReferenceBehavior>(Tree);
+		OutNode->ReferencedTreePath = Path;
+		Tree->RootNode = OutNode;
+		return Tree;
+	}
+
+	const FBehaviacReferenceBehaviorTask* GetReferenceTask(UBehaviacAgentComponent* Agent)
+	{
+		FBehaviacBehaviorTreeTask* Root = Agent->GetBehaviorTreeTask();
+		return Root ? BehaviacCastTask<FBehaviacReferenceBehaviorTask>(Root->GetChildTask(0)) : nullptr;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Loading once per path
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeRegistry_DedupesByPath,
+	"BehaviacPlugin.TreeRegistry.DedupesByPath",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeRegistry_DedupesByPath::RunTest(const FString&)
+{
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+
+	TestEqual(TEXT("Extension dropped"), FBehaviacTreeRegistry::NormalizePath(TEXT("Combat/Attack.xml")), FString(TEXT("Combat/Attack")));
+	TestEqual(TEXT("Separators and leading slash"), FBehaviacTreeRegistry::NormalizePath(TEXT("\\Combat\\Attack.XML")), FString(TEXT("Combat/Attack")));
+
+	const FString File = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Automation/TreeRegistryTest.xml"));
+	const FString XML =
+		TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+			"<behavior agenttype=\"TestAgent\" version=\"5\">"
+			"  <node class=\"behaviac::Action\" id=\"1\">"
+			"    <property name=\"Method\" value=\"TreeRegistryStep\"/>"
+			"  </node>"
+			"</behavior>");
+	if (!TestTrue(TEXT("XML written"), FFileHelper::SaveStringToFile(XML, *File))) return false;
+
+	UBehaviacBehaviorTree* First = Registry.Load(File);
+	TestNotNull(TEXT("File loaded"), First);
+	TestTrue(TEXT("Second load is the same tree"), Registry.Load(File) == First);
+	TestTrue(TEXT("Found without the extension"), Registry.Find(FPaths::ChangeExtension(File, TEXT(""))) == First);
+
+	// An edited file is loaded again
+	if (!TestTrue(TEXT("XML edited"), FFileHelper::SaveStringToFile(XML.Replace(TEXT("TreeRegistryStep"), TEXT("TreeRegistryEditedStep")), *File))) return false;
+	TestNull(TEXT("Stale tree not found"), Registry.Find(File));
+	UBehaviacBehaviorTree* Edited = Registry.Load(File);
+	TestTrue(TEXT("Edited file parsed again"), Edited && Edited != First);
+	TestTrue(TEXT("Edited tree registered"), Registry.Find(File) == Edited);
+	Registry.Unregister(File);
+	TestNull(TEXT("Forgotten after unregister"), Registry.Find(File));
+	IFileManager::Get().Delete(*File);
+
+	// Trees built in code resolve like loaded ones
+	UBehaviacBehaviorTree* Built = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Registry.Register(TEXT("Tests/RegistryBuilt"), Built);
+	TestTrue(TEXT("Registered tree loads"), Registry.Load(TEXT("/Tests/RegistryBuilt.xml")) == Built);
+	Registry.Unregister(TEXT("Tests/RegistryBuilt"));
+
+	AddExpectedError(TEXT("Could not find behavior tree"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestNull(TEXT("Unknown path"), Registry.Load(TEXT("Tests/RegistryMissing")));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Linking ReferencedBehavior nodes
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeRegistry_LinksReferencedBehavior,
+	"BehaviacPlugin.TreeRegistry.LinksReferencedBehavior",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeRegistry_LinksReferencedBehavior::RunTest(const FString&)
+{
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+
+	UBehaviacBehaviorTree* Sub = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Sub->RootNode = BT_MakeAction(A, EBehaviacStatus::Success, TEXT("TreeRegistrySubStep"));
+	Registry.Register(TEXT("Tests/RegistrySub"), Sub);
+
+	UBehaviacReferenceBehavior* Ref = nullptr;
+	UBehaviacBehaviorTree* Main = MakeReferencingTree(TEXT("Tests/RegistrySub.xml"), Ref);
+
+	int32 Calls = 0;
+	auto Step = [&Calls]()
+	{
+		++Calls;
+		return EBehaviacStatus::Success;
+	};
+	A->RegisterMethodHandler(TEXT("TreeRegistrySubStep"), Step);
+	B->RegisterMethodHandler(TEXT("TreeRegistrySubStep"), Step);
+
+	A->LoadBehaviorTree(Main);
+	B->LoadBehaviorTree(Main);
+	TestNull(TEXT("Not linked before the first entry"), Ref->GetLinkedTree());
+
+	TestEqual(TEXT("A runs the subtree"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("B runs the subtree"), B->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestEqual(TEXT("Subtree action ran for both"), Calls, 2);
+	TestTrue(TEXT("Linked to the registered tree"), Ref->GetLinkedTree() == Sub);
+	TestTrue(TEXT("Link recorded"), Registry.IsLinked(Main, Sub));
+
+	const FBehaviacReferenceBehaviorTask* TaskA = GetReferenceTask(A);
+	const FBehaviacReferenceBehaviorTask* TaskB = GetReferenceTask(B);
+	if (!TestTrue(TEXT("Reference tasks built"), TaskA && TaskB)) return false;
+	TestTrue(TEXT("A's subtree instanced"), TaskA->GetSubtree().IsValid());
+	TestTrue(TEXT("Program shared with the subtree asset"), TaskA->GetSubtree().GetProgram() == Sub->GetCompiledTree());
+	TestTrue(TEXT("Program shared between agents"), TaskA->GetSubtree().GetProgram() == TaskB->GetSubtree().GetProgram());
+	TestTrue(TEXT("State is per agent"), TaskA->GetSubtree().GetRoot() != TaskB->GetSubtree().GetRoot());
+
+	Registry.Unregister(TEXT("Tests/RegistrySub"));
+	TestFalse(TEXT("Links dropped with the tree"), Registry.IsLinked(Main, Sub));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeRegistry_RelinksAfterChanges,
+	"BehaviacPlugin.TreeRegistry.RelinksAfterChanges",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeRegistry_RelinksAfterChanges::RunTest(const FString&)
+{
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+	UBehaviacAgentComponent* B = BT_MakeAgent();
+
+	UBehaviacReferenceBehavior* Ref = nullptr;
+	UBehaviacBehaviorTree* Main = MakeReferencingTree(TEXT("Tests/RegistryLate"), Ref);
+	AddExpectedError(TEXT("Could not find behavior tree"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	// Nothing registered yet: the link fails
+	A->LoadBehaviorTree(Main);
+	TestEqual(TEXT("Missing subtree fails"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestNull(TEXT("Not linked"), Ref->GetLinkedTree());
+
+	// Registered later: the failed link is tried again
+	UBehaviacBehaviorTree* Late = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	Late->RootNode = BT_MakeAction(A, EBehaviacStatus::Success, TEXT("TreeRegistryLateStep"));
+	Registry.Register(TEXT("Tests/RegistryLate"), Late);
+	TestEqual(TEXT("Subtree runs once registered"), A->TickBehaviorTree(), EBehaviacStatus::Success);
+	TestTrue(TEXT("Linked to the late tree"), Ref->GetLinkedTree() == Late);
+
+	// Unregistered: the link to the dropped tree is not reused
+	Registry.Unregister(TEXT("Tests/RegistryLate"));
+	B->LoadBehaviorTree(Main);
+	TestEqual(TEXT("Dropped subtree fails"), B->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestNull(TEXT("Link to the dropped tree reset"), Ref->GetLinkedTree());
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Cycles
+// ---------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacTreeRegistry_DetectsCycles,
+	"BehaviacPlugin.TreeRegistry.DetectsCycles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacTreeRegistry_DetectsCycles::RunTest(const FString&)
+{
+	FBehaviacTreeRegistry& Registry = FBehaviacTreeRegistry::Get();
+	UBehaviacAgentComponent* A = BT_MakeAgent();
+
+	// RegistryA -> RegistryB -> RegistryA
+	UBehaviacReferenceBehavior* RefA = nullptr;
+	UBehaviacReferenceBehavior* RefB = nullptr;
+	UBehaviacBehaviorTree* TreeA = MakeReferencingTree(TEXT("Tests/RegistryB"), RefA);
+	UBehaviacBehaviorTree* TreeB = MakeReferencingTree(TEXT("Tests/RegistryA"), RefB);
+	Registry.Register(TEXT("Tests/RegistryA"), TreeA);
+	Registry.Register(TEXT("Tests/RegistryB"), TreeB);
+
+	AddExpectedError(TEXT("not linked"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	A->LoadBehaviorTree(TreeA);
+	TestEqual(TEXT("Cycle fails instead of recursing"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestTrue(TEXT("A links to B"), RefA->GetLinkedTree() == TreeB);
+	TestNull(TEXT("B refused the link back"), RefB->GetLinkedTree());
+	TestFalse(TEXT("Closing link rejected"), Registry.AddLink(TreeB, TreeA));
+
+	// A tree referencing itself
+	UBehaviacReferenceBehavior* RefSelf = nullptr;
+	UBehaviacBehaviorTree* Self = MakeReferencingTree(TEXT("Tests/RegistrySelf"), RefSelf);
+	Registry.Register(TEXT("Tests/RegistrySelf"), Self);
+	A->LoadBehaviorTree(Self);
+	TestEqual(TEXT("Self reference fails"), A->TickBehaviorTree(), EBehaviacStatus::Failure);
+	TestNull(TEXT("Self reference not linked"), RefSelf->GetLinkedTree());
+
+	Registry.Unregister(TEXT("Tests/RegistryA"));
+	Registry.Unregister(TEXT("Tests/RegistryB"));
+	Registry.Unregister(TEXT("Tests/RegistrySelf"));
+	return true;
+}
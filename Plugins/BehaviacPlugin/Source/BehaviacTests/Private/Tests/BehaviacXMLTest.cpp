@@ -9,6 +9,8 @@
 #include "BehaviorTree/Composites/BehaviacComposites.h"
 #include "BehaviorTree/Actions/BehaviacActions.h"
 #include "BehaviorTree/Conditions/BehaviacConditions.h"
+#include "BehaviorTree/BehaviacXmlReader.h"
+#include "BehaviorTree/BehaviacTreeBinary.h"
 
 // ===========================================================================
 // Helper: load XML and return the tree asset
@@ -17,6 +19,8 @@
 static UBehaviacBehaviorTree* LoadXML(const FString& XML)
 {
 	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	// These tests check the parse itself; the optimizer has its own tests
+	Tree->bOptimizeOnLoad = false;
 	bool bOK = Tree->LoadFromXML(XML);
 	return bOK ? Tree : nullptr;
 }
@@ -170,7 +174,7 @@ bool FBehaviacXML_LoadAndExecute::RunTest(const FString&)
 		return EBehaviacStatus::Success;
 	});
 
-	UBehaviacBehaviorTreeTask* TaskTree = BT_BuildTree(Tree->RootNode);
+	TUniquePtr<FBehaviacBehaviorTreeTask> TaskTree = BT_BuildTree(Tree->RootNode);
 	EBehaviacStatus S = TaskTree->Tick(A);
 	TestEqual(TEXT("XML tree executes → Success"), S, EBehaviacStatus::Success);
 	return true;
@@ -197,7 +201,7 @@ bool FBehaviacXML_MissingMethod::RunTest(const FString&)
 
 	UBehaviacAgentComponent* A = BT_MakeAgent();
 	// No handler registered for "UnregisteredMethod"
-	UBehaviacBehaviorTreeTask* TaskTree = BT_BuildTree(Tree->RootNode);
+	TUniquePtr<FBehaviacBehaviorTreeTask> TaskTree = BT_BuildTree(Tree->RootNode);
 	EBehaviacStatus S = TaskTree->Tick(A);
 
 	// When no handler is present, the action falls back to ResultOption=Success
@@ -261,3 +265,164 @@ bool FBehaviacXML_AgentTypeAndVersion::RunTest(const FString&)
 	TestEqual(TEXT("Version parsed"),   Tree->Version,   7);
 	return true;
 }
+
+// ===========================================================================
+// Streaming reader
+// ===========================================================================
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacXML_ReaderTokens,
+	"BehaviacPlugin.XML.ReaderTokens",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacXML_ReaderTokens::RunTest(const FString&)
+{
+	const FString XML = TEXT("<?xml version=\"1.0\"?><a x=\"1\" y='&lt;2&gt; &amp; &#65;'><!-- <b> --><b/>text<c\n  z = \"3\"></c></a>");
+	FBehaviacXmlReader Reader(XML);
+
+	TestEqual(TEXT("Prolog skipped, <a> starts"), Reader.Next(), EBehaviacXmlToken::StartElement);
+	TestEqual(TEXT("Name is a"), FString(Reader.GetName()), FString(TEXT("a")));
+	TestEqual(TEXT("Double-quoted attribute"), Reader.GetAttribute(TEXT("x")), FString(TEXT("1")));
+	TestEqual(TEXT("Single-quoted attribute, entities decoded"), Reader.GetAttribute(TEXT("y")), FString(TEXT("<2> & A")));
+	TestEqual(TEXT("Missing attribute is empty"), Reader.GetAttribute(TEXT("w")), FString());
+
+	TestEqual(TEXT("Comment skipped, <b/> starts"), Reader.Next(), EBehaviacXmlToken::StartElement);
+	TestEqual(TEXT("Name is b"), FString(Reader.GetName()), FString(TEXT("b")));
+	TestEqual(TEXT("<b/> ends itself"), Reader.Next(), EBehaviacXmlToken::EndElement);
+
+	TestEqual(TEXT("Text skipped, <c> starts"), Reader.Next(), EBehaviacXmlToken::StartElement);
+	TestEqual(TEXT("Attribute across lines"), Reader.GetAttribute(TEXT("z")), FString(TEXT("3")));
+	TestEqual(TEXT("Depth of c"), Reader.GetDepth(), 2);
+	TestEqual(TEXT("</c>"), Reader.Next(), EBehaviacXmlToken::EndElement);
+	TestEqual(TEXT("</a>"), Reader.Next(), EBehaviacXmlToken::EndElement);
+	TestEqual(TEXT("Done"), Reader.Next(), EBehaviacXmlToken::EndOfDocument);
+	TestFalse(TEXT("No error"), Reader.HasError());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacXML_ReaderErrorLocation,
+	"BehaviacPlugin.XML.ReaderErrorLocation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacXML_ReaderErrorLocation::RunTest(const FString&)
+{
+	FBehaviacXmlReader Mismatched(TEXT("<behavior>\n  <node class=\"Noop\">\n  </behavior>"));
+	Mismatched.Next();
+	Mismatched.Next();
+	TestEqual(TEXT("Mismatched end tag"), Mismatched.Next(), EBehaviacXmlToken::Error);
+	int32 Line = 0;
+	int32 Column = 0;
+	Mismatched.GetLocation(Line, Column);
+	TestEqual(TEXT("Error line"), Line, 3);
+	TestEqual(TEXT("Error column"), Column, 3);
+	TestTrue(TEXT("Message names both tags"), Mismatched.GetErrorMessage().Contains(TEXT("</behavior> closes <node>")));
+	TestTrue(TEXT("Message has the location"), Mismatched.GetErrorMessage().StartsWith(TEXT("line 3, column 3")));
+	TestEqual(TEXT("Reader stays failed"), Mismatched.Next(), EBehaviacXmlToken::Error);
+
+	FBehaviacXmlReader Unterminated(TEXT("<behavior>\n<node class=\"Noop>"));
+	Unterminated.Next();
+	TestEqual(TEXT("Unterminated value"), Unterminated.Next(), EBehaviacXmlToken::Error);
+	TestTrue(TEXT("Reported at the attribute"), Unterminated.GetErrorMessage().StartsWith(TEXT("line 2, column 7")));
+
+	AddExpectedError(TEXT("Failed to parse XML content, line 3"), EAutomationExpectedErrorFlags::Contains, 1);
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	TestFalse(TEXT("Tree load fails"), Tree->LoadFromXML(TEXT("<behavior>\n  <node class=\"Noop\">\n  </behavior>")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacXML_ReaderRejectsMalformed,
+	"BehaviacPlugin.XML.ReaderRejectsMalformed",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacXML_ReaderRejectsMalformed::RunTest(const FString&)
+{
+	// Only comments and the like may follow the root
+	FBehaviacXmlReader Trailing(TEXT("<a></a><!-- done -->"));
+	Trailing.Next();
+	Trailing.Next();
+	TestEqual(TEXT("Comment after the root"), Trailing.Next(), EBehaviacXmlToken::EndOfDocument);
+
+	FBehaviacXmlReader SecondRoot(TEXT("<a/>\n<b/>"));
+	SecondRoot.Next();
+	SecondRoot.Next();
+	TestEqual(TEXT("Second root"), SecondRoot.Next(), EBehaviacXmlToken::Error);
+	TestTrue(TEXT("Reported at the second root"), SecondRoot.GetErrorMessage().StartsWith(TEXT("line 2, column 1: <b> after the root element")));
+
+	// Character references must be all digits, and a character
+	FBehaviacXmlReader CharRefs(TEXT("<a x='&#x41;&#66;&amp;#z;'/>"));
+	TestEqual(TEXT("Valid references"), CharRefs.Next(), EBehaviacXmlToken::StartElement);
+	TestEqual(TEXT("Hex and decimal decoded"), CharRefs.GetAttribute(TEXT("x")), FString(TEXT("AB&#z;")));
+
+	const TCHAR* Malformed[] = { TEXT("&#12abc;"), TEXT("&#x;"), TEXT("&#xG1;"), TEXT("&#0;"), TEXT("&#xD800;"), TEXT("&#99999999;") };
+	for (const TCHAR* Reference : Malformed)
+	{
+		FBehaviacXmlReader Reader(FString::Printf(TEXT("<a x=\"1%s\"/>"), Reference));
+		TestEqual(FString::Printf(TEXT("%s rejected"), Reference), Reader.Next(), EBehaviacXmlToken::Error);
+		TestTrue(FString::Printf(TEXT("%s named"), Reference), Reader.GetErrorMessage().Contains(TEXT("malformed character reference")));
+	}
+	TestEqual(TEXT("Decoding keeps a malformed reference as written"), FBehaviacXmlReader::DecodeText(TEXT("&#12abc;")), FString(TEXT("&#12abc;")));
+
+	AddExpectedError(TEXT("<node> after the root element"), EAutomationExpectedErrorFlags::Contains, 1);
+	UBehaviacBehaviorTree* Tree = NewObject<UBehaviacBehaviorTree>(GetTransientPackage());
+	TestFalse(TEXT("Tree with two roots fails"), Tree->LoadFromXML(
+		TEXT("<behavior><node class=\"True\" id=\"1\"/></behavior><node class=\"True\" id=\"2\"/>")));
+	TestNull(TEXT("No root node kept"), Tree->RootNode);
+
+	TArray<uint8> Compiled;
+	FString Error;
+	TestFalse(TEXT("Compiling it fails too"), FBehaviacTreeBinary::CompileXML(
+		TEXT("<behavior><node class=\"True\" id=\"1\"/></behavior><node class=\"True\" id=\"2\"/>"), Compiled, Error));
+	TestTrue(TEXT("Compile error names it"), Error.Contains(TEXT("after the root element")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FBehaviacXML_CommentsAndAttachments,
+	"BehaviacPlugin.XML.CommentsAndAttachments",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+bool FBehaviacXML_CommentsAndAttachments::RunTest(const FString&)
+{
+	// Comments may hold '<' and '>', attributes may span lines
+	const FString XML =
+		TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+			"<!--\n  MoodRoll < 0.35 -> Sleepy\n-->\n"
+			"<behavior version=\"1\" agenttype=\"TestAgent\">\n"
+			"  <node class=\"Sequence\" id=\"1\">\n"
+			"    <!-- <node class=\"Noop\" id=\"9\"/> -->\n"
+			"    <node class=\"Condition\" id=\"2\">\n"
+			"      <property\n        name=\"Opl\"\n        value=\"Self.AIState\"/>\n"
+			"      <property name=\"Operator\" value=\"Equal\"/>\n"
+			"      <property name=\"Opr\" value=\"&quot;Chase&quot;\"/>\n"
+			"    </node>\n"
+			"    <node class=\"Action\" id=\"3\">\n"
+			"      <property name=\"Method\" value=\"XmlReaderStep\"/>\n"
+			"      <attachment class=\"Precondition\" id=\"4\">\n"
+			"        <property name=\"Opl\" value=\"Self.HP\"/>\n"
+			"        <property name=\"Operator\" value=\"Greater\"/>\n"
+			"        <property name=\"Opr\" value=\"0\"/>\n"
+			"      </attachment>\n"
+			"    </node>\n"
+			"  </node>\n"
+			"</behavior>\n");
+
+	UBehaviacBehaviorTree* Tree = LoadXML(XML);
+	if (!TestNotNull(TEXT("Tree loaded"), Tree)) return false;
+	if (!TestNotNull(TEXT("Root parsed"), Tree->RootNode)) return false;
+
+	TestEqual(TEXT("Commented node ignored"), Tree->RootNode->GetChildCount(), 2);
+	TestEqual(TEXT("Root id"), Tree->RootNode->NodeId, 1);
+
+	const UBehaviacCondition* Condition = Cast<UBehaviacCondition>(Tree->RootNode->GetChild(0));
+	if (TestNotNull(TEXT("Condition parsed"), Condition))
+	{
+		TestEqual(TEXT("Multi-line property read"), Condition->LeftOperand, FString(TEXT("Self.AIState")));
+		TestEqual(TEXT("Entities decoded"), Condition->RightOperand, FString(TEXT("\"Chase\"")));
+	}
+
+	const UBehaviacBehaviorNode* Action = Tree->RootNode->GetChild(1);
+	if (TestNotNull(TEXT("Action parsed"), Action))
+	{
+		TestEqual(TEXT("Precondition attached"), Action->Preconditions.Num(), 1);
+		TestEqual(TEXT("Action id"), Action->NodeId, 3);
+	}
+	return true;
+}
@@ -0,0 +1,127 @@
+// Behaviac UE5 Plugin
+// Generated from behavior tree NativeTreeSample by the BehaviacGenerateNativeTrees commandlet. Do not edit:
+// once the tree changes, this code no longer matches and the tree is interpreted until regenerated.
+
+#include "BehaviorTree/BehaviacNativeTree.h"
+#include "BehaviacAgent.h"
+
+namespace
+{
+class FBehaviacNativeTree_NativeTreeSample final : public FBehaviacNativeTreeTask
+{
+protected:
+	virtual void ResetState() override { State = FState(); }
+
+	virtual EBehaviacStatus OnUpdate(UBehaviacAgentComponent* Agent, EBehaviacStatus ChildStatus) override { return Node0(Agent); }
+
+private:
+	struct FState
+	{
+		int32 Hints1[2] = { INDEX_NONE, INDEX_NONE };
+		double EndTime4 = -1.0;
+		int32 Cursor2 = 0;
+		int32 Cursor0 = 0;
+	};
+	FState State;
+
+	/** BehaviacCondition (id 2) */
+	EBehaviacStatus Node1(UBehaviacAgentComponent* Agent)
+	{
+		static const FName Key(TEXT("NativeSample_Value"));
+		double Value;
+		if (ReadNumber(Agent, Key, State.Hints1[0], Value))
+		{
+			return Value < 5.0 ? EBehaviacStatus::Success : EBehaviacStatus::Failure;
+		}
+		static const FBehaviacComparison Comparison = MakeComparison(TEXT("Self.NativeSample_Value"), EBehaviacOperatorType::Less, TEXT("5"));
+		return EvaluateCondition(Agent, Comparison, State.Hints1);
+	}
+
+	/** BehaviacAction (id 4) */
+	EBehaviacStatus Node3(UBehaviacAgentComponent* Agent)
+	{
+		static const int32 MethodId = FBehaviacMethodRegistry::FindOrAdd(TEXT("NativeSample_Act"));
+		return CallMethod(Agent, MethodId, EBehaviacStatus::Running);
+	}
+
+	/** BehaviacWait (id 5) */
+	EBehaviacStatus Node4(UBehaviacAgentComponent* Agent)
+	{
+		return WaitFor(Agent, 0.5f, State.EndTime4);
+	}
+
+	/** BehaviacSelector (id 3) */
+	EBehaviacStatus Node2(UBehaviacAgentComponent* Agent)
+	{
+		for (;;)
+		{
+			EBehaviacStatus Result = EBehaviacStatus::Invalid;
+			switch (State.Cursor2)
+			{
+			case 0: Result = Node3(Agent); break;
+			case 1: Result = Node4(Agent); break;
+			default: State.Cursor2 = 0; return EBehaviacStatus::Failure;
+			}
+			if (Result == EBehaviacStatus::Running)
+			{
+				return Result;
+			}
+			if (Result == EBehaviacStatus::Success)
+			{
+				State.Cursor2 = 0;
+				return Result;
+			}
+			++State.Cursor2;
+		}
+	}
+
+	/** BehaviacFalse (id 7) */
+	EBehaviacStatus Node6(UBehaviacAgentComponent* Agent)
+	{
+		return EBehaviacStatus::Failure;
+	}
+
+	/** BehaviacDecoratorNot (id 6) */
+	EBehaviacStatus Node5(UBehaviacAgentComponent* Agent)
+	{
+		const EBehaviacStatus Result = Node6(Agent);
+		if (Result == EBehaviacStatus::Running)
+		{
+			return Result;
+		}
+		if (Result == EBehaviacStatus::Success)
+		{
+			return EBehaviacStatus::Failure;
+		}
+		return Result == EBehaviacStatus::Failure ? EBehaviacStatus::Success : Result;
+	}
+
+	/** BehaviacSequence (id 1) */
+	EBehaviacStatus Node0(UBehaviacAgentComponent* Agent)
+	{
+		for (;;)
+		{
+			EBehaviacStatus Result = EBehaviacStatus::Invalid;
+			switch (State.Cursor0)
+			{
+			case 0: Result = Node1(Agent); break;
+			case 1: Result = Node2(Agent); break;
+			case 2: Result = Node5(Agent); break;
+			default: State.Cursor0 = 0; return EBehaviacStatus::Success;
+			}
+			if (Result == EBehaviacStatus::Running)
+			{
+				return Result;
+			}
+			if (Result == EBehaviacStatus::Failure)
+			{
+				State.Cursor0 = 0;
+				return Result;
+			}
+			++State.Cursor0;
+		}
+	}
+};
+}
+
+BEHAVIAC_REGISTER_NATIVE_TREE(FBehaviacNativeTree_NativeTreeSample, "NativeTreeSample", 0x9DB49DA3u)
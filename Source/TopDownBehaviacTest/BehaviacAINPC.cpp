@@ -32,6 +32,7 @@ ABehaviacAINPC::ABehaviacAINPC() : Super()
 	LookAroundYaw = 0.0f;
 	LookAroundDir = 1;
 	GuardRadius = 1500.0f;  // Default: 1500 units from spawn
+	bUseBehaviacTickManager = false;
 
 	// Set up AI Controller
 	AIControllerClass = AAIController::StaticClass();
@@ -140,29 +141,28 @@ void ABehaviacAINPC::BeginPlay()
 		BehaviacAgent->SetPropertyValue(TEXT("HasTarget"), TEXT("false"));
 		BehaviacAgent->SetPropertyValue(TEXT("AIState"), TEXT("Patrol"));
 
-		// Always reload from XML file directly so edits take effect without reimporting the asset.
-		// Falls back to the assigned BehaviorTree asset if the file path is unavailable.
-		UBehaviacBehaviorTree* TreeToLoad = nullptr;
-		if (BehaviorTree && !BehaviorTree->SourceFilePath.IsEmpty())
+		// Run the asset's cooked nodes directly. Only when the XML was edited since the
+		// last import is it loaded from the file, so edits take effect without reimporting.
+		// The file is read and parsed in the background while the cooked tree runs, and
+		// shared by every NPC until it changes on disk.
+		if (BehaviorTree)
 		{
-			UBehaviacBehaviorTree* FromFile = UBehaviacBehaviorTreeLibrary::LoadBehaviorTreeFromFile(this, BehaviorTree->SourceFilePath);
-			if (FromFile)
+			bool bLoaded = false;
+			if (!BehaviorTree->SourceFilePath.IsEmpty() && !BehaviorTree->IsCookedFromCurrentSource())
 			{
-				UE_LOG(LogTemp, Warning, TEXT("🌳 [%s] Loaded BT from XML: %s"), *GetName(), *BehaviorTree->SourceFilePath);
-				TreeToLoad = FromFile;
+				UE_LOG(LogTemp, Warning, TEXT("🌳 [%s] Loading BT from XML: %s"), *GetName(), *BehaviorTree->SourceFilePath);
+				BehaviacAgent->LoadBehaviorTreeFromFileAsync(BehaviorTree->SourceFilePath, BehaviorTree);
+				bLoaded = BehaviacAgent->HasBehaviorTree() || BehaviacAgent->IsLoadingBehaviorTree();
+			}
+			else
+			{
+				bLoaded = BehaviacAgent->LoadBehaviorTree(BehaviorTree);
 			}
-		}
-		if (!TreeToLoad)
-		{
-			TreeToLoad = BehaviorTree;
-		}
 
-		if (TreeToLoad)
-		{
-			bool bLoaded = BehaviacAgent->LoadBehaviorTree(TreeToLoad);
 			if (bLoaded)
 			{
 				UE_LOG(LogTemp, Warning, TEXT("✅ [%s]: Behavior tree loaded."), *GetName());
+				BehaviacAgent->SetUseTickManager(bUseBehaviacTickManager);
 			}
 			else
 			{
@@ -193,8 +193,8 @@ void ABehaviacAINPC::Tick(float DeltaTime)
 		DebugTimer = 0.0f;
 	}
 
-	// Tick the behavior tree
-	if (BehaviacAgent)
+	// Tick the behavior tree (unless the Behaviac tick manager does it for us)
+	if (BehaviacAgent && !BehaviacAgent->IsTickManaged())
 	{
 		TickCounter++;
 		
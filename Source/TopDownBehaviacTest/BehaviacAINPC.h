@@ -46,6 +46,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Behaviac")
 	UBehaviacBehaviorTree* BehaviorTree;
 
+	// Tick the tree from the world's Behaviac tick manager instead of this actor's Tick
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Behaviac")
+	bool bUseBehaviacTickManager;
+
 	// AI Properties (Blackboard values)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|State")
 	float DetectionRadius;
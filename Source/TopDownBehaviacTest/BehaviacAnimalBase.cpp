@@ -10,6 +10,9 @@ ABehaviacAnimalBase::ABehaviacAnimalBase()
 {
 	BehaviacAgent = CreateDefaultSubobject<UBehaviacAgentComponent>(TEXT("BehaviacAgent"));
 	BehaviacAgent->bAutoTick = false;
+
+	// Managed ticks run after the actor Tick, so subclasses can sync properties there first
+	BehaviacAgent->ManagedTickGroup = TG_DuringPhysics;
 }
 
 void ABehaviacAnimalBase::BeginPlay()
@@ -47,6 +50,10 @@ void ABehaviacAnimalBase::BeginPlay()
 	{
 		UE_LOG(LogBehaviac, Error, TEXT("[BehaviacAnimalBase] %s: failed to load behavior tree!"), *GetName());
 	}
+	else
+	{
+		BehaviacAgent->SetUseTickManager(bUseBehaviacTickManager);
+	}
 }
 
 void ABehaviacAnimalBase::Tick(float DeltaTime)
@@ -37,6 +37,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behaviac AI", meta = (AllowPrivateAccess = "true"))
 	UBehaviacAgentComponent* BehaviacAgent;
 
+	/** Tick the tree from the world's Behaviac tick manager instead of the actor Tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviac AI")
+	bool bUseBehaviacTickManager = false;
+
 	// ── Position (avoids FVector crossing Puerts boundary) ───────────────────
 	UFUNCTION(BlueprintCallable, Category = "AI|Nav")
 	float GetLocationX() const { return GetActorLocation().X; }
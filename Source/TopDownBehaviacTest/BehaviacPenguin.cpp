@@ -49,7 +49,10 @@ void ABehaviacPenguin::Tick(float DeltaTime)
 	if (!BehaviacAgent) return;
 
 	UpdateBehaviacProperties();
-	BehaviacAgent->TickBehaviorTree();
+	if (!BehaviacAgent->IsTickManaged())
+	{
+		BehaviacAgent->TickBehaviorTree();
+	}
 }
 
 void ABehaviacPenguin::UpdateBehaviacProperties()